@@ -49,6 +49,14 @@ endif
 include common_features.mk
 include $(TMK_PATH)/common.mk
 include $(QUANTUM_PATH)/serial_link/tests/rules.mk
+include $(TMK_PATH)/protocol/tests/rules.mk
+include $(QUANTUM_PATH)/tests/rules.mk
+include $(QUANTUM_PATH)/audio/tests/rules.mk
+include $(DRIVER_PATH)/ugfx/gdisp/tests/rules.mk
+include $(DRIVER_PATH)/avr/tests/rules.mk
+include $(DRIVER_PATH)/arm/tests/rules.mk
+include $(TOP_DIR)/keyboards/ergodox_ez/tests/test.mk
+include $(QUANTUM_PATH)/visualizer/tests/rules.mk
 ifneq ($(filter $(FULL_TESTS),$(TEST)),)
 include build_full_test.mk
 endif
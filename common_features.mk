@@ -38,7 +38,9 @@ ifeq ($(strip $(AUDIO_ENABLE)), yes)
         SRC += $(QUANTUM_DIR)/audio/audio.c
     else
         SRC += $(QUANTUM_DIR)/audio/audio_arm.c
+        SRC += $(QUANTUM_DIR)/audio/synth_mixer.c
     endif
+    SRC += $(QUANTUM_DIR)/audio/synth.c
     SRC += $(QUANTUM_DIR)/audio/voices.c
     SRC += $(QUANTUM_DIR)/audio/luts.c
 endif
@@ -83,6 +85,7 @@ ifeq ($(strip $(UCIS_ENABLE)), yes)
     OPT_DEFS += -DUCIS_ENABLE
     UNICODE_COMMON = yes
     SRC += $(QUANTUM_DIR)/process_keycode/process_ucis.c
+    SRC += $(QUANTUM_DIR)/process_keycode/process_ucis_index.c
 endif
 
 ifeq ($(strip $(UNICODEMAP_ENABLE)), yes)
@@ -98,6 +101,7 @@ ifeq ($(strip $(UNICODE_ENABLE)), yes)
 endif
 
 ifeq ($(strip $(UNICODE_COMMON)), yes)
+    OPT_DEFS += -DUNICODE_COMMON_ENABLE
     SRC += $(QUANTUM_DIR)/process_keycode/process_unicode_common.c
 endif
 
@@ -109,7 +113,21 @@ ifeq ($(strip $(RGBLIGHT_ENABLE)), yes)
     ifeq ($(strip $(RGBLIGHT_CUSTOM_DRIVER)), yes)
         OPT_DEFS += -DRGBLIGHT_CUSTOM_DRIVER
     else
-	    SRC += ws2812.c
+        WS2812_DRIVER = yes
+    endif
+endif
+
+ifeq ($(strip $(RGB_MATRIX_ENABLE)), yes)
+    ifeq ($(strip $(RGBLIGHT_ENABLE)), yes)
+        $(error RGB_MATRIX_ENABLE and RGBLIGHT_ENABLE can't be used together)
+    endif
+    OPT_DEFS += -DRGB_MATRIX_ENABLE
+    SRC += $(QUANTUM_DIR)/rgb_matrix.c
+    CIE1931_CURVE = yes
+    ifeq ($(strip $(RGB_MATRIX_CUSTOM_DRIVER)), yes)
+        OPT_DEFS += -DRGB_MATRIX_CUSTOM_DRIVER
+    else
+        WS2812_DRIVER = yes
     endif
 endif
 
@@ -161,6 +179,13 @@ ifeq ($(strip $(BACKLIGHT_ENABLE)), yes)
     endif
 endif
 
+ifeq ($(strip $(WS2812_DRIVER)), yes)
+    SRC += ws2812.c
+    ifeq ($(PLATFORM),CHIBIOS)
+        SRC += ws2812_spi.c
+    endif
+endif
+
 ifeq ($(strip $(CIE1931_CURVE)), yes)
     OPT_DEFS += -DUSE_CIE1931_CURVE
     LED_TABLES = yes
@@ -180,6 +205,44 @@ ifeq ($(strip $(TERMINAL_ENABLE)), yes)
     OPT_DEFS += -DTERMINAL_ENABLE
 endif
 
+ifeq ($(strip $(DYNAMIC_KEYMAP_ENABLE)), yes)
+    ifeq ($(strip $(KEYMAP_COMPACT_ENABLE)), yes)
+        $(error DYNAMIC_KEYMAP_ENABLE and KEYMAP_COMPACT_ENABLE can't be used together)
+    endif
+    OPT_DEFS += -DDYNAMIC_KEYMAP_ENABLE
+    SRC += $(QUANTUM_DIR)/dynamic_keymap.c
+endif
+
+ifeq ($(strip $(RAW_STREAM_ENABLE)), yes)
+    ifneq ($(strip $(RAW_ENABLE)), yes)
+        $(error RAW_STREAM_ENABLE requires RAW_ENABLE)
+    endif
+    OPT_DEFS += -DRAW_STREAM_ENABLE
+    SRC += $(QUANTUM_DIR)/raw_stream.c
+    SRC += $(QUANTUM_DIR)/raw_hid_stream.c
+endif
+
+ifeq ($(strip $(KEYMAP_COMPACT_ENABLE)), yes)
+    OPT_DEFS += -DKEYMAP_COMPACT_ENABLE
+    SRC += $(QUANTUM_DIR)/keymap_compact.c
+    KEYMAP_COMPACT_TOOL := $(KEYMAP_OUTPUT)/keymap_compact
+    KEYMAP_COMPACT_DATA := $(KEYMAP_OUTPUT)/keymap_compact_data.c
+    SRC += $(KEYMAP_COMPACT_DATA)
+    HOST_CC ?= cc
+    KEYMAP_COMPACT_OBJCOPY ?= $(OBJCOPY)
+
+$(KEYMAP_COMPACT_TOOL): $(QUANTUM_PATH)/tools/keymap_compact.c $(QUANTUM_PATH)/keymap_compact_pack.c
+	@mkdir -p $(@D)
+	$(HOST_CC) -I$(QUANTUM_PATH) -I$(TMK_PATH)/common $^ -o $@
+
+# The keymaps array is extracted from the compiled keymap, so that it's
+# evaluated with exactly the same configuration as the firmware
+$(KEYMAP_COMPACT_DATA): $(KEYMAP_OUTPUT)/$(KEYMAP_C:.c=.o) $(KEYMAP_COMPACT_TOOL)
+	@$(SILENT) || printf "$(MSG_COMPACTING_KEYMAP) $<" | $(AWK_CMD)
+	$(eval CMD=$(KEYMAP_COMPACT_OBJCOPY) -O binary -j '*.keymaps' $< $(@:.c=.bin) && $(KEYMAP_COMPACT_TOOL) $(@:.c=.bin) $@)
+	@$(BUILD_CMD)
+endif
+
 ifeq ($(strip $(USB_HID_ENABLE)), yes)
     include $(TMK_DIR)/protocol/usb_hid.mk
 endif
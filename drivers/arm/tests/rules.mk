@@ -0,0 +1,19 @@
+# Copyright 2026 QMK Firmware contributors
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 2 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+ws2812_spi_INC := $(DRIVER_PATH)/arm
+ws2812_spi_SRC := \
+	$(DRIVER_PATH)/arm/tests/ws2812_spi_tests.cpp \
+	$(DRIVER_PATH)/arm/ws2812_spi.c
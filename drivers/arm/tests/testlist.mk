@@ -0,0 +1,2 @@
+TEST_LIST +=\
+	ws2812_spi
@@ -0,0 +1,93 @@
+/* Copyright 2026 QMK Firmware contributors
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "gtest/gtest.h"
+#include <vector>
+extern "C" {
+#include "ws2812_spi.h"
+}
+
+namespace {
+
+// Samples the SPI bit stream like an LED does, the bit is a one when the
+// line is still high at 500ns
+std::vector<uint8_t> decode(const std::vector<uint8_t>& spi, uint16_t size) {
+    std::vector<uint8_t> colors;
+    for (uint16_t i = 0; i < size; i++) {
+        uint8_t byte = 0;
+        for (uint8_t bit = 0; bit < 8; bit++) {
+            uint16_t symbol = i * 24 + bit * 3;
+            bool start = spi[symbol / 8] & (0x80 >> (symbol % 8));
+            bool middle = spi[(symbol + 1) / 8] & (0x80 >> ((symbol + 1) % 8));
+            bool end = spi[(symbol + 2) / 8] & (0x80 >> ((symbol + 2) % 8));
+            EXPECT_TRUE(start) << "byte " << i << " bit " << int(bit);
+            EXPECT_FALSE(end) << "byte " << i << " bit " << int(bit);
+            byte = (byte << 1) | middle;
+        }
+        colors.push_back(byte);
+    }
+    return colors;
+}
+
+std::vector<uint8_t> encode(const std::vector<uint8_t>& colors) {
+    std::vector<uint8_t> spi(WS2812_SPI_BUFFER_SIZE(colors.size()), 0xAA);
+    EXPECT_EQ(ws2812_spi_encode(colors.data(), colors.size(), spi.data()), spi.size());
+    return spi;
+}
+
+}
+
+TEST(Ws2812Spi, AllByteValuesRoundTrip) {
+    std::vector<uint8_t> colors;
+    for (int i = 0; i < 256; i++) {
+        colors.push_back(i);
+    }
+    EXPECT_EQ(decode(encode(colors), colors.size()), colors);
+}
+
+TEST(Ws2812Spi, GrbwLedsAreSentInMemoryOrder) {
+    // Two GRBW LEDs
+    std::vector<uint8_t> colors = {0xFF, 0x00, 0x80, 0x01, 0x12, 0x34, 0x56, 0x78};
+    std::vector<uint8_t> spi = encode(colors);
+    EXPECT_EQ(decode(spi, colors.size()), colors);
+    // 0xFF is all 110 symbols
+    EXPECT_EQ(spi[0], 0xDB);
+    EXPECT_EQ(spi[1], 0x6D);
+    EXPECT_EQ(spi[2], 0xB6);
+    // 0x00 is all 100 symbols
+    EXPECT_EQ(spi[3], 0x92);
+    EXPECT_EQ(spi[4], 0x49);
+    EXPECT_EQ(spi[5], 0x24);
+}
+
+TEST(Ws2812Spi, EndsWithTheResetTime) {
+    std::vector<uint8_t> colors(3 * 10, 0xFF);
+    std::vector<uint8_t> spi = encode(colors);
+    size_t reset = spi.size() - colors.size() * WS2812_SPI_BYTES_PER_BYTE;
+    EXPECT_GE(reset * 8 * 1e6 / WS2812_SPI_BITRATE, WS2812_RESET_US);
+    for (size_t i = colors.size() * WS2812_SPI_BYTES_PER_BYTE; i < spi.size(); i++) {
+        EXPECT_EQ(spi[i], 0);
+    }
+}
+
+TEST(Ws2812Spi, PulsesMatchTheLedTiming) {
+    const double symbol_ns = 1e9 / WS2812_SPI_BITRATE;
+    // The WS2812B T0H of 400ns and T1H of 800ns, +-150ns
+    EXPECT_GE(symbol_ns, 250);
+    EXPECT_LE(symbol_ns, 550);
+    EXPECT_GE(2 * symbol_ns, 650);
+    EXPECT_LE(2 * symbol_ns, 950);
+}
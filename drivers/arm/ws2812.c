@@ -0,0 +1,66 @@
+/* Copyright 2026 QMK Firmware contributors
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "ch.h"
+#include "hal.h"
+#include "ws2812.h"
+#include "ws2812_spi.h"
+
+#if !SPI_USE_WAIT
+#error "The WS2812 driver needs SPI_USE_WAIT in halconf.h"
+#endif
+
+#ifndef WS2812_SPI
+#define WS2812_SPI SPID1
+#endif
+
+#if defined(RGBLED_NUM)
+#define WS2812_LED_COUNT RGBLED_NUM
+#elif defined(RGB_MATRIX_LED_COUNT)
+#define WS2812_LED_COUNT RGB_MATRIX_LED_COUNT
+#endif
+
+extern const SPIConfig ws2812_spi_config;
+
+static uint8_t buffer[WS2812_SPI_BUFFER_SIZE(WS2812_LED_COUNT * sizeof(LED_TYPE))];
+static bool started = false;
+
+static void ws2812_send(const uint8_t *colors, uint16_t size) {
+    if (!started) {
+        spiStart(&WS2812_SPI, &ws2812_spi_config);
+        started = true;
+    }
+    // The buffer is still being sent, sleep until the end of the transfer
+    // wakes us up like it would wake up spiSend
+    osalSysLock();
+    if (WS2812_SPI.state == SPI_ACTIVE) {
+        _spi_wait_s(&WS2812_SPI);
+    }
+    osalSysUnlock();
+    if (size > WS2812_LED_COUNT * sizeof(LED_TYPE)) {
+        size = WS2812_LED_COUNT * sizeof(LED_TYPE);
+    }
+    uint16_t length = ws2812_spi_encode(colors, size, buffer);
+    spiStartSend(&WS2812_SPI, length, buffer);
+}
+
+void ws2812_setleds(LED_TYPE *ledarray, uint16_t number_of_leds) {
+    ws2812_send((const uint8_t *)ledarray, number_of_leds * sizeof(LED_TYPE));
+}
+
+void ws2812_setleds_rgbw(LED_TYPE *ledarray, uint16_t number_of_leds) {
+    ws2812_send((const uint8_t *)ledarray, number_of_leds * sizeof(LED_TYPE));
+}
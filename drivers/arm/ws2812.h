@@ -0,0 +1,38 @@
+/* Copyright 2026 QMK Firmware contributors
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef WS2812_H
+#define WS2812_H
+
+#include <stdint.h>
+#include "rgblight_types.h"
+
+/* WS2812 output over SPI with DMA
+ *
+ * The SPI configuration depends on the MCU, so the keyboard defines
+ * ws2812_spi_config, which has to run the SPI at WS2812_SPI_BITRATE with
+ * 8 bit frames, MSB first. The keyboard also sets RGB_DI_PIN to the MOSI
+ * function of WS2812_SPI, which defaults to SPID1.
+ *
+ * ws2812_setleds() only encodes the colors and starts the transfer, the
+ * LEDs are updated in the background. If the previous transfer is still
+ * running, it waits for that first.
+ */
+
+void ws2812_setleds(LED_TYPE *ledarray, uint16_t number_of_leds);
+void ws2812_setleds_rgbw(LED_TYPE *ledarray, uint16_t number_of_leds);
+
+#endif
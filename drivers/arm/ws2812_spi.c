@@ -0,0 +1,37 @@
+/* Copyright 2026 QMK Firmware contributors
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "ws2812_spi.h"
+#include <string.h>
+
+// The 12 bits of SPI symbols for each nibble of color
+static const uint16_t nibble_symbols[16] = {
+    0x924, 0x926, 0x934, 0x936, 0x9A4, 0x9A6, 0x9B4, 0x9B6,
+    0xD24, 0xD26, 0xD34, 0xD36, 0xDA4, 0xDA6, 0xDB4, 0xDB6,
+};
+
+uint16_t ws2812_spi_encode(const uint8_t *colors, uint16_t size, uint8_t *buffer) {
+    uint8_t *out = buffer;
+    for (uint16_t i = 0; i < size; i++) {
+        uint16_t high = nibble_symbols[colors[i] >> 4];
+        uint16_t low = nibble_symbols[colors[i] & 0xF];
+        *out++ = high >> 4;
+        *out++ = ((high & 0xF) << 4) | (low >> 8);
+        *out++ = low & 0xFF;
+    }
+    memset(out, 0, WS2812_SPI_RESET_BYTES);
+    return WS2812_SPI_BUFFER_SIZE(size);
+}
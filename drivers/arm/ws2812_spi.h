@@ -0,0 +1,54 @@
+/* Copyright 2026 QMK Firmware contributors
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef WS2812_SPI_H
+#define WS2812_SPI_H
+
+#include <stdint.h>
+
+/* WS2812 bit stream encoding for SPI
+ *
+ * Every bit sent to the LEDs becomes three bits on the SPI MOSI line, 110
+ * for a one and 100 for a zero. At 3MHz that's a high time of 333ns for a
+ * zero and 667ns for a one, within the timing of all the WS2812 variants,
+ * so the SPI and its DMA can send the whole strip without the CPU.
+ */
+
+#define WS2812_SPI_BYTES_PER_BYTE 3
+
+#ifndef WS2812_SPI_BITRATE
+#define WS2812_SPI_BITRATE 3000000
+#endif
+
+// The newer WS2812B need the line to be low for 280us to latch the colors
+#ifndef WS2812_RESET_US
+#define WS2812_RESET_US 280
+#endif
+
+#define WS2812_SPI_RESET_BYTES ((WS2812_RESET_US * (WS2812_SPI_BITRATE / 1000) + 7999) / 8000)
+
+// The size of the SPI buffer for size bytes of colors
+#define WS2812_SPI_BUFFER_SIZE(size) ((size) * WS2812_SPI_BYTES_PER_BYTE + WS2812_SPI_RESET_BYTES)
+
+/* Encodes the colors to buffer, followed by the reset time
+ *
+ * The colors are bytes in the order they are sent, so an LED_TYPE array
+ * can be passed as it is, with GRB or GRBW LEDs. The buffer has to be
+ * WS2812_SPI_BUFFER_SIZE(size) bytes, which is also what's returned.
+ */
+uint16_t ws2812_spi_encode(const uint8_t *colors, uint16_t size, uint8_t *buffer);
+
+#endif
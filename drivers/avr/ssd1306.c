@@ -27,7 +27,25 @@
 #if DEBUG_TO_SCREEN
 static uint8_t displaying;
 #endif
-static uint16_t last_flush;
+static uint32_t last_flush;
+static bool display_on;
+
+struct CharacterMatrix display;
+
+#define MatrixCells (MatrixRows * MatrixCols)
+
+#ifndef SCL_CLOCK
+#define SCL_CLOCK 400000L
+#endif
+// Each byte takes 9 clocks on the bus, including the acknowledge
+#define BytesPerMs (SCL_CLOCK / 9 / 1000)
+// The bytes sent for each run of cells on a row, besides the glyphs. The
+// page and column addresses are three commands each, sent one at a time,
+// and the data starts with the address and the control byte.
+#define RunOverhead (2 * 3 * 3 + 2)
+
+// The cell where the next render continues
+static uint8_t render_pos;
 
 // Write command sequence.
 // Returns true on success.
@@ -102,6 +120,7 @@ static void clear_display(void) {
   }
 
   display.dirty = false;
+  render_pos = 0;
 
 done:
   i2c_master_stop();
@@ -153,6 +172,8 @@ bool iota_gfx_init(void) {
   send_cmd1(NormalDisplay);
   send_cmd1(DeActivateScroll);
   send_cmd1(DisplayOn);
+  display_on = true;
+  last_flush = timer_read32();
 
   send_cmd2(SetContrast, 0); // Dim
 
@@ -174,6 +195,7 @@ bool iota_gfx_off(void) {
   bool success = false;
 
   send_cmd1(DisplayOff);
+  display_on = false;
   success = true;
 
 done:
@@ -184,14 +206,35 @@ bool iota_gfx_on(void) {
   bool success = false;
 
   send_cmd1(DisplayOn);
+  display_on = true;
   success = true;
 
 done:
   return success;
 }
 
+static inline bool cell_dirty(const struct CharacterMatrix *matrix, uint8_t row, uint8_t col) {
+  return matrix->dirty_cells[row][col / 8] & (1 << (col % 8));
+}
+
+static inline void mark_cell(struct CharacterMatrix *matrix, uint8_t row, uint8_t col, bool dirty) {
+  if (dirty) {
+    matrix->dirty_cells[row][col / 8] |= 1 << (col % 8);
+  } else {
+    matrix->dirty_cells[row][col / 8] &= ~(1 << (col % 8));
+  }
+}
+
+static inline void set_cell(struct CharacterMatrix *matrix, uint8_t row, uint8_t col, uint8_t c) {
+  if (matrix->display[row][col] != c) {
+    matrix->display[row][col] = c;
+    mark_cell(matrix, row, col, true);
+  }
+}
+
 void matrix_write_char_inner(struct CharacterMatrix *matrix, uint8_t c) {
-  *matrix->cursor = c;
+  uint8_t pos = matrix->cursor - &matrix->display[0][0];
+  set_cell(matrix, pos / MatrixCols, pos % MatrixCols, c);
   ++matrix->cursor;
 
   if (matrix->cursor - &matrix->display[0][0] == sizeof(matrix->display)) {
@@ -200,12 +243,11 @@ void matrix_write_char_inner(struct CharacterMatrix *matrix, uint8_t c) {
             MatrixCols * (MatrixRows - 1));
     matrix->cursor = &matrix->display[MatrixRows - 1][0];
     memset(matrix->cursor, ' ', MatrixCols);
+    matrix->dirty = true;
   }
 }
 
 void matrix_write_char(struct CharacterMatrix *matrix, uint8_t c) {
-  matrix->dirty = true;
-
   if (c == '\n') {
     // Clear to end of line from the cursor and then move to the
     // start of the next line
@@ -255,22 +297,27 @@ void matrix_clear(struct CharacterMatrix *matrix) {
   memset(matrix->display, ' ', sizeof(matrix->display));
   matrix->cursor = &matrix->display[0][0];
   matrix->dirty = true;
+  memset(matrix->dirty_cells, 0, sizeof(matrix->dirty_cells));
+}
+
+void matrix_update(struct CharacterMatrix *dest, const struct CharacterMatrix *source) {
+  for (uint8_t row = 0; row < MatrixRows; ++row) {
+    for (uint8_t col = 0; col < MatrixCols; ++col) {
+      set_cell(dest, row, col, source->display[row][col]);
+    }
+  }
 }
 
 void iota_gfx_clear_screen(void) {
   matrix_clear(&display);
 }
 
-void matrix_render(struct CharacterMatrix *matrix) {
-  last_flush = timer_read();
-  iota_gfx_on();
-#if DEBUG_TO_SCREEN
-  ++displaying;
-#endif
+// Sends the cells from col to end - 1 of a row
+static bool render_run(struct CharacterMatrix *matrix, uint8_t row, uint8_t col, uint8_t end) {
+  bool success = false;
 
-  // Move to the home position
-  send_cmd3(PageAddr, 0, MatrixRows - 1);
-  send_cmd3(ColumnAddr, 0, (MatrixCols * FontWidth) - 1);
+  send_cmd3(PageAddr, row, row);
+  send_cmd3(ColumnAddr, col * FontWidth, (end * FontWidth) - 1);
 
   if (i2c_start_write(SSD1306_ADDRESS)) {
     goto done;
@@ -280,27 +327,90 @@ void matrix_render(struct CharacterMatrix *matrix) {
     goto done;
   }
 
-  for (uint8_t row = 0; row < MatrixRows; ++row) {
-    for (uint8_t col = 0; col < MatrixCols; ++col) {
-      const uint8_t *glyph = font + (matrix->display[row][col] * (FontWidth - 1));
+  for (; col < end; ++col) {
+    const uint8_t *glyph = font + (matrix->display[row][col] * (FontWidth - 1));
 
-      for (uint8_t glyphCol = 0; glyphCol < FontWidth - 1; ++glyphCol) {
-        uint8_t colBits = pgm_read_byte(glyph + glyphCol);
-        i2c_master_write(colBits);
-      }
-
-      // 1 column of space between chars (it's not included in the glyph)
-      i2c_master_write(0);
+    for (uint8_t glyphCol = 0; glyphCol < FontWidth - 1; ++glyphCol) {
+      uint8_t colBits = pgm_read_byte(glyph + glyphCol);
+      i2c_master_write(colBits);
     }
-  }
 
-  matrix->dirty = false;
+    // 1 column of space between chars (it's not included in the glyph)
+    i2c_master_write(0);
+    mark_cell(matrix, row, col, false);
+  }
+  success = true;
 
 done:
   i2c_master_stop();
+  return success;
+}
+
+// Sends the runs of dirty cells on each row, starting from render_pos,
+// until the next run would go over the budget in bytes. The first run is
+// always sent, so that the rendering progresses with any budget.
+// Returns true when all the cells have been sent.
+static bool render_cells(struct CharacterMatrix *matrix, uint16_t budget) {
+  bool sent = false;
+  bool done = false;
+
+#if DEBUG_TO_SCREEN
+  ++displaying;
+#endif
+
+  if (matrix->dirty) {
+    for (uint8_t row = 0; row < MatrixRows; ++row) {
+      for (uint8_t col = 0; col < MatrixCols; ++col) {
+        mark_cell(matrix, row, col, true);
+      }
+    }
+    matrix->dirty = false;
+  }
+
+  for (uint8_t scanned = 0; scanned < MatrixCells;) {
+    uint8_t row = render_pos / MatrixCols;
+    uint8_t col = render_pos % MatrixCols;
+    uint8_t end = col + 1;
+
+    if (cell_dirty(matrix, row, col)) {
+      uint16_t cost = RunOverhead + FontWidth;
+      while (end < MatrixCols && cell_dirty(matrix, row, end) &&
+             cost + FontWidth <= budget) {
+        ++end;
+        cost += FontWidth;
+      }
+      if (sent && cost > budget) {
+        goto stop;
+      }
+      if (!display_on) {
+        iota_gfx_on();
+      }
+      if (!render_run(matrix, row, col, end)) {
+        goto stop;
+      }
+      last_flush = timer_read32();
+      sent = true;
+      budget = cost < budget ? budget - cost : 0;
+    }
+
+    scanned += end - col;
+    render_pos = (row * MatrixCols + end) % MatrixCells;
+  }
+  done = true;
+
+stop:
 #if DEBUG_TO_SCREEN
   --displaying;
 #endif
+  return done;
+}
+
+void matrix_render(struct CharacterMatrix *matrix) {
+  render_cells(matrix, UINT16_MAX);
+}
+
+bool matrix_render_step(struct CharacterMatrix *matrix, uint16_t budget_us) {
+  return render_cells(matrix, (uint32_t)budget_us * BytesPerMs / 1000);
 }
 
 void iota_gfx_flush(void) {
@@ -314,11 +424,11 @@ void iota_gfx_task_user(void) {
 void iota_gfx_task(void) {
   iota_gfx_task_user();
 
-  if (display.dirty) {
-    iota_gfx_flush();
-  }
+  // Large changes are spread over several calls, so that they don't stall
+  // the matrix scan
+  matrix_render_step(&display, SSD1306_RENDER_BUDGET_US);
 
-  if (timer_elapsed(last_flush) > ScreenOffInterval) {
+  if (display_on && timer_elapsed32(last_flush) > ScreenOffInterval) {
     iota_gfx_off();
   }
 }
@@ -1,6 +1,7 @@
 #ifndef SSD1306_H
 #define SSD1306_H
 
+#include <stdint.h>
 #include <stdbool.h>
 #include <stdio.h>
 #include "pincontrol.h"
@@ -61,13 +62,22 @@ enum ssd1306_cmds {
 #define MatrixRows (DisplayHeight / FontHeight)
 #define MatrixCols (DisplayWidth / FontWidth)
 
+// How long iota_gfx_task can spend sending changes to the display, the rest
+// is sent by the following calls
+#ifndef SSD1306_RENDER_BUDGET_US
+#define SSD1306_RENDER_BUDGET_US 1000
+#endif
+
 struct CharacterMatrix {
   uint8_t display[MatrixRows][MatrixCols];
   uint8_t *cursor;
+  // Set when the whole matrix needs to be sent
   bool dirty;
+  // The cells that have changed since they were sent, one bit per cell
+  uint8_t dirty_cells[MatrixRows][(MatrixCols + 7) / 8];
 };
 
-struct CharacterMatrix display;
+extern struct CharacterMatrix display;
 
 bool iota_gfx_init(void);
 void iota_gfx_task(void);
@@ -86,7 +96,13 @@ void matrix_write_char_inner(struct CharacterMatrix *matrix, uint8_t c);
 void matrix_write_char(struct CharacterMatrix *matrix, uint8_t c);
 void matrix_write(struct CharacterMatrix *matrix, const char *data);
 void matrix_write_P(struct CharacterMatrix *matrix, const char *data);
+// Copies the characters of source to dest, and marks the cells that changed
+void matrix_update(struct CharacterMatrix *dest, const struct CharacterMatrix *source);
+// Sends all the changed cells
 void matrix_render(struct CharacterMatrix *matrix);
+// Sends the changed cells for at most budget_us, continuing from where the
+// previous call stopped. Returns true when nothing is left to send.
+bool matrix_render_step(struct CharacterMatrix *matrix, uint16_t budget_us);
 
 
 
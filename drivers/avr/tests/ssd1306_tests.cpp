@@ -0,0 +1,260 @@
+/* Copyright 2026 QMK Firmware contributors
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "gtest/gtest.h"
+#include <algorithm>
+#include <cstring>
+#include <vector>
+extern "C" {
+#include "ssd1306.h"
+#include "glcdfont.c"
+#include "i2c.h"
+void set_time(uint32_t t);
+void advance_time(uint32_t ms);
+}
+
+namespace {
+
+const int Pages = DisplayHeight / 8;
+
+// A model of the SSD1306 in horizontal addressing mode, that receives the
+// bytes written to the mock I2C bus
+struct {
+    uint32_t bytes;
+    bool control_next;
+    bool data_mode;
+    uint8_t command[3];
+    uint8_t command_length;
+    uint8_t command_expected;
+    uint8_t column_start, column_end, column;
+    uint8_t page_start, page_end, page;
+    bool on;
+    uint8_t ram[Pages][DisplayWidth];
+} oled;
+
+uint8_t command_arguments(uint8_t command) {
+    switch (command) {
+        case ColumnAddr:
+        case PageAddr:
+            return 2;
+        case SetContrast:
+        case SetDisplayClockDiv:
+        case SetMultiPlex:
+        case SetDisplayOffset:
+        case SetChargePump:
+        case SetMemoryMode:
+        case SetComPins:
+        case SetPreCharge:
+        case SetVComDetect:
+            return 1;
+        default:
+            return 0;
+    }
+}
+
+void execute_command() {
+    switch (oled.command[0]) {
+        case ColumnAddr:
+            oled.column_start = oled.column = oled.command[1];
+            oled.column_end = oled.command[2];
+            break;
+        case PageAddr:
+            oled.page_start = oled.page = oled.command[1];
+            oled.page_end = oled.command[2];
+            break;
+        case DisplayOn:
+            oled.on = true;
+            break;
+        case DisplayOff:
+            oled.on = false;
+            break;
+    }
+}
+
+void write_command(uint8_t b) {
+    if (oled.command_expected == 0) {
+        oled.command_length = 0;
+        oled.command_expected = command_arguments(b) + 1;
+    }
+    oled.command[oled.command_length++] = b;
+    if (oled.command_length == oled.command_expected) {
+        execute_command();
+        oled.command_expected = 0;
+    }
+}
+
+void write_ram(uint8_t b) {
+    if (oled.page < Pages && oled.column < DisplayWidth) {
+        oled.ram[oled.page][oled.column] = b;
+    }
+    if (oled.column == oled.column_end) {
+        oled.column = oled.column_start;
+        oled.page = oled.page == oled.page_end ? oled.page_start : oled.page + 1;
+    } else {
+        oled.column++;
+    }
+}
+
+uint32_t bus_us(uint32_t bytes) {
+    return bytes * 9 * 1000000ull / SCL_CLOCK;
+}
+
+}
+
+extern "C" uint8_t i2c_master_start(uint8_t address) {
+    EXPECT_EQ(address, SSD1306_ADDRESS << 1);
+    oled.bytes++;
+    oled.control_next = true;
+    return 0;
+}
+
+extern "C" void i2c_master_stop(void) {
+}
+
+extern "C" uint8_t i2c_master_write(uint8_t data) {
+    oled.bytes++;
+    if (oled.control_next) {
+        oled.control_next = false;
+        oled.data_mode = data & 0x40;
+    } else if (oled.data_mode) {
+        write_ram(data);
+    } else {
+        write_command(data);
+    }
+    return 0;
+}
+
+class SSD1306 : public testing::Test {
+public:
+    SSD1306() {
+        memset(&oled, 0, sizeof(oled));
+        set_time(0);
+        iota_gfx_init();
+    }
+
+    // Runs the task until it stops sending, and returns the bytes sent by
+    // each call
+    std::vector<uint32_t> render() {
+        std::vector<uint32_t> calls;
+        for (int i = 0; i < 1000; i++) {
+            uint32_t start = oled.bytes;
+            iota_gfx_task();
+            if (oled.bytes == start) {
+                break;
+            }
+            calls.push_back(oled.bytes - start);
+        }
+        return calls;
+    }
+
+    uint32_t total(const std::vector<uint32_t>& calls) {
+        uint32_t sum = 0;
+        for (uint32_t bytes : calls) {
+            sum += bytes;
+        }
+        return sum;
+    }
+
+    void expect_shown() {
+        for (int row = 0; row < MatrixRows; row++) {
+            for (int col = 0; col < MatrixCols; col++) {
+                const uint8_t* glyph = font + display.display[row][col] * (FontWidth - 1);
+                for (int i = 0; i < FontWidth; i++) {
+                    uint8_t expected = i < FontWidth - 1 ? glyph[i] : 0;
+                    ASSERT_EQ(oled.ram[row][col * FontWidth + i], expected)
+                        << "row " << row << " col " << col;
+                }
+            }
+        }
+    }
+
+    void show(const char* text) {
+        struct CharacterMatrix matrix;
+        matrix_clear(&matrix);
+        matrix_write(&matrix, text);
+        matrix_update(&display, &matrix);
+    }
+};
+
+// The page and column addresses, one command per transaction, and the
+// start of the data
+const uint32_t RUN_BYTES = 2 * 3 * 3 + 2;
+
+TEST_F(SSD1306, NothingIsSentWithoutChanges) {
+    EXPECT_EQ(render().size(), 0u);
+}
+
+TEST_F(SSD1306, WritingACharacterSendsOneCell) {
+    iota_gfx_write("A");
+    std::vector<uint32_t> calls = render();
+    ASSERT_EQ(calls.size(), 1u);
+    EXPECT_EQ(calls[0], RUN_BYTES + FontWidth);
+    expect_shown();
+}
+
+TEST_F(SSD1306, UpdatingTheMatrixOnlySendsTheChangedCells) {
+    show("Layer: Base");
+    render();
+    expect_shown();
+    show("Layer: Lower");
+    // "Bas" and " " change to "Low" and "r", while the "e" stays
+    EXPECT_EQ(total(render()), 2 * RUN_BYTES + 4 * FontWidth);
+    expect_shown();
+}
+
+TEST_F(SSD1306, ClearingTheScreenIsSpreadOverSeveralCalls) {
+    for (int i = 0; i < MatrixRows * MatrixCols; i++) {
+        iota_gfx_write_char('a' + i % 26);
+    }
+    matrix_render(&display);
+    expect_shown();
+    iota_gfx_clear_screen();
+    std::vector<uint32_t> calls = render();
+    EXPECT_GT(calls.size(), 1u);
+    EXPECT_LE(bus_us(*std::max_element(calls.begin(), calls.end())), SSD1306_RENDER_BUDGET_US);
+    expect_shown();
+}
+
+TEST_F(SSD1306, ChangesDuringARenderAreSent) {
+    iota_gfx_write("Some text on the first line\nand on the second line\nand third");
+    iota_gfx_task();
+    // Behind the cells that have been sent
+    display.display[0][0] = 'X';
+    display.dirty = true;
+    iota_gfx_task();
+    iota_gfx_write_char('Y');
+    render();
+    expect_shown();
+}
+
+TEST_F(SSD1306, MatrixRenderSendsEverythingAtOnce) {
+    iota_gfx_write("Some text on the first line\nand on the second line\nand third");
+    iota_gfx_task();
+    matrix_render(&display);
+    EXPECT_EQ(render().size(), 0u);
+    expect_shown();
+}
+
+TEST_F(SSD1306, TheDisplayTurnsOffOnceAndBackOnWithChanges) {
+    advance_time(300001);
+    iota_gfx_task();
+    EXPECT_FALSE(oled.on);
+    EXPECT_EQ(render().size(), 0u);
+    iota_gfx_write("A");
+    render();
+    EXPECT_TRUE(oled.on);
+    expect_shown();
+}
@@ -141,6 +141,29 @@ unsigned char I2C_Write(unsigned char c)
 
 #endif
 
+/*
+  With WS2812_CHUNK_LEDS defined, the interrupts are only disabled while
+  that many LEDs are sent, and enabled again in between, so a long strip
+  doesn't delay the USB and timer interrupts for milliseconds. The LEDs
+  keep waiting for more data as long as the line isn't low for longer than
+  their reset time, so the interrupt handlers have to finish well within
+  that, about 5us to be safe with all WS2812 variants.
+*/
+static void ws2812_send_leds(uint8_t *data, uint16_t datlen, uint8_t maskhi, uint8_t led_size)
+{
+#ifdef WS2812_CHUNK_LEDS
+  uint16_t chunk = WS2812_CHUNK_LEDS * led_size;
+  while (datlen > chunk) {
+    ws2812_sendarray_mask(data, chunk, maskhi);
+    data += chunk;
+    datlen -= chunk;
+  }
+#else
+  (void)led_size;
+#endif
+  ws2812_sendarray_mask(data, datlen, maskhi);
+}
+
 // Setleds for standard RGB
 void inline ws2812_setleds(LED_TYPE *ledarray, uint16_t leds)
 {
@@ -154,7 +177,7 @@ void inline ws2812_setleds_pin(LED_TYPE *ledarray, uint16_t leds, uint8_t pinmas
   // new universal format (DDR)
   _SFR_IO8((RGB_DI_PIN >> 4) + 1) |= pinmask;
 
-  ws2812_sendarray_mask((uint8_t*)ledarray,leds+leds+leds,pinmask);
+  ws2812_send_leds((uint8_t*)ledarray,leds+leds+leds,pinmask,3);
   _delay_us(50);
 }
 
@@ -188,7 +211,7 @@ void inline ws2812_setleds_rgbw(LED_TYPE *ledarray, uint16_t leds)
   // new universal format (DDR)
   _SFR_IO8((RGB_DI_PIN >> 4) + 1) |= _BV(RGB_DI_PIN & 0xF);
 
-  ws2812_sendarray_mask((uint8_t*)ledarray,leds<<2,_BV(RGB_DI_PIN & 0xF));
+  ws2812_send_leds((uint8_t*)ledarray,leds<<2,_BV(RGB_DI_PIN & 0xF),4);
 
 
   #ifndef RGBW_BB_TWI
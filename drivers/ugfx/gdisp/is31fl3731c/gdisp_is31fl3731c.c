@@ -109,6 +109,10 @@ typedef struct{
     uint8_t write_buffer[IS31_FRAME_SIZE];
     uint8_t frame_buffer[GDISP_SCREEN_HEIGHT * GDISP_SCREEN_WIDTH];
     uint8_t page;
+    // The PWM registers that have changed since each of the two pages was
+    // last written, the range is empty when start == end
+    uint8_t dirty_start[2];
+    uint8_t dirty_end[2];
 }__attribute__((__packed__)) PrivData;
 
 // Some common routines and macros
@@ -139,11 +143,41 @@ static GFXINLINE void write_ram(GDisplay *g, uint8_t page, uint16_t offset, uint
     write_data(g, (uint8_t*)PRIV(g), length + 1);
 }
 
+// Writes the PWM registers from start to end. The register address has to
+// be sent right before the data, so it temporarily replaces the byte before
+// the range, which is write_buffer_offset for the first register.
+static GFXINLINE void write_pwm(GDisplay *g, uint8_t page, uint8_t start, uint8_t end) {
+    uint8_t* tx = (uint8_t*)PRIV(g) + start;
+    uint8_t saved = *tx;
+    *tx = IS31_PWM_REG + start;
+    write_page(g, page);
+    write_data(g, tx, end - start + 1);
+    *tx = saved;
+}
+
+static GFXINLINE void mark_dirty(GDisplay *g, uint8_t address) {
+    for (uint8_t i = 0; i < 2; i++) {
+        if (PRIV(g)->dirty_start[i] == PRIV(g)->dirty_end[i]) {
+            PRIV(g)->dirty_start[i] = address;
+            PRIV(g)->dirty_end[i] = address + 1;
+        }
+        else if (address < PRIV(g)->dirty_start[i]) {
+            PRIV(g)->dirty_start[i] = address;
+        }
+        else if (address >= PRIV(g)->dirty_end[i]) {
+            PRIV(g)->dirty_end[i] = address + 1;
+        }
+    }
+}
+
 LLDSPEC bool_t gdisp_lld_init(GDisplay *g) {
     // The private area is the display surface.
     g->priv = gfxAlloc(sizeof(PrivData));
     __builtin_memset(PRIV(g), 0, sizeof(PrivData));
     PRIV(g)->page = 0;
+    // The first frame is written in full to both pages
+    PRIV(g)->dirty_end[0] = IS31_PWM_SIZE;
+    PRIV(g)->dirty_end[1] = IS31_PWM_SIZE;
 
     // Initialise the board interface
     init_board(g);
@@ -191,25 +225,38 @@ LLDSPEC bool_t gdisp_lld_init(GDisplay *g) {
         if (!(g->flags & GDISP_FLG_NEEDFLUSH))
             return;
 
-        PRIV(g)->page++;
-        PRIV(g)->page %= 2;
-        // TODO: some smarter algorithm for this
-        // We should run only one physical page at a time
-        // This way we don't need to send so much data, and
-        // we could use slightly less memory
+        g->flags &= ~GDISP_FLG_NEEDFLUSH;
+
+        // The write buffer holds the frame that is on the screen, so
+        // comparing against it finds the LEDs that changed, including the
+        // ones changed by the backlight
         uint8_t* src = PRIV(g)->frame_buffer;
         for (int y=0;y<GDISP_SCREEN_HEIGHT;y++) {
             for (int x=0;x<GDISP_SCREEN_WIDTH;x++) {
                 uint8_t val = (uint16_t)*src * g->g.Backlight / 100;
-                PRIV(g)->write_buffer[get_led_address(g, x, y)]=CIE1931_CURVE[val];
+                uint8_t address = get_led_address(g, x, y);
+                uint8_t pwm = CIE1931_CURVE[val];
+                if (PRIV(g)->write_buffer[address] != pwm) {
+                    PRIV(g)->write_buffer[address] = pwm;
+                    mark_dirty(g, address);
+                }
                 ++src;
             }
         }
-        write_ram(g, PRIV(g)->page, IS31_PWM_REG, IS31_PWM_SIZE);
+
+        uint8_t shown = PRIV(g)->page;
+        if (PRIV(g)->dirty_start[shown] == PRIV(g)->dirty_end[shown])
+            return;
+
+        // The other page was last written two flushes ago, so only the
+        // registers that changed since then are sent
+        PRIV(g)->page++;
+        PRIV(g)->page %= 2;
+        uint8_t page = PRIV(g)->page;
+        write_pwm(g, page, PRIV(g)->dirty_start[page], PRIV(g)->dirty_end[page]);
+        PRIV(g)->dirty_start[page] = PRIV(g)->dirty_end[page] = 0;
         gfxSleepMilliseconds(1);
         write_register(g, IS31_FUNCTIONREG, IS31_REG_PICTDISP, PRIV(g)->page);
-
-        g->flags &= ~GDISP_FLG_NEEDFLUSH;
     }
 #endif
 
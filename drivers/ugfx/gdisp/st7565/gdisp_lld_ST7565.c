@@ -34,6 +34,8 @@
 
 #define GDISP_FLG_NEEDFLUSH         (GDISP_FLG_DRIVER<<0)
 
+#define GDISP_PAGES                 (GDISP_SCREEN_HEIGHT / 8)
+
 #include "st7565.h"
 
 /*===========================================================================*/
@@ -56,10 +58,22 @@
 /* Driver local functions.                                                   */
 /*===========================================================================*/
 
+/*
+ * The display is double buffered in the controller, so each of the two
+ * buffers keeps its own dirty column range for every page. A range is the
+ * columns that have changed since the buffer was last written, and it's
+ * empty when start == end.
+ */
+typedef struct{
+    uint8_t start;
+    uint8_t end;
+}DirtyRange;
+
 typedef struct{
     bool_t buffer2;
     uint8_t data_pos;
     uint8_t data[16];
+    DirtyRange dirty[2][GDISP_PAGES];
     uint8_t ram[GDISP_SCREEN_HEIGHT * GDISP_SCREEN_WIDTH / 8];
 }PrivData;
 
@@ -86,6 +100,42 @@ static GFXINLINE void flush_cmd(GDisplay* g) {
 #define xyaddr(x, y)        ((x) + ((y)>>3)*GDISP_SCREEN_WIDTH)
 #define xybit(y)            (1<<((y)&7))
 
+static GFXINLINE void mark_dirty(GDisplay* g, coord_t x, coord_t page) {
+    for (unsigned b = 0; b < 2; b++) {
+        DirtyRange* range = &PRIV(g)->dirty[b][page];
+        if (range->start == range->end) {
+            range->start = x;
+            range->end = x + 1;
+        }
+        else if (x < range->start) {
+            range->start = x;
+        }
+        else if (x >= range->end) {
+            range->end = x + 1;
+        }
+    }
+}
+
+// Only marks the page dirty when the pixel actually changes, so redrawing
+// the same content doesn't send anything
+static GFXINLINE void set_pixel(GDisplay* g, coord_t x, coord_t y, bool_t on) {
+    uint8_t* dst = &(RAM(g)[xyaddr(x, y)]);
+    uint8_t value = on ? *dst | xybit(y) : *dst & ~xybit(y);
+    if (value != *dst) {
+        *dst = value;
+        mark_dirty(g, x, y >> 3);
+        g->flags |= GDISP_FLG_NEEDFLUSH;
+    }
+}
+
+static GFXINLINE bool_t is_clean(GDisplay* g, unsigned buffer) {
+    for (unsigned p = 0; p < GDISP_PAGES; p++) {
+        if (PRIV(g)->dirty[buffer][p].start != PRIV(g)->dirty[buffer][p].end)
+            return FALSE;
+    }
+    return TRUE;
+}
+
 /*===========================================================================*/
 /* Driver exported functions.                                                */
 /*===========================================================================*/
@@ -102,6 +152,13 @@ LLDSPEC bool_t gdisp_lld_init(GDisplay *g) {
     g->priv = gfxAlloc(sizeof(PrivData));
     PRIV(g)->buffer2 = false;
     PRIV(g)->data_pos = 0;
+    // Neither buffer has been written yet
+    for (unsigned b = 0; b < 2; b++) {
+        for (unsigned p = 0; p < GDISP_PAGES; p++) {
+            PRIV(g)->dirty[b][p].start = 0;
+            PRIV(g)->dirty[b][p].end = GDISP_SCREEN_WIDTH;
+        }
+    }
 
     // Initialise the board interface
     init_board(g);
@@ -156,18 +213,32 @@ LLDSPEC void gdisp_lld_flush(GDisplay *g) {
     if (!(g->flags & GDISP_FLG_NEEDFLUSH))
         return;
 
+    // The buffer on the screen only misses the changes since the last flush,
+    // so if there are none, the pixels were drawn back to what they were
+    unsigned target = PRIV(g)->buffer2 ? 1 : 0;
+    if (is_clean(g, !target)) {
+        g->flags &= ~GDISP_FLG_NEEDFLUSH;
+        return;
+    }
+
     acquire_bus(g);
     enter_cmd_mode(g);
     unsigned dstOffset = (PRIV(g)->buffer2 ? 4 : 0);
-    for (p = 0; p < 4; p++) {
+    for (p = 0; p < GDISP_PAGES; p++) {
+        // The hidden buffer was last written two flushes ago, so only the
+        // columns changed since then are sent
+        DirtyRange* range = &PRIV(g)->dirty[target][p];
+        if (range->start == range->end)
+            continue;
         write_cmd(g, ST7565_PAGE | (p + dstOffset));
-        write_cmd(g, ST7565_COLUMN_MSB | 0);
-        write_cmd(g, ST7565_COLUMN_LSB | 0);
+        write_cmd(g, ST7565_COLUMN_MSB | (range->start >> 4));
+        write_cmd(g, ST7565_COLUMN_LSB | (range->start & 0xF));
         write_cmd(g, ST7565_RMW);
         flush_cmd(g);
         enter_data_mode(g);
-        write_data(g, RAM(g) + (p*GDISP_SCREEN_WIDTH), GDISP_SCREEN_WIDTH);
+        write_data(g, RAM(g) + (p*GDISP_SCREEN_WIDTH) + range->start, range->end - range->start);
         enter_cmd_mode(g);
+        range->start = range->end = 0;
     }
     unsigned line = (PRIV(g)->buffer2 ? 32 : 0);
     write_cmd(g, ST7565_START_LINE | line);
@@ -202,11 +273,7 @@ LLDSPEC void gdisp_lld_draw_pixel(GDisplay *g) {
         y = g->p.x;
         break;
     }
-    if (gdispColor2Native(g->p.color) != Black)
-        RAM(g)[xyaddr(x, y)] |= xybit(y);
-    else
-        RAM(g)[xyaddr(x, y)] &= ~xybit(y);
-    g->flags |= GDISP_FLG_NEEDFLUSH;
+    set_pixel(g, x, y, gdispColor2Native(g->p.color) != Black);
 }
 #endif
 
@@ -250,18 +317,11 @@ LLDSPEC void gdisp_lld_blit_area(GDisplay *g) {
             uint8_t src = buffer[srcbit / 8];
             uint8_t bit = 7-(srcbit % 8);
             uint8_t bitset = (src >> bit) & 1;
-            uint8_t* dst = &(RAM(g)[xyaddr(dstx, dsty)]);
-            if (bitset) {
-                *dst |= xybit(dsty);
-            }
-            else {
-                *dst &= ~xybit(dsty);
-            }
+            set_pixel(g, dstx, dsty, bitset);
             dstx++;
             srcbit++;
         }
     }
-    g->flags |= GDISP_FLG_NEEDFLUSH;
 }
 
 #if GDISP_NEED_CONTROL && GDISP_HARDWARE_CONTROL
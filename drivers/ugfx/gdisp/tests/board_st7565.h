@@ -0,0 +1,61 @@
+/* Copyright 2026 QMK Firmware contributors
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _GDISP_LLD_BOARD_H
+#define _GDISP_LLD_BOARD_H
+
+#include "gdisp_mock.h"
+
+static bool mock_data_mode;
+
+static GFXINLINE void acquire_bus(GDisplay *g) {
+    (void) g;
+}
+
+static GFXINLINE void release_bus(GDisplay *g) {
+    (void) g;
+}
+
+static GFXINLINE void init_board(GDisplay *g) {
+    (void) g;
+    mock_data_mode = false;
+}
+
+static GFXINLINE void post_init_board(GDisplay *g) {
+    (void) g;
+}
+
+static GFXINLINE void setpin_reset(GDisplay *g, bool_t state) {
+    (void) g;
+    (void) state;
+}
+
+static GFXINLINE void enter_data_mode(GDisplay *g) {
+    (void) g;
+    mock_data_mode = true;
+}
+
+static GFXINLINE void enter_cmd_mode(GDisplay *g) {
+    (void) g;
+    mock_data_mode = false;
+}
+
+static GFXINLINE void write_data(GDisplay *g, uint8_t* data, uint16_t length) {
+    (void) g;
+    st7565_mock_write(mock_data_mode, data, length);
+}
+
+#endif /* _GDISP_LLD_BOARD_H */
@@ -0,0 +1,68 @@
+/* Copyright 2026 QMK Firmware contributors
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef GDISP_MOCK_H
+#define GDISP_MOCK_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/* Models of the displays on the other side of the mock buses
+ *
+ * The mock boards pass everything that the drivers write to the models,
+ * which count the bytes, and keep the memory of the controllers, so that
+ * the tests can check what would be on the screen.
+ */
+
+#define MOCK_LCD_WIDTH 128
+#define MOCK_LCD_HEIGHT 32
+#define MOCK_LED_WIDTH 7
+#define MOCK_LED_HEIGHT 7
+
+typedef struct GDisplay GDisplay;
+
+typedef struct {
+    // The number of bytes and transfers written to the bus
+    uint32_t bytes;
+    uint32_t transfers;
+} mock_bus_t;
+
+extern mock_bus_t mock_bus;
+
+void st7565_mock_write(bool data_mode, const uint8_t* data, uint16_t length);
+void is31fl3731c_mock_write(const uint8_t* data, uint16_t length);
+
+// Initializes the driver and its model, and returns the display
+GDisplay* st7565_mock_init(void);
+void st7565_mock_draw_pixel(GDisplay* g, int16_t x, int16_t y, bool on);
+// Blits a one bit per pixel bitmap, like gdispGBlitArea does for fonts
+void st7565_mock_blit(GDisplay* g, int16_t x, int16_t y, int16_t cx, int16_t cy, const uint8_t* bitmap, int16_t bitmap_width);
+void st7565_mock_flush(GDisplay* g);
+// The pixel in the driver's frame buffer
+bool st7565_mock_pixel(GDisplay* g, int16_t x, int16_t y);
+// The pixel that is on the screen, from the model
+bool st7565_mock_shown(int16_t x, int16_t y);
+
+GDisplay* is31fl3731c_mock_init(void);
+void is31fl3731c_mock_draw_pixel(GDisplay* g, int16_t x, int16_t y, uint8_t color);
+void is31fl3731c_mock_set_backlight(GDisplay* g, uint8_t backlight);
+void is31fl3731c_mock_flush(GDisplay* g);
+// The PWM value that the driver should have sent for the pixel
+uint8_t is31fl3731c_mock_expected(GDisplay* g, int16_t x, int16_t y);
+// The PWM value of the LED on the frame that is shown, from the model
+uint8_t is31fl3731c_mock_shown(int16_t x, int16_t y);
+
+#endif
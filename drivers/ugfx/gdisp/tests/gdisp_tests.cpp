@@ -0,0 +1,244 @@
+/* Copyright 2026 QMK Firmware contributors
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "gtest/gtest.h"
+#include <cstdlib>
+extern "C" {
+#include "gdisp_mock.h"
+}
+
+namespace {
+
+// The command bytes for selecting the page and column of one range
+const uint32_t ST7565_RANGE_COMMANDS = 4;
+// The start line command that shows the buffer
+const uint32_t ST7565_SWAP_COMMANDS = 1;
+
+// Selecting the page and the register address of the PWM range, and then
+// selecting the function page and the shown frame
+const uint32_t IS31_FLUSH_OVERHEAD = 2 + 1 + 2 + 2;
+const uint32_t IS31_PWM_SIZE = 0x90;
+
+// An 8x8 glyph, with one byte per line
+const uint8_t glyph_a[] = {0x18, 0x24, 0x42, 0x42, 0x7E, 0x42, 0x42, 0x00};
+const uint8_t glyph_b[] = {0x7C, 0x42, 0x42, 0x7C, 0x42, 0x42, 0x7C, 0x00};
+const uint8_t cursor[] = {0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF};
+
+// The first and last column that differ between glyph_a and glyph_b, the
+// blank columns at the edges are the same
+int first_changed_column() {
+    uint8_t changed = 0;
+    for (int i = 0; i < 8; i++) {
+        changed |= glyph_a[i] ^ glyph_b[i];
+    }
+    return __builtin_clz(changed) - 24;
+}
+
+int last_changed_column() {
+    uint8_t changed = 0;
+    for (int i = 0; i < 8; i++) {
+        changed |= glyph_a[i] ^ glyph_b[i];
+    }
+    return 7 - __builtin_ctz(changed);
+}
+
+uint32_t changed_columns() {
+    return last_changed_column() - first_changed_column() + 1;
+}
+
+}
+
+class GdispST7565 : public testing::Test {
+public:
+    GdispST7565() {
+        g = st7565_mock_init();
+    }
+
+    uint32_t flush() {
+        uint32_t start = mock_bus.bytes;
+        st7565_mock_flush(g);
+        return mock_bus.bytes - start;
+    }
+
+    void expect_shown() {
+        for (int y = 0; y < MOCK_LCD_HEIGHT; y++) {
+            for (int x = 0; x < MOCK_LCD_WIDTH; x++) {
+                ASSERT_EQ(st7565_mock_shown(x, y), st7565_mock_pixel(g, x, y)) << "at " << x << ", " << y;
+            }
+        }
+    }
+
+    // Writes both buffers of the controller once, and leaves glyph_a at the
+    // given position on the screen
+    void warm_up(int16_t x, int16_t y) {
+        st7565_mock_blit(g, x, y, 8, 8, glyph_b, 8);
+        flush();
+        st7565_mock_blit(g, x, y, 8, 8, glyph_a, 8);
+        flush();
+    }
+
+    GDisplay* g;
+};
+
+TEST_F(GdispST7565, FirstFlushSendsTheWholeScreen) {
+    st7565_mock_draw_pixel(g, 10, 10, true);
+    const uint32_t pages = MOCK_LCD_HEIGHT / 8;
+    EXPECT_EQ(flush(), pages * (ST7565_RANGE_COMMANDS + MOCK_LCD_WIDTH) + ST7565_SWAP_COMMANDS);
+    expect_shown();
+}
+
+TEST_F(GdispST7565, SecondFlushSendsTheWholeScreenToTheOtherBuffer) {
+    st7565_mock_draw_pixel(g, 10, 10, true);
+    flush();
+    st7565_mock_draw_pixel(g, 20, 20, true);
+    const uint32_t pages = MOCK_LCD_HEIGHT / 8;
+    EXPECT_EQ(flush(), pages * (ST7565_RANGE_COMMANDS + MOCK_LCD_WIDTH) + ST7565_SWAP_COMMANDS);
+    expect_shown();
+}
+
+TEST_F(GdispST7565, ChangingAGlyphOnlySendsItsColumns) {
+    warm_up(40, 8);
+    st7565_mock_blit(g, 40, 8, 8, 8, glyph_b, 8);
+    EXPECT_EQ(flush(), ST7565_RANGE_COMMANDS + changed_columns() + ST7565_SWAP_COMMANDS);
+    expect_shown();
+}
+
+TEST_F(GdispST7565, AGlyphAcrossTwoPagesSendsBothPages) {
+    warm_up(40, 4);
+    st7565_mock_blit(g, 40, 4, 8, 8, cursor, 8);
+    EXPECT_EQ(flush(), 2 * (ST7565_RANGE_COMMANDS + 8) + ST7565_SWAP_COMMANDS);
+    expect_shown();
+}
+
+TEST_F(GdispST7565, TheHiddenBufferGetsTheChangesOfBothFlushes) {
+    warm_up(40, 8);
+    st7565_mock_blit(g, 40, 8, 8, 8, glyph_b, 8);
+    flush();
+    st7565_mock_blit(g, 80, 8, 8, 8, glyph_b, 8);
+    // One range from the first glyph to the second, as they are on the same
+    // page
+    const uint32_t columns = (80 + last_changed_column()) - (40 + first_changed_column()) + 1;
+    EXPECT_EQ(flush(), ST7565_RANGE_COMMANDS + columns + ST7565_SWAP_COMMANDS);
+    expect_shown();
+}
+
+TEST_F(GdispST7565, RedrawingTheSameContentSendsNothing) {
+    warm_up(40, 8);
+    uint32_t transfers = mock_bus.transfers;
+    st7565_mock_blit(g, 40, 8, 8, 8, glyph_a, 8);
+    EXPECT_EQ(flush(), 0u);
+    EXPECT_EQ(mock_bus.transfers, transfers);
+    expect_shown();
+}
+
+TEST_F(GdispST7565, RandomUpdatesAreShown) {
+    srand(1);
+    for (int frame = 0; frame < 50; frame++) {
+        for (int i = 0; i < rand() % 20; i++) {
+            st7565_mock_draw_pixel(g, rand() % MOCK_LCD_WIDTH, rand() % MOCK_LCD_HEIGHT, rand() % 2);
+        }
+        flush();
+        expect_shown();
+    }
+}
+
+class GdispIS31FL3731C : public testing::Test {
+public:
+    GdispIS31FL3731C() {
+        g = is31fl3731c_mock_init();
+    }
+
+    uint32_t flush() {
+        uint32_t start = mock_bus.bytes;
+        is31fl3731c_mock_flush(g);
+        return mock_bus.bytes - start;
+    }
+
+    void expect_shown() {
+        for (int y = 0; y < MOCK_LED_HEIGHT; y++) {
+            for (int x = 0; x < MOCK_LED_WIDTH; x++) {
+                ASSERT_EQ(is31fl3731c_mock_shown(x, y), is31fl3731c_mock_expected(g, x, y)) << "at " << x << ", " << y;
+            }
+        }
+    }
+
+    // Writes both frames once
+    void warm_up() {
+        is31fl3731c_mock_draw_pixel(g, 0, 0, 255);
+        flush();
+        is31fl3731c_mock_draw_pixel(g, 0, 0, 0);
+        flush();
+    }
+
+    GDisplay* g;
+};
+
+TEST_F(GdispIS31FL3731C, FirstFlushSendsAllPwmRegisters) {
+    is31fl3731c_mock_draw_pixel(g, 3, 3, 255);
+    EXPECT_EQ(flush(), IS31_FLUSH_OVERHEAD + IS31_PWM_SIZE);
+    expect_shown();
+}
+
+TEST_F(GdispIS31FL3731C, ChangingOneLedSendsOneRegister) {
+    warm_up();
+    is31fl3731c_mock_draw_pixel(g, 0, 0, 255);
+    EXPECT_EQ(flush(), IS31_FLUSH_OVERHEAD + 1);
+    expect_shown();
+}
+
+TEST_F(GdispIS31FL3731C, ChangingARowSendsTheRow) {
+    warm_up();
+    for (int x = 0; x < MOCK_LED_WIDTH; x++) {
+        is31fl3731c_mock_draw_pixel(g, x, 0, 255);
+    }
+    EXPECT_EQ(flush(), IS31_FLUSH_OVERHEAD + MOCK_LED_WIDTH);
+    expect_shown();
+}
+
+TEST_F(GdispIS31FL3731C, RedrawingTheSameContentSendsNothing) {
+    warm_up();
+    uint32_t transfers = mock_bus.transfers;
+    is31fl3731c_mock_draw_pixel(g, 0, 0, 0);
+    EXPECT_EQ(flush(), 0u);
+    EXPECT_EQ(mock_bus.transfers, transfers);
+    expect_shown();
+}
+
+TEST_F(GdispIS31FL3731C, ChangingTheBacklightUpdatesTheLitLeds) {
+    warm_up();
+    is31fl3731c_mock_draw_pixel(g, 2, 1, 255);
+    is31fl3731c_mock_draw_pixel(g, 5, 4, 255);
+    flush();
+    flush();
+    is31fl3731c_mock_set_backlight(g, 50);
+    // From LA(2, 1) to LA(5, 4)
+    EXPECT_EQ(flush(), IS31_FLUSH_OVERHEAD + 4 * 16 + 5 - (1 * 16 + 2) + 1);
+    expect_shown();
+}
+
+TEST_F(GdispIS31FL3731C, RandomUpdatesAreShown) {
+    srand(1);
+    for (int frame = 0; frame < 50; frame++) {
+        for (int i = 0; i < rand() % 5; i++) {
+            is31fl3731c_mock_draw_pixel(g, rand() % MOCK_LED_WIDTH, rand() % MOCK_LED_HEIGHT, rand() % 256);
+        }
+        if (frame % 10 == 0) {
+            is31fl3731c_mock_set_backlight(g, rand() % 101);
+        }
+        flush();
+        expect_shown();
+    }
+}
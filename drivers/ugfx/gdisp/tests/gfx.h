@@ -0,0 +1,92 @@
+/* Copyright 2026 QMK Firmware contributors
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef GFX_H
+#define GFX_H
+
+/* The parts of uGFX that the low level gdisp drivers use
+ *
+ * This lets the drivers be built natively against the mock boards, so the
+ * tests can check what they send over the bus.
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+
+#define TRUE 1
+#define FALSE 0
+
+#define GFX_USE_GDISP TRUE
+// The control calls cast pointers to integers, which doesn't build cleanly
+// on 64 bit hosts
+#define GDISP_NEED_CONTROL FALSE
+
+#define GFXINLINE inline
+// Each driver is built in its own translation unit
+#define LLDSPEC static __attribute__((unused))
+
+typedef int8_t bool_t;
+typedef int16_t coord_t;
+typedef uint8_t color_t;
+
+#define Black 0
+#define White 255
+#define gdispColor2Native(c) (c)
+#define gdispNative2Color(c) (c)
+
+typedef enum {
+    powerOff,
+    powerSleep,
+    powerDeepSleep,
+    powerOn,
+} powermode_t;
+
+typedef enum {
+    GDISP_ROTATE_0 = 0,
+    GDISP_ROTATE_90 = 90,
+    GDISP_ROTATE_180 = 180,
+    GDISP_ROTATE_270 = 270,
+} orientation_t;
+
+#define GDISP_FLG_DRIVER 0x0100
+
+typedef struct GDisplay {
+    struct {
+        coord_t Width;
+        coord_t Height;
+        orientation_t Orientation;
+        powermode_t Powermode;
+        uint8_t Backlight;
+        uint8_t Contrast;
+    } g;
+    void* priv;
+    uint16_t flags;
+    struct {
+        coord_t x, y;
+        coord_t cx, cy;
+        coord_t x1, y1;
+        coord_t x2, y2;
+        color_t color;
+        void* ptr;
+    } p;
+} GDisplay;
+
+#define gfxAlloc(size) malloc(size)
+#define gfxSleepMilliseconds(ms) ((void)(ms))
+#define gfxSleepMicroseconds(us) ((void)(us))
+
+#endif
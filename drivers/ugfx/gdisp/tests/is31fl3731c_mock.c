@@ -0,0 +1,89 @@
+/* Copyright 2026 QMK Firmware contributors
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <string.h>
+
+#define LED_WIDTH MOCK_LED_WIDTH
+#define LED_HEIGHT MOCK_LED_HEIGHT
+#include "gdisp_mock.h"
+#include "ugfx/gdisp/is31fl3731c/gdisp_is31fl3731c.c"
+
+// Eight frames, and the function registers on page nine
+#define IS31_MOCK_PAGES (IS31_FUNCTIONREG + 1)
+
+static struct {
+    uint8_t page;
+    uint8_t registers[IS31_MOCK_PAGES][IS31_FRAME_SIZE];
+} leds;
+
+static GDisplay led_display;
+
+void is31fl3731c_mock_write(const uint8_t* data, uint16_t length) {
+    mock_bus.bytes += length;
+    mock_bus.transfers++;
+    if (length < 2) {
+        return;
+    }
+    if (data[0] == IS31_COMMANDREGISTER) {
+        leds.page = data[1];
+        return;
+    }
+    // The register address auto increments
+    for (uint16_t i = 1; i < length; i++) {
+        uint16_t reg = data[0] + i - 1;
+        if (leds.page < IS31_MOCK_PAGES && reg < IS31_FRAME_SIZE) {
+            leds.registers[leds.page][reg] = data[i];
+        }
+    }
+}
+
+GDisplay* is31fl3731c_mock_init(void) {
+    free(led_display.priv);
+    memset(&led_display, 0, sizeof(led_display));
+    memset(&leds, 0, sizeof(leds));
+    memset(&mock_bus, 0, sizeof(mock_bus));
+    gdisp_lld_init(&led_display);
+    led_display.g.Backlight = 100;
+    return &led_display;
+}
+
+void is31fl3731c_mock_draw_pixel(GDisplay* g, int16_t x, int16_t y, uint8_t color) {
+    g->p.x = x;
+    g->p.y = y;
+    g->p.color = color;
+    gdisp_lld_draw_pixel(g);
+}
+
+void is31fl3731c_mock_set_backlight(GDisplay* g, uint8_t backlight) {
+    g->g.Backlight = backlight;
+    g->flags |= GDISP_FLG_NEEDFLUSH;
+}
+
+void is31fl3731c_mock_flush(GDisplay* g) {
+    gdisp_lld_flush(g);
+}
+
+uint8_t is31fl3731c_mock_expected(GDisplay* g, int16_t x, int16_t y) {
+    g->p.x = x;
+    g->p.y = y;
+    uint8_t val = (uint16_t)gdisp_lld_get_pixel_color(g) * g->g.Backlight / 100;
+    return CIE1931_CURVE[val];
+}
+
+uint8_t is31fl3731c_mock_shown(int16_t x, int16_t y) {
+    uint8_t frame = leds.registers[IS31_FUNCTIONREG][IS31_REG_PICTDISP] & 7;
+    return leds.registers[frame][IS31_PWM_REG + get_led_address(NULL, x, y)];
+}
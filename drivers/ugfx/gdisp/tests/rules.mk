@@ -0,0 +1,22 @@
+# Copyright 2026 QMK Firmware contributors
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 2 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+gdisp_flush_DEFS := -DUSE_CIE1931_CURVE
+gdisp_flush_INC := $(DRIVER_PATH)/ugfx/gdisp/tests
+gdisp_flush_SRC := \
+	$(DRIVER_PATH)/ugfx/gdisp/tests/gdisp_tests.cpp \
+	$(DRIVER_PATH)/ugfx/gdisp/tests/st7565_mock.c \
+	$(DRIVER_PATH)/ugfx/gdisp/tests/is31fl3731c_mock.c \
+	$(QUANTUM_PATH)/led_tables.c
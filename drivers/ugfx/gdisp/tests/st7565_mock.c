@@ -0,0 +1,113 @@
+/* Copyright 2026 QMK Firmware contributors
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <string.h>
+
+#define LCD_WIDTH MOCK_LCD_WIDTH
+#define LCD_HEIGHT MOCK_LCD_HEIGHT
+#include "gdisp_mock.h"
+#include "ugfx/gdisp/st7565/gdisp_lld_ST7565.c"
+
+// The controller has 8 pages of 132 columns, and a ninth page for icons
+#define ST7565_MOCK_PAGES 8
+#define ST7565_MOCK_COLUMNS 132
+
+static struct {
+    uint8_t page;
+    uint8_t column;
+    uint8_t start_line;
+    bool contrast_next;
+    uint8_t ram[ST7565_MOCK_PAGES][ST7565_MOCK_COLUMNS];
+} lcd;
+
+static GDisplay lcd_display;
+
+mock_bus_t mock_bus;
+
+void st7565_mock_write(bool data_mode, const uint8_t* data, uint16_t length) {
+    mock_bus.bytes += length;
+    mock_bus.transfers++;
+    for (uint16_t i = 0; i < length; i++) {
+        uint8_t b = data[i];
+        if (data_mode) {
+            if (lcd.page < ST7565_MOCK_PAGES && lcd.column < ST7565_MOCK_COLUMNS) {
+                lcd.ram[lcd.page][lcd.column] = b;
+            }
+            lcd.column++;
+        }
+        else if (lcd.contrast_next) {
+            lcd.contrast_next = false;
+        }
+        else if (b == ST7565_CONTRAST) {
+            lcd.contrast_next = true;
+        }
+        else if ((b & 0xF0) == ST7565_PAGE) {
+            lcd.page = b & 0x0F;
+        }
+        else if ((b & 0xF0) == ST7565_COLUMN_MSB) {
+            lcd.column = (lcd.column & 0x0F) | ((b & 0x0F) << 4);
+        }
+        else if ((b & 0xF0) == ST7565_COLUMN_LSB) {
+            lcd.column = (lcd.column & 0xF0) | (b & 0x0F);
+        }
+        else if ((b & 0xC0) == ST7565_START_LINE) {
+            lcd.start_line = b & 0x3F;
+        }
+    }
+}
+
+GDisplay* st7565_mock_init(void) {
+    free(lcd_display.priv);
+    memset(&lcd_display, 0, sizeof(lcd_display));
+    memset(&lcd, 0, sizeof(lcd));
+    memset(&mock_bus, 0, sizeof(mock_bus));
+    gdisp_lld_init(&lcd_display);
+    return &lcd_display;
+}
+
+void st7565_mock_draw_pixel(GDisplay* g, int16_t x, int16_t y, bool on) {
+    g->p.x = x;
+    g->p.y = y;
+    g->p.color = on ? White : Black;
+    gdisp_lld_draw_pixel(g);
+}
+
+void st7565_mock_blit(GDisplay* g, int16_t x, int16_t y, int16_t cx, int16_t cy, const uint8_t* bitmap, int16_t bitmap_width) {
+    g->p.x = x;
+    g->p.y = y;
+    g->p.cx = cx;
+    g->p.cy = cy;
+    g->p.x1 = 0;
+    g->p.y1 = 0;
+    g->p.x2 = bitmap_width;
+    g->p.ptr = (void*)bitmap;
+    gdisp_lld_blit_area(g);
+}
+
+void st7565_mock_flush(GDisplay* g) {
+    gdisp_lld_flush(g);
+}
+
+bool st7565_mock_pixel(GDisplay* g, int16_t x, int16_t y) {
+    g->p.x = x;
+    g->p.y = y;
+    return gdisp_lld_get_pixel_color(g) != Black;
+}
+
+bool st7565_mock_shown(int16_t x, int16_t y) {
+    uint8_t line = (lcd.start_line + y) % (ST7565_MOCK_PAGES * 8);
+    return (lcd.ram[line / 8][x] >> (line % 8)) & 1;
+}
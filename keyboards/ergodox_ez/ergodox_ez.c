@@ -120,27 +120,7 @@ uint8_t init_mcp23018(void) {
         _delay_ms(1000);
     }
 
-    // set pin direction
-    // - unused  : input  : 1
-    // - input   : input  : 1
-    // - driving : output : 0
-    mcp23018_status = i2c_start(I2C_ADDR_WRITE);    if (mcp23018_status) goto out;
-    mcp23018_status = i2c_write(IODIRA);            if (mcp23018_status) goto out;
-    mcp23018_status = i2c_write(0b00000000);        if (mcp23018_status) goto out;
-    mcp23018_status = i2c_write(0b00111111);        if (mcp23018_status) goto out;
-    i2c_stop();
-
-    // set pull-up
-    // - unused  : on  : 1
-    // - input   : on  : 1
-    // - driving : off : 0
-    mcp23018_status = i2c_start(I2C_ADDR_WRITE);    if (mcp23018_status) goto out;
-    mcp23018_status = i2c_write(GPPUA);             if (mcp23018_status) goto out;
-    mcp23018_status = i2c_write(0b00000000);        if (mcp23018_status) goto out;
-    mcp23018_status = i2c_write(0b00111111);        if (mcp23018_status) goto out;
-
-out:
-    i2c_stop();
+    mcp23018_status = mcp23018_init();
 
 #ifdef LEFT_LEDS
     if (!mcp23018_status) mcp23018_status = ergodox_left_leds_update();
@@ -160,26 +140,11 @@ uint8_t ergodox_left_leds_update(void) {
 #define LEFT_LED_2_SHIFT        6       // in MCP23018 port B
 #define LEFT_LED_3_SHIFT        7       // in MCP23018 port A
 
-    // set logical value (doesn't matter on inputs)
-    // - unused  : hi-Z : 1
-    // - input   : hi-Z : 1
-    // - driving : hi-Z : 1
-    mcp23018_status = i2c_start(I2C_ADDR_WRITE);
-    if (mcp23018_status) goto out;
-    mcp23018_status = i2c_write(OLATA);
-    if (mcp23018_status) goto out;
-    mcp23018_status = i2c_write(0b11111111
-                                & ~(ergodox_left_led_3<<LEFT_LED_3_SHIFT)
-                                );
-    if (mcp23018_status) goto out;
-    mcp23018_status = i2c_write(0b11111111
-                                & ~(ergodox_left_led_2<<LEFT_LED_2_SHIFT)
-                                & ~(ergodox_left_led_1<<LEFT_LED_1_SHIFT)
-                                );
-    if (mcp23018_status) goto out;
-
- out:
-    i2c_stop();
+    // port A is written together with the row selects, and port B only
+    // when it changes, so this can be called on every scan
+    mcp23018_status = mcp23018_write_leds(
+        ergodox_left_led_3<<LEFT_LED_3_SHIFT,
+        (ergodox_left_led_2<<LEFT_LED_2_SHIFT) | (ergodox_left_led_1<<LEFT_LED_1_SHIFT));
     return mcp23018_status;
 }
 #endif
@@ -675,6 +675,4 @@ void matrix_init_user(void)
   rgblight_setrgb(0, 255, 255);
   ergodox_led_all_off();
   wait_ms(1000);
-
-  rgblight_effect_knight(50);
 }
\ No newline at end of file
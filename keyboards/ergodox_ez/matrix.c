@@ -33,36 +33,20 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #include "debug.h"
 #include "util.h"
 #include "matrix.h"
+#include "debounce.h"
 #include QMK_KEYBOARD_H
 #include "i2cmaster.h"
 #ifdef DEBUG_MATRIX_SCAN_RATE
 #include  "timer.h"
 #endif
 
-/*
- * This constant define not debouncing time in msecs, but amount of matrix
- * scan loops which should be made to get stable debounced results.
- *
- * On Ergodox matrix scan rate is relatively low, because of slow I2C.
- * Now it's only 317 scans/second, or about 3.15 msec/scan.
- * According to Cherry specs, debouncing time is 5 msec.
- *
- * However, some switches seem to have higher debouncing requirements, or
- * something else might be wrong. (Also, the scan speed has improved since
- * that comment was written.)
- */
-
-#ifndef DEBOUNCE
-#   define DEBOUNCE	5
-#endif
-
 /* matrix state(1:on, 0:off) */
 static matrix_row_t matrix[MATRIX_ROWS];
 
 // Debouncing: store for each key the number of scans until it's eligible to
 // change.  When scanning the matrix, ignore any changes in keys that have
 // already changed in the last DEBOUNCE scans.
-static uint8_t debounce_matrix[MATRIX_ROWS * MATRIX_COLS];
+static debounce_row_t debounce[MATRIX_ROWS];
 
 static matrix_row_t read_cols(uint8_t row);
 static void init_cols(void);
@@ -118,9 +102,7 @@ void matrix_init(void)
     // initialize matrix state: all keys off
     for (uint8_t i=0; i < MATRIX_ROWS; i++) {
         matrix[i] = 0;
-        for (uint8_t j=0; j < MATRIX_COLS; ++j) {
-            debounce_matrix[i * MATRIX_COLS + j] = 0;
-        }
+        debounce[i] = (debounce_row_t){ { 0 } };
     }
 
 #ifdef DEBUG_MATRIX_SCAN_RATE
@@ -149,30 +131,6 @@ void matrix_power_up(void) {
 #endif
 }
 
-// Returns a matrix_row_t whose bits are set if the corresponding key should be
-// eligible to change in this scan.
-matrix_row_t debounce_mask(uint8_t row) {
-  matrix_row_t result = 0;
-  for (uint8_t j=0; j < MATRIX_COLS; ++j) {
-    if (debounce_matrix[row * MATRIX_COLS + j]) {
-      --debounce_matrix[row * MATRIX_COLS + j];
-    } else {
-      result |= (1 << j);
-    }
-  }
-  return result;
-}
-
-// Report changed keys in the given row.  Resets the debounce countdowns
-// corresponding to each set bit in 'change' to DEBOUNCE.
-void debounce_report(matrix_row_t change, uint8_t row) {
-  for (uint8_t i = 0; i < MATRIX_COLS; ++i) {
-    if (change & (1 << i)) {
-      debounce_matrix[row * MATRIX_COLS + i] = DEBOUNCE;
-    }
-  }
-}
-
 uint8_t matrix_scan(void)
 {
     if (mcp23018_status) { // if there was an error
@@ -208,21 +166,27 @@ uint8_t matrix_scan(void)
     mcp23018_status = ergodox_left_leds_update();
 #endif // LEFT_LEDS
     for (uint8_t i = 0; i < MATRIX_ROWS_PER_SIDE; i++) {
-        select_row(i);
-        // and select on left hand
+        // select on the right hand first, so that it settles while the row
+        // select is written to the left hand
         select_row(i + MATRIX_ROWS_PER_SIDE);
-        // we don't need a 30us delay anymore, because selecting a
-        // left-hand row requires more than 30us for i2c.
-        matrix_row_t mask = debounce_mask(i);
-        matrix_row_t cols = (read_cols(i) & mask) | (matrix[i] & ~mask);
-        debounce_report(cols ^ matrix[i], i);
-        matrix[i] = cols;
-        // grab cols from right hand
-        mask = debounce_mask(i + MATRIX_ROWS_PER_SIDE);
-        cols = (read_cols(i + MATRIX_ROWS_PER_SIDE) & mask) | (matrix[i + MATRIX_ROWS_PER_SIDE] & ~mask);
-        debounce_report(cols ^ matrix[i + MATRIX_ROWS_PER_SIDE], i + MATRIX_ROWS_PER_SIDE);
-        matrix[i + MATRIX_ROWS_PER_SIDE] = cols;
+        // this starts the transaction of the left hand row, and holds the
+        // bus until its columns are read
+        if (!mcp23018_status) {
+            mcp23018_status = mcp23018_select_row(i);
+        } else {
+            // without the left hand transaction, the right hand row needs
+            // to settle on its own
+            wait_us(30);
+        }
+        // grab cols from the right hand while the left hand row settles,
+        // the repeated start and the address of the read give it another
+        // ~25us on top of this
+        matrix_row_t cols = read_cols(i + MATRIX_ROWS_PER_SIDE);
         unselect_rows();
+        matrix[i + MATRIX_ROWS_PER_SIDE] = debounce_row(&debounce[i + MATRIX_ROWS_PER_SIDE],
+                                                     matrix[i + MATRIX_ROWS_PER_SIDE], cols);
+        // and complete the transaction on the left hand
+        matrix[i] = debounce_row(&debounce[i], matrix[i], read_cols(i));
     }
 
     matrix_scan_quantum();
@@ -290,19 +254,12 @@ static void  init_cols(void)
 static matrix_row_t read_cols(uint8_t row)
 {
     if (row < 7) {
-        if (mcp23018_status) { // if there was an error
-            return 0;
-        } else {
-            uint8_t data = 0;
-            mcp23018_status = i2c_start(I2C_ADDR_WRITE);    if (mcp23018_status) goto out;
-            mcp23018_status = i2c_write(GPIOB);             if (mcp23018_status) goto out;
-            mcp23018_status = i2c_start(I2C_ADDR_READ);     if (mcp23018_status) goto out;
-            data = i2c_readNak();
-            data = ~data;
-        out:
-            i2c_stop();
-            return data;
+        // the row was selected by mcp23018_select_row
+        uint8_t data = 0;
+        if (!mcp23018_status) {
+            mcp23018_status = mcp23018_read_cols(&data);
         }
+        return data;
     } else {
         /* read from teensy
 	 * bitmask is 0b11110011, but we want those all
@@ -342,20 +299,8 @@ static void unselect_rows(void)
 
 static void select_row(uint8_t row)
 {
-    if (row < 7) {
-        // select on mcp23018
-        if (mcp23018_status) { // if there was an error
-            // do nothing
-        } else {
-            // set active row low  : 0
-            // set other rows hi-Z : 1
-            mcp23018_status = i2c_start(I2C_ADDR_WRITE);        if (mcp23018_status) goto out;
-            mcp23018_status = i2c_write(GPIOA);                 if (mcp23018_status) goto out;
-            mcp23018_status = i2c_write(0xFF & ~(1<<row));      if (mcp23018_status) goto out;
-        out:
-            i2c_stop();
-        }
-    } else {
+    // the rows of the mcp23018 are selected with mcp23018_select_row
+    if (row >= 7) {
         // select on teensy
         // Output low(DDR:1, PORT:0) to select
         switch (row) {
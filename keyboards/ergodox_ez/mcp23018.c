@@ -0,0 +1,95 @@
+/* Copyright 2026 QMK Firmware contributors
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "mcp23018.h"
+
+#define MCP23018_ROW_PINS 0b01111111
+#define MCP23018_COL_PINS 0b00111111
+
+// The LED pins of port A, that are merged into the row selects
+static uint8_t leds_a;
+// The last value written to OLATB, and whether it's known at all
+static uint8_t olatb;
+static bool olatb_valid;
+
+static uint8_t write_registers(uint8_t reg, uint8_t a, uint8_t b) {
+    uint8_t status;
+    status = i2c_start(I2C_ADDR_WRITE);     if (status) goto out;
+    status = i2c_write(reg);                if (status) goto out;
+    status = i2c_write(a);                  if (status) goto out;
+    status = i2c_write(b);                  if (status) goto out;
+out:
+    i2c_stop();
+    return status;
+}
+
+uint8_t mcp23018_init(void) {
+    olatb_valid = false;
+
+    // set pin direction
+    // - unused  : input  : 1
+    // - input   : input  : 1
+    // - driving : output : 0
+    uint8_t status = write_registers(IODIRA, 0b00000000, 0b00111111);
+    if (status) return status;
+
+    // set pull-up
+    // - unused  : on  : 1
+    // - input   : on  : 1
+    // - driving : off : 0
+    return write_registers(GPPUA, 0b00000000, 0b00111111);
+}
+
+uint8_t mcp23018_select_row(uint8_t row) {
+    // set active row low  : 0
+    // set other rows hi-Z : 1
+    uint8_t status;
+    status = i2c_start(I2C_ADDR_WRITE);                     if (status) goto out;
+    status = i2c_write(GPIOA);                              if (status) goto out;
+    status = i2c_write(0xFF & ~(1 << row) & ~leds_a);       if (status) goto out;
+    // keep the bus, the address pointer now points to GPIOB
+    return 0;
+out:
+    i2c_stop();
+    return status;
+}
+
+uint8_t mcp23018_read_cols(uint8_t* cols) {
+    uint8_t status = i2c_rep_start(I2C_ADDR_READ);
+    if (!status) {
+        *cols = ~i2c_readNak() & MCP23018_COL_PINS;
+    }
+    i2c_stop();
+    return status;
+}
+
+uint8_t mcp23018_write_leds(uint8_t port_a, uint8_t port_b) {
+    leds_a = port_a & ~MCP23018_ROW_PINS;
+    uint8_t value = 0xFF & ~(port_b & ~MCP23018_COL_PINS);
+    if (olatb_valid && value == olatb) {
+        return 0;
+    }
+
+    uint8_t status;
+    status = i2c_start(I2C_ADDR_WRITE);     if (status) goto out;
+    status = i2c_write(OLATB);              if (status) goto out;
+    status = i2c_write(value);              if (status) goto out;
+    olatb = value;
+    olatb_valid = true;
+out:
+    i2c_stop();
+    return status;
+}
@@ -0,0 +1,73 @@
+/* Copyright 2026 QMK Firmware contributors
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef MCP23018_H
+#define MCP23018_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "i2cmaster.h"
+
+// I2C aliases and register addresses (see "mcp23018.md")
+#define I2C_ADDR        0b0100000
+#define I2C_ADDR_WRITE  ( (I2C_ADDR<<1) | I2C_WRITE )
+#define I2C_ADDR_READ   ( (I2C_ADDR<<1) | I2C_READ  )
+#define IODIRA          0x00            // i/o direction register
+#define IODIRB          0x01
+#define GPPUA           0x0C            // GPIO pull-up resistor register
+#define GPPUB           0x0D
+#define GPIOA           0x12            // general purpose i/o port register (write modifies OLAT)
+#define GPIOB           0x13
+#define OLATA           0x14            // output latch register
+#define OLATB           0x15
+
+/* The left hand of the ErgoDox EZ
+ *
+ * The rows are driven from A0-A6 and the columns are read from B0-B5, the
+ * remaining pins, A7, B6 and B7, drive the left hand LEDs.
+ *
+ * A row is scanned with a single sequential transaction, which writes the
+ * row select to GPIOA, and then reads the columns from GPIOB, where the
+ * address pointer has moved on to. The transaction is split in two, so that
+ * the caller can do other work, like reading the right hand, while the row
+ * settles:
+ *
+ *     status = mcp23018_select_row(row);
+ *     // the bus is held until the columns are read
+ *     if (!status) status = mcp23018_read_cols(&cols);
+ *
+ * All the functions return 0 on success, and a non-zero status if the left
+ * hand didn't respond, in which case the bus has already been released.
+ */
+
+// Sets the pin directions and pull-ups, and forgets the LED state, so that
+// the next mcp23018_write_leds writes it again
+uint8_t mcp23018_init(void);
+
+// Starts the transaction of a row scan, the row is driven low and the other
+// rows are left high
+uint8_t mcp23018_select_row(uint8_t row);
+
+// Completes the transaction started by mcp23018_select_row, the columns are
+// returned as set bits when the key is pressed
+uint8_t mcp23018_read_cols(uint8_t* cols);
+
+// Sets the LEDs, the bits are set for the pins that should be driven low.
+// The port A LEDs are written together with the next row select, while port
+// B is only written when it changes
+uint8_t mcp23018_write_leds(uint8_t port_a, uint8_t port_b);
+
+#endif
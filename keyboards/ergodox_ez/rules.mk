@@ -16,6 +16,7 @@
 
 # # project specific files
 SRC = twimaster.c \
+	  mcp23018.c \
 	  matrix.c
 
 # MCU name
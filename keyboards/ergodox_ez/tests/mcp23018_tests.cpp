@@ -0,0 +1,252 @@
+/* Copyright 2026 QMK Firmware contributors
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "gtest/gtest.h"
+#include <cstring>
+extern "C" {
+#include "mcp23018.h"
+}
+
+namespace {
+
+const int Rows = 7;
+const int Cols = 6;
+
+// A model of the MCP23018 of the left hand, in the default sequential mode,
+// that is driven through the I2C functions below
+struct {
+    bool connected;
+    bool open;
+    bool reading;
+    bool addressed;
+    uint8_t pointer;
+    uint8_t regs[OLATB + 1];
+    bool keys[Rows][Cols];
+    // Bus traffic
+    int transactions;
+    int starts;
+    int bytes;
+} mcp;
+
+// The pins read from a port, the outputs read their latch, and an input
+// is pulled low through a pressed key to a row that is driven low
+uint8_t read_port_b() {
+    uint8_t value = mcp.regs[OLATB] & ~mcp.regs[IODIRB];
+    for (int col = 0; col < 8; col++) {
+        if (!(mcp.regs[IODIRB] & (1 << col))) {
+            continue;
+        }
+        bool low = false;
+        for (int row = 0; row < Rows; row++) {
+            bool driven_low = !(mcp.regs[IODIRA] & (1 << row)) && !(mcp.regs[OLATA] & (1 << row));
+            low |= col < Cols && driven_low && mcp.keys[row][col];
+        }
+        if (!low && (mcp.regs[GPPUB] & (1 << col))) {
+            value |= 1 << col;
+        }
+    }
+    return value;
+}
+
+uint8_t start(uint8_t address) {
+    mcp.starts++;
+    if (!mcp.open) {
+        mcp.transactions++;
+    }
+    mcp.open = true;
+    mcp.bytes++;
+    if (!mcp.connected || (address >> 1) != I2C_ADDR) {
+        return 1;
+    }
+    mcp.reading = address & I2C_READ;
+    mcp.addressed = false;
+    return 0;
+}
+
+}
+
+extern "C" {
+
+unsigned char i2c_start(unsigned char address) {
+    EXPECT_FALSE(mcp.open) << "Use i2c_rep_start to restart a transaction";
+    return start(address);
+}
+
+unsigned char i2c_rep_start(unsigned char address) {
+    EXPECT_TRUE(mcp.open);
+    return start(address);
+}
+
+void i2c_stop(void) {
+    mcp.open = false;
+}
+
+unsigned char i2c_write(unsigned char data) {
+    EXPECT_TRUE(mcp.open);
+    EXPECT_FALSE(mcp.reading);
+    mcp.bytes++;
+    if (!mcp.connected) {
+        return 1;
+    }
+    if (!mcp.addressed) {
+        mcp.pointer = data;
+        mcp.addressed = true;
+        return 0;
+    }
+    uint8_t reg = mcp.pointer;
+    // Writing to the port writes the latch
+    if (reg == GPIOA || reg == GPIOB) {
+        reg += OLATA - GPIOA;
+    }
+    mcp.regs[reg] = data;
+    mcp.pointer++;
+    return 0;
+}
+
+unsigned char i2c_readNak(void) {
+    EXPECT_TRUE(mcp.open);
+    EXPECT_TRUE(mcp.reading);
+    mcp.bytes++;
+    uint8_t reg = mcp.pointer++;
+    return reg == GPIOB ? read_port_b() : mcp.regs[reg];
+}
+
+}
+
+class Mcp23018 : public testing::Test {
+public:
+    Mcp23018() {
+        memset(&mcp, 0, sizeof(mcp));
+        // The power on state
+        mcp.connected = true;
+        mcp.regs[IODIRA] = 0xFF;
+        mcp.regs[IODIRB] = 0xFF;
+        EXPECT_EQ(mcp23018_init(), 0);
+        EXPECT_EQ(mcp23018_write_leds(0, 0), 0);
+        reset_traffic();
+    }
+
+    void reset_traffic() {
+        mcp.transactions = 0;
+        mcp.starts = 0;
+        mcp.bytes = 0;
+    }
+
+    uint8_t scan_row(uint8_t row) {
+        uint8_t cols = 0xAA;
+        EXPECT_EQ(mcp23018_select_row(row), 0);
+        EXPECT_EQ(mcp23018_read_cols(&cols), 0);
+        EXPECT_FALSE(mcp.open);
+        return cols;
+    }
+};
+
+TEST_F(Mcp23018, InitSetsUpThePins) {
+    EXPECT_EQ(mcp.regs[IODIRA], 0b00000000);
+    EXPECT_EQ(mcp.regs[IODIRB], 0b00111111);
+    EXPECT_EQ(mcp.regs[GPPUA], 0b00000000);
+    EXPECT_EQ(mcp.regs[GPPUB], 0b00111111);
+}
+
+TEST_F(Mcp23018, ScanReadsThePressedKeys) {
+    mcp.keys[0][0] = true;
+    mcp.keys[2][3] = true;
+    mcp.keys[2][5] = true;
+    mcp.keys[6][1] = true;
+    EXPECT_EQ(scan_row(0), 0b000001);
+    EXPECT_EQ(scan_row(1), 0);
+    EXPECT_EQ(scan_row(2), 0b101000);
+    EXPECT_EQ(scan_row(3), 0);
+    EXPECT_EQ(scan_row(6), 0b000010);
+}
+
+TEST_F(Mcp23018, OnlyTheSelectedRowIsDriven) {
+    EXPECT_EQ(mcp23018_select_row(4), 0);
+    EXPECT_EQ(mcp.regs[OLATA], 0xFF & ~(1 << 4));
+    // The bus is held while the row settles
+    EXPECT_TRUE(mcp.open);
+    uint8_t cols;
+    EXPECT_EQ(mcp23018_read_cols(&cols), 0);
+    EXPECT_FALSE(mcp.open);
+}
+
+TEST_F(Mcp23018, EachRowIsScannedWithOneTransaction) {
+    for (uint8_t row = 0; row < Rows; row++) {
+        scan_row(row);
+    }
+    EXPECT_EQ(mcp.transactions, Rows);
+    // The address, register and row select, and then the address and
+    // the columns after a repeated start
+    EXPECT_EQ(mcp.starts, Rows * 2);
+    EXPECT_EQ(mcp.bytes, Rows * 5);
+}
+
+TEST_F(Mcp23018, ADisconnectedLeftHandReleasesTheBus) {
+    mcp.connected = false;
+    EXPECT_NE(mcp23018_select_row(0), 0);
+    EXPECT_FALSE(mcp.open);
+    EXPECT_NE(mcp23018_write_leds(0, 0b11000000), 0);
+    EXPECT_FALSE(mcp.open);
+    EXPECT_NE(mcp23018_init(), 0);
+    EXPECT_FALSE(mcp.open);
+}
+
+TEST_F(Mcp23018, ALeftHandThatDisconnectsDuringTheScanReleasesTheBus) {
+    EXPECT_EQ(mcp23018_select_row(0), 0);
+    mcp.connected = false;
+    uint8_t cols;
+    EXPECT_NE(mcp23018_read_cols(&cols), 0);
+    EXPECT_FALSE(mcp.open);
+}
+
+TEST_F(Mcp23018, LedsAreOnlyWrittenWhenTheyChange) {
+    EXPECT_EQ(mcp23018_write_leds(0, 0b10000000), 0);
+    EXPECT_EQ(mcp.transactions, 1);
+    EXPECT_EQ(mcp.regs[OLATB], 0b01111111);
+    EXPECT_EQ(mcp23018_write_leds(0, 0b10000000), 0);
+    EXPECT_EQ(mcp.transactions, 1);
+    EXPECT_EQ(mcp23018_write_leds(0, 0b11000000), 0);
+    EXPECT_EQ(mcp.transactions, 2);
+    EXPECT_EQ(mcp.regs[OLATB], 0b00111111);
+}
+
+TEST_F(Mcp23018, LedsAreWrittenAgainAfterAReset) {
+    EXPECT_EQ(mcp23018_write_leds(0, 0b10000000), 0);
+    // The left hand is reconnected, and has lost its state
+    mcp.regs[OLATB] = 0;
+    EXPECT_EQ(mcp23018_init(), 0);
+    reset_traffic();
+    EXPECT_EQ(mcp23018_write_leds(0, 0b10000000), 0);
+    EXPECT_EQ(mcp.transactions, 1);
+    EXPECT_EQ(mcp.regs[OLATB], 0b01111111);
+}
+
+TEST_F(Mcp23018, PortALedsAreWrittenWithTheRowSelect) {
+    EXPECT_EQ(mcp23018_write_leds(0b10000000, 0), 0);
+    EXPECT_EQ(mcp.transactions, 0);
+    scan_row(2);
+    EXPECT_EQ(mcp.regs[OLATA], 0b01111011);
+    EXPECT_EQ(mcp23018_write_leds(0, 0), 0);
+    scan_row(2);
+    EXPECT_EQ(mcp.regs[OLATA], 0b11111011);
+}
+
+TEST_F(Mcp23018, LedsDontShowUpAsKeys) {
+    EXPECT_EQ(mcp23018_write_leds(0b10000000, 0b11000000), 0);
+    for (uint8_t row = 0; row < Rows; row++) {
+        EXPECT_EQ(scan_row(row), 0);
+    }
+}
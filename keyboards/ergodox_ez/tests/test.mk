@@ -0,0 +1,21 @@
+# Copyright 2026 QMK Firmware contributors
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 2 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+# Not named rules.mk, which would make the tests a subproject of the keyboard
+
+mcp23018_INC := $(TOP_DIR)/keyboards/ergodox_ez
+mcp23018_SRC := \
+	$(TOP_DIR)/keyboards/ergodox_ez/tests/mcp23018_tests.cpp \
+	$(TOP_DIR)/keyboards/ergodox_ez/mcp23018.c
@@ -107,14 +107,6 @@ void matrix_scan_user(void) {
     #endif
 }
 
-void matrix_update(struct CharacterMatrix *dest,
-                          const struct CharacterMatrix *source) {
-  if (memcmp(dest->display, source->display, sizeof(dest->display))) {
-    memcpy(dest->display, source->display, sizeof(dest->display));
-    dest->dirty = true;
-  }
-}
-
 void iota_gfx_task_user(void) {
 #if DEBUG_TO_SCREEN
   if (debug_enable) {
@@ -0,0 +1,9 @@
+#ifndef KEYMAP_CONFIG_H
+#define KEYMAP_CONFIG_H
+
+#include QMK_KEYBOARD_CONFIG_H
+
+// Start the unicode input with NEO_U instead of KC_U
+#define UNICODE_KEY_LNX KC_A
+
+#endif
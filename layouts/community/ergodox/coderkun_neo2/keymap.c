@@ -281,16 +281,6 @@ void matrix_scan_user(void)
 };
 
 
-// Override Unicode start method to use NEO_U instead of KC_U
-void unicode_input_start (void) {
-    register_code(KC_LCTL);
-    register_code(KC_LSFT);
-    register_code(NEO_U);
-    unregister_code(NEO_U);
-    unregister_code(KC_LSFT);
-    unregister_code(KC_LCTL);
-};
-
 // Override method to use NEO_A instead of KC_A
 uint16_t hex_to_keycode(uint8_t hex)
 {
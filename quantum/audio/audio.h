@@ -25,6 +25,7 @@
 #include "musical_notes.h"
 #include "song_list.h"
 #include "voices.h"
+#include "synth.h"
 #include "quantum.h"
 #include <math.h>
 
@@ -49,37 +50,7 @@ void audio_toggle(void);
 void audio_on(void);
 void audio_off(void);
 
-// Vibrato rate functions
-
-#ifdef VIBRATO_ENABLE
-
-void set_vibrato_rate(float rate);
-void increase_vibrato_rate(float change);
-void decrease_vibrato_rate(float change);
-
-#ifdef VIBRATO_STRENGTH_ENABLE
-
-void set_vibrato_strength(float strength);
-void increase_vibrato_strength(float change);
-void decrease_vibrato_strength(float change);
-
-#endif
-
-#endif
-
-// Polyphony functions
-
-void set_polyphony_rate(float rate);
-void enable_polyphony(void);
-void disable_polyphony(void);
-void increase_polyphony_rate(float change);
-void decrease_polyphony_rate(float change);
-
-void set_timbre(float timbre);
-void set_tempo(uint8_t tempo);
-
-void increase_tempo(uint8_t tempo_change);
-void decrease_tempo(uint8_t tempo_change);
+// The vibrato, polyphony, timbre and tempo functions are in synth.h
 
 void audio_init(void);
 
@@ -90,6 +61,8 @@ void play_note(float freq, int vol);
 void stop_note(float freq);
 void stop_all_notes(void);
 void play_notes(float (*np)[][2], uint16_t n_count, bool n_repeat);
+// Plays a packed song from PROGMEM, see musical_notes.h
+void play_song(const song_note_t* song, uint16_t n_count, bool n_repeat);
 
 #define SCALE (int8_t []){ 0 + (12*0), 2 + (12*0), 4 + (12*0), 5 + (12*0), 7 + (12*0), 9 + (12*0), 11 + (12*0), \
                            0 + (12*1), 2 + (12*1), 4 + (12*1), 5 + (12*1), 7 + (12*1), 9 + (12*1), 11 + (12*1), \
@@ -103,8 +76,13 @@ void play_notes(float (*np)[][2], uint16_t n_count, bool n_repeat);
 #define NOTE_ARRAY_SIZE(x) ((int16_t)(sizeof(x) / (sizeof(x[0]))))
 #define PLAY_NOTE_ARRAY(note_array, note_repeat, deprecated_arg) play_notes(&note_array, NOTE_ARRAY_SIZE((note_array)), (note_repeat)); \
 	_Pragma ("message \"'PLAY_NOTE_ARRAY' macro is deprecated\"")
+#ifdef PACKED_SONGS
+#define PLAY_SONG(note_array) play_song(note_array, NOTE_ARRAY_SIZE((note_array)), false)
+#define PLAY_LOOP(note_array) play_song(note_array, NOTE_ARRAY_SIZE((note_array)), true)
+#else
 #define PLAY_SONG(note_array) play_notes(&note_array, NOTE_ARRAY_SIZE((note_array)), false)
 #define PLAY_LOOP(note_array) play_notes(&note_array, NOTE_ARRAY_SIZE((note_array)), true)
+#endif
 
 bool is_playing_notes(void);
 
@@ -16,28 +16,47 @@
 
 #include "luts.h"
 
-const float vibrato_lut[VIBRATO_LUT_LENGTH] =
+// The deviation of the vibrato from the base frequency, (multiplier - 1) * 2^16
+const int16_t vibrato_lut_q16[VIBRATO_LUT_LENGTH] PROGMEM =
 {
-	1.0022336811487,
-	1.0042529943610,
-	1.0058584256028,
-	1.0068905285205,
-	1.0072464122237,
-	1.0068905285205,
-	1.0058584256028,
-	1.0042529943610,
-	1.0022336811487,
-	1.0000000000000,
-	0.9977712970630,
-	0.9957650169978,
-	0.9941756956510,
-	0.9931566259436,
-	0.9928057204913,
-	0.9931566259436,
-	0.9941756956510,
-	0.9957650169978,
-	0.9977712970630,
-	1.0000000000000,
+	146,
+	279,
+	384,
+	452,
+	475,
+	452,
+	384,
+	279,
+	146,
+	0,
+	-146,
+	-278,
+	-382,
+	-448,
+	-471,
+	-448,
+	-382,
+	-278,
+	-146,
+	0,
+};
+
+// The frequencies of the top octave of packed songs, C8 to B8, in 24.8 fixed
+// point, the lower octaves are shifted down from these
+const uint32_t note_frequency_lut[NOTE_FREQUENCY_LUT_LENGTH] PROGMEM =
+{
+	1071618,
+	1135340,
+	1202851,
+	1274376,
+	1350154,
+	1430439,
+	1515497,
+	1605613,
+	1701088,
+	1802240,
+	1909407,
+	2022946,
 };
 
 const uint16_t frequency_lut[FREQUENCY_LUT_LENGTH] =
@@ -14,23 +14,20 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
-#if defined(__AVR__)
-    #include <avr/io.h>
-    #include <avr/interrupt.h>
-    #include <avr/pgmspace.h>
-#else
-    #include "ch.h"
-    #include "hal.h"
-#endif
+#include <stdint.h>
+#include "progmem.h"
 
 #ifndef LUTS_H
 #define LUTS_H
 
 #define VIBRATO_LUT_LENGTH 20
 
+#define NOTE_FREQUENCY_LUT_LENGTH 12
+
 #define FREQUENCY_LUT_LENGTH 349
 
-extern const float vibrato_lut[VIBRATO_LUT_LENGTH];
+extern const int16_t vibrato_lut_q16[VIBRATO_LUT_LENGTH];
+extern const uint32_t note_frequency_lut[NOTE_FREQUENCY_LUT_LENGTH];
 extern const uint16_t frequency_lut[FREQUENCY_LUT_LENGTH];
 
 #endif /* LUTS_H */
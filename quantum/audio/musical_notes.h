@@ -17,15 +17,80 @@
 #ifndef MUSICAL_NOTES_H
 #define MUSICAL_NOTES_H
 
+#include <stdint.h>
+
 // Tempo Placeholder
 #define TEMPO_DEFAULT 100
 
 
 #define SONG(notes...) { notes }
 
+/* Packed songs
+ *
+ * By default a song is an array of float pairs, the frequency and the
+ * duration of each note, which takes 8 bytes of RAM per note. A file that
+ * defines PACKED_SONGS before including this header gets the same SONG()
+ * definitions packed into a song_note_t per note instead, which should be
+ * declared const and PROGMEM:
+ *
+ *   const song_note_t my_song[] PROGMEM = SONG(QWERTY_SOUND);
+ *   PLAY_SONG(my_song);
+ *
+ * The top 7 bits are the MIDI note number, 0 is a rest, and the bottom 9
+ * bits are the duration. The frequencies are rounded to the closest
+ * semitone at compile time, and notes above B8 are played as B8.
+ */
+typedef uint16_t song_note_t;
+
+#define SONG_PITCH_BITS 7
+#define SONG_DURATION_BITS 9
+#define SONG_DURATION_MAX ((1 << SONG_DURATION_BITS) - 1)
+// The MIDI note number of B8
+#define SONG_PITCH_MAX 119
+
+#define SONG_NOTE_PITCH(n) ((uint8_t)((n) >> SONG_DURATION_BITS))
+#define SONG_NOTE_DURATION(n) ((n) & SONG_DURATION_MAX)
+
+// C-1, the frequency of MIDI note 0, and half a semitone as a ratio
+#define SONG_PITCH_BASE 8.1757989f
+#define SONG_HALF_SEMITONE 0.9715319f
+
+// The octave of freq, counted from C-1, up to 9
+#define SONG_OCTAVE(freq) ( \
+    ((freq) >= SONG_PITCH_BASE * SONG_HALF_SEMITONE * 2) + \
+    ((freq) >= SONG_PITCH_BASE * SONG_HALF_SEMITONE * 4) + \
+    ((freq) >= SONG_PITCH_BASE * SONG_HALF_SEMITONE * 8) + \
+    ((freq) >= SONG_PITCH_BASE * SONG_HALF_SEMITONE * 16) + \
+    ((freq) >= SONG_PITCH_BASE * SONG_HALF_SEMITONE * 32) + \
+    ((freq) >= SONG_PITCH_BASE * SONG_HALF_SEMITONE * 64) + \
+    ((freq) >= SONG_PITCH_BASE * SONG_HALF_SEMITONE * 128) + \
+    ((freq) >= SONG_PITCH_BASE * SONG_HALF_SEMITONE * 256) + \
+    ((freq) >= SONG_PITCH_BASE * SONG_HALF_SEMITONE * 512))
+
+// The semitone of ratio, the frequency divided by the C of its octave
+#define SONG_SEMITONE(ratio) ( \
+    ((ratio) >= 1.0293022f) + ((ratio) >= 1.0905077f) + ((ratio) >= 1.1553527f) + \
+    ((ratio) >= 1.2240535f) + ((ratio) >= 1.2968396f) + ((ratio) >= 1.3739536f) + \
+    ((ratio) >= 1.4556532f) + ((ratio) >= 1.5422108f) + ((ratio) >= 1.6339155f) + \
+    ((ratio) >= 1.7310731f) + ((ratio) >= 1.8340081f))
+
+// The closest MIDI note number to freq, frequencies below C-1 are rests
+#define SONG_PITCH(freq) (SONG_OCTAVE(freq) * 12 + \
+    SONG_SEMITONE((freq) / (SONG_PITCH_BASE * (1 << SONG_OCTAVE(freq)))))
+
+#define SONG_PACK_NOTE(freq, duration) ((song_note_t)( \
+    (SONG_PITCH(freq) << SONG_DURATION_BITS) | \
+    ((duration) > SONG_DURATION_MAX ? SONG_DURATION_MAX : (duration))))
+
+#ifdef PACKED_SONGS
+    #define SONG_NOTE(freq, duration) SONG_PACK_NOTE(freq, duration)
+#else
+    #define SONG_NOTE(freq, duration) {(freq), duration}
+#endif
+
 
 // Note Types
-#define MUSICAL_NOTE(note, duration)   {(NOTE##note), duration}
+#define MUSICAL_NOTE(note, duration)   SONG_NOTE((NOTE##note), duration)
 #define WHOLE_NOTE(note)               MUSICAL_NOTE(note, 64)
 #define HALF_NOTE(note)                MUSICAL_NOTE(note, 32)
 #define QUARTER_NOTE(note)             MUSICAL_NOTE(note, 16)
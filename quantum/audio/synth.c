@@ -0,0 +1,449 @@
+/* Copyright 2026 QMK Firmware contributors
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "synth.h"
+#include "voices.h"
+#include "luts.h"
+#include "progmem.h"
+#include "musical_notes.h"
+
+/* The glissando constant 440 / 24 * ln(2), as 24.8 fixed point, and half of
+ * its square, as 16.16 fixed point
+ *
+ * f * 2^(440 / f / 24) = f * e^(C / f), which is approximated by the first
+ * terms of the series f + C + C^2 / 2f. This is within 1% of the exact
+ * value at 30Hz, and within 0.05Hz above 100Hz.
+ */
+#define GLIDE_C 3253
+#define GLIDE_C2 5291004UL
+
+// Duration units of a song note, in microseconds at a tempo of 1.
+// A quarter note, 16 units, is 131ms at the default tempo of 100.
+#define NOTE_UNIT_US_NUM 2048UL
+#define NOTE_UNIT_US_DEN 25UL
+
+// The number of polyphony switches per second is multiplied by this
+#define POLYPHONY_DIVIDER 8
+
+uint8_t note_tempo = TEMPO_DEFAULT;
+synth_timbre_t note_timbre = SYNTH_TIMBRE(TIMBRE_DEFAULT);
+uint8_t polyphony_rate = 0;
+bool glissando = true;
+uint16_t envelope_index = 0;
+
+#ifdef VIBRATO_ENABLE
+uint16_t vibrato_rate = 32;
+uint16_t vibrato_strength = 128;
+static uint16_t vibrato_counter = 0;
+#endif
+
+static uint8_t voices = 0;
+static uint8_t voice_place = 0;
+static synth_freq_t frequencies[SYNTH_MAX_VOICES];
+static synth_freq_t frequency = 0;
+static synth_freq_t frequency_alt = 0;
+static uint32_t polyphony_position_us = 0;
+
+static bool playing_notes = false;
+static bool playing_note = false;
+
+// Packed notes, in PROGMEM or in float_song
+static const song_note_t* notes_pointer;
+static bool notes_progmem;
+static uint16_t notes_count;
+static bool notes_repeat;
+static uint16_t current_note;
+static bool note_resting;
+static synth_freq_t note_frequency;
+// The frequency of the note after the current one, looked up for the gap
+static synth_freq_t next_frequency;
+static uint32_t note_length_us;
+static uint32_t note_position_us;
+
+// The packed copy of the float song that is playing
+static song_note_t float_song[SYNTH_FLOAT_SONG_MAX];
+
+synth_freq_t synth_glide(synth_freq_t current, synth_freq_t target) {
+    if (current == 0 || target == 0) {
+        return target;
+    }
+    if (current + GLIDE_C < target + GLIDE_C2 / target) {
+        return current + GLIDE_C + GLIDE_C2 / current;
+    }
+    if (current > target + GLIDE_C + GLIDE_C2 / target) {
+        return current - GLIDE_C + GLIDE_C2 / current;
+    }
+    return target;
+}
+
+synth_freq_t synth_vibrato_apply(synth_freq_t freq, uint8_t index, uint16_t strength) {
+    int32_t deviation = ((int32_t)(int16_t)pgm_read_word(&vibrato_lut_q16[index]) * strength) >> 8;
+    // Split the multiplication so that it fits 32 bits for all audible frequencies
+    return freq + (((int32_t)(freq >> 4) * deviation) >> 12);
+}
+
+#ifdef VIBRATO_ENABLE
+static synth_freq_t vibrato(synth_freq_t average_freq) {
+    #ifdef VIBRATO_STRENGTH_ENABLE
+        synth_freq_t vibrated_freq = synth_vibrato_apply(average_freq, vibrato_counter >> 8, vibrato_strength);
+    #else
+        synth_freq_t vibrated_freq = synth_vibrato_apply(average_freq, vibrato_counter >> 8, 256);
+    #endif
+    // Lower notes move faster through the table
+    uint32_t step = vibrato_rate + (uint32_t)vibrato_rate * SYNTH_FREQ(440) / average_freq;
+    vibrato_counter = (vibrato_counter + step) % (VIBRATO_LUT_LENGTH << 8);
+    return vibrated_freq;
+}
+
+static synth_freq_t apply_vibrato(synth_freq_t freq) {
+    if (vibrato_strength > 0 && freq > 0) {
+        return vibrato(freq);
+    }
+    return freq;
+}
+#else
+#define apply_vibrato(freq) (freq)
+#endif
+
+static synth_freq_t envelope(synth_freq_t freq) {
+    if (envelope_index < 0xFFFF) {
+        envelope_index++;
+    }
+    freq = voice_envelope(freq);
+    if (freq < SYNTH_FREQ_MIN) {
+        freq = SYNTH_FREQ_MIN;
+    }
+    return freq;
+}
+
+void synth_reset(void) {
+    synth_stop_all();
+    note_tempo = TEMPO_DEFAULT;
+    note_timbre = SYNTH_TIMBRE(TIMBRE_DEFAULT);
+    polyphony_rate = 0;
+    glissando = true;
+    envelope_index = 0;
+#ifdef VIBRATO_ENABLE
+    vibrato_rate = 32;
+    vibrato_strength = 128;
+    vibrato_counter = 0;
+#endif
+}
+
+void synth_stop_all(void) {
+    voices = 0;
+    voice_place = 0;
+    frequency = 0;
+    frequency_alt = 0;
+    playing_notes = false;
+    playing_note = false;
+    for (uint8_t i = 0; i < SYNTH_MAX_VOICES; i++) {
+        frequencies[i] = 0;
+    }
+}
+
+void synth_note_on(synth_freq_t freq) {
+    if (voices >= SYNTH_MAX_VOICES) {
+        return;
+    }
+    // Cancel notes if notes are playing
+    if (playing_notes) {
+        synth_stop_all();
+    }
+    playing_note = true;
+    envelope_index = 0;
+    if (freq > 0) {
+        frequencies[voices++] = freq;
+    }
+}
+
+uint8_t synth_note_off(synth_freq_t freq) {
+    if (!playing_note) {
+        return voices;
+    }
+    for (int8_t i = voices - 1; i >= 0; i--) {
+        if (frequencies[i] == freq) {
+            for (uint8_t j = i; j < SYNTH_MAX_VOICES - 1; j++) {
+                frequencies[j] = frequencies[j + 1];
+            }
+            frequencies[SYNTH_MAX_VOICES - 1] = 0;
+            voices--;
+            break;
+        }
+    }
+    if (voice_place >= voices) {
+        voice_place = 0;
+    }
+    if (voices == 0) {
+        frequency = 0;
+        frequency_alt = 0;
+        playing_note = false;
+    }
+    return voices;
+}
+
+synth_freq_t synth_note_frequency(uint8_t pitch) {
+    if (pitch == 0) {
+        return 0;
+    }
+    if (pitch > SONG_PITCH_MAX) {
+        pitch = SONG_PITCH_MAX;
+    }
+    uint8_t shift = SONG_PITCH_MAX / 12 - pitch / 12;
+    uint32_t freq = pgm_read_dword(&note_frequency_lut[pitch % 12]);
+    return (freq + ((1UL << shift) >> 1)) >> shift;
+}
+
+static song_note_t song_note(uint16_t note) {
+    if (notes_progmem) {
+        return pgm_read_word(&notes_pointer[note]);
+    }
+    return notes_pointer[note];
+}
+
+static synth_freq_t song_frequency(uint16_t note) {
+    return synth_note_frequency(SONG_NOTE_PITCH(song_note(note)));
+}
+
+static void load_note(uint16_t note, synth_freq_t freq) {
+    note_frequency = freq;
+    uint32_t duration = SONG_NOTE_DURATION(song_note(note));
+    note_length_us = duration * note_tempo * NOTE_UNIT_US_NUM / NOTE_UNIT_US_DEN;
+    note_position_us = 0;
+}
+
+static void start_notes(const song_note_t* np, bool progmem, uint16_t n_count, bool n_repeat) {
+    // Cancel note if a note is playing
+    if (playing_note) {
+        synth_stop_all();
+    }
+    if (n_count == 0) {
+        return;
+    }
+    playing_notes = true;
+    notes_pointer = np;
+    notes_progmem = progmem;
+    notes_count = n_count;
+    notes_repeat = n_repeat;
+    current_note = 0;
+    note_resting = false;
+    envelope_index = 0;
+    load_note(0, song_frequency(0));
+}
+
+static song_note_t pack_note(float freq, float duration) {
+    return SONG_PACK_NOTE(freq, (uint16_t)duration);
+}
+
+void synth_play_notes(float (*np)[][2], uint16_t n_count, bool n_repeat) {
+    // The whole song is packed here, so that the timer doesn't do any float
+    // math while it plays
+    if (n_count > SYNTH_FLOAT_SONG_MAX) {
+        n_count = SYNTH_FLOAT_SONG_MAX;
+    }
+    for (uint16_t i = 0; i < n_count; i++) {
+        float_song[i] = pack_note((*np)[i][0], (*np)[i][1]);
+    }
+    start_notes(float_song, false, n_count, n_repeat);
+}
+
+void synth_play_song(const song_note_t* song, uint16_t n_count, bool n_repeat) {
+    start_notes(song, true, n_count, n_repeat);
+}
+
+bool synth_is_playing_note(void) {
+    return playing_note;
+}
+
+bool synth_is_playing_notes(void) {
+    return playing_notes;
+}
+
+uint8_t synth_voices(void) {
+    return voices;
+}
+
+static void tick_note(uint16_t elapsed_us, uint8_t channels, synth_output_t* out) {
+    if (voices == 0) {
+        return;
+    }
+    // The second highest voice goes to the second channel, unless the
+    // voices take turns on the first one
+    if (channels > 1 && voices > 1 && polyphony_rate == 0) {
+        frequency_alt = glissando ? synth_glide(frequency_alt, frequencies[voices - 2]) : frequencies[voices - 2];
+        out->freq[1] = envelope(apply_vibrato(frequency_alt));
+    }
+
+    synth_freq_t freq;
+    if (polyphony_rate > 0) {
+        if (voices > 1) {
+            voice_place %= voices;
+            polyphony_position_us += elapsed_us;
+            if (polyphony_position_us > 1000000UL / POLYPHONY_DIVIDER / polyphony_rate) {
+                voice_place = (voice_place + 1) % voices;
+                polyphony_position_us = 0;
+            }
+        }
+        freq = apply_vibrato(frequencies[voice_place]);
+    } else {
+        frequency = glissando ? synth_glide(frequency, frequencies[voices - 1]) : frequencies[voices - 1];
+        freq = apply_vibrato(frequency);
+    }
+    out->freq[0] = envelope(freq);
+}
+
+static void tick_notes(uint16_t elapsed_us, synth_output_t* out) {
+    if (note_frequency > 0) {
+        out->freq[0] = envelope(apply_vibrato(note_frequency));
+        out->freq[1] = out->freq[0];
+    }
+
+    note_position_us += elapsed_us;
+    if (note_position_us < note_length_us) {
+        return;
+    }
+    note_position_us = 0;
+
+    if (!note_resting) {
+        bool last = current_note + 1 >= notes_count;
+        if (last && !notes_repeat) {
+            playing_notes = false;
+            out->stop = true;
+            return;
+        }
+        // Insert a gap of one period between the notes, which is silent when
+        // the next note has the same pitch, so that they can be told apart
+        note_resting = true;
+        note_length_us = note_frequency ? synth_period(note_frequency, 1000000UL) : 0;
+        next_frequency = song_frequency(last ? 0 : current_note + 1);
+        if (note_frequency == next_frequency) {
+            note_frequency = 0;
+        }
+    } else {
+        note_resting = false;
+        current_note++;
+        if (current_note >= notes_count) {
+            current_note = 0;
+        }
+        envelope_index = 0;
+        load_note(current_note, next_frequency);
+    }
+}
+
+void synth_tick(uint16_t elapsed_us, uint8_t channels, synth_output_t* out) {
+    out->freq[0] = 0;
+    out->freq[1] = 0;
+    out->stop = false;
+
+    if (playing_note) {
+        tick_note(elapsed_us, channels, out);
+    }
+    if (playing_notes) {
+        tick_notes(elapsed_us, out);
+    }
+    out->timbre = note_timbre;
+}
+
+// Converts a float setting to 8.8 fixed point, saturating at max
+static uint16_t to_fixed(float value, uint16_t max) {
+    if (value <= 0) {
+        return 0;
+    }
+    if (value >= (float)max / 256) {
+        return max;
+    }
+    return value * 256;
+}
+
+#ifdef VIBRATO_ENABLE
+
+// Vibrato rate functions
+
+void set_vibrato_rate(float rate) {
+    vibrato_rate = to_fixed(rate, SYNTH_VIBRATO_RATE_MAX);
+}
+
+void increase_vibrato_rate(float change) {
+    vibrato_rate = to_fixed(vibrato_rate / 256.0f * change, SYNTH_VIBRATO_RATE_MAX);
+}
+
+void decrease_vibrato_rate(float change) {
+    vibrato_rate = to_fixed(vibrato_rate / 256.0f / change, SYNTH_VIBRATO_RATE_MAX);
+}
+
+#ifdef VIBRATO_STRENGTH_ENABLE
+
+void set_vibrato_strength(float strength) {
+    vibrato_strength = to_fixed(strength, SYNTH_VIBRATO_STRENGTH_MAX);
+}
+
+void increase_vibrato_strength(float change) {
+    vibrato_strength = to_fixed(vibrato_strength / 256.0f * change, SYNTH_VIBRATO_STRENGTH_MAX);
+}
+
+void decrease_vibrato_strength(float change) {
+    vibrato_strength = to_fixed(vibrato_strength / 256.0f / change, SYNTH_VIBRATO_STRENGTH_MAX);
+}
+
+#endif  /* VIBRATO_STRENGTH_ENABLE */
+
+#endif /* VIBRATO_ENABLE */
+
+// Polyphony functions
+
+void set_polyphony_rate(float rate) {
+    polyphony_rate = to_fixed(rate, 0xFF << 8) >> 8;
+}
+
+void enable_polyphony() {
+    polyphony_rate = 5;
+}
+
+void disable_polyphony() {
+    polyphony_rate = 0;
+}
+
+void increase_polyphony_rate(float change) {
+    set_polyphony_rate(polyphony_rate * change);
+}
+
+void decrease_polyphony_rate(float change) {
+    set_polyphony_rate(polyphony_rate / change);
+}
+
+// Timbre function
+
+void set_timbre(float timbre) {
+    note_timbre = SYNTH_TIMBRE(timbre < 0 ? 0 : timbre);
+}
+
+// Tempo functions
+
+void set_tempo(uint8_t tempo) {
+    note_tempo = tempo;
+}
+
+void decrease_tempo(uint8_t tempo_change) {
+    note_tempo += tempo_change;
+}
+
+void increase_tempo(uint8_t tempo_change) {
+    if (note_tempo - tempo_change < 10) {
+        note_tempo = 10;
+    } else {
+        note_tempo -= tempo_change;
+    }
+}
@@ -0,0 +1,185 @@
+/* Copyright 2026 QMK Firmware contributors
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SYNTH_H
+#define SYNTH_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "musical_notes.h"
+
+/* Fixed point synthesis core
+ *
+ * Everything that used to be computed with floats inside the audio timer
+ * interrupts, note sequencing, glissando, vibrato, polyphony and the voice
+ * envelopes, lives here and only uses integer math. The platform drivers
+ * (audio.c, audio_pwm.c and audio_arm.c) call synth_tick from their timer
+ * interrupt, and only program the hardware from the result.
+ *
+ * The core has no hardware dependencies, so it can also be built natively
+ * where synth_render turns it into PCM samples.
+ */
+
+// Frequencies are in Hz, as unsigned 24.8 fixed point
+typedef uint32_t synth_freq_t;
+#define SYNTH_FREQ_SHIFT 8
+#define SYNTH_FREQ(hz) ((synth_freq_t)((hz) * (1 << SYNTH_FREQ_SHIFT) + 0.5f))
+#define SYNTH_HZ(freq) ((freq) >> SYNTH_FREQ_SHIFT)
+
+// The lowest frequency that fits the 16 bit AVR timers at 16MHz / 8
+#define SYNTH_FREQ_MIN SYNTH_FREQ(30.52)
+
+// The timbre is the duty cycle of the square wave, in 1/256
+typedef uint8_t synth_timbre_t;
+#define SYNTH_TIMBRE(t) ((synth_timbre_t)((t) >= 1.0f ? 255 : (t) * 256))
+
+#define SYNTH_MAX_VOICES 8
+
+// The number of notes of a float song that are played, see synth_play_notes
+#ifndef SYNTH_FLOAT_SONG_MAX
+#define SYNTH_FLOAT_SONG_MAX 64
+#endif
+
+typedef struct {
+    // The frequency of each output channel, 0 when the channel is silent
+    synth_freq_t freq[2];
+    synth_timbre_t timbre;
+    // Set when a song has ended, the platform should stop its timers
+    bool stop;
+} synth_output_t;
+
+// Tunable state, shared with the voice envelopes in voices.c
+extern uint8_t note_tempo;
+extern synth_timbre_t note_timbre;
+// Voice switches per second, 0 plays the voices on separate channels
+extern uint8_t polyphony_rate;
+extern bool glissando;
+// The number of ticks since the current note started
+extern uint16_t envelope_index;
+
+#ifdef VIBRATO_ENABLE
+// Vibrato table entries to advance per tick at 440Hz, in 8.8 fixed point
+extern uint16_t vibrato_rate;
+// The depth of the vibrato in 8.8 fixed point, 1.0 is the full table
+extern uint16_t vibrato_strength;
+#endif
+
+// Keeps the vibrato math within 32 bits
+#define SYNTH_VIBRATO_RATE_MAX 0x7FFF
+#define SYNTH_VIBRATO_STRENGTH_MAX 0x3FF
+
+// Vibrato rate functions
+
+#ifdef VIBRATO_ENABLE
+
+void set_vibrato_rate(float rate);
+void increase_vibrato_rate(float change);
+void decrease_vibrato_rate(float change);
+
+#ifdef VIBRATO_STRENGTH_ENABLE
+
+void set_vibrato_strength(float strength);
+void increase_vibrato_strength(float change);
+void decrease_vibrato_strength(float change);
+
+#endif
+
+#endif
+
+// Polyphony functions
+
+void set_polyphony_rate(float rate);
+void enable_polyphony(void);
+void disable_polyphony(void);
+void increase_polyphony_rate(float change);
+void decrease_polyphony_rate(float change);
+
+void set_timbre(float timbre);
+void set_tempo(uint8_t tempo);
+
+void increase_tempo(uint8_t tempo_change);
+void decrease_tempo(uint8_t tempo_change);
+
+void synth_reset(void);
+void synth_note_on(synth_freq_t freq);
+// Returns the number of voices that are still playing
+uint8_t synth_note_off(synth_freq_t freq);
+// Packs a float song into RAM and plays it, like a packed song. Only the first
+// SYNTH_FLOAT_SONG_MAX notes are played.
+void synth_play_notes(float (*np)[][2], uint16_t n_count, bool n_repeat);
+// Plays a packed song, which is read from PROGMEM one note at a time
+void synth_play_song(const song_note_t* song, uint16_t n_count, bool n_repeat);
+void synth_stop_all(void);
+bool synth_is_playing_note(void);
+bool synth_is_playing_notes(void);
+uint8_t synth_voices(void);
+
+/* Advances the synthesizer
+ *
+ * elapsed_us is the time since the previous tick and channels is the number
+ * of channels that the platform can output. Glissando, vibrato and envelopes
+ * advance once per tick, while notes, rests and polyphony are timed in
+ * microseconds, so the songs play at the same tempo on all platforms.
+ */
+void synth_tick(uint16_t elapsed_us, uint8_t channels, synth_output_t* out);
+
+// The frequency of a MIDI note number, 0 for rests
+synth_freq_t synth_note_frequency(uint8_t pitch);
+
+// Approximates freq * 2^(+-1/24 * 440 / freq), the glissando step of the
+// original float implementation, moving current towards target
+synth_freq_t synth_glide(synth_freq_t current, synth_freq_t target);
+
+// Applies the vibrato table entry at index to freq, strength is in 8.8
+// fixed point
+synth_freq_t synth_vibrato_apply(synth_freq_t freq, uint8_t index, uint16_t strength);
+
+// The period of freq in ticks of a timer running at clock Hz, the clock has
+// to be below 16MHz, so that the math fits 32 bits
+static inline uint32_t synth_period(synth_freq_t freq, uint32_t clock) {
+    return (clock << SYNTH_FREQ_SHIFT) / freq;
+}
+
+static inline uint32_t synth_duty(uint32_t period, synth_timbre_t timbre) {
+    return (period * timbre) >> 8;
+}
+
+/* Phase accumulator oscillator
+ *
+ * A full cycle wraps the 32 bit phase, so the top bits can be used directly
+ * as an index into a wave table.
+ */
+typedef struct {
+    uint32_t phase;
+    uint32_t step;
+} synth_osc_t;
+
+static inline void synth_osc_set(synth_osc_t* osc, synth_freq_t freq, uint32_t sample_rate) {
+    osc->step = ((uint64_t)freq << (32 - SYNTH_FREQ_SHIFT)) / sample_rate;
+}
+
+// Advances the oscillator by one sample, returns true when a cycle completes
+static inline bool synth_osc_next(synth_osc_t* osc) {
+    uint32_t phase = osc->phase;
+    osc->phase += osc->step;
+    return osc->phase < phase;
+}
+
+static inline bool synth_osc_square(const synth_osc_t* osc, synth_timbre_t timbre) {
+    return (osc->phase >> 24) < timbre;
+}
+
+#endif
@@ -0,0 +1,148 @@
+/* Copyright 2026 QMK Firmware contributors
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "synth_mixer.h"
+
+static uint16_t envelope_step(uint32_t sample_rate, uint32_t us) {
+    uint32_t samples = (uint64_t)sample_rate * us / 1000000UL;
+    if (samples == 0) {
+        return SYNTH_MIXER_LEVEL_MAX;
+    }
+    // Rounded up, so that the envelope never takes longer than configured
+    return (SYNTH_MIXER_LEVEL_MAX + samples - 1) / samples;
+}
+
+static void start_voice(synth_mixer_t* mixer, synth_mixer_voice_t* voice, synth_freq_t freq, synth_timbre_t timbre) {
+    if (voice->freq == 0 || voice->level == 0) {
+        voice->osc.phase = 0;
+    }
+    synth_osc_set(&voice->osc, freq, mixer->sample_rate);
+    voice->freq = freq;
+    voice->timbre = timbre;
+    voice->released = false;
+}
+
+void synth_mixer_init(synth_mixer_t* mixer, uint32_t sample_rate) {
+    mixer->sample_rate = sample_rate;
+    mixer->attack_step = envelope_step(sample_rate, SYNTH_MIXER_ATTACK_US);
+    mixer->release_step = envelope_step(sample_rate, SYNTH_MIXER_RELEASE_US);
+    synth_mixer_stop_all(mixer);
+}
+
+void synth_mixer_note_on(synth_mixer_t* mixer, synth_freq_t freq, synth_timbre_t timbre) {
+    synth_mixer_voice_t* target = &mixer->voices[0];
+    for (uint8_t i = 0; i < SYNTH_MIXER_VOICES; i++) {
+        synth_mixer_voice_t* voice = &mixer->voices[i];
+        if (voice->freq == freq) {
+            target = voice;
+            break;
+        }
+        // Prefer free voices, then released ones, then the quietest
+        if (voice->freq == 0) {
+            if (target->freq != 0) {
+                target = voice;
+            }
+        } else if (target->freq != 0 && (voice->released > target->released ||
+                (voice->released == target->released && voice->level < target->level))) {
+            target = voice;
+        }
+    }
+    start_voice(mixer, target, freq, timbre);
+}
+
+void synth_mixer_note_off(synth_mixer_t* mixer, synth_freq_t freq) {
+    for (uint8_t i = 0; i < SYNTH_MIXER_VOICES; i++) {
+        if (mixer->voices[i].freq == freq) {
+            mixer->voices[i].released = true;
+        }
+    }
+}
+
+void synth_mixer_song(synth_mixer_t* mixer, synth_freq_t freq, synth_timbre_t timbre) {
+    synth_mixer_voice_t* voice = &mixer->song;
+    if (freq == 0) {
+        voice->released = true;
+    } else {
+        start_voice(mixer, voice, freq, timbre);
+    }
+}
+
+void synth_mixer_stop_all(synth_mixer_t* mixer) {
+    for (uint8_t i = 0; i < SYNTH_MIXER_VOICES; i++) {
+        mixer->voices[i].freq = 0;
+        mixer->voices[i].level = 0;
+    }
+    mixer->song.freq = 0;
+    mixer->song.level = 0;
+}
+
+uint8_t synth_mixer_voices(const synth_mixer_t* mixer) {
+    uint8_t count = mixer->song.freq != 0;
+    for (uint8_t i = 0; i < SYNTH_MIXER_VOICES; i++) {
+        count += mixer->voices[i].freq != 0;
+    }
+    return count;
+}
+
+// Adds the voice to the mix, and frees it once the release has faded out
+static void mix_voice(const synth_mixer_t* mixer, synth_mixer_voice_t* voice, int32_t* mix, uint16_t size) {
+    if (voice->freq == 0) {
+        return;
+    }
+    uint16_t level = voice->level;
+    for (uint16_t i = 0; i < size; i++) {
+        if (voice->released) {
+            if (level <= mixer->release_step) {
+                voice->freq = 0;
+                level = 0;
+                break;
+            }
+            level -= mixer->release_step;
+        } else if (level < SYNTH_MIXER_LEVEL_MAX) {
+            level = level < SYNTH_MIXER_LEVEL_MAX - mixer->attack_step ? level + mixer->attack_step : SYNTH_MIXER_LEVEL_MAX;
+        }
+        synth_osc_next(&voice->osc);
+        int32_t amplitude = ((uint32_t)level * SYNTH_MIXER_AMPLITUDE) >> 16;
+        mix[i] += synth_osc_square(&voice->osc, voice->timbre) ? amplitude : -amplitude;
+    }
+    voice->level = level;
+}
+
+// The mix is accumulated in blocks, to keep the 32 bit buffer on the stack small
+#define MIX_BLOCK 32
+
+bool synth_mixer_render(synth_mixer_t* mixer, int16_t* buffer, uint16_t size) {
+    while (size > 0) {
+        uint16_t block = size < MIX_BLOCK ? size : MIX_BLOCK;
+        int32_t mix[MIX_BLOCK] = {0};
+        for (uint8_t i = 0; i < SYNTH_MIXER_VOICES; i++) {
+            mix_voice(mixer, &mixer->voices[i], mix, block);
+        }
+        mix_voice(mixer, &mixer->song, mix, block);
+        for (uint16_t i = 0; i < block; i++) {
+            int32_t sample = mix[i];
+            if (sample > INT16_MAX) {
+                sample = INT16_MAX;
+            } else if (sample < INT16_MIN) {
+                sample = INT16_MIN;
+            }
+            buffer[i] = sample;
+        }
+        buffer += block;
+        size -= block;
+    }
+    return synth_mixer_voices(mixer) > 0;
+}
@@ -0,0 +1,89 @@
+/* Copyright 2026 QMK Firmware contributors
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SYNTH_MIXER_H
+#define SYNTH_MIXER_H
+
+#include "synth.h"
+
+/* Polyphonic sample mixer
+ *
+ * Every voice is a square wave oscillator with its own timbre and an
+ * attack and release envelope, and all of them are summed into 16 bit
+ * samples, which are clipped instead of wrapping around when too many voices
+ * play at once. Notes only change the voice state, the samples are rendered
+ * from the DAC callback, a buffer at a time.
+ *
+ * Songs are sequenced by synth_tick as before, and play on a separate voice,
+ * which follows the glissando and vibrato of the synthesizer.
+ */
+
+#ifndef SYNTH_MIXER_VOICES
+    #define SYNTH_MIXER_VOICES SYNTH_MAX_VOICES
+#endif
+
+// The amplitude of a voice at full level, four voices fit without clipping
+#ifndef SYNTH_MIXER_AMPLITUDE
+    #define SYNTH_MIXER_AMPLITUDE 8192
+#endif
+
+#ifndef SYNTH_MIXER_ATTACK_US
+    #define SYNTH_MIXER_ATTACK_US 5000
+#endif
+
+#ifndef SYNTH_MIXER_RELEASE_US
+    #define SYNTH_MIXER_RELEASE_US 50000
+#endif
+
+#define SYNTH_MIXER_LEVEL_MAX 0xFFFF
+
+typedef struct {
+    synth_osc_t osc;
+    // The note that started the voice, 0 when the voice is free
+    synth_freq_t freq;
+    synth_timbre_t timbre;
+    bool released;
+    // The envelope, from 0 to SYNTH_MIXER_LEVEL_MAX
+    uint16_t level;
+} synth_mixer_voice_t;
+
+typedef struct {
+    uint32_t sample_rate;
+    // The envelope change per sample
+    uint16_t attack_step;
+    uint16_t release_step;
+    synth_mixer_voice_t voices[SYNTH_MIXER_VOICES];
+    synth_mixer_voice_t song;
+} synth_mixer_t;
+
+void synth_mixer_init(synth_mixer_t* mixer, uint32_t sample_rate);
+
+// Starts a note on a free voice, or on the quietest one when all of them
+// are in use. A note that is already playing is restarted.
+void synth_mixer_note_on(synth_mixer_t* mixer, synth_freq_t freq, synth_timbre_t timbre);
+// Releases the note, the voice is freed once the release has faded out
+void synth_mixer_note_off(synth_mixer_t* mixer, synth_freq_t freq);
+// Sets the frequency of the song voice, 0 releases it
+void synth_mixer_song(synth_mixer_t* mixer, synth_freq_t freq, synth_timbre_t timbre);
+void synth_mixer_stop_all(synth_mixer_t* mixer);
+
+// The number of voices that are playing or releasing, including the song
+uint8_t synth_mixer_voices(const synth_mixer_t* mixer);
+
+// Fills the buffer with the mix, returns false when all the voices are silent
+bool synth_mixer_render(synth_mixer_t* mixer, int16_t* buffer, uint16_t size);
+
+#endif
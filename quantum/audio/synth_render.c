@@ -0,0 +1,82 @@
+/* Copyright 2026 QMK Firmware contributors
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "synth_render.h"
+
+// Rests tick at this frequency when ticking once per period
+#define REST_FREQUENCY SYNTH_FREQ(440)
+
+void synth_render_init(synth_render_t* render, uint32_t sample_rate, uint16_t tick_us, uint8_t channels) {
+    render->sample_rate = sample_rate;
+    render->tick_us = tick_us;
+    render->channels = channels;
+    // Tick on the first sample
+    render->tick_length_us = 0;
+    render->tick_position = 0;
+    for (uint8_t i = 0; i < 2; i++) {
+        render->osc[i].phase = 0;
+        render->osc[i].step = 0;
+        render->out.freq[i] = 0;
+    }
+    render->out.timbre = 0;
+    render->out.stop = false;
+    render->stopped = false;
+}
+
+static void tick(synth_render_t* render) {
+    synth_tick(render->tick_length_us, render->channels, &render->out);
+    if (render->out.stop || !(synth_is_playing_note() || synth_is_playing_notes())) {
+        render->stopped = true;
+        return;
+    }
+    for (uint8_t i = 0; i < 2; i++) {
+        synth_osc_set(&render->osc[i], render->out.freq[i], render->sample_rate);
+    }
+    if (render->tick_us) {
+        render->tick_length_us = render->tick_us;
+    } else {
+        synth_freq_t freq = render->out.freq[0] ? render->out.freq[0] : REST_FREQUENCY;
+        render->tick_length_us = synth_period(freq, 1000000);
+    }
+}
+
+uint32_t synth_render(synth_render_t* render, int16_t* buffer, uint32_t size) {
+    for (uint32_t i = 0; i < size; i++) {
+        uint32_t tick_end = (uint32_t)render->tick_length_us * render->sample_rate;
+        if (!render->stopped && render->tick_position >= tick_end) {
+            render->tick_position -= tick_end;
+            tick(render);
+        }
+        if (render->stopped) {
+            for (uint32_t j = i; j < size; j++) {
+                buffer[j] = 0;
+            }
+            return i;
+        }
+
+        int32_t sample = 0;
+        for (uint8_t c = 0; c < 2; c++) {
+            if (render->out.freq[c]) {
+                bool high = synth_osc_square(&render->osc[c], render->out.timbre);
+                sample += high ? SYNTH_RENDER_AMPLITUDE : -SYNTH_RENDER_AMPLITUDE;
+                synth_osc_next(&render->osc[c]);
+            }
+        }
+        buffer[i] = sample;
+        render->tick_position += 1000000;
+    }
+    return size;
+}
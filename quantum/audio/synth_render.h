@@ -0,0 +1,51 @@
+/* Copyright 2026 QMK Firmware contributors
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SYNTH_RENDER_H
+#define SYNTH_RENDER_H
+
+#include "synth.h"
+
+/* Renders the synthesizer into 16 bit PCM samples
+ *
+ * This drives synth_tick the same way as the platform timers do, so that the
+ * output and timing can be checked without any hardware. With a tick_us of 0
+ * the synthesizer is ticked once per period of the first channel, like the
+ * AVR timer interrupts, otherwise with a fixed interval, like the ARM timer.
+ */
+
+#define SYNTH_RENDER_AMPLITUDE 8192
+
+typedef struct {
+    uint32_t sample_rate;
+    uint16_t tick_us;
+    uint8_t channels;
+    // The length of the current tick, and the time spent in it, in
+    // microseconds multiplied by the sample rate
+    uint16_t tick_length_us;
+    uint32_t tick_position;
+    synth_osc_t osc[2];
+    synth_output_t out;
+    bool stopped;
+} synth_render_t;
+
+void synth_render_init(synth_render_t* render, uint32_t sample_rate, uint16_t tick_us, uint8_t channels);
+
+// Fills the buffer, returns the number of samples rendered before the
+// synthesizer went quiet, which is less than size when it did
+uint32_t synth_render(synth_render_t* render, int16_t* buffer, uint32_t size);
+
+#endif
@@ -0,0 +1,166 @@
+/* Copyright 2026 QMK Firmware contributors
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "gtest/gtest.h"
+#include <algorithm>
+#include <vector>
+extern "C" {
+#include "synth_mixer.h"
+#include "musical_notes.h"
+}
+
+namespace {
+
+const uint32_t SAMPLE_RATE = 8000;
+const size_t ATTACK_SAMPLES = SAMPLE_RATE * SYNTH_MIXER_ATTACK_US / 1000000;
+const size_t RELEASE_SAMPLES = SAMPLE_RATE * SYNTH_MIXER_RELEASE_US / 1000000;
+const synth_timbre_t TIMBRE = SYNTH_TIMBRE(TIMBRE_50);
+
+}
+
+class AudioMixer : public testing::Test {
+public:
+    AudioMixer() {
+        synth_mixer_init(&mixer, SAMPLE_RATE);
+    }
+
+    std::vector<int16_t> render(size_t size) {
+        std::vector<int16_t> pcm(size);
+        playing = synth_mixer_render(&mixer, pcm.data(), pcm.size());
+        return pcm;
+    }
+
+    static int16_t peak(const std::vector<int16_t>& pcm, size_t begin, size_t end) {
+        int16_t result = 0;
+        for (size_t i = begin; i < end; i++) {
+            result = std::max<int16_t>(result, std::abs(pcm[i]));
+        }
+        return result;
+    }
+
+    synth_mixer_t mixer;
+    bool playing;
+};
+
+TEST_F(AudioMixer, IsSilentWithoutVoices) {
+    auto pcm = render(100);
+    EXPECT_FALSE(playing);
+    EXPECT_EQ(peak(pcm, 0, pcm.size()), 0);
+}
+
+TEST_F(AudioMixer, ChordIsTheSumOfItsNotes) {
+    const synth_freq_t notes[] = {SYNTH_FREQ(NOTE_C4), SYNTH_FREQ(NOTE_E4), SYNTH_FREQ(NOTE_G4)};
+    std::vector<int32_t> sum(1000);
+    for (synth_freq_t note : notes) {
+        synth_mixer_init(&mixer, SAMPLE_RATE);
+        synth_mixer_note_on(&mixer, note, TIMBRE);
+        auto pcm = render(sum.size());
+        for (size_t i = 0; i < sum.size(); i++) {
+            sum[i] += pcm[i];
+        }
+    }
+    synth_mixer_init(&mixer, SAMPLE_RATE);
+    for (synth_freq_t note : notes) {
+        synth_mixer_note_on(&mixer, note, TIMBRE);
+    }
+    EXPECT_EQ(synth_mixer_voices(&mixer), 3);
+    auto chord = render(sum.size());
+    EXPECT_TRUE(playing);
+    for (size_t i = 0; i < sum.size(); i++) {
+        ASSERT_EQ(chord[i], sum[i]) << "sample " << i;
+    }
+}
+
+TEST_F(AudioMixer, LoudMixIsClippedInsteadOfWrapping) {
+    // Almost always high, so that all the voices add up
+    for (uint8_t i = 0; i < SYNTH_MIXER_VOICES; i++) {
+        synth_mixer_note_on(&mixer, SYNTH_FREQ(NOTE_C4) + i * SYNTH_FREQ(1), 255);
+    }
+    auto pcm = render(ATTACK_SAMPLES + 100);
+    EXPECT_EQ(peak(pcm, 0, pcm.size()), INT16_MAX);
+    for (size_t i = ATTACK_SAMPLES; i < pcm.size(); i++) {
+        ASSERT_GT(pcm[i], 0) << "sample " << i;
+    }
+}
+
+TEST_F(AudioMixer, AttackRampsUpTheLevel) {
+    synth_mixer_note_on(&mixer, SYNTH_FREQ(NOTE_A4), TIMBRE);
+    auto pcm = render(ATTACK_SAMPLES * 2);
+    EXPECT_LT(std::abs(pcm[0]), SYNTH_MIXER_AMPLITUDE / 4);
+    EXPECT_EQ(peak(pcm, ATTACK_SAMPLES, pcm.size()), SYNTH_MIXER_AMPLITUDE - 1);
+}
+
+TEST_F(AudioMixer, ReleasedVoiceFadesOutAndIsFreed) {
+    synth_mixer_note_on(&mixer, SYNTH_FREQ(NOTE_A4), TIMBRE);
+    render(ATTACK_SAMPLES);
+    synth_mixer_note_off(&mixer, SYNTH_FREQ(NOTE_A4));
+    auto pcm = render(RELEASE_SAMPLES / 2);
+    EXPECT_TRUE(playing);
+    EXPECT_LT(peak(pcm, pcm.size() - 10, pcm.size()), SYNTH_MIXER_AMPLITUDE * 3 / 4);
+    EXPECT_GT(peak(pcm, pcm.size() - 10, pcm.size()), SYNTH_MIXER_AMPLITUDE / 4);
+    pcm = render(RELEASE_SAMPLES);
+    EXPECT_FALSE(playing);
+    EXPECT_EQ(synth_mixer_voices(&mixer), 0);
+    EXPECT_EQ(peak(pcm, pcm.size() * 3 / 4, pcm.size()), 0);
+}
+
+TEST_F(AudioMixer, VoicesKeepTheirOwnTimbre) {
+    synth_mixer_note_on(&mixer, SYNTH_FREQ(NOTE_A4), SYNTH_TIMBRE(TIMBRE_25));
+    synth_mixer_note_on(&mixer, SYNTH_FREQ(NOTE_A5), SYNTH_TIMBRE(TIMBRE_75));
+    synth_mixer_note_off(&mixer, SYNTH_FREQ(NOTE_A5));
+    render(RELEASE_SAMPLES + ATTACK_SAMPLES);
+    auto pcm = render(SAMPLE_RATE);
+    size_t high = std::count_if(pcm.begin(), pcm.end(), [](int16_t s) { return s > 0; });
+    EXPECT_NEAR(high, SAMPLE_RATE / 4, SAMPLE_RATE / 100);
+}
+
+TEST_F(AudioMixer, QuietestVoiceIsStolenWhenAllAreInUse) {
+    for (uint8_t i = 0; i < SYNTH_MIXER_VOICES; i++) {
+        synth_mixer_note_on(&mixer, SYNTH_FREQ(NOTE_C4) + i * SYNTH_FREQ(10), TIMBRE);
+    }
+    render(ATTACK_SAMPLES);
+    synth_mixer_note_off(&mixer, SYNTH_FREQ(NOTE_C4) + SYNTH_FREQ(10));
+    synth_mixer_note_on(&mixer, SYNTH_FREQ(NOTE_C6), TIMBRE);
+    EXPECT_EQ(synth_mixer_voices(&mixer), SYNTH_MIXER_VOICES);
+    // The released note was replaced, the held ones keep playing
+    EXPECT_EQ(mixer.voices[1].freq, SYNTH_FREQ(NOTE_C6));
+    EXPECT_FALSE(mixer.voices[1].released);
+    for (uint8_t i = 0; i < SYNTH_MIXER_VOICES; i++) {
+        if (i == 1) {
+            continue;
+        }
+        EXPECT_EQ(mixer.voices[i].freq, SYNTH_FREQ(NOTE_C4) + i * SYNTH_FREQ(10)) << "voice " << (int)i;
+        EXPECT_FALSE(mixer.voices[i].released) << "voice " << (int)i;
+        EXPECT_EQ(mixer.voices[i].level, SYNTH_MIXER_LEVEL_MAX) << "voice " << (int)i;
+    }
+    synth_mixer_note_off(&mixer, SYNTH_FREQ(NOTE_C6));
+    for (uint8_t i = 0; i < SYNTH_MIXER_VOICES; i++) {
+        synth_mixer_note_off(&mixer, SYNTH_FREQ(NOTE_C4) + i * SYNTH_FREQ(10));
+    }
+    render(RELEASE_SAMPLES);
+    EXPECT_EQ(synth_mixer_voices(&mixer), 0);
+}
+
+TEST_F(AudioMixer, SongVoiceChangesPitchWithoutRestarting) {
+    synth_mixer_song(&mixer, SYNTH_FREQ(NOTE_A4), TIMBRE);
+    render(ATTACK_SAMPLES);
+    synth_mixer_song(&mixer, SYNTH_FREQ(NOTE_C5), TIMBRE);
+    auto pcm = render(10);
+    EXPECT_EQ(peak(pcm, 0, pcm.size()), SYNTH_MIXER_AMPLITUDE - 1);
+    synth_mixer_song(&mixer, 0, TIMBRE);
+    render(RELEASE_SAMPLES);
+    EXPECT_FALSE(playing);
+}
@@ -0,0 +1,158 @@
+/* Copyright 2026 QMK Firmware contributors
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "gtest/gtest.h"
+#include <cmath>
+#include <cstring>
+#include <vector>
+extern "C" {
+#include "synth.h"
+#include "synth_render.h"
+#include "voices.h"
+#include "musical_notes.h"
+#include "song_list.h"
+}
+
+namespace {
+
+#define ALL_SONGS(X) \
+    X(ODE_TO_JOY) X(ROCK_A_BYE_BABY) X(CLOSE_ENCOUNTERS_5_NOTE) X(DOE_A_DEER) \
+    X(IN_LIKE_FLINT) X(IMPERIAL_MARCH) X(CLUEBOARD_SOUND) X(BASKET_CASE) \
+    X(STARTUP_SOUND) X(GOODBYE_SOUND) X(PLANCK_SOUND) X(PREONIC_SOUND) \
+    X(QWERTY_SOUND) X(COLEMAK_SOUND) X(DVORAK_SOUND) X(PLOVER_SOUND) \
+    X(PLOVER_GOODBYE_SOUND) X(MUSIC_ON_SOUND) X(AUDIO_ON_SOUND) X(AUDIO_OFF_SOUND) \
+    X(MUSIC_SCALE_SOUND) X(MUSIC_OFF_SOUND) X(VOICE_CHANGE_SOUND) X(CHROMATIC_SOUND) \
+    X(MAJOR_SOUND) X(GUITAR_SOUND) X(VIOLIN_SOUND) X(CAPS_LOCK_ON_SOUND) \
+    X(CAPS_LOCK_OFF_SOUND) X(SCROLL_LOCK_ON_SOUND) X(SCROLL_LOCK_OFF_SOUND) \
+    X(NUM_LOCK_ON_SOUND) X(NUM_LOCK_OFF_SOUND) X(AG_NORM_SOUND) X(AG_SWAP_SOUND) \
+    X(UNICODE_WINDOWS) X(UNICODE_LINUX) X(COIN_SOUND) X(ONE_UP_SOUND) \
+    X(SONIC_RING) X(ZELDA_PUZZLE) X(ZELDA_TREASURE) X(TERMINAL_SOUND)
+
+// Every song is defined twice from the same SONG() definition, first as
+// floats and then packed, just like a file that defines PACKED_SONGS
+#define FLOAT_SONG(name) float name##_float[][2] = SONG(name);
+ALL_SONGS(FLOAT_SONG)
+
+#undef SONG_NOTE
+#define SONG_NOTE(freq, duration) SONG_PACK_NOTE(freq, duration)
+#define PACKED_SONG(name) const song_note_t name##_packed[] = SONG(name);
+ALL_SONGS(PACKED_SONG)
+
+struct Song {
+    const char* name;
+    const float (*notes)[2];
+    size_t count;
+    const song_note_t* packed;
+    size_t packed_count;
+};
+
+#define SONG_ENTRY(name) {#name, name##_float, sizeof(name##_float) / sizeof(name##_float[0]), \
+    name##_packed, sizeof(name##_packed) / sizeof(name##_packed[0])},
+const Song songs[] = {
+    ALL_SONGS(SONG_ENTRY)
+};
+
+const uint32_t SAMPLE_RATE = 8000;
+
+}
+
+class AudioSongs : public testing::Test {
+public:
+    AudioSongs() {
+        synth_reset();
+        set_voice(default_voice);
+    }
+
+    ~AudioSongs() {
+        synth_reset();
+    }
+
+    // Renders until the song stops, and returns the length in samples
+    size_t render_length() {
+        synth_render_t render;
+        synth_render_init(&render, SAMPLE_RATE, 0, 1);
+        std::vector<int16_t> pcm(SAMPLE_RATE * 10);
+        return synth_render(&render, pcm.data(), pcm.size());
+    }
+};
+
+TEST_F(AudioSongs, EverySongDecodesToTheSameNotes) {
+    for (const Song& song : songs) {
+        ASSERT_EQ(song.packed_count, song.count) << song.name;
+        for (size_t i = 0; i < song.count; i++) {
+            float hz = song.notes[i][0];
+            uint8_t pitch = SONG_NOTE_PITCH(song.packed[i]);
+            EXPECT_EQ(SONG_NOTE_DURATION(song.packed[i]), song.notes[i][1]) << song.name << " note " << i;
+            if (hz == 0) {
+                EXPECT_EQ(pitch, 0) << song.name << " note " << i;
+                continue;
+            }
+            EXPECT_EQ(pitch, std::lround(12 * std::log2(hz / 440) + 69)) << song.name << " note " << i;
+            // The note constants are rounded to 0.01Hz
+            EXPECT_NEAR(synth_note_frequency(pitch) / 256.0, hz, 0.01) << song.name << " note " << i;
+        }
+    }
+}
+
+TEST_F(AudioSongs, PackedSongsUseAQuarterOfTheMemory) {
+    EXPECT_EQ(sizeof(STARTUP_SOUND_packed) * 4, sizeof(STARTUP_SOUND_float));
+}
+
+TEST_F(AudioSongs, PackedSongPlaysLikeTheFloatSong) {
+    synth_play_notes(&STARTUP_SOUND_float, sizeof(STARTUP_SOUND_float) / sizeof(STARTUP_SOUND_float[0]), false);
+    size_t float_length = render_length();
+    synth_reset();
+    synth_play_song(STARTUP_SOUND_packed, sizeof(STARTUP_SOUND_packed) / sizeof(STARTUP_SOUND_packed[0]), false);
+    size_t packed_length = render_length();
+    EXPECT_GT(float_length, 0);
+    EXPECT_NEAR(packed_length, float_length, 1);
+}
+
+TEST_F(AudioSongs, FloatSongsAreConvertedWhenTheyAreLoaded) {
+    float song[sizeof(STARTUP_SOUND_float) / sizeof(STARTUP_SOUND_float[0])][2];
+    memcpy(song, STARTUP_SOUND_float, sizeof(song));
+    synth_play_notes(&song, sizeof(song) / sizeof(song[0]), false);
+    // The timer never looks at the floats again
+    for (auto& note : song) {
+        note[0] = 0;
+        note[1] = 0;
+    }
+    size_t length = render_length();
+    synth_reset();
+    synth_play_song(STARTUP_SOUND_packed, sizeof(STARTUP_SOUND_packed) / sizeof(STARTUP_SOUND_packed[0]), false);
+    EXPECT_EQ(length, render_length());
+}
+
+TEST_F(AudioSongs, LongFloatSongsAreCut) {
+    float song[SYNTH_FLOAT_SONG_MAX + 1][2];
+    for (auto& note : song) {
+        note[0] = NOTE_A4;
+        note[1] = 1;
+    }
+    synth_play_notes(&song, SYNTH_FLOAT_SONG_MAX + 1, false);
+    size_t length = render_length();
+    synth_reset();
+    synth_play_notes(&song, SYNTH_FLOAT_SONG_MAX, false);
+    EXPECT_EQ(length, render_length());
+}
+
+TEST_F(AudioSongs, OutOfRangeNotesAreClamped) {
+    EXPECT_EQ(SONG_NOTE_DURATION(SONG_PACK_NOTE(NOTE_A4, 1000)), SONG_DURATION_MAX);
+    EXPECT_EQ(SONG_NOTE_PITCH(SONG_PACK_NOTE(NOTE_A4, 1000)), 69);
+    EXPECT_EQ(SONG_NOTE_PITCH(SONG_PACK_NOTE(20000.0f, 8)), SONG_PITCH_MAX);
+    EXPECT_EQ(SONG_NOTE_PITCH(SONG_PACK_NOTE(NOTE_REST, 8)), 0);
+    EXPECT_EQ(synth_note_frequency(127), synth_note_frequency(SONG_PITCH_MAX));
+}
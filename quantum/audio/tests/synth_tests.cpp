@@ -0,0 +1,246 @@
+/* Copyright 2026 QMK Firmware contributors
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "gtest/gtest.h"
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <string>
+#include <vector>
+extern "C" {
+#include "synth.h"
+#include "synth_render.h"
+#include "voices.h"
+#include "musical_notes.h"
+#include "song_list.h"
+}
+
+namespace {
+
+const uint32_t SAMPLE_RATE = 8000;
+// The interval of the ARM audio timer
+const uint16_t FIXED_TICK_US = 2048;
+
+// Run with UPDATE_GOLDEN=1 to write the golden files instead of comparing
+const char* GOLDEN_DIR = "quantum/audio/tests/golden/";
+
+float startup_song[][2] = SONG(STARTUP_SOUND);
+float repeated_notes[][2] = SONG(E__NOTE(_A4), E__NOTE(_A4));
+
+}
+
+class AudioSynth : public testing::Test {
+public:
+    AudioSynth() {
+        synth_reset();
+        set_voice(default_voice);
+        srand(1);
+    }
+
+    ~AudioSynth() {
+        synth_reset();
+    }
+
+    void start_render(uint16_t tick_us, uint8_t channels) {
+        synth_render_init(&render, SAMPLE_RATE, tick_us, channels);
+    }
+
+    // Renders up to the given time, returns false if the synthesizer stopped
+    bool render_ms(uint32_t ms) {
+        uint32_t size = SAMPLE_RATE * ms / 1000;
+        size_t start = pcm.size();
+        pcm.resize(start + size);
+        uint32_t rendered = synth_render(&render, &pcm[start], size);
+        pcm.resize(start + rendered);
+        return rendered == size;
+    }
+
+    void render_song(uint16_t tick_us) {
+        start_render(tick_us, 1);
+        synth_play_notes(&startup_song, sizeof(startup_song) / sizeof(startup_song[0]), false);
+        EXPECT_FALSE(render_ms(1000));
+    }
+
+    uint32_t duration_us() {
+        return (uint64_t)pcm.size() * 1000000 / SAMPLE_RATE;
+    }
+
+    void expect_golden(const std::string& name) {
+        std::string path = GOLDEN_DIR + name + ".pcm";
+        if (getenv("UPDATE_GOLDEN")) {
+            std::ofstream out(path, std::ios::binary);
+            for (int16_t sample : pcm) {
+                out.put(sample & 0xFF);
+                out.put((sample >> 8) & 0xFF);
+            }
+            return;
+        }
+        std::ifstream in(path, std::ios::binary);
+        ASSERT_TRUE(in.good()) << "Missing golden file " << path;
+        std::vector<int16_t> golden;
+        int lo, hi;
+        while ((lo = in.get()) != EOF && (hi = in.get()) != EOF) {
+            golden.push_back((int16_t)(lo | (hi << 8)));
+        }
+        ASSERT_EQ(pcm.size(), golden.size()) << "The length of " << name << " changed";
+        for (size_t i = 0; i < pcm.size(); i++) {
+            ASSERT_EQ(pcm[i], golden[i]) << name << " differs at " << i * 1000.0 / SAMPLE_RATE << "ms";
+        }
+    }
+
+    synth_render_t render;
+    std::vector<int16_t> pcm;
+};
+
+TEST_F(AudioSynth, StartupSongMatchesGolden) {
+    render_song(0);
+    expect_golden("startup_song");
+}
+
+TEST_F(AudioSynth, StartupSongWithFixedTickMatchesGolden) {
+    render_song(FIXED_TICK_US);
+    expect_golden("startup_song_fixed_tick");
+}
+
+TEST_F(AudioSynth, GlissandoChordMatchesGolden) {
+    set_voice(delayed_vibrato);
+    start_render(0, 2);
+    synth_note_on(SYNTH_FREQ(NOTE_C4));
+    render_ms(100);
+    synth_note_on(SYNTH_FREQ(NOTE_G5));
+    render_ms(200);
+    synth_note_off(SYNTH_FREQ(NOTE_G5));
+    render_ms(200);
+    synth_note_off(SYNTH_FREQ(NOTE_C4));
+    EXPECT_FALSE(render_ms(10));
+    expect_golden("glissando_chord");
+}
+
+TEST_F(AudioSynth, VoicesMatchGolden) {
+    for (int voice = 0; voice < number_of_voices; voice++) {
+        set_voice((voice_type)voice);
+        start_render(0, 1);
+        synth_note_on(SYNTH_FREQ(NOTE_A4));
+        render_ms(150);
+        synth_note_off(SYNTH_FREQ(NOTE_A4));
+    }
+    expect_golden("voices");
+}
+
+TEST_F(AudioSynth, SongTempoIsTheSameOnAllPlatforms) {
+    // Two eighth notes and a dotted eighth note, with a gap of one period
+    // between the notes
+    const double expected_us = (8 + 8 + 12) * TEMPO_DEFAULT * 81.92 + 1e6 / NOTE_E6 + 1e6 / NOTE_A6;
+    render_song(0);
+    EXPECT_NEAR(duration_us(), expected_us, expected_us * 0.01);
+    pcm.clear();
+    synth_reset();
+    // Each note and gap can end up to one tick late
+    render_song(FIXED_TICK_US);
+    EXPECT_NEAR(duration_us(), expected_us, FIXED_TICK_US * 5);
+}
+
+TEST_F(AudioSynth, TempoScalesTheSong) {
+    set_tempo(TEMPO_DEFAULT / 2);
+    render_song(FIXED_TICK_US);
+    const double expected_us = (8 + 8 + 12) * TEMPO_DEFAULT / 2 * 81.92;
+    EXPECT_NEAR(duration_us(), expected_us, FIXED_TICK_US * 5);
+}
+
+TEST_F(AudioSynth, RepeatedNotesAreSeparatedBySilence) {
+    start_render(0, 1);
+    synth_play_notes(&repeated_notes, sizeof(repeated_notes) / sizeof(repeated_notes[0]), false);
+    render_ms(1000);
+    // Find a run of silence in the middle
+    size_t silent = 0;
+    size_t longest = 0;
+    for (size_t i = 0; i < pcm.size(); i++) {
+        silent = pcm[i] == 0 ? silent + 1 : 0;
+        longest = std::max(longest, silent);
+    }
+    EXPECT_GE(longest, SAMPLE_RATE / NOTE_A4);
+}
+
+TEST_F(AudioSynth, LoopingSongsKeepPlaying) {
+    start_render(FIXED_TICK_US, 1);
+    synth_play_notes(&startup_song, sizeof(startup_song) / sizeof(startup_song[0]), true);
+    EXPECT_TRUE(render_ms(2000));
+    EXPECT_TRUE(synth_is_playing_notes());
+}
+
+TEST_F(AudioSynth, GlideFollowsTheFloatFormula) {
+    const synth_freq_t high = SYNTH_FREQ(20000);
+    for (double hz = 30.52; hz < 8000; hz *= 1.1) {
+        double expected = hz * pow(2, 440 / hz / 12 / 2);
+        double up = synth_glide(SYNTH_FREQ(hz), high) / 256.0;
+        EXPECT_NEAR(up, expected, expected * 0.01) << hz << "Hz";
+        if (hz > 100) {
+            EXPECT_NEAR(up, expected, 0.05) << hz << "Hz";
+        }
+        // Closer to the target than one step, it snaps to the target
+        if (hz > 40) {
+            expected = hz * pow(2, -440 / hz / 12 / 2);
+            double down = synth_glide(SYNTH_FREQ(hz), SYNTH_FREQ(20)) / 256.0;
+            EXPECT_NEAR(down, expected, expected * 0.01) << hz << "Hz";
+        }
+    }
+}
+
+TEST_F(AudioSynth, GlideReachesTheTarget) {
+    const synth_freq_t targets[] = {SYNTH_FREQ(NOTE_C3), SYNTH_FREQ(NOTE_A4), SYNTH_FREQ(NOTE_C8)};
+    for (synth_freq_t from : targets) {
+        for (synth_freq_t to : targets) {
+            synth_freq_t freq = from;
+            int ticks = 0;
+            while (freq != to && ticks < 10000) {
+                synth_freq_t next = synth_glide(freq, to);
+                // Never overshoots
+                EXPECT_EQ(next > freq, to > freq);
+                freq = next;
+                ticks++;
+            }
+            EXPECT_EQ(freq, to);
+        }
+    }
+}
+
+TEST_F(AudioSynth, VibratoMatchesTheFloatTable) {
+    // The peaks of the original float table
+    EXPECT_NEAR(synth_vibrato_apply(SYNTH_FREQ(440), 4, 256) / 256.0, 440 * 1.0072464122237, 0.01);
+    EXPECT_NEAR(synth_vibrato_apply(SYNTH_FREQ(440), 9, 256) / 256.0, 440, 0.01);
+    EXPECT_NEAR(synth_vibrato_apply(SYNTH_FREQ(440), 14, 256) / 256.0, 440 * 0.9928057204913, 0.01);
+    // pow(x, 0.5) is close to 1 + (x - 1) / 2 for small deviations
+    EXPECT_NEAR(synth_vibrato_apply(SYNTH_FREQ(440), 4, 128) / 256.0, 440 * pow(1.0072464122237, 0.5), 0.01);
+}
+
+TEST_F(AudioSynth, TimerPeriodsMatchTheFloatFormula) {
+    const uint32_t clock = 16000000 / 8;
+    for (double hz = 30.52; hz < 8000; hz *= 1.1) {
+        synth_freq_t freq = SYNTH_FREQ(hz);
+        EXPECT_NEAR(synth_period(freq, clock), clock / hz, clock / hz * 0.001 + 1) << hz << "Hz";
+    }
+    EXPECT_EQ(synth_duty(synth_period(SYNTH_FREQ(440), clock), SYNTH_TIMBRE(TIMBRE_50)), 4545 / 2);
+}
+
+TEST_F(AudioSynth, StoppingAnUnknownNoteKeepsTheOthers) {
+    synth_note_on(SYNTH_FREQ(NOTE_A4));
+    synth_note_on(SYNTH_FREQ(NOTE_C5));
+    EXPECT_EQ(synth_note_off(SYNTH_FREQ(NOTE_E5)), 2);
+    EXPECT_EQ(synth_note_off(SYNTH_FREQ(NOTE_A4)), 1);
+    EXPECT_TRUE(synth_is_playing_note());
+    EXPECT_EQ(synth_note_off(SYNTH_FREQ(NOTE_C5)), 0);
+    EXPECT_FALSE(synth_is_playing_note());
+}
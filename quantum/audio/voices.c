@@ -14,15 +14,9 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 #include "voices.h"
-#include "audio.h"
+#include "musical_notes.h"
 #include "stdlib.h"
 
-// these are imported from audio.c
-extern uint16_t envelope_index;
-extern float note_timbre;
-extern float polyphony_rate;
-extern bool glissando;
-
 voice_type voice = default_voice;
 
 void set_voice(voice_type v) {
@@ -37,15 +31,15 @@ void voice_deiterate() {
     voice = (voice - 1 + number_of_voices) % number_of_voices;
 }
 
-float voice_envelope(float frequency) {
+synth_freq_t voice_envelope(synth_freq_t frequency) {
     // envelope_index ranges from 0 to 0xFFFF, which is preserved at 880.0 Hz
     __attribute__ ((unused))
-    uint16_t compensated_index = (uint16_t)((float)envelope_index * (880.0 / frequency));
+    uint16_t compensated_index = SYNTH_HZ(frequency) ? (uint16_t)((uint32_t)envelope_index * 880 / SYNTH_HZ(frequency)) : 0;
 
     switch (voice) {
         case default_voice:
             glissando = false;
-            note_timbre = TIMBRE_50;
+            note_timbre = SYNTH_TIMBRE(TIMBRE_50);
             polyphony_rate = 0;
 	        break;
 
@@ -56,19 +50,19 @@ float voice_envelope(float frequency) {
             polyphony_rate = 0;
             switch (compensated_index) {
                 case 0 ... 9:
-                    note_timbre = TIMBRE_12;
+                    note_timbre = SYNTH_TIMBRE(TIMBRE_12);
                     break;
 
                 case 10 ... 19:
-                    note_timbre = TIMBRE_25;
+                    note_timbre = SYNTH_TIMBRE(TIMBRE_25);
                     break;
 
                 case 20 ... 200:
-                    note_timbre = .125 + .125;
+                    note_timbre = SYNTH_TIMBRE(.125 + .125);
                     break;
 
                 default:
-                    note_timbre = .125;
+                    note_timbre = SYNTH_TIMBRE(.125);
                     break;
             }
             break;
@@ -89,67 +83,67 @@ float voice_envelope(float frequency) {
                 // }
                 // frequency = (rand() % (int)(frequency * 1.2 - frequency)) + (frequency * 0.8);
 
-            if (frequency < 80.0) {
+            if (frequency < SYNTH_FREQ(80)) {
 
-            } else if (frequency < 160.0) {
+            } else if (frequency < SYNTH_FREQ(160)) {
 
                 // Bass drum: 60 - 100 Hz
-                frequency = (rand() % (int)(40)) + 60;
+                frequency = (synth_freq_t)((rand() % 40) + 60) << SYNTH_FREQ_SHIFT;
                 switch (envelope_index) {
                     case 0 ... 10:
-                        note_timbre = 0.5;
+                        note_timbre = SYNTH_TIMBRE(0.5);
                         break;
                     case 11 ... 20:
-                        note_timbre = 0.5 * (21 - envelope_index) / 10;
+                        note_timbre = SYNTH_TIMBRE(0.5) * (21 - envelope_index) / 10;
                         break;
                     default:
                         note_timbre = 0;
                         break;
                 }
 
-            } else if (frequency < 320.0) {
+            } else if (frequency < SYNTH_FREQ(320)) {
 
 
                 // Snare drum: 1 - 2 KHz
-                frequency = (rand() % (int)(1000)) + 1000;
+                frequency = (synth_freq_t)((rand() % 1000) + 1000) << SYNTH_FREQ_SHIFT;
                 switch (envelope_index) {
                     case 0 ... 5:
-                        note_timbre = 0.5;
+                        note_timbre = SYNTH_TIMBRE(0.5);
                         break;
                     case 6 ... 20:
-                        note_timbre = 0.5 * (21 - envelope_index) / 15;
+                        note_timbre = SYNTH_TIMBRE(0.5) * (21 - envelope_index) / 15;
                         break;
                     default:
                         note_timbre = 0;
                         break;
                 }
 
-            } else if (frequency < 640.0) {
+            } else if (frequency < SYNTH_FREQ(640)) {
 
                 // Closed Hi-hat: 3 - 5 KHz
-                frequency = (rand() % (int)(2000)) + 3000;
+                frequency = (synth_freq_t)((rand() % 2000) + 3000) << SYNTH_FREQ_SHIFT;
                 switch (envelope_index) {
                     case 0 ... 15:
-                        note_timbre = 0.5;
+                        note_timbre = SYNTH_TIMBRE(0.5);
                         break;
                     case 16 ... 20:
-                        note_timbre = 0.5 * (21 - envelope_index) / 5;
+                        note_timbre = SYNTH_TIMBRE(0.5) * (21 - envelope_index) / 5;
                         break;
                     default:
                         note_timbre = 0;
                         break;
                 }
 
-            } else if (frequency < 1280.0) {
+            } else if (frequency < SYNTH_FREQ(1280)) {
 
                 // Open Hi-hat: 3 - 5 KHz
-                frequency = (rand() % (int)(2000)) + 3000;
+                frequency = (synth_freq_t)((rand() % 2000) + 3000) << SYNTH_FREQ_SHIFT;
                 switch (envelope_index) {
                     case 0 ... 35:
-                        note_timbre = 0.5;
+                        note_timbre = SYNTH_TIMBRE(0.5);
                         break;
                     case 36 ... 50:
-                        note_timbre = 0.5 * (51 - envelope_index) / 15;
+                        note_timbre = SYNTH_TIMBRE(0.5) * (51 - envelope_index) / 15;
                         break;
                     default:
                         note_timbre = 0;
@@ -164,16 +158,18 @@ float voice_envelope(float frequency) {
             switch (compensated_index) {
                 case 0 ... 9:
                     frequency = frequency / 4;
-                    note_timbre = TIMBRE_12;
+                    note_timbre = SYNTH_TIMBRE(TIMBRE_12);
 	                break;
 
                 case 10 ... 19:
                     frequency = frequency / 2;
-                    note_timbre = TIMBRE_12;
+                    note_timbre = SYNTH_TIMBRE(TIMBRE_12);
 	                break;
 
                 case 20 ... 200:
-                    note_timbre = .125 - pow(((float)compensated_index - 20) / (200 - 20), 2)*.125;
+                    // A quadratic fade out from TIMBRE_12
+                    note_timbre = SYNTH_TIMBRE(TIMBRE_12) - SYNTH_TIMBRE(TIMBRE_12) *
+                        (uint32_t)(compensated_index - 20) * (compensated_index - 20) / ((200 - 20) * (200 - 20));
 	                break;
 
                 default:
@@ -212,11 +208,11 @@ float voice_envelope(float frequency) {
             switch (compensated_index) {
                 default:
                     #define OCS_SPEED 10
-                    #define OCS_AMP   .25
+                    #define OCS_AMP   SYNTH_TIMBRE(.25)
                     // sine wave is slow
                     // note_timbre = (sin((float)compensated_index/10000*OCS_SPEED) * OCS_AMP / 2) + .5;
                     // triangle wave is a bit faster
-                    note_timbre = (float)abs((compensated_index*OCS_SPEED % 3000) - 1500) * ( OCS_AMP / 1500 ) + (1 - OCS_AMP) / 2;
+                    note_timbre = (uint32_t)abs((int32_t)((uint32_t)compensated_index*OCS_SPEED % 3000) - 1500) * OCS_AMP / 1500 + (256 - OCS_AMP) / 2;
                 	break;
             }
 	        break;
@@ -224,23 +220,24 @@ float voice_envelope(float frequency) {
         case duty_octave_down:
             glissando = true;
             polyphony_rate = 0;
-            note_timbre = (envelope_index % 2) * .125 + .375 * 2;
+            note_timbre = (envelope_index % 2) * SYNTH_TIMBRE(.125) + SYNTH_TIMBRE(.375 * 2);
             if ((envelope_index % 4) == 0)
-                note_timbre = 0.5;
+                note_timbre = SYNTH_TIMBRE(0.5);
             if ((envelope_index % 8) == 0)
                 note_timbre = 0;
             break;
         case delayed_vibrato:
             glissando = true;
             polyphony_rate = 0;
-            note_timbre = TIMBRE_50;
+            note_timbre = SYNTH_TIMBRE(TIMBRE_50);
             #define VOICE_VIBRATO_DELAY 150
             #define VOICE_VIBRATO_SPEED 50
             switch (compensated_index) {
                 case 0 ... VOICE_VIBRATO_DELAY:
                     break;
                 default:
-                    frequency = frequency * vibrato_lut[(int)fmod((((float)compensated_index - (VOICE_VIBRATO_DELAY + 1))/1000*VOICE_VIBRATO_SPEED), VIBRATO_LUT_LENGTH)];
+                    frequency = synth_vibrato_apply(frequency,
+                        ((uint32_t)(compensated_index - (VOICE_VIBRATO_DELAY + 1)) * VOICE_VIBRATO_SPEED / 1000) % VIBRATO_LUT_LENGTH, 256);
                     break;
             }
             break;
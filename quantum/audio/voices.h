@@ -20,11 +20,12 @@
 #endif
 #include "wait.h"
 #include "luts.h"
+#include "synth.h"
 
 #ifndef VOICES_H
 #define VOICES_H
 
-float voice_envelope(float frequency);
+synth_freq_t voice_envelope(synth_freq_t frequency);
 
 typedef enum {
     default_voice,
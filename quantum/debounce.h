@@ -0,0 +1,84 @@
+/* Copyright 2026 QMK Firmware contributors
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef DEBOUNCE_H
+#define DEBOUNCE_H
+
+#include <stdint.h>
+#include "matrix.h"
+
+/* Per key debouncing for custom matrix.c files
+ *
+ * Each key has a counter, that is set to DEBOUNCE when the key changes, and
+ * counts down once per scan. A key can't change again until its counter
+ * reaches zero. The counters of a row are stored as bit planes, bit j of
+ * planes[k] is bit k of the counter of column j, so that a whole row is
+ * counted down with a few word operations, instead of a loop over the
+ * columns.
+ *
+ *     static debounce_row_t debounce[MATRIX_ROWS];
+ *
+ *     matrix[row] = debounce_row(&debounce[row], matrix[row], read_cols(row));
+ *
+ * DEBOUNCE is measured in scans, and is at most 255.
+ */
+
+#ifndef DEBOUNCE
+#   define DEBOUNCE 5
+#endif
+
+#if DEBOUNCE < 1 || DEBOUNCE > 255
+#   error "DEBOUNCE has to be between 1 and 255"
+#endif
+
+#define DEBOUNCE_PLANES \
+    (DEBOUNCE < 2 ? 1 : DEBOUNCE < 4 ? 2 : DEBOUNCE < 8 ? 3 : DEBOUNCE < 16 ? 4 : \
+     DEBOUNCE < 32 ? 5 : DEBOUNCE < 64 ? 6 : DEBOUNCE < 128 ? 7 : 8)
+
+typedef struct {
+    matrix_row_t planes[DEBOUNCE_PLANES];
+} debounce_row_t;
+
+// Returns the new debounced state of a row, from the previous one and the
+// columns that were just read
+static inline matrix_row_t debounce_row(debounce_row_t* counters, matrix_row_t debounced, matrix_row_t raw) {
+    matrix_row_t busy = 0;
+    for (uint8_t k = 0; k < DEBOUNCE_PLANES; k++) {
+        busy |= counters->planes[k];
+    }
+
+    // Count down the busy counters, the borrow ripples up through the
+    // planes as long as the lower bits are zero
+    matrix_row_t borrow = busy;
+    for (uint8_t k = 0; k < DEBOUNCE_PLANES; k++) {
+        matrix_row_t plane = counters->planes[k];
+        counters->planes[k] = plane ^ borrow;
+        borrow &= ~plane;
+    }
+
+    matrix_row_t cols = (raw & ~busy) | (debounced & busy);
+    // Only keys with a zero counter can change, so setting the counter
+    // only needs to set bits
+    matrix_row_t changed = cols ^ debounced;
+    for (uint8_t k = 0; k < DEBOUNCE_PLANES; k++) {
+        if (DEBOUNCE & (1 << k)) {
+            counters->planes[k] |= changed;
+        }
+    }
+    return cols;
+}
+
+#endif
@@ -0,0 +1,206 @@
+/* Copyright 2026 QMK Firmware contributors
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "dynamic_keymap.h"
+#include "keymap.h"
+#include "eeprom.h"
+#include "progmem.h"
+#ifdef RAW_ENABLE
+#include "raw_hid.h"
+#endif
+
+/* EEPROM layout
+ *
+ * magic number (2 bytes), layer count, rows, cols, followed by the keycodes
+ * in the same order as the keymaps array. The header makes sure that a keymap
+ * saved by a firmware with a different layout is not loaded.
+ */
+#define EEPROM_MAGIC ((uint16_t*)(DYNAMIC_KEYMAP_EEPROM_ADDR))
+#define EEPROM_LAYERS ((uint8_t*)(DYNAMIC_KEYMAP_EEPROM_ADDR + 2))
+#define EEPROM_ROWS ((uint8_t*)(DYNAMIC_KEYMAP_EEPROM_ADDR + 3))
+#define EEPROM_COLS ((uint8_t*)(DYNAMIC_KEYMAP_EEPROM_ADDR + 4))
+#define EEPROM_HEADER_SIZE 5
+#define EEPROM_KEYMAP ((uint8_t*)(DYNAMIC_KEYMAP_EEPROM_ADDR + EEPROM_HEADER_SIZE))
+
+#if defined(E2END) && DYNAMIC_KEYMAP_EEPROM_ADDR + EEPROM_HEADER_SIZE + DYNAMIC_KEYMAP_LAYER_COUNT * DYNAMIC_KEYMAP_LAYER_SIZE > E2END + 1
+#error "The dynamic keymap doesn't fit the EEPROM, reduce DYNAMIC_KEYMAP_LAYER_COUNT"
+#endif
+
+static uint16_t dynamic_keymap[DYNAMIC_KEYMAP_LAYER_COUNT][MATRIX_ROWS][MATRIX_COLS];
+
+static uint8_t* eeprom_key_address(uint8_t layer, uint16_t offset) {
+    return EEPROM_KEYMAP + layer * DYNAMIC_KEYMAP_LAYER_SIZE + offset;
+}
+
+static bool eeprom_is_valid(void) {
+    return eeprom_read_word(EEPROM_MAGIC) == DYNAMIC_KEYMAP_MAGIC_NUMBER &&
+        eeprom_read_byte(EEPROM_LAYERS) == DYNAMIC_KEYMAP_LAYER_COUNT &&
+        eeprom_read_byte(EEPROM_ROWS) == MATRIX_ROWS &&
+        eeprom_read_byte(EEPROM_COLS) == MATRIX_COLS;
+}
+
+void dynamic_keymap_reset(void) {
+    for (uint8_t layer = 0; layer < DYNAMIC_KEYMAP_LAYER_COUNT; layer++) {
+        for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+            for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+                dynamic_keymap[layer][row][col] = pgm_read_word(&keymaps[layer][row][col]);
+            }
+        }
+        eeprom_update_block(dynamic_keymap[layer], eeprom_key_address(layer, 0), DYNAMIC_KEYMAP_LAYER_SIZE);
+    }
+    eeprom_update_byte(EEPROM_LAYERS, DYNAMIC_KEYMAP_LAYER_COUNT);
+    eeprom_update_byte(EEPROM_ROWS, MATRIX_ROWS);
+    eeprom_update_byte(EEPROM_COLS, MATRIX_COLS);
+    // Written last, so that an interrupted reset is detected on the next boot
+    eeprom_update_word(EEPROM_MAGIC, DYNAMIC_KEYMAP_MAGIC_NUMBER);
+}
+
+void dynamic_keymap_init(void) {
+    if (!eeprom_is_valid()) {
+        dynamic_keymap_reset();
+        return;
+    }
+    for (uint8_t layer = 0; layer < DYNAMIC_KEYMAP_LAYER_COUNT; layer++) {
+        eeprom_read_block(dynamic_keymap[layer], eeprom_key_address(layer, 0), DYNAMIC_KEYMAP_LAYER_SIZE);
+    }
+}
+
+uint16_t dynamic_keymap_get_keycode(uint8_t layer, uint8_t row, uint8_t col) {
+    return dynamic_keymap[layer][row][col];
+}
+
+void dynamic_keymap_set_keycode(uint8_t layer, uint8_t row, uint8_t col, uint16_t keycode) {
+    dynamic_keymap[layer][row][col] = keycode;
+    uint16_t offset = (row * MATRIX_COLS + col) * 2;
+    eeprom_update_word((uint16_t*)eeprom_key_address(layer, offset), keycode);
+}
+
+// The buffers use the in memory representation, which is little endian on
+// all supported platforms, just like the EEPROM
+static bool buffer_is_valid(uint8_t layer, uint16_t offset, uint8_t size) {
+    return layer < DYNAMIC_KEYMAP_LAYER_COUNT && offset <= DYNAMIC_KEYMAP_LAYER_SIZE &&
+        size <= DYNAMIC_KEYMAP_LAYER_SIZE - offset;
+}
+
+bool dynamic_keymap_get_buffer(uint8_t layer, uint16_t offset, uint8_t size, uint8_t* data) {
+    if (!buffer_is_valid(layer, offset, size)) {
+        return false;
+    }
+    const uint8_t* source = (const uint8_t*)dynamic_keymap[layer] + offset;
+    for (uint8_t i = 0; i < size; i++) {
+        data[i] = source[i];
+    }
+    return true;
+}
+
+bool dynamic_keymap_set_buffer(uint8_t layer, uint16_t offset, uint8_t size, const uint8_t* data) {
+    if (!buffer_is_valid(layer, offset, size)) {
+        return false;
+    }
+    uint8_t* target = (uint8_t*)dynamic_keymap[layer] + offset;
+    for (uint8_t i = 0; i < size; i++) {
+        target[i] = data[i];
+    }
+    eeprom_update_block(target, eeprom_key_address(layer, offset), size);
+    return true;
+}
+
+uint16_t keymap_key_to_keycode(uint8_t layer, keypos_t key) {
+    // The layers above the dynamic ones can't be remapped
+    if (layer >= DYNAMIC_KEYMAP_LAYER_COUNT) {
+        return pgm_read_word(&keymaps[layer][key.row][key.col]);
+    }
+    return dynamic_keymap[layer][key.row][key.col];
+}
+
+static bool key_is_valid(uint8_t layer, uint8_t row, uint8_t col) {
+    return layer < DYNAMIC_KEYMAP_LAYER_COUNT && row < MATRIX_ROWS && col < MATRIX_COLS;
+}
+
+bool dynamic_keymap_process_command(uint8_t* data, uint8_t length) {
+    switch (data[0]) {
+        case DYNAMIC_KEYMAP_GET_INFO:
+            if (length < 4) {
+                break;
+            }
+            data[1] = DYNAMIC_KEYMAP_LAYER_COUNT;
+            data[2] = MATRIX_ROWS;
+            data[3] = MATRIX_COLS;
+            return true;
+        case DYNAMIC_KEYMAP_GET_KEYCODE: {
+            if (length < 6 || !key_is_valid(data[1], data[2], data[3])) {
+                break;
+            }
+            uint16_t keycode = dynamic_keymap_get_keycode(data[1], data[2], data[3]);
+            data[4] = keycode >> 8;
+            data[5] = keycode & 0xFF;
+            return true;
+        }
+        case DYNAMIC_KEYMAP_SET_KEYCODE:
+            if (length < 6 || !key_is_valid(data[1], data[2], data[3])) {
+                break;
+            }
+            dynamic_keymap_set_keycode(data[1], data[2], data[3], (data[4] << 8) | data[5]);
+            return true;
+        case DYNAMIC_KEYMAP_GET_BUFFER:
+            if (length < DYNAMIC_KEYMAP_BUFFER_HEADER ||
+                data[4] > length - DYNAMIC_KEYMAP_BUFFER_HEADER) {
+                break;
+            }
+            if (!dynamic_keymap_get_buffer(data[1], (data[2] << 8) | data[3], data[4],
+                    &data[DYNAMIC_KEYMAP_BUFFER_HEADER])) {
+                break;
+            }
+            return true;
+        case DYNAMIC_KEYMAP_SET_BUFFER:
+            if (length < DYNAMIC_KEYMAP_BUFFER_HEADER ||
+                data[4] > length - DYNAMIC_KEYMAP_BUFFER_HEADER) {
+                break;
+            }
+            if (!dynamic_keymap_set_buffer(data[1], (data[2] << 8) | data[3], data[4],
+                    &data[DYNAMIC_KEYMAP_BUFFER_HEADER])) {
+                break;
+            }
+            return true;
+        case DYNAMIC_KEYMAP_RESET:
+            dynamic_keymap_reset();
+            return true;
+        default:
+            return false;
+    }
+    data[0] = DYNAMIC_KEYMAP_ERROR;
+    return true;
+}
+
+// With RAW_STREAM_ENABLE the commands are dispatched by raw_hid_stream.c
+#if defined(RAW_ENABLE) && !defined(RAW_STREAM_ENABLE)
+__attribute__ ((weak))
+void raw_hid_receive_kb(uint8_t* data, uint8_t length) {
+    data[0] = DYNAMIC_KEYMAP_ERROR;
+    raw_hid_send(data, length);
+}
+
+void raw_hid_receive(uint8_t* data, uint8_t length) {
+    if (length == 0) {
+        return;
+    }
+    if (dynamic_keymap_process_command(data, length)) {
+        raw_hid_send(data, length);
+    } else {
+        raw_hid_receive_kb(data, length);
+    }
+}
+#endif
@@ -0,0 +1,83 @@
+/* Copyright 2026 QMK Firmware contributors
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef DYNAMIC_KEYMAP_H
+#define DYNAMIC_KEYMAP_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "keyboard.h"
+
+// The number of layers that can be remapped, the keymap.c needs to define at
+// least this many layers, since they are used as the defaults
+#ifndef DYNAMIC_KEYMAP_LAYER_COUNT
+#define DYNAMIC_KEYMAP_LAYER_COUNT 4
+#endif
+
+// The start of the keymap in the EEPROM, after the eeconfig settings
+#ifndef DYNAMIC_KEYMAP_EEPROM_ADDR
+#define DYNAMIC_KEYMAP_EEPROM_ADDR 32
+#endif
+
+#define DYNAMIC_KEYMAP_MAGIC_NUMBER 0x4B4D
+#define DYNAMIC_KEYMAP_LAYER_SIZE (MATRIX_ROWS * MATRIX_COLS * 2)
+
+/* Raw HID commands
+ *
+ * Every command is answered with a packet of the same length, which echoes
+ * the request with the results filled in. Keycodes and offsets are sent
+ * big endian. A request that can't be handled is answered with the command
+ * byte set to DYNAMIC_KEYMAP_ERROR.
+ *
+ * GET_INFO      [cmd] -> [cmd, layers, rows, cols]
+ * GET_KEYCODE   [cmd, layer, row, col] -> [cmd, layer, row, col, kc_hi, kc_lo]
+ * SET_KEYCODE   [cmd, layer, row, col, kc_hi, kc_lo]
+ * GET_BUFFER    [cmd, layer, offset_hi, offset_lo, size] -> [..., data]
+ * SET_BUFFER    [cmd, layer, offset_hi, offset_lo, size, data]
+ * RESET         [cmd]
+ *
+ * The buffer commands transfer the raw little endian keycodes of a layer,
+ * offset and size are in bytes and limited to the packet length.
+ */
+enum dynamic_keymap_command {
+    DYNAMIC_KEYMAP_GET_INFO = 0x01,
+    DYNAMIC_KEYMAP_GET_KEYCODE,
+    DYNAMIC_KEYMAP_SET_KEYCODE,
+    DYNAMIC_KEYMAP_GET_BUFFER,
+    DYNAMIC_KEYMAP_SET_BUFFER,
+    DYNAMIC_KEYMAP_RESET,
+    DYNAMIC_KEYMAP_ERROR = 0xFF,
+};
+
+#define DYNAMIC_KEYMAP_BUFFER_HEADER 5
+
+void dynamic_keymap_init(void);
+void dynamic_keymap_reset(void);
+uint16_t dynamic_keymap_get_keycode(uint8_t layer, uint8_t row, uint8_t col);
+void dynamic_keymap_set_keycode(uint8_t layer, uint8_t row, uint8_t col, uint16_t keycode);
+bool dynamic_keymap_get_buffer(uint8_t layer, uint16_t offset, uint8_t size, uint8_t* data);
+bool dynamic_keymap_set_buffer(uint8_t layer, uint16_t offset, uint8_t size, const uint8_t* data);
+
+// Handles the commands above, returns false if the command is unknown
+bool dynamic_keymap_process_command(uint8_t* data, uint8_t length);
+
+// Called for raw HID packets that aren't dynamic keymap commands, replies
+// with DYNAMIC_KEYMAP_ERROR by default. With RAW_STREAM_ENABLE the commands
+// can also be sent as longer messages, and raw_stream_command_kb() gets the
+// other ones instead
+void raw_hid_receive_kb(uint8_t* data, uint8_t length);
+
+#endif
@@ -171,6 +171,7 @@ void action_function(keyrecord_t *record, uint8_t id, uint8_t opt)
 {
 }
 
+#ifndef KEYMAP_COMPACT_ENABLE
 // translates key to keycode
 __attribute__ ((weak))
 uint16_t keymap_key_to_keycode(uint8_t layer, keypos_t key)
@@ -178,6 +179,7 @@ uint16_t keymap_key_to_keycode(uint8_t layer, keypos_t key)
     // Read entire word (16bits)
     return pgm_read_word(&keymaps[(layer)][(key.row)][(key.col)]);
 }
+#endif
 
 // translates function id to action
 __attribute__ ((weak))
@@ -0,0 +1,52 @@
+/* Copyright 2026 QMK Firmware contributors
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "keymap_compact.h"
+#include "keymap.h"
+
+// Generated from the keymap.c by quantum/tools/keymap_compact.c
+extern const uint16_t keymap_compact_num_cells PROGMEM;
+extern const uint16_t keymap_compact_bitmap[] PROGMEM;
+extern const uint16_t keymap_compact_base[] PROGMEM;
+extern const uint16_t keymap_compact_keycodes[] PROGMEM;
+
+#define LAYER_CELLS (MATRIX_ROWS * MATRIX_COLS)
+
+static bool get_cell(uint8_t layer, keypos_t key, uint16_t* cell) {
+    if (layer >= pgm_read_word(&keymap_compact_num_cells) / LAYER_CELLS) {
+        return false;
+    }
+    *cell = layer * LAYER_CELLS + key.row * MATRIX_COLS + key.col;
+    return true;
+}
+
+// The dense keymaps array is never referenced, so the linker drops it
+uint16_t keymap_key_to_keycode(uint8_t layer, keypos_t key)
+{
+    uint16_t cell;
+    if (!get_cell(layer, key, &cell)) {
+        return KC_TRNS;
+    }
+    return keymap_compact_read(keymap_compact_bitmap, keymap_compact_base, keymap_compact_keycodes, cell);
+}
+
+bool keymap_compact_has_key(uint8_t layer, keypos_t key) {
+    uint16_t cell;
+    if (!get_cell(layer, key, &cell)) {
+        return false;
+    }
+    return keymap_compact_is_set(keymap_compact_bitmap, cell);
+}
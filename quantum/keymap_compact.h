@@ -0,0 +1,78 @@
+/* Copyright 2026 QMK Firmware contributors
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef KEYMAP_COMPACT_H
+#define KEYMAP_COMPACT_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "progmem.h"
+
+/* Compacted keymap format
+ *
+ * The dense keymaps[layer][row][col] array is treated as a flat list of cells,
+ * cell = (layer * MATRIX_ROWS + row) * MATRIX_COLS + col. The cells are split
+ * into blocks of 16, and every block is stored as
+ *   bitmap[block] - bit n is set when cell block * 16 + n is not KC_TRNS
+ *   base[block]   - the number of non transparent cells in the blocks before
+ * The non transparent keycodes themselves are packed in cell order into
+ * keycodes[], so a lookup is a bitmap test followed by a popcount.
+ *
+ * The data is generated from the keymap.c at build time by
+ * quantum/tools/keymap_compact.c, see KEYMAP_COMPACT_ENABLE.
+ */
+
+#define KEYMAP_COMPACT_TRANSPARENT 1
+
+#define KEYMAP_COMPACT_BLOCKS(cells) (((cells) + 15) / 16)
+
+static inline uint8_t keymap_compact_popcount(uint16_t bits) {
+    uint8_t count = 0;
+    while (bits) {
+        bits &= bits - 1;
+        count++;
+    }
+    return count;
+}
+
+static inline bool keymap_compact_is_set(const uint16_t* bitmap, uint16_t cell) {
+    return pgm_read_word(&bitmap[cell / 16]) & (1u << (cell % 16));
+}
+
+static inline uint16_t keymap_compact_read(const uint16_t* bitmap, const uint16_t* base,
+        const uint16_t* keycodes, uint16_t cell) {
+    uint16_t bits = pgm_read_word(&bitmap[cell / 16]);
+    uint16_t mask = 1u << (cell % 16);
+    if (!(bits & mask)) {
+        return KEYMAP_COMPACT_TRANSPARENT;
+    }
+    uint16_t index = pgm_read_word(&base[cell / 16]) + keymap_compact_popcount(bits & (mask - 1));
+    return pgm_read_word(&keycodes[index]);
+}
+
+// Packs num_cells dense keycodes, bitmap and base need KEYMAP_COMPACT_BLOCKS(num_cells)
+// entries and keycodes up to num_cells. Returns the number of packed keycodes.
+uint16_t keymap_compact_pack(const uint16_t* dense, uint16_t num_cells,
+        uint16_t* bitmap, uint16_t* base, uint16_t* keycodes);
+
+#ifdef KEYMAP_COMPACT_ENABLE
+#include "keyboard.h"
+
+// Returns false if the key is transparent on the layer, without decoding it
+bool keymap_compact_has_key(uint8_t layer, keypos_t key);
+#endif
+
+#endif
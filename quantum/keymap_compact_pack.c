@@ -0,0 +1,36 @@
+/* Copyright 2026 QMK Firmware contributors
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "keymap_compact.h"
+
+// This is only used at build time and by the tests, the firmware itself
+// only contains the generated tables
+uint16_t keymap_compact_pack(const uint16_t* dense, uint16_t num_cells,
+        uint16_t* bitmap, uint16_t* base, uint16_t* keycodes) {
+    uint16_t count = 0;
+    for (uint16_t block = 0; block < KEYMAP_COMPACT_BLOCKS(num_cells); block++) {
+        bitmap[block] = 0;
+        base[block] = count;
+        for (uint8_t bit = 0; bit < 16; bit++) {
+            uint16_t cell = block * 16 + bit;
+            if (cell < num_cells && dense[cell] != KEYMAP_COMPACT_TRANSPARENT) {
+                bitmap[block] |= 1u << bit;
+                keycodes[count++] = dense[cell];
+            }
+        }
+    }
+    return count;
+}
@@ -18,6 +18,7 @@
 #include "eeprom.h"
 #include "keymap_steno.h"
 #include "virtser.h"
+#include "byte_queue.h"
 
 // TxBolt Codes
 #define TXB_NUL 0
@@ -61,6 +62,21 @@ uint8_t state[MAX_STATE_SIZE] = {0};
 uint8_t pressed = 0;
 steno_mode_t mode;
 
+// Set when keys have been pressed since the last chord was sent
+static bool chord_pending = false;
+static bool first_up = false;
+static bool repeat = false;
+static bool repeating = false;
+static uint16_t repeat_timer;
+
+/* The chords that are waiting to be sent
+ *
+ * The chords are only queued when they're complete, so that a full buffer
+ * drops whole chords instead of breaking the framing of the protocol.
+ */
+static uint8_t buffer_data[STENO_BUFFER_SIZE];
+static byte_queue_t buffer = BYTE_QUEUE_INITIALIZER(buffer_data);
+
 uint8_t boltmap[64] = {
   TXB_NUL, TXB_NUM, TXB_NUM, TXB_NUM, TXB_NUM, TXB_NUM, TXB_NUM,
   TXB_S_L, TXB_S_L, TXB_T_L, TXB_K_L, TXB_P_L, TXB_W_L, TXB_H_L,
@@ -87,13 +103,61 @@ void steno_set_mode(steno_mode_t new_mode) {
   eeprom_update_byte(EECONFIG_STENOMODE, mode);
 }
 
-void send_steno_state(uint8_t size, bool send_empty) {
-  for (uint8_t i = 0; i < size; ++i) {
-    if (state[i] || send_empty) {
-      virtser_send(state[i]);
+void steno_set_first_up(bool enable) {
+  first_up = enable;
+}
+
+void steno_set_repeat(bool enable) {
+  repeat = enable;
+}
+
+static void queue_chord(const uint8_t *packet, uint8_t size) {
+  if (size <= byte_queue_space(&buffer)) {
+    byte_queue_write(&buffer, packet, size);
+  }
+}
+
+static void send_chord(void) {
+  uint8_t packet[MAX_STATE_SIZE + 1];
+  uint8_t size = 0;
+  switch(mode) {
+    case STENO_MODE_BOLT:
+      for (uint8_t i = 0; i < BOLT_STATE_SIZE; ++i) {
+        if (state[i]) {
+          packet[size++] = state[i];
+        }
+      }
+      packet[size++] = 0; // terminating byte
+      break;
+    case STENO_MODE_GEMINI:
+      for (uint8_t i = 0; i < GEMINI_STATE_SIZE; ++i) {
+        packet[size++] = state[i];
+      }
+      packet[0] |= 0x80; // Indicate start of packet
+      break;
+    default:
+      return;
+  }
+  queue_chord(packet, size);
+}
+
+void steno_task(void) {
+  if (repeat && chord_pending && pressed > 0 &&
+      timer_elapsed(repeat_timer) >= (repeating ? STENO_REPEAT_INTERVAL : STENO_REPEAT_DELAY)) {
+    send_chord();
+    repeating = true;
+    repeat_timer = timer_read();
+  }
+  // Send as much as the endpoint takes, in at most two contiguous writes
+  const uint8_t *span;
+  uint8_t length;
+  while ((length = byte_queue_peek(&buffer, &span)) > 0) {
+    uint8_t written = virtser_write(span, length);
+    byte_queue_consume(&buffer, written);
+    if (written < length) {
+      break;
     }
   }
-  steno_clear_state();
 }
 
 bool update_state_bolt(uint8_t key) {
@@ -102,20 +166,19 @@ bool update_state_bolt(uint8_t key) {
   return false;
 }
 
-bool send_state_bolt(void) {
-  send_steno_state(BOLT_STATE_SIZE, false);
-  virtser_send(0); // terminating byte
-  return false;
-}
-
 bool update_state_gemini(uint8_t key) {
   state[key / 7] |= 1 << (6 - (key % 7));
   return false;
 }
 
-bool send_state_gemini(void) {
-  state[0] |= 0x80; // Indicate start of packet
-  send_steno_state(GEMINI_STATE_SIZE, true);
+// Sends the chord, unless it has been repeated while it was held
+static bool finish_chord(void) {
+  if (chord_pending && !repeating) {
+    send_chord();
+  }
+  chord_pending = false;
+  repeating = false;
+  steno_clear_state();
   return false;
 }
 
@@ -137,6 +200,9 @@ bool process_steno(uint16_t keycode, keyrecord_t *record) {
       if (IS_PRESSED(record->event)) {
         uint8_t key = keycode - QK_STENO;
         ++pressed;
+        chord_pending = true;
+        repeating = false;
+        repeat_timer = timer_read();
         switch(mode) {
           case STENO_MODE_BOLT:
             return update_state_bolt(key);
@@ -149,14 +215,10 @@ bool process_steno(uint16_t keycode, keyrecord_t *record) {
         --pressed;
         if (pressed <= 0) {
           pressed = 0;
-          switch(mode) {
-            case STENO_MODE_BOLT:
-              return send_state_bolt();
-            case STENO_MODE_GEMINI:
-              return send_state_gemini();
-            default:
-              return false;
-          }
+          return finish_chord();
+        }
+        if (first_up && chord_pending) {
+          return finish_chord();
         }
       }
 
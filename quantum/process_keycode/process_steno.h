@@ -22,10 +22,32 @@
   #error "must have virtser enabled to use steno"
 #endif
 
+// The number of bytes of complete chords that can wait to be sent
+#ifndef STENO_BUFFER_SIZE
+  #define STENO_BUFFER_SIZE 64
+#endif
+#if STENO_BUFFER_SIZE > 128 || (STENO_BUFFER_SIZE & (STENO_BUFFER_SIZE - 1))
+  #error "STENO_BUFFER_SIZE must be a power of two of at most 128"
+#endif
+
+// How long a chord has to be held before it repeats, and how often
+#ifndef STENO_REPEAT_DELAY
+  #define STENO_REPEAT_DELAY 500
+#endif
+#ifndef STENO_REPEAT_INTERVAL
+  #define STENO_REPEAT_INTERVAL 100
+#endif
+
 typedef enum { STENO_MODE_BOLT, STENO_MODE_GEMINI } steno_mode_t;
 
 bool process_steno(uint16_t keycode, keyrecord_t *record);
 void steno_init(void);
 void steno_set_mode(steno_mode_t mode);
+// Sends the chord when the first key is released, instead of the last
+void steno_set_first_up(bool enable);
+// Repeats a chord while it's held
+void steno_set_repeat(bool enable);
+// Writes the queued chords to the virtual serial port, without waiting
+void steno_task(void);
 
 #endif
\ No newline at end of file
@@ -15,11 +15,25 @@
  */
 #include "quantum.h"
 #include "action_tapping.h"
+#include <string.h>
 
 uint8_t get_oneshot_mods(void);
 
+#ifndef TAP_DANCE_MAX_ACTIVE
+#define TAP_DANCE_MAX_ACTIVE 8
+#endif
+
 static uint16_t last_td;
-static int8_t highest_td = -1;
+
+// The dances that have been tapped, and not reset yet, in the order they
+// were first tapped. All other dances are idle, so only these have to be
+// looked at when a key is pressed.
+static uint8_t active[TAP_DANCE_MAX_ACTIVE];
+static uint8_t active_count;
+// The active dances that haven't reached their tapping term yet, in the
+// order of their deadlines, so that the scan only has to check the first
+static uint8_t pending[TAP_DANCE_MAX_ACTIVE];
+static uint8_t pending_count;
 
 void qk_tap_dance_pair_on_each_tap (qk_tap_dance_state_t *state, void *user_data) {
   qk_tap_dance_pair_t *pair = (qk_tap_dance_pair_t *)user_data;
@@ -110,24 +124,65 @@ static inline void process_tap_dance_action_on_reset (qk_tap_dance_action_t *act
   send_keyboard_report();
 }
 
+static inline uint16_t tapping_term (qk_tap_dance_action_t *action)
+{
+  if (action->custom_tapping_term > 0) {
+    return action->custom_tapping_term;
+  }
+  return TAPPING_TERM;
+}
+
+static inline uint16_t deadline (uint8_t idx)
+{
+  qk_tap_dance_action_t *action = &tap_dance_actions[idx];
+  return action->state.timer + tapping_term (action);
+}
+
+static void remove_dance (uint8_t *set, uint8_t *count, uint8_t idx)
+{
+  for (uint8_t i = 0; i < *count; i++) {
+    if (set[i] == idx) {
+      (*count)--;
+      memmove (&set[i], &set[i + 1], *count - i);
+      return;
+    }
+  }
+}
+
+// (Re)schedules the expiry of a dance that was just tapped
+static void schedule_dance (uint8_t idx)
+{
+  remove_dance (pending, &pending_count, idx);
+  uint16_t due = deadline (idx);
+  uint8_t i = pending_count;
+  while (i > 0 && (int16_t)(deadline (pending[i - 1]) - due) > 0) {
+    pending[i] = pending[i - 1];
+    i--;
+  }
+  pending[i] = idx;
+  pending_count++;
+}
+
 void preprocess_tap_dance(uint16_t keycode, keyrecord_t *record) {
   qk_tap_dance_action_t *action;
 
   if (!record->event.pressed)
     return;
 
-  if (highest_td == -1)
-    return;
-
-  for (int i = 0; i <= highest_td; i++) {
-    action = &tap_dance_actions[i];
-    if (action->state.count) {
-      if (keycode == action->state.keycode && keycode == last_td)
-        continue;
+  // Resetting a dance removes it from the active set, so only move on when
+  // it's still there
+  uint8_t i = 0;
+  while (i < active_count) {
+    uint8_t idx = active[i];
+    action = &tap_dance_actions[idx];
+    if (action->state.count &&
+        !(keycode == action->state.keycode && keycode == last_td)) {
       action->state.interrupted = true;
       process_tap_dance_action_on_dance_finished (action);
       reset_tap_dance (&action->state);
     }
+    if (i < active_count && active[i] == idx)
+      i++;
   }
 }
 
@@ -137,10 +192,15 @@ bool process_tap_dance(uint16_t keycode, keyrecord_t *record) {
 
   switch(keycode) {
   case QK_TAP_DANCE ... QK_TAP_DANCE_MAX:
-    if ((int16_t)idx > highest_td)
-      highest_td = idx;
     action = &tap_dance_actions[idx];
 
+    if (record->event.pressed && !action->state.count) {
+      // Too many dances at once, this tap is ignored
+      if (active_count == TAP_DANCE_MAX_ACTIVE)
+        break;
+      active[active_count++] = idx;
+    }
+
     action->state.pressed = record->event.pressed;
     if (record->event.pressed) {
       action->state.keycode = keycode;
@@ -149,6 +209,7 @@ bool process_tap_dance(uint16_t keycode, keyrecord_t *record) {
       action->state.oneshot_mods = get_oneshot_mods();
       action->state.weak_mods = get_mods();
       action->state.weak_mods |= get_weak_mods();
+      schedule_dance (idx);
       process_tap_dance_action_on_each_tap (action);
 
       last_td = keycode;
@@ -167,22 +228,14 @@ bool process_tap_dance(uint16_t keycode, keyrecord_t *record) {
 
 
 void matrix_scan_tap_dance () {
-  if (highest_td == -1)
-    return;
-  uint16_t tap_user_defined;
-
-  for (uint8_t i = 0; i <= highest_td; i++) {
-    qk_tap_dance_action_t *action = &tap_dance_actions[i];
-    if(action->custom_tapping_term > 0 ) {
-      tap_user_defined = action->custom_tapping_term;
-    }
-    else{
-      tap_user_defined = TAPPING_TERM;
-    }
-    if (action->state.count && timer_elapsed (action->state.timer) > tap_user_defined) {
-      process_tap_dance_action_on_dance_finished (action);
-      reset_tap_dance (&action->state);
-    }
+  while (pending_count) {
+    qk_tap_dance_action_t *action = &tap_dance_actions[pending[0]];
+    if (timer_elapsed (action->state.timer) <= tapping_term (action))
+      return;
+    // A dance that is still held is reset when it's released
+    remove_dance (pending, &pending_count, pending[0]);
+    process_tap_dance_action_on_dance_finished (action);
+    reset_tap_dance (&action->state);
   }
 }
 
@@ -200,4 +253,8 @@ void reset_tap_dance (qk_tap_dance_state_t *state) {
   state->interrupted = false;
   state->finished = false;
   last_td = 0;
+
+  uint8_t idx = state->keycode - QK_TAP_DANCE;
+  remove_dance (active, &active_count, idx);
+  remove_dance (pending, &pending_count, idx);
 }
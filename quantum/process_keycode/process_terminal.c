@@ -14,6 +14,9 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+// The songs are stored packed in PROGMEM, see musical_notes.h
+#define PACKED_SONGS
+
 #include "process_terminal.h"
 #include <string.h>
 #include "version.h"
@@ -32,7 +35,7 @@ const char terminal_prompt[8] = "> ";
     #ifndef TERMINAL_SONG
         #define TERMINAL_SONG SONG(TERMINAL_SOUND)
     #endif
-    float terminal_song[][2] = TERMINAL_SONG;
+    const song_note_t terminal_song[] PROGMEM = TERMINAL_SONG;
     #define TERMINAL_BELL() PLAY_SONG(terminal_song)
 #else 
     #define TERMINAL_BELL()  
@@ -93,8 +96,6 @@ void terminal_about(void) {
 
 void terminal_help(void);
 
-extern const uint16_t keymaps[][MATRIX_ROWS][MATRIX_COLS];
-
 void terminal_keycode(void) {
     if (strlen(arguments[1]) != 0 && strlen(arguments[2]) != 0 && strlen(arguments[3]) != 0) {
         char keycode_dec[5];
@@ -102,7 +103,7 @@ void terminal_keycode(void) {
         uint16_t layer = strtol(arguments[1], (char **)NULL, 10);
         uint16_t row = strtol(arguments[2], (char **)NULL, 10);
         uint16_t col = strtol(arguments[3], (char **)NULL, 10);
-        uint16_t keycode = pgm_read_word(&keymaps[layer][row][col]);
+        uint16_t keycode = keymap_key_to_keycode(layer, (keypos_t){ .row = row, .col = col });
         itoa(keycode, keycode_dec, 10);
         itoa(keycode, keycode_hex, 16);
         SEND_STRING("0x");
@@ -122,7 +123,7 @@ void terminal_keymap(void) {
         uint16_t layer = strtol(arguments[1], (char **)NULL, 10);
         for (int r = 0; r < MATRIX_ROWS; r++) {
             for (int c = 0; c < MATRIX_COLS; c++) {
-                uint16_t keycode = pgm_read_word(&keymaps[layer][r][c]);
+                uint16_t keycode = keymap_key_to_keycode(layer, (keypos_t){ .row = r, .col = c });
                 char keycode_s[8];
                 sprintf(keycode_s, "0x%04x, ", keycode);
                 send_string(keycode_s);
@@ -18,10 +18,17 @@
 
 qk_ucis_state_t qk_ucis_state;
 
+static ucis_index_t ucis_index;
+
 void qk_ucis_start(void) {
   qk_ucis_state.count = 0;
   qk_ucis_state.in_progress = true;
 
+  if (!ucis_index.table) {
+    ucis_index_init(&ucis_index, ucis_symbol_table);
+  }
+  ucis_index_reset(&ucis_index);
+
   qk_ucis_start_user();
 }
 
@@ -32,22 +39,35 @@ void qk_ucis_start_user(void) {
   unicode_input_finish();
 }
 
-static bool is_uni_seq(char *seq) {
-  uint8_t i;
+static char ucis_char(uint16_t keycode) {
+  switch (keycode) {
+  case KC_A ... KC_Z:
+    return keycode - KC_A + 'a';
+  case KC_1 ... KC_9:
+    return keycode - KC_1 + '1';
+  case KC_0:
+    return '0';
+  }
+  return 0;
+}
 
-  for (i = 0; seq[i]; i++) {
-    uint16_t code;
-    if (('1' <= seq[i]) && (seq[i] <= '0'))
-      code = seq[i] - '1' + KC_1;
-    else
-      code = seq[i] - 'a' + KC_A;
+__attribute__((weak))
+void qk_ucis_no_match_user(void) {}
 
-    if (i > qk_ucis_state.count || qk_ucis_state.codes[i] != code)
-      return false;
+static void ucis_narrow(uint16_t keycode) {
+  bool had_candidates = ucis_index.first != ucis_index.last;
+  if (!ucis_index_narrow(&ucis_index, ucis_char(keycode)) && had_candidates) {
+    qk_ucis_no_match_user();
   }
+}
 
-  return (qk_ucis_state.codes[i] == KC_ENT ||
-          qk_ucis_state.codes[i] == KC_SPC);
+// Backspace can't be undone in the index, so the remaining input is
+// narrowed again from the start
+static void ucis_renarrow(void) {
+  ucis_index_reset(&ucis_index);
+  for (uint8_t i = 0; i < qk_ucis_state.count; i++) {
+    ucis_index_narrow(&ucis_index, ucis_char(qk_ucis_state.codes[i]));
+  }
 }
 
 __attribute__((weak))
@@ -108,6 +128,7 @@ bool process_ucis (uint16_t keycode, keyrecord_t *record) {
   if (keycode == KC_BSPC) {
     if (qk_ucis_state.count >= 2) {
       qk_ucis_state.count -= 2;
+      ucis_renarrow();
       return true;
     } else {
       qk_ucis_state.count--;
@@ -116,8 +137,6 @@ bool process_ucis (uint16_t keycode, keyrecord_t *record) {
   }
 
   if (keycode == KC_ENT || keycode == KC_SPC || keycode == KC_ESC) {
-    bool symbol_found = false;
-
     for (i = qk_ucis_state.count; i > 0; i--) {
       register_code (KC_BSPC);
       unregister_code (KC_BSPC);
@@ -129,15 +148,11 @@ bool process_ucis (uint16_t keycode, keyrecord_t *record) {
       return false;
     }
 
+    const qk_ucis_symbol_t *symbol = ucis_index_find(&ucis_index);
     unicode_input_start();
-    for (i = 0; ucis_symbol_table[i].symbol; i++) {
-      if (is_uni_seq (ucis_symbol_table[i].symbol)) {
-        symbol_found = true;
-        register_ucis(ucis_symbol_table[i].code + 2);
-        break;
-      }
-    }
-    if (!symbol_found) {
+    if (symbol) {
+      register_ucis(symbol->code + 2);
+    } else {
       qk_ucis_symbol_fallback();
     }
     unicode_input_finish();
@@ -145,5 +160,7 @@ bool process_ucis (uint16_t keycode, keyrecord_t *record) {
     qk_ucis_state.in_progress = false;
     return false;
   }
+
+  ucis_narrow(keycode);
   return true;
 }
@@ -19,16 +19,12 @@
 
 #include "quantum.h"
 #include "process_unicode_common.h"
+#include "process_ucis_index.h"
 
 #ifndef UCIS_MAX_SYMBOL_LENGTH
 #define UCIS_MAX_SYMBOL_LENGTH 32
 #endif
 
-typedef struct {
-  char *symbol;
-  char *code;
-} qk_ucis_symbol_t;
-
 typedef struct {
   uint8_t count;
   uint16_t codes[UCIS_MAX_SYMBOL_LENGTH];
@@ -40,11 +36,14 @@ extern qk_ucis_state_t qk_ucis_state;
 #define UCIS_TABLE(...) {__VA_ARGS__, {NULL, NULL}}
 #define UCIS_SYM(name, code) {name, #code}
 
+// Keep the table sorted by symbol, so that it can be searched quickly
 extern const qk_ucis_symbol_t ucis_symbol_table[];
 
 void qk_ucis_start(void);
 void qk_ucis_start_user(void);
 void qk_ucis_symbol_fallback (void);
+// Called as soon as the typed characters can't be the start of any symbol
+void qk_ucis_no_match_user (void);
 void register_ucis(const char *hex);
 bool process_ucis (uint16_t keycode, keyrecord_t *record);
 
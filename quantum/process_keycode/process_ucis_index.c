@@ -0,0 +1,99 @@
+/* Copyright 2026 QMK Firmware contributors
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "process_ucis_index.h"
+#include <string.h>
+
+// The next character of symbol i, which has to start with the characters
+// typed so far
+static inline uint8_t symbol_char(const ucis_index_t *index, uint16_t i) {
+  return index->table[i].symbol[index->length];
+}
+
+// Whether symbol i starts with the characters typed so far, which are the
+// same as the first characters of the first candidate
+static inline bool has_prefix(const ucis_index_t *index, uint16_t i) {
+  return strncmp(index->table[i].symbol, index->table[index->first].symbol, index->length) == 0;
+}
+
+void ucis_index_init(ucis_index_t *index, const qk_ucis_symbol_t *table) {
+  index->table = table;
+  index->size = 0;
+  index->sorted = true;
+  for (uint16_t i = 0; table[i].symbol; i++) {
+    if (i > 0 && strcmp(table[i - 1].symbol, table[i].symbol) > 0) {
+      index->sorted = false;
+    }
+    index->size++;
+  }
+  ucis_index_reset(index);
+}
+
+void ucis_index_reset(ucis_index_t *index) {
+  index->first = 0;
+  index->last = index->size;
+  index->length = 0;
+}
+
+bool ucis_index_narrow(ucis_index_t *index, char c) {
+  uint8_t ch = c;
+  uint16_t first = index->first;
+  uint16_t last = index->last;
+
+  if (first == last || ch == 0) {
+    index->first = index->last;
+  } else if (index->sorted) {
+    // The candidates are sorted by their next character
+    uint16_t lo = first, hi = last;
+    while (lo < hi) {
+      uint16_t mid = lo + (hi - lo) / 2;
+      if (symbol_char(index, mid) < ch) lo = mid + 1; else hi = mid;
+    }
+    first = lo;
+    hi = last;
+    while (lo < hi) {
+      uint16_t mid = lo + (hi - lo) / 2;
+      if (symbol_char(index, mid) <= ch) lo = mid + 1; else hi = mid;
+    }
+    index->first = first;
+    index->last = lo;
+  } else {
+    uint16_t new_first = last;
+    uint16_t new_last = last;
+    for (uint16_t i = first; i < last; i++) {
+      if (has_prefix(index, i) && symbol_char(index, i) == ch) {
+        if (new_first == last) new_first = i;
+        new_last = i + 1;
+      }
+    }
+    index->first = new_first;
+    index->last = new_last;
+  }
+
+  index->length++;
+  return index->first != index->last;
+}
+
+const qk_ucis_symbol_t *ucis_index_find(const ucis_index_t *index) {
+  // The shortest candidate comes first in a sorted table
+  uint16_t last = index->sorted && index->first != index->last ? index->first + 1 : index->last;
+  for (uint16_t i = index->first; i < last; i++) {
+    if (has_prefix(index, i) && symbol_char(index, i) == 0) {
+      return &index->table[i];
+    }
+  }
+  return NULL;
+}
@@ -0,0 +1,60 @@
+/* Copyright 2026 QMK Firmware contributors
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef PROCESS_UCIS_INDEX_H
+#define PROCESS_UCIS_INDEX_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+typedef struct {
+  char *symbol;
+  char *code;
+} qk_ucis_symbol_t;
+
+/* Incremental lookup of the UCIS symbols
+ *
+ * The symbols that start with the characters typed so far are narrowed down
+ * as each character is typed, so that a typo is noticed right away, and the
+ * symbol is already known when the input is finished.
+ *
+ * When the symbol table is sorted, the symbols that share a prefix are next
+ * to each other, and each character is found with a binary search, so
+ * tables with thousands of symbols are fine. Other tables work too, but
+ * each character then has to look at the remaining candidates one by one.
+ */
+typedef struct {
+  const qk_ucis_symbol_t *table;
+  uint16_t size;
+  bool sorted;
+  // The candidates are within [first, last), and first is always one of them
+  uint16_t first;
+  uint16_t last;
+  uint8_t length;
+} ucis_index_t;
+
+// Counts the symbols of a table that ends with a NULL symbol, and checks
+// whether it's sorted
+void ucis_index_init(ucis_index_t *index, const qk_ucis_symbol_t *table);
+// Starts a new input, all the symbols are candidates
+void ucis_index_reset(ucis_index_t *index);
+// Adds a typed character, returns false when no symbol starts with the
+// characters typed so far
+bool ucis_index_narrow(ucis_index_t *index, char c);
+// The symbol that was typed, NULL if there's none
+const qk_ucis_symbol_t *ucis_index_find(const ucis_index_t *index);
+
+#endif
@@ -25,10 +25,7 @@ bool process_unicode(uint16_t keycode, keyrecord_t *record) {
       set_unicode_input_mode(eeprom_read_byte(EECONFIG_UNICODEMODE));
       first_flag = 1;
     }
-    uint16_t unicode = keycode & 0x7FFF;
-    unicode_input_start();
-    register_hex(unicode);
-    unicode_input_finish();
+    unicode_send(keycode & 0x7FFF);
   }
   return true;
 }
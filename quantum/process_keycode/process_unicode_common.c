@@ -18,10 +18,42 @@
 #include "eeprom.h"
 
 static uint8_t input_mode;
+// The mods that were held when typing started
 uint8_t mods;
 
+/* Unicode output
+ *
+ * A code point is typed as a list of steps, each of which is one report with
+ * the given mods and at most one key pressed. The reports are built on their
+ * own copy of the keyboard report, so the mods that the user holds are only
+ * cleared once before typing, and restored once after it.
+ */
+typedef struct {
+  uint8_t mods;
+  uint8_t key;
+} unicode_step_t;
+
+// Start, a surrogate pair or eight digits, and finish
+#define UNICODE_MAX_STEPS (4 + 8 * 2 + 2)
+
+static unicode_step_t steps[UNICODE_MAX_STEPS];
+static uint8_t step_count;
+static uint8_t step_index;
+// The step that waits for UNICODE_TYPE_DELAY after the start
+static uint8_t delay_step;
+static uint16_t delay_timer;
+
+static report_keyboard_t report;
+static uint8_t report_key;
+static bool typing;
+
+static uint32_t queue[UNICODE_QUEUE_SIZE];
+static uint8_t queue_head;
+static uint8_t queue_count;
+
 void set_unicode_input_mode(uint8_t os_target)
 {
+  unicode_flush();
   input_mode = os_target;
   eeprom_update_byte(EECONFIG_UNICODEMODE, os_target);
 }
@@ -31,92 +63,269 @@ uint8_t get_unicode_input_mode(void) {
 }
 
 __attribute__((weak))
-void unicode_input_start (void) {
-  // save current mods
-  mods = keyboard_report->mods;
+uint16_t hex_to_keycode(uint8_t hex)
+{
+  if (hex == 0x0) {
+    return KC_0;
+  } else if (hex < 0xA) {
+    return KC_1 + (hex - 0x1);
+  } else {
+    return KC_A + (hex - 0xA);
+  }
+}
 
-  // unregister all mods to start from clean state
-  if (mods & MOD_BIT(KC_LSFT)) unregister_code(KC_LSFT);
-  if (mods & MOD_BIT(KC_RSFT)) unregister_code(KC_RSFT);
-  if (mods & MOD_BIT(KC_LCTL)) unregister_code(KC_LCTL);
-  if (mods & MOD_BIT(KC_RCTL)) unregister_code(KC_RCTL);
-  if (mods & MOD_BIT(KC_LALT)) unregister_code(KC_LALT);
-  if (mods & MOD_BIT(KC_RALT)) unregister_code(KC_RALT);
-  if (mods & MOD_BIT(KC_LGUI)) unregister_code(KC_LGUI);
-  if (mods & MOD_BIT(KC_RGUI)) unregister_code(KC_RGUI);
+static void add_step(uint8_t step_mods, uint8_t key) {
+  steps[step_count].mods = step_mods;
+  steps[step_count].key = key;
+  step_count++;
+}
 
+// The mods that are held while the digits are typed
+static uint8_t digit_mods(void) {
   switch(input_mode) {
   case UC_OSX:
-    register_code(KC_LALT);
-    break;
+  case UC_WIN:
+    return MOD_BIT(KC_LALT);
   case UC_OSX_RALT:
-    register_code(KC_RALT);
+    return MOD_BIT(KC_RALT);
+  }
+  return 0;
+}
+
+static void add_start_steps(void) {
+  switch(input_mode) {
+  case UC_OSX:
+  case UC_OSX_RALT:
+    add_step(digit_mods(), KC_NO);
     break;
   case UC_LNX:
-    register_code(KC_LCTL);
-    register_code(KC_LSFT);
-    register_code(KC_U);
-    unregister_code(KC_U);
-    unregister_code(KC_LSFT);
-    unregister_code(KC_LCTL);
+    add_step(MOD_BIT(KC_LCTL) | MOD_BIT(KC_LSFT), KC_NO);
+    add_step(MOD_BIT(KC_LCTL) | MOD_BIT(KC_LSFT), UNICODE_KEY_LNX);
+    add_step(0, KC_NO);
     break;
   case UC_WIN:
-    register_code(KC_LALT);
-    register_code(KC_PPLS);
-    unregister_code(KC_PPLS);
+    add_step(MOD_BIT(KC_LALT), KC_NO);
+    add_step(MOD_BIT(KC_LALT), KC_PPLS);
+    add_step(MOD_BIT(KC_LALT), KC_NO);
     break;
   case UC_WINC:
-    register_code(KC_RALT);
-    unregister_code(KC_RALT);
-    register_code(KC_U);
-    unregister_code(KC_U);
+    add_step(MOD_BIT(KC_RALT), KC_NO);
+    add_step(0, KC_NO);
+    add_step(0, KC_U);
+    add_step(0, KC_NO);
+    break;
   }
-  wait_ms(UNICODE_TYPE_DELAY);
 }
 
-__attribute__((weak))
-void unicode_input_finish (void) {
+// At least four digits, without the leading zeros of longer numbers
+static void add_hex_steps(uint32_t hex, uint8_t hex_mods) {
+  int8_t i = 7;
+  while (i > 3 && ((hex >> (i * 4)) & 0xF) == 0) {
+    i--;
+  }
+  for (; i >= 0; i--) {
+    add_step(hex_mods, hex_to_keycode((hex >> (i * 4)) & 0xF));
+    add_step(hex_mods, KC_NO);
+  }
+}
+
+static void add_finish_steps(void) {
   switch(input_mode) {
-    case UC_OSX:
-    case UC_WIN:
-      unregister_code(KC_LALT);
-      break;
-    case UC_OSX_RALT:
-      unregister_code(KC_RALT);
-      break;
-    case UC_LNX:
-      register_code(KC_SPC);
-      unregister_code(KC_SPC);
-      break;
-  }
-
-  // reregister previously set mods
-  if (mods & MOD_BIT(KC_LSFT)) register_code(KC_LSFT);
-  if (mods & MOD_BIT(KC_RSFT)) register_code(KC_RSFT);
-  if (mods & MOD_BIT(KC_LCTL)) register_code(KC_LCTL);
-  if (mods & MOD_BIT(KC_RCTL)) register_code(KC_RCTL);
-  if (mods & MOD_BIT(KC_LALT)) register_code(KC_LALT);
-  if (mods & MOD_BIT(KC_RALT)) register_code(KC_RALT);
-  if (mods & MOD_BIT(KC_LGUI)) register_code(KC_LGUI);
-  if (mods & MOD_BIT(KC_RGUI)) register_code(KC_RGUI);
+  case UC_OSX:
+  case UC_OSX_RALT:
+  case UC_WIN:
+    add_step(0, KC_NO);
+    break;
+  case UC_LNX:
+    add_step(0, KC_SPC);
+    add_step(0, KC_NO);
+    break;
+  }
 }
 
-__attribute__((weak))
-uint16_t hex_to_keycode(uint8_t hex)
-{
-  if (hex == 0x0) {
-    return KC_0;
-  } else if (hex < 0xA) {
-    return KC_1 + (hex - 0x1);
+static void add_code_point_steps(uint32_t code_point) {
+  add_start_steps();
+  delay_step = step_count;
+  if (code_point > 0xFFFF && (input_mode == UC_OSX || input_mode == UC_OSX_RALT)) {
+    // Convert to UTF-16 surrogate pair
+    code_point -= 0x10000;
+    add_hex_steps(0xD800 + (code_point >> 10), digit_mods());
+    add_hex_steps(0xDC00 + (code_point & 0x3FF), digit_mods());
   } else {
-    return KC_A + (hex - 0xA);
+    add_hex_steps(code_point, digit_mods());
+  }
+  add_finish_steps();
+}
+
+static void send_step(void) {
+  unicode_step_t *step = &steps[step_index++];
+  if (report_key != KC_NO) {
+    del_key_from_report(&report, report_key);
+  }
+  if (step->key != KC_NO) {
+    add_key_to_report(&report, step->key);
+  }
+  report_key = step->key;
+  report.mods = step->mods;
+  host_keyboard_send(&report);
+}
+
+static void run_steps(void) {
+  while (step_index < step_count) {
+    send_step();
+  }
+  step_index = step_count = 0;
+}
+
+static void sync_report(void) {
+  report = *keyboard_report;
+  report_key = KC_NO;
+}
+
+static void begin_typing(void) {
+  sync_report();
+  mods = keyboard_report->mods;
+  if (mods) {
+    report.mods = 0;
+    host_keyboard_send(&report);
+  }
+  typing = true;
+}
+
+static void end_typing(void) {
+  typing = false;
+  if (mods) {
+    send_keyboard_report();
+  }
+}
+
+bool unicode_supported(uint32_t code_point) {
+  switch(input_mode) {
+  case UC_OSX:
+  case UC_OSX_RALT:
+    return code_point <= 0x10FFFF;
+  case UC_LNX:
+    return code_point <= 0xFFFFF;
+  }
+  return true;
+}
+
+bool unicode_send(uint32_t code_point) {
+  if (!unicode_supported(code_point)) {
+    return false;
+  }
+  if (queue_count == UNICODE_QUEUE_SIZE) {
+    unicode_flush();
+  }
+  queue[(queue_head + queue_count) % UNICODE_QUEUE_SIZE] = code_point;
+  queue_count++;
+  return true;
+}
+
+bool unicode_send_string(const char *str) {
+  bool sent = true;
+  while (*str) {
+    uint8_t byte = *str++;
+    uint32_t code_point;
+    uint8_t continuation;
+    if (byte < 0x80) {
+      code_point = byte;
+      continuation = 0;
+    } else if ((byte & 0xE0) == 0xC0) {
+      code_point = byte & 0x1F;
+      continuation = 1;
+    } else if ((byte & 0xF0) == 0xE0) {
+      code_point = byte & 0x0F;
+      continuation = 2;
+    } else if ((byte & 0xF8) == 0xF0) {
+      code_point = byte & 0x07;
+      continuation = 3;
+    } else {
+      sent = false;
+      continue;
+    }
+    for (; continuation > 0 && (*str & 0xC0) == 0x80; continuation--) {
+      code_point = (code_point << 6) | (*str++ & 0x3F);
+    }
+    if (continuation > 0 || !unicode_send(code_point)) {
+      sent = false;
+    }
+  }
+  return sent;
+}
+
+static bool waiting_for_delay(void) {
+  return step_index == delay_step && timer_elapsed(delay_timer) < UNICODE_TYPE_DELAY;
+}
+
+void unicode_task(void) {
+  if (step_index == step_count) {
+    step_index = step_count = 0;
+    if (queue_count == 0) {
+      if (typing) {
+        end_typing();
+      }
+      return;
+    }
+    if (!typing) {
+      begin_typing();
+    }
+    add_code_point_steps(queue[queue_head]);
+    queue_head = (queue_head + 1) % UNICODE_QUEUE_SIZE;
+    queue_count--;
+    delay_timer = timer_read();
+  }
+  if (waiting_for_delay()) {
+    return;
+  }
+  send_step();
+  if (step_index == delay_step) {
+    delay_timer = timer_read();
+  }
+}
+
+void unicode_flush(void) {
+  while (typing || queue_count > 0) {
+    if (step_index < step_count && waiting_for_delay()) {
+      wait_ms(1);
+    }
+    unicode_task();
+  }
+}
+
+__attribute__((weak))
+void unicode_input_start (void) {
+  unicode_flush();
+  begin_typing();
+  add_start_steps();
+  run_steps();
+  wait_ms(UNICODE_TYPE_DELAY);
+}
+
+__attribute__((weak))
+void unicode_input_finish (void) {
+  if (!typing) {
+    sync_report();
+  }
+  add_finish_steps();
+  run_steps();
+  if (typing) {
+    end_typing();
   }
 }
 
 void register_hex(uint16_t hex) {
-  for(int i = 3; i >= 0; i--) {
-    uint8_t digit = ((hex >> (i*4)) & 0xF);
-    register_code(hex_to_keycode(digit));
-    unregister_code(hex_to_keycode(digit));
+  if (!typing) {
+    sync_report();
+  }
+  add_hex_steps(hex, report.mods);
+  run_steps();
+}
+
+void register_hex32(uint32_t hex) {
+  if (!typing) {
+    sync_report();
   }
+  add_hex_steps(hex, report.mods);
+  run_steps();
 }
@@ -23,14 +23,43 @@
 #define UNICODE_TYPE_DELAY 10
 #endif
 
+// The number of code points that can wait to be typed
+#ifndef UNICODE_QUEUE_SIZE
+#define UNICODE_QUEUE_SIZE 16
+#endif
+
+// The key that is pressed with Ctrl+Shift to start the input on Linux
+#ifndef UNICODE_KEY_LNX
+#define UNICODE_KEY_LNX KC_U
+#endif
+
 __attribute__ ((unused))
 static uint8_t input_mode;
 
 void set_unicode_input_mode(uint8_t os_target);
 uint8_t get_unicode_input_mode(void);
+// Returns false if the code point can't be typed in the current input mode
+bool unicode_supported(uint32_t code_point);
+
+/* Queues a code point to be typed
+ *
+ * The code points are typed by unicode_task, one report per call, so that
+ * the main loop doesn't block. Only if the queue is full, the queued code
+ * points are typed at once. Returns false if the code point isn't supported.
+ */
+bool unicode_send(uint32_t code_point);
+// Queues the code points of an UTF-8 string
+bool unicode_send_string(const char *str);
+void unicode_task(void);
+// Types the queued code points at once
+void unicode_flush(void);
+
+// Types a single code point, and blocks until it's done
 void unicode_input_start(void);
 void unicode_input_finish(void);
+uint16_t hex_to_keycode(uint8_t hex);
 void register_hex(uint16_t hex);
+void register_hex32(uint32_t hex);
 
 #define UC_OSX 0  // Mac OS X
 #define UC_LNX 1  // Linux
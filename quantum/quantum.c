@@ -14,6 +14,9 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+// The songs are stored packed in PROGMEM, see musical_notes.h
+#define PACKED_SONGS
+
 #include "quantum.h"
 #ifdef PROTOCOL_LUFA
 #include "outputselect.h"
@@ -52,11 +55,11 @@ extern backlight_config_t backlight_config;
   #ifndef AG_SWAP_SONG
     #define AG_SWAP_SONG SONG(AG_SWAP_SOUND)
   #endif
-  float goodbye_song[][2] = GOODBYE_SONG;
-  float ag_norm_song[][2] = AG_NORM_SONG;
-  float ag_swap_song[][2] = AG_SWAP_SONG;
+  const song_note_t goodbye_song[] PROGMEM = GOODBYE_SONG;
+  const song_note_t ag_norm_song[] PROGMEM = AG_NORM_SONG;
+  const song_note_t ag_swap_song[] PROGMEM = AG_SWAP_SONG;
   #ifdef DEFAULT_LAYER_SONGS
-    float default_layer_songs[][16][2] = DEFAULT_LAYER_SONGS;
+    const song_note_t default_layer_songs[][16] PROGMEM = DEFAULT_LAYER_SONGS;
   #endif
 #endif
 
@@ -221,6 +224,22 @@ bool process_record_quantum(keyrecord_t *record) {
     preprocess_tap_dance(keycode, record);
   #endif
 
+  #ifdef RGB_MATRIX_ENABLE
+    if (record->event.pressed) {
+      rgb_matrix_key_hit(key.row, key.col);
+    }
+  #endif
+
+  #ifdef UNICODE_COMMON_ENABLE
+    // The queued code points are typed before anything else is sent
+    #if defined(UNICODE_ENABLE)
+    if (keycode < QK_UNICODE)
+    #elif defined(UNICODEMAP_ENABLE)
+    if (keycode < QK_UNICODE_MAP || keycode > QK_UNICODE_MAP_MAX)
+    #endif
+      unicode_flush();
+  #endif
+
   if (!(
   #if defined(KEY_LOCK_ENABLE)
     // Must run first to be able to mask key_up events.
@@ -426,6 +445,89 @@ bool process_record_quantum(keyrecord_t *record) {
       }
     }
     return false;
+  #elif defined(RGB_MATRIX_ENABLE)
+  case RGB_TOG:
+    if (record->event.pressed) {
+      rgb_matrix_toggle();
+    }
+    return false;
+  case RGB_MODE_FORWARD:
+    if (record->event.pressed) {
+      uint8_t shifted = get_mods() & (MOD_BIT(KC_LSHIFT)|MOD_BIT(KC_RSHIFT));
+      if(shifted) {
+        rgb_matrix_step_reverse();
+      }
+      else {
+        rgb_matrix_step();
+      }
+    }
+    return false;
+  case RGB_MODE_REVERSE:
+    if (record->event.pressed) {
+      uint8_t shifted = get_mods() & (MOD_BIT(KC_LSHIFT)|MOD_BIT(KC_RSHIFT));
+      if(shifted) {
+        rgb_matrix_step();
+      }
+      else {
+        rgb_matrix_step_reverse();
+      }
+    }
+    return false;
+  case RGB_HUI:
+    if (record->event.pressed) {
+      rgb_matrix_increase_hue();
+    }
+    return false;
+  case RGB_HUD:
+    if (record->event.pressed) {
+      rgb_matrix_decrease_hue();
+    }
+    return false;
+  case RGB_SAI:
+    if (record->event.pressed) {
+      rgb_matrix_increase_sat();
+    }
+    return false;
+  case RGB_SAD:
+    if (record->event.pressed) {
+      rgb_matrix_decrease_sat();
+    }
+    return false;
+  case RGB_VAI:
+    if (record->event.pressed) {
+      rgb_matrix_increase_val();
+    }
+    return false;
+  case RGB_VAD:
+    if (record->event.pressed) {
+      rgb_matrix_decrease_val();
+    }
+    return false;
+  case RGB_MODE_PLAIN:
+    if (record->event.pressed) {
+      rgb_matrix_mode(RGB_MATRIX_SOLID);
+    }
+    return false;
+  case RGB_MODE_BREATHE:
+    if (record->event.pressed) {
+      rgb_matrix_mode(RGB_MATRIX_BREATHING);
+    }
+    return false;
+  case RGB_MODE_RAINBOW:
+    if (record->event.pressed) {
+      rgb_matrix_mode(RGB_MATRIX_CYCLE_ALL);
+    }
+    return false;
+  case RGB_MODE_SWIRL:
+    if (record->event.pressed) {
+      rgb_matrix_mode(RGB_MATRIX_CYCLE_OUT_IN);
+    }
+    return false;
+  case RGB_MODE_GRADIENT:
+    if (record->event.pressed) {
+      rgb_matrix_mode(RGB_MATRIX_CYCLE_LEFT_RIGHT);
+    }
+    return false;
   #endif
     #ifdef PROTOCOL_LUFA
     case OUT_AUTO:
@@ -830,6 +932,9 @@ void matrix_init_quantum() {
   #ifdef AUDIO_ENABLE
     audio_init();
   #endif
+  #ifdef RGB_MATRIX_ENABLE
+    rgb_matrix_init();
+  #endif
   matrix_init_kb();
 }
 
@@ -846,10 +951,26 @@ void matrix_scan_quantum() {
     matrix_scan_combo();
   #endif
 
+  #ifdef UNICODE_COMMON_ENABLE
+    unicode_task();
+  #endif
+
+  #ifdef STENO_ENABLE
+    steno_task();
+  #endif
+
+  #ifdef RAW_STREAM_ENABLE
+    raw_hid_stream_task();
+  #endif
+
   #if defined(BACKLIGHT_ENABLE) && defined(BACKLIGHT_PIN)
     backlight_task();
   #endif
 
+  #ifdef RGB_MATRIX_ENABLE
+    rgb_matrix_task();
+  #endif
+
   matrix_scan_kb();
 }
 
@@ -30,6 +30,9 @@
 #ifdef RGBLIGHT_ENABLE
   #include "rgblight.h"
 #endif
+#ifdef RGB_MATRIX_ENABLE
+  #include "rgb_matrix.h"
+#endif
 #include "action_layer.h"
 #include "eeconfig.h"
 #include <stddef.h>
@@ -76,6 +79,10 @@ extern uint32_t default_layer_state;
 	#include "process_chording.h"
 #endif
 
+#ifdef UNICODE_COMMON_ENABLE
+	#include "process_unicode_common.h"
+#endif
+
 #ifdef UNICODE_ENABLE
 	#include "process_unicode.h"
 #endif
@@ -106,6 +113,10 @@ extern uint32_t default_layer_state;
 	#include "process_key_lock.h"
 #endif
 
+#ifdef RAW_STREAM_ENABLE
+	#include "raw_stream.h"
+#endif
+
 #ifdef TERMINAL_ENABLE
 	#include "process_terminal.h"
 #else
@@ -0,0 +1,108 @@
+/* Copyright 2026 QMK Firmware contributors
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "raw_stream.h"
+#include "raw_hid.h"
+#ifdef DYNAMIC_KEYMAP_ENABLE
+#include "dynamic_keymap.h"
+#endif
+
+static uint16_t ping(uint8_t* data, uint16_t length, uint16_t size) {
+    return length;
+}
+
+static uint16_t get_info(uint8_t* data, uint16_t length, uint16_t size) {
+    if (size < 5) {
+        data[0] = RAW_STREAM_ERROR;
+        return length;
+    }
+    data[1] = RAW_STREAM_PACKET_SIZE;
+    data[2] = RAW_STREAM_MESSAGE_SIZE >> 8;
+    data[3] = RAW_STREAM_MESSAGE_SIZE & 0xFF;
+    data[4] = RAW_STREAM_WINDOW;
+    return length > 5 ? length : 5;
+}
+
+#ifdef DYNAMIC_KEYMAP_ENABLE
+// The dynamic keymap replies in place, with the same length as the request
+static uint16_t dynamic_keymap(uint8_t* data, uint16_t length, uint16_t size) {
+    if (length > 0xFF) {
+        length = 0xFF;
+    }
+    dynamic_keymap_process_command(data, length);
+    return length;
+}
+#endif
+
+static const raw_stream_command_t commands[] = {
+#ifdef DYNAMIC_KEYMAP_ENABLE
+    {DYNAMIC_KEYMAP_GET_INFO, dynamic_keymap},
+    {DYNAMIC_KEYMAP_GET_KEYCODE, dynamic_keymap},
+    {DYNAMIC_KEYMAP_SET_KEYCODE, dynamic_keymap},
+    {DYNAMIC_KEYMAP_GET_BUFFER, dynamic_keymap},
+    {DYNAMIC_KEYMAP_SET_BUFFER, dynamic_keymap},
+    {DYNAMIC_KEYMAP_RESET, dynamic_keymap},
+#endif
+    {RAW_STREAM_PING, ping},
+    {RAW_STREAM_GET_INFO, get_info},
+};
+
+__attribute__ ((weak))
+uint16_t raw_stream_command_user(uint8_t* data, uint16_t length, uint16_t size) {
+    data[0] = RAW_STREAM_ERROR;
+    return length;
+}
+
+__attribute__ ((weak))
+uint16_t raw_stream_command_kb(uint8_t* data, uint16_t length, uint16_t size) {
+    return raw_stream_command_user(data, length, size);
+}
+
+uint16_t raw_hid_stream_dispatch(uint8_t* data, uint16_t length, uint16_t size) {
+    if (length == 0) {
+        return 0;
+    }
+    for (uint8_t i = 0; i < sizeof(commands) / sizeof(commands[0]); i++) {
+        if (commands[i].command == data[0]) {
+            return commands[i].handler(data, length, size);
+        }
+    }
+    return raw_stream_command_kb(data, length, size);
+}
+
+static void receive_message(raw_stream_t* stream, uint8_t* message, uint16_t length) {
+    uint16_t reply = raw_hid_stream_dispatch(message, length, RAW_STREAM_MESSAGE_SIZE);
+    if (reply > 0) {
+        raw_stream_send(stream, reply);
+    }
+}
+
+static uint8_t buffer[RAW_STREAM_MESSAGE_SIZE];
+static raw_stream_t stream = RAW_STREAM_INITIALIZER(buffer, raw_hid_send, receive_message);
+
+void raw_hid_receive(uint8_t* data, uint8_t length) {
+    if (raw_stream_receive(&stream, data, length)) {
+        return;
+    }
+    // A single packet message, the reply is always a full packet
+    if (raw_hid_stream_dispatch(data, length, length) > 0) {
+        raw_hid_send(data, length);
+    }
+}
+
+void raw_hid_stream_task(void) {
+    raw_stream_task(&stream);
+}
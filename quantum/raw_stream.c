@@ -0,0 +1,272 @@
+/* Copyright 2026 QMK Firmware contributors
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "raw_stream.h"
+#include <string.h>
+#include "timer.h"
+
+// Sequence numbers wrap at 256, the distance from a to b
+#define SEQ_DIFF(a, b) ((uint8_t)((uint8_t)(a) - (uint8_t)(b)))
+
+void raw_stream_init(raw_stream_t* stream, uint8_t* buffer, raw_stream_send_func_t send, raw_stream_receive_func_t receive) {
+    memset(stream, 0, sizeof(raw_stream_t));
+    stream->buffer = buffer;
+    stream->send = send;
+    stream->receive = receive;
+}
+
+static uint8_t tx_count(raw_stream_t* stream) {
+    return (stream->tx_length + RAW_STREAM_PAYLOAD - 1) / RAW_STREAM_PAYLOAD;
+}
+
+static bool send_ack(raw_stream_t* stream) {
+    uint8_t packet[RAW_STREAM_PACKET_SIZE] = {
+        RAW_STREAM_ACK, stream->rx_next, stream->rx_received >> 1,
+    };
+    if (!stream->send(packet, sizeof(packet))) {
+        return false;
+    }
+    stream->rx_ack = false;
+    stream->rx_unacked = 0;
+    return true;
+}
+
+static bool send_data(raw_stream_t* stream, uint8_t seq) {
+    uint8_t packet[RAW_STREAM_PACKET_SIZE];
+    uint8_t index = SEQ_DIFF(seq, stream->tx_first);
+    uint16_t offset = index * RAW_STREAM_PAYLOAD;
+    uint8_t length = RAW_STREAM_PAYLOAD;
+    uint8_t flags = index == 0 ? RAW_STREAM_FLAG_START : 0;
+    if (stream->tx_length - offset <= RAW_STREAM_PAYLOAD) {
+        length = stream->tx_length - offset;
+        flags |= RAW_STREAM_FLAG_END;
+    }
+    packet[0] = RAW_STREAM_DATA;
+    packet[1] = seq;
+    packet[2] = flags;
+    packet[3] = length;
+    memcpy(&packet[RAW_STREAM_HEADER], &stream->buffer[offset], length);
+    memset(&packet[RAW_STREAM_HEADER + length], 0, RAW_STREAM_PAYLOAD - length);
+    return stream->send(packet, sizeof(packet));
+}
+
+static void flush(raw_stream_t* stream) {
+    if (stream->rx_ack) {
+        // The acknowledgements go first, the other side won't accept data
+        // before its own message has been acknowledged
+        if (stream->state != RAW_STREAM_SENDING && stream->rx_unacked > 0 &&
+            timer_elapsed(stream->rx_ack_time) < RAW_STREAM_ACK_DELAY) {
+            return;
+        }
+        if (!send_ack(stream)) {
+            return;
+        }
+    }
+    if (stream->state != RAW_STREAM_SENDING) {
+        return;
+    }
+    if (!stream->tx_synced) {
+        if (stream->tx_sync_sent && timer_elapsed(stream->tx_time) < RAW_STREAM_TIMEOUT) {
+            return;
+        }
+        uint8_t packet[RAW_STREAM_PACKET_SIZE] = {RAW_STREAM_SYNC, stream->tx_first};
+        if (stream->send(packet, sizeof(packet))) {
+            stream->tx_sync_sent = true;
+            stream->tx_time = timer_read();
+        }
+        return;
+    }
+    uint8_t end = stream->tx_first + tx_count(stream);
+    while (SEQ_DIFF(stream->tx_cursor, stream->tx_base) < RAW_STREAM_WINDOW && stream->tx_cursor != end) {
+        uint8_t bit = 1 << SEQ_DIFF(stream->tx_cursor, stream->tx_base);
+        if (!(stream->tx_acked & bit)) {
+            if (!send_data(stream, stream->tx_cursor)) {
+                return;
+            }
+            stream->tx_time = timer_read();
+        }
+        stream->tx_cursor++;
+        if (SEQ_DIFF(stream->tx_cursor, stream->tx_base) > SEQ_DIFF(stream->tx_sent, stream->tx_base)) {
+            stream->tx_sent = stream->tx_cursor;
+        }
+    }
+}
+
+static void receive_ack(raw_stream_t* stream, uint8_t next, uint8_t received) {
+    if (stream->state != RAW_STREAM_SENDING) {
+        return;
+    }
+    if (!stream->tx_synced) {
+        stream->tx_synced = next == stream->tx_first;
+        return;
+    }
+    uint8_t acked = SEQ_DIFF(next, stream->tx_base);
+    // Acknowledges something that wasn't sent, it belongs to an older message
+    if (acked > SEQ_DIFF(stream->tx_sent, stream->tx_base)) {
+        return;
+    }
+    if (acked > 0) {
+        stream->tx_base = next;
+        stream->tx_acked >>= acked;
+        stream->tx_time = timer_read();
+        if (SEQ_DIFF(stream->tx_cursor, stream->tx_base) > SEQ_DIFF(stream->tx_sent, stream->tx_base)) {
+            stream->tx_cursor = stream->tx_base;
+        }
+    }
+    // Bit 0 of the bitmap is the packet after next
+    stream->tx_acked |= received << 1;
+    if (SEQ_DIFF(stream->tx_base, stream->tx_first) == tx_count(stream)) {
+        stream->state = RAW_STREAM_IDLE;
+    }
+}
+
+static void start_receiving(raw_stream_t* stream) {
+    stream->state = RAW_STREAM_RECEIVING;
+    stream->rx_first = stream->rx_next;
+    stream->rx_received = 0;
+    stream->rx_count = 0;
+    stream->rx_length = 0;
+    stream->rx_overflow = false;
+}
+
+static void receive_sync(raw_stream_t* stream, uint8_t seq) {
+    // The other side has started over, so it's not going to acknowledge
+    // what was sent to it, and it won't send the rest of its message
+    stream->state = RAW_STREAM_IDLE;
+    stream->rx_synced = true;
+    stream->rx_next = seq;
+    stream->rx_received = 0;
+    stream->rx_ack = true;
+    send_ack(stream);
+}
+
+static void receive_data(raw_stream_t* stream, uint8_t seq, uint8_t flags, const uint8_t* payload, uint8_t length) {
+    if (!stream->rx_synced) {
+        if (!(flags & RAW_STREAM_FLAG_START)) {
+            return;
+        }
+        stream->rx_synced = true;
+        stream->rx_next = seq;
+    }
+    uint8_t ahead = SEQ_DIFF(seq, stream->rx_next);
+    if (ahead >= (uint8_t)-RAW_STREAM_WINDOW) {
+        // Already received, the acknowledgement must have been lost
+        stream->rx_ack = true;
+        send_ack(stream);
+        return;
+    }
+    if (ahead >= RAW_STREAM_WINDOW || stream->state == RAW_STREAM_SENDING) {
+        // Too far ahead, or there's no room for it before the message has
+        // been sent
+        return;
+    }
+    if (stream->state == RAW_STREAM_IDLE) {
+        start_receiving(stream);
+    }
+    uint8_t index = SEQ_DIFF(seq, stream->rx_first);
+    if (((flags & RAW_STREAM_FLAG_START) != 0) != (index == 0)) {
+        return;
+    }
+    if (!(flags & RAW_STREAM_FLAG_END) && length != RAW_STREAM_PAYLOAD) {
+        return;
+    }
+    uint16_t offset = index * RAW_STREAM_PAYLOAD;
+    if (offset + length > RAW_STREAM_MESSAGE_SIZE) {
+        stream->rx_overflow = true;
+    } else {
+        memcpy(&stream->buffer[offset], payload, length);
+    }
+    if (flags & RAW_STREAM_FLAG_END) {
+        stream->rx_count = index + 1;
+        stream->rx_length = offset + length;
+    }
+    stream->rx_received |= 1 << ahead;
+    if (stream->rx_unacked++ == 0) {
+        stream->rx_ack_time = timer_read();
+    }
+    while (stream->rx_received & 1) {
+        stream->rx_received >>= 1;
+        stream->rx_next++;
+    }
+    stream->rx_ack = true;
+    bool complete = stream->rx_count != 0 && SEQ_DIFF(stream->rx_next, stream->rx_first) == stream->rx_count;
+    // Acknowledge right away when something is missing, when half of the
+    // window has been received and when the message is complete, otherwise
+    // wait a bit, so that more packets can be acknowledged at once
+    if (ahead != 0 || stream->rx_unacked >= (RAW_STREAM_WINDOW + 1) / 2 || complete) {
+        send_ack(stream);
+    }
+    if (complete) {
+        stream->state = RAW_STREAM_IDLE;
+        if (!stream->rx_overflow) {
+            stream->receive(stream, stream->buffer, stream->rx_length);
+        }
+    }
+}
+
+bool raw_stream_receive(raw_stream_t* stream, uint8_t* packet, uint8_t length) {
+    if (length < RAW_STREAM_HEADER) {
+        return false;
+    }
+    switch (packet[0]) {
+        case RAW_STREAM_DATA:
+            if (packet[3] <= RAW_STREAM_PAYLOAD && packet[3] <= length - RAW_STREAM_HEADER) {
+                receive_data(stream, packet[1], packet[2], &packet[RAW_STREAM_HEADER], packet[3]);
+            }
+            break;
+        case RAW_STREAM_SYNC:
+            receive_sync(stream, packet[1]);
+            break;
+        case RAW_STREAM_ACK:
+            receive_ack(stream, packet[1], packet[2]);
+            break;
+        default:
+            return false;
+    }
+    flush(stream);
+    return true;
+}
+
+bool raw_stream_send(raw_stream_t* stream, uint16_t length) {
+    if (stream->state != RAW_STREAM_IDLE || length == 0 || length > RAW_STREAM_MESSAGE_SIZE) {
+        return false;
+    }
+    stream->state = RAW_STREAM_SENDING;
+    stream->tx_length = length;
+    stream->tx_first = stream->tx_sent;
+    stream->tx_base = stream->tx_sent;
+    stream->tx_cursor = stream->tx_sent;
+    stream->tx_acked = 0;
+    flush(stream);
+    return true;
+}
+
+bool raw_stream_send_copy(raw_stream_t* stream, const uint8_t* data, uint16_t length) {
+    if (stream->state != RAW_STREAM_IDLE || length > RAW_STREAM_MESSAGE_SIZE) {
+        return false;
+    }
+    memcpy(stream->buffer, data, length);
+    return raw_stream_send(stream, length);
+}
+
+void raw_stream_task(raw_stream_t* stream) {
+    if (stream->state == RAW_STREAM_SENDING && stream->tx_cursor != stream->tx_base &&
+        timer_elapsed(stream->tx_time) >= RAW_STREAM_TIMEOUT) {
+        // Send everything that hasn't been acknowledged again
+        stream->tx_cursor = stream->tx_base;
+    }
+    flush(stream);
+}
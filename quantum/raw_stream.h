@@ -0,0 +1,207 @@
+/* Copyright 2026 QMK Firmware contributors
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef RAW_STREAM_H
+#define RAW_STREAM_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/* Message transport over raw HID packets
+ *
+ * Messages longer than a packet are split into numbered data packets, which
+ * the receiver puts together directly in the message buffer, in whatever
+ * order they arrive. Up to RAW_STREAM_WINDOW packets are in flight, and the
+ * receiver acknowledges them together with one packet that contains the
+ * next sequence number it expects, and a bitmap of the packets after that
+ * which it has already received. Packets that aren't acknowledged within
+ * RAW_STREAM_TIMEOUT are sent again.
+ *
+ * SYNC [0xFC, seq]
+ * DATA [0xFD, seq, flags, length, payload...]
+ * ACK  [0xFE, next seq, received bitmap]
+ *
+ * Every data packet except the last one of a message carries a full
+ * payload, so its place in the message follows from its sequence number.
+ * The first byte of a message is the command.
+ *
+ * Either side can be restarted while the other one keeps running, for
+ * example when a host tool is started again. So before its first message
+ * the sender tells the receiver where its sequence numbers start with a
+ * SYNC, which is sent until it's acknowledged. A receiver that has just
+ * been started follows the first packet that starts a message.
+ *
+ * Both sides share one buffer for the messages in both directions, like a
+ * request and its reply. So a message is only sent when the previous one
+ * has been received or acknowledged in full, and data that arrives while a
+ * message is being sent is dropped, to be sent again by the other side. So
+ * only one side should start sending at a time, the keyboard only replies.
+ *
+ * The same code runs on the host, see quantum/tools/raw_stream_loopback.c.
+ */
+
+#ifndef RAW_STREAM_PACKET_SIZE
+#define RAW_STREAM_PACKET_SIZE 32
+#endif
+
+// The largest message, this is also the size of the message buffer
+#ifndef RAW_STREAM_MESSAGE_SIZE
+#define RAW_STREAM_MESSAGE_SIZE 128
+#endif
+
+// The number of packets that can be in flight, at most 8
+#ifndef RAW_STREAM_WINDOW
+#define RAW_STREAM_WINDOW 4
+#endif
+
+// Time in ms before the packets that haven't been acknowledged are resent
+#ifndef RAW_STREAM_TIMEOUT
+#define RAW_STREAM_TIMEOUT 50
+#endif
+
+// Time in ms that the acknowledgements are held back, so that more packets
+// can be acknowledged at once
+#ifndef RAW_STREAM_ACK_DELAY
+#define RAW_STREAM_ACK_DELAY 5
+#endif
+
+#if RAW_STREAM_WINDOW > 8
+  #error "RAW_STREAM_WINDOW must be at most 8"
+#endif
+
+#define RAW_STREAM_HEADER 4
+#define RAW_STREAM_PAYLOAD (RAW_STREAM_PACKET_SIZE - RAW_STREAM_HEADER)
+
+/* Packet types and the commands of the transport itself
+ *
+ * The commands from 0xF0 up are reserved, the others are free for the
+ * keyboard to use. Packets that don't start with SYNC, DATA or ACK aren't
+ * part of the transport, and handled as single packet messages.
+ *
+ * PING      [cmd, data...] -> [cmd, data...]
+ * GET_INFO  [cmd] -> [cmd, packet size, message size hi, lo, window]
+ *
+ * A command that can't be handled is answered with the command byte set to
+ * RAW_STREAM_ERROR.
+ */
+enum raw_stream_packet_type {
+    RAW_STREAM_PING = 0xF0,
+    RAW_STREAM_GET_INFO,
+    RAW_STREAM_SYNC = 0xFC,
+    RAW_STREAM_DATA,
+    RAW_STREAM_ACK,
+    RAW_STREAM_ERROR,
+};
+
+#define RAW_STREAM_FLAG_START 0x01
+#define RAW_STREAM_FLAG_END 0x02
+
+typedef enum {
+    RAW_STREAM_IDLE,
+    RAW_STREAM_RECEIVING,
+    RAW_STREAM_SENDING,
+} raw_stream_state_t;
+
+typedef struct raw_stream raw_stream_t;
+
+// Sends one packet, returns false if it couldn't be sent right now
+typedef bool (*raw_stream_send_func_t)(uint8_t* packet, uint8_t length);
+
+// Called with a complete message, which is still in the message buffer. It
+// can reply by calling raw_stream_send from the callback, the buffer can be
+// reused for the reply
+typedef void (*raw_stream_receive_func_t)(raw_stream_t* stream, uint8_t* message, uint16_t length);
+
+struct raw_stream {
+    uint8_t* buffer;
+    raw_stream_send_func_t send;
+    raw_stream_receive_func_t receive;
+    raw_stream_state_t state;
+
+    // Sending, everything before tx_base has been acknowledged, tx_cursor
+    // is the next packet to send and tx_sent is one past the last one sent.
+    // Bit n of tx_acked is set when tx_base + n has been acknowledged
+    uint16_t tx_length;
+    uint8_t tx_first;
+    uint8_t tx_base;
+    uint8_t tx_cursor;
+    uint8_t tx_sent;
+    uint8_t tx_acked;
+    uint16_t tx_time;
+    bool tx_synced;
+    bool tx_sync_sent;
+
+    // Receiving, everything before rx_next has been received, bit n of
+    // rx_received is set when rx_next + n has been received
+    uint16_t rx_length;
+    uint8_t rx_first;
+    uint8_t rx_next;
+    uint8_t rx_received;
+    uint8_t rx_count;
+    uint8_t rx_unacked;
+    uint16_t rx_ack_time;
+    bool rx_ack;
+    bool rx_overflow;
+    bool rx_synced;
+};
+
+#define RAW_STREAM_INITIALIZER(data, send_func, receive_func) \
+    { .buffer = (data), .send = (send_func), .receive = (receive_func) }
+
+void raw_stream_init(raw_stream_t* stream, uint8_t* buffer, raw_stream_send_func_t send, raw_stream_receive_func_t receive);
+
+// Handles a packet from the other side, returns false if it isn't part of
+// the transport
+bool raw_stream_receive(raw_stream_t* stream, uint8_t* packet, uint8_t length);
+
+// Starts sending the first length bytes of the message buffer, returns false
+// if another message is being sent, or the message is too long
+bool raw_stream_send(raw_stream_t* stream, uint16_t length);
+
+// Copies a message into the buffer and starts sending it
+bool raw_stream_send_copy(raw_stream_t* stream, const uint8_t* data, uint16_t length);
+
+// Sends the pending packets, acknowledgements and retransmissions, call
+// this regularly
+void raw_stream_task(raw_stream_t* stream);
+
+static inline bool raw_stream_busy(const raw_stream_t* stream) {
+    return stream->state != RAW_STREAM_IDLE;
+}
+
+/* The command dispatch of the keyboard, with RAW_STREAM_ENABLE
+ *
+ * The commands are handled in place, the handler gets the message and the
+ * size of the buffer it's in, and returns the length of the reply, or 0 to
+ * not reply. The same handlers are used for single packet messages, which
+ * are answered with a single packet.
+ */
+typedef uint16_t (*raw_stream_handler_t)(uint8_t* data, uint16_t length, uint16_t size);
+
+typedef struct {
+    uint8_t command;
+    raw_stream_handler_t handler;
+} raw_stream_command_t;
+
+// Handles the commands that aren't in the built in table, replies with
+// RAW_STREAM_ERROR by default
+uint16_t raw_stream_command_kb(uint8_t* data, uint16_t length, uint16_t size);
+uint16_t raw_stream_command_user(uint8_t* data, uint16_t length, uint16_t size);
+
+uint16_t raw_hid_stream_dispatch(uint8_t* data, uint16_t length, uint16_t size);
+void raw_hid_stream_task(void);
+
+#endif
@@ -0,0 +1,475 @@
+/* Copyright 2026 QMK Firmware contributors
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "rgb_matrix.h"
+#include <string.h>
+#include "timer.h"
+#include "led_tables.h"
+#ifndef RGB_MATRIX_CUSTOM_DRIVER
+#include "ws2812.h"
+#endif
+
+static rgb_matrix_config_t rgb_matrix_config = {
+    .enable = true,
+    .mode = RGB_MATRIX_SOLID,
+    .hue = 0,
+    .sat = 255,
+    .val = 255,
+    .speed = 128,
+};
+
+static LED_TYPE framebuffer[RGB_MATRIX_LED_COUNT];
+static uint8_t key_leds[MATRIX_ROWS][MATRIX_COLS];
+
+static bool needs_render = true;
+static uint32_t last_frame = 0;
+// The effect time in milliseconds, which wraps around like the timer, and
+// the 1/128 milliseconds that the speed scaling left over
+static uint32_t effect_time = 0;
+static uint8_t effect_fraction = 0;
+static uint32_t effect_updated = 0;
+
+#if RGB_MATRIX_KEY_QUEUE > 128 || (RGB_MATRIX_KEY_QUEUE & (RGB_MATRIX_KEY_QUEUE - 1))
+#error RGB_MATRIX_KEY_QUEUE has to be a power of two, up to 128
+#endif
+
+// The LEDs of the key presses since the last frame
+static uint8_t key_queue[RGB_MATRIX_KEY_QUEUE];
+static uint8_t key_queue_head = 0;
+static uint8_t key_queue_tail = 0;
+
+static rgb_matrix_hit_t hits[RGB_MATRIX_HITS];
+static uint8_t hit_count = 0;
+static uint8_t next_hit = 0;
+static uint8_t heat[RGB_MATRIX_LED_COUNT];
+static uint32_t heat_updated = 0;
+
+LED_TYPE rgb_matrix_hsv_to_rgb(uint16_t hue, uint8_t sat, uint8_t val) {
+    uint8_t r, g, b;
+    if (sat == 0) {
+        r = g = b = val;
+    } else {
+        uint8_t base = ((255 - sat) * val) >> 8;
+        uint8_t color = (val - base) * (hue % 60) / 60;
+        switch (hue / 60) {
+        case 0:
+            r = val; g = base + color; b = base;
+            break;
+        case 1:
+            r = val - color; g = val; b = base;
+            break;
+        case 2:
+            r = base; g = val; b = base + color;
+            break;
+        case 3:
+            r = base; g = val - color; b = val;
+            break;
+        case 4:
+            r = base + color; g = base; b = val;
+            break;
+        default:
+            r = val; g = base; b = val - color;
+            break;
+        }
+    }
+    LED_TYPE led = {0};
+    led.r = pgm_read_byte(&CIE1931_CURVE[r]);
+    led.g = pgm_read_byte(&CIE1931_CURVE[g]);
+    led.b = pgm_read_byte(&CIE1931_CURVE[b]);
+    return led;
+}
+
+// Moves the hue by the given amount of degrees, which can be negative
+static uint16_t shift_hue(uint16_t hue, int32_t shift) {
+    int32_t h = (hue + shift) % 360;
+    return h < 0 ? h + 360 : h;
+}
+
+static uint8_t add_clamped(uint8_t value, int16_t step) {
+    int16_t v = value + step;
+    return v < 0 ? 0 : v > 255 ? 255 : v;
+}
+
+static uint8_t isqrt16(uint16_t x) {
+    uint16_t result = 0;
+    uint16_t bit = 1 << 14;
+    while (bit > x) {
+        bit >>= 2;
+    }
+    while (bit) {
+        if (x >= result + bit) {
+            x -= result + bit;
+            result = (result >> 1) + bit;
+        } else {
+            result >>= 1;
+        }
+        bit >>= 2;
+    }
+    return result;
+}
+
+// Effects
+
+static LED_TYPE effect_solid(const rgb_matrix_frame_t* frame, uint8_t index, const rgb_matrix_led_t* led) {
+    (void)index;
+    (void)led;
+    return rgb_matrix_hsv_to_rgb(frame->config->hue, frame->config->sat, frame->config->val);
+}
+
+// A squared triangle wave, which looks close to a sine to the eye, with a
+// period of 4 seconds
+static LED_TYPE effect_breathing(const rgb_matrix_frame_t* frame, uint8_t index, const rgb_matrix_led_t* led) {
+    (void)index;
+    (void)led;
+    uint16_t phase = (frame->time >> 3) & 0x1FF;
+    uint16_t wave = phase < 256 ? phase : 511 - phase;
+    uint8_t val = (uint32_t)frame->config->val * wave * wave / (255 * 255);
+    return rgb_matrix_hsv_to_rgb(frame->config->hue, frame->config->sat, val);
+}
+
+// The hues go around the color wheel in 3.6 seconds
+#define CYCLE_HUE(frame) ((frame)->time / 10)
+
+static LED_TYPE effect_cycle_all(const rgb_matrix_frame_t* frame, uint8_t index, const rgb_matrix_led_t* led) {
+    (void)index;
+    (void)led;
+    uint16_t hue = shift_hue(frame->config->hue, CYCLE_HUE(frame) % 360);
+    return rgb_matrix_hsv_to_rgb(hue, frame->config->sat, frame->config->val);
+}
+
+// The whole color wheel across the board
+static LED_TYPE effect_cycle_left_right(const rgb_matrix_frame_t* frame, uint8_t index, const rgb_matrix_led_t* led) {
+    (void)index;
+    int32_t shift = (int32_t)led->x * 360 / RGB_MATRIX_WIDTH - (int32_t)(CYCLE_HUE(frame) % 360);
+    return rgb_matrix_hsv_to_rgb(shift_hue(frame->config->hue, shift), frame->config->sat, frame->config->val);
+}
+
+// Half of the color wheel from the top to the bottom
+static LED_TYPE effect_cycle_up_down(const rgb_matrix_frame_t* frame, uint8_t index, const rgb_matrix_led_t* led) {
+    (void)index;
+    int32_t shift = (int32_t)led->y * 180 / RGB_MATRIX_HEIGHT - (int32_t)(CYCLE_HUE(frame) % 360);
+    return rgb_matrix_hsv_to_rgb(shift_hue(frame->config->hue, shift), frame->config->sat, frame->config->val);
+}
+
+// Rings of color moving out from the center
+static LED_TYPE effect_cycle_out_in(const rgb_matrix_frame_t* frame, uint8_t index, const rgb_matrix_led_t* led) {
+    (void)index;
+    int16_t dx = led->x - RGB_MATRIX_CENTER_X;
+    int16_t dy = led->y - RGB_MATRIX_CENTER_Y;
+    uint8_t distance = isqrt16(dx * dx + dy * dy);
+    int32_t shift = (int32_t)distance * 3 - (int32_t)(CYCLE_HUE(frame) % 360);
+    return rgb_matrix_hsv_to_rgb(shift_hue(frame->config->hue, shift), frame->config->sat, frame->config->val);
+}
+
+// How strongly the LED is lit by the rings moving out from the recent key
+// presses, from 0 to 255
+static uint8_t ripple_intensity(const rgb_matrix_frame_t* frame, const rgb_matrix_led_t* led) {
+    uint8_t intensity = 0;
+    for (uint8_t i = 0; i < frame->hit_count; i++) {
+        const rgb_matrix_hit_t* hit = &frame->hits[i];
+        uint32_t age = frame->time - hit->time;
+        if (age >= RGB_MATRIX_HIT_MS) {
+            continue;
+        }
+        int16_t dx = led->x - hit->x;
+        int16_t dy = led->y - hit->y;
+        uint8_t distance = isqrt16(dx * dx + dy * dy);
+        // The rings cross the board in about a second, and are 8 units wide
+        int16_t offset = distance - (int16_t)(age * RGB_MATRIX_WIDTH / RGB_MATRIX_HIT_MS);
+        if (offset < -8 || offset > 8) {
+            continue;
+        }
+        uint8_t ring = 255 - (offset < 0 ? -offset : offset) * 31;
+        uint8_t faded = ring * (RGB_MATRIX_HIT_MS - age) / RGB_MATRIX_HIT_MS;
+        if (faded > intensity) {
+            intensity = faded;
+        }
+    }
+    return intensity;
+}
+
+// Rings of the selected color on a dark board
+static LED_TYPE effect_ripple(const rgb_matrix_frame_t* frame, uint8_t index, const rgb_matrix_led_t* led) {
+    (void)index;
+    uint8_t val = frame->config->val * ripple_intensity(frame, led) / 255;
+    return rgb_matrix_hsv_to_rgb(frame->config->hue, frame->config->sat, val);
+}
+
+// Rings that shift the hue of the selected color
+static LED_TYPE effect_splash(const rgb_matrix_frame_t* frame, uint8_t index, const rgb_matrix_led_t* led) {
+    (void)index;
+    uint16_t shift = (uint16_t)ripple_intensity(frame, led) * 180 / 255;
+    return rgb_matrix_hsv_to_rgb(shift_hue(frame->config->hue, shift), frame->config->sat, frame->config->val);
+}
+
+// From blue for cold keys to red for the most used keys
+static LED_TYPE effect_heatmap(const rgb_matrix_frame_t* frame, uint8_t index, const rgb_matrix_led_t* led) {
+    (void)led;
+    uint16_t hue = 240 - (uint16_t)frame->heat[index] * 240 / 255;
+    return rgb_matrix_hsv_to_rgb(hue, frame->config->sat, frame->config->val);
+}
+
+static const rgb_matrix_effect_t effects[RGB_MATRIX_MODES] PROGMEM = {
+    [RGB_MATRIX_SOLID] = {effect_solid, false, false},
+    [RGB_MATRIX_BREATHING] = {effect_breathing, true, false},
+    [RGB_MATRIX_CYCLE_ALL] = {effect_cycle_all, true, false},
+    [RGB_MATRIX_CYCLE_LEFT_RIGHT] = {effect_cycle_left_right, true, false},
+    [RGB_MATRIX_CYCLE_UP_DOWN] = {effect_cycle_up_down, true, false},
+    [RGB_MATRIX_CYCLE_OUT_IN] = {effect_cycle_out_in, true, false},
+    [RGB_MATRIX_RIPPLE] = {effect_ripple, true, true},
+    [RGB_MATRIX_SPLASH] = {effect_splash, true, true},
+    [RGB_MATRIX_HEATMAP] = {effect_heatmap, true, true},
+};
+
+static rgb_matrix_effect_func_t effect_func(uint8_t mode) {
+    return (rgb_matrix_effect_func_t)pgm_read_ptr(&effects[mode].func);
+}
+
+static bool effect_animated(uint8_t mode) {
+    return pgm_read_byte(&effects[mode].animated);
+}
+
+static bool effect_reactive(uint8_t mode) {
+    return pgm_read_byte(&effects[mode].reactive);
+}
+
+static void clear_hits(void) {
+    key_queue_tail = key_queue_head;
+    hit_count = 0;
+    next_hit = 0;
+    memset(heat, 0, sizeof(heat));
+    heat_updated = 0;
+}
+
+// Moves the queued key presses to the hits and the heatmap, and cools the
+// heatmap down
+static void update_hits(uint32_t time) {
+    while (key_queue_tail != key_queue_head) {
+        uint8_t led = key_queue[key_queue_tail & (RGB_MATRIX_KEY_QUEUE - 1)];
+        key_queue_tail++;
+        hits[next_hit].x = pgm_read_byte(&rgb_matrix_leds[led].x);
+        hits[next_hit].y = pgm_read_byte(&rgb_matrix_leds[led].y);
+        hits[next_hit].time = time;
+        next_hit = (next_hit + 1) % RGB_MATRIX_HITS;
+        if (hit_count < RGB_MATRIX_HITS) {
+            hit_count++;
+        }
+        heat[led] = add_clamped(heat[led], RGB_MATRIX_HEAT_STEP);
+    }
+    uint32_t cooling = (time - heat_updated) / RGB_MATRIX_HEAT_DECAY_MS;
+    if (cooling > 0) {
+        heat_updated += cooling * RGB_MATRIX_HEAT_DECAY_MS;
+        uint8_t step = cooling > 255 ? 255 : cooling;
+        for (uint8_t i = 0; i < RGB_MATRIX_LED_COUNT; i++) {
+            heat[i] = heat[i] > step ? heat[i] - step : 0;
+        }
+    }
+}
+
+void rgb_matrix_key_hit(uint8_t row, uint8_t col) {
+    if (!rgb_matrix_config.enable || !effect_reactive(rgb_matrix_config.mode)) {
+        return;
+    }
+    if (row >= MATRIX_ROWS || col >= MATRIX_COLS || key_leds[row][col] == RGB_MATRIX_NO_LED) {
+        return;
+    }
+    if ((uint8_t)(key_queue_head - key_queue_tail) < RGB_MATRIX_KEY_QUEUE) {
+        key_queue[key_queue_head & (RGB_MATRIX_KEY_QUEUE - 1)] = key_leds[row][col];
+        key_queue_head++;
+    }
+}
+
+static void flush(void) {
+#ifdef RGB_MATRIX_CUSTOM_DRIVER
+    rgb_matrix_driver_setleds(framebuffer, RGB_MATRIX_LED_COUNT);
+#else
+    ws2812_setleds(framebuffer, RGB_MATRIX_LED_COUNT);
+#endif
+}
+
+// Only the LEDs that changed mark the framebuffer dirty, so static colors
+// don't keep the LED data line busy
+static bool render(void) {
+    uint32_t now = timer_read32();
+    uint32_t elapsed = TIMER_DIFF_32(now, effect_updated);
+    // Only the static effects go this long without a frame, and they don't
+    // use the time, the limit keeps the scaling from overflowing
+    if (elapsed > 0xFFFF) {
+        elapsed = 0xFFFF;
+    }
+    uint32_t ticks = elapsed * rgb_matrix_config.speed + effect_fraction;
+    effect_time += ticks >> 7;
+    effect_fraction = ticks & 0x7F;
+    effect_updated = now;
+    last_frame = now;
+
+    rgb_matrix_frame_t frame = {
+        .time = effect_time,
+        .config = &rgb_matrix_config,
+        .hits = hits,
+        .hit_count = hit_count,
+        .heat = heat,
+    };
+    rgb_matrix_effect_func_t func = effect_func(rgb_matrix_config.mode);
+    if (rgb_matrix_config.enable && effect_reactive(rgb_matrix_config.mode)) {
+        update_hits(frame.time);
+        frame.hit_count = hit_count;
+    }
+    bool dirty = false;
+    for (uint8_t i = 0; i < RGB_MATRIX_LED_COUNT; i++) {
+        LED_TYPE color = {0};
+        if (rgb_matrix_config.enable) {
+            rgb_matrix_led_t led = {
+                .row = pgm_read_byte(&rgb_matrix_leds[i].row),
+                .col = pgm_read_byte(&rgb_matrix_leds[i].col),
+                .x = pgm_read_byte(&rgb_matrix_leds[i].x),
+                .y = pgm_read_byte(&rgb_matrix_leds[i].y),
+            };
+            color = func(&frame, i, &led);
+        }
+        if (memcmp(&color, &framebuffer[i], sizeof(color)) != 0) {
+            framebuffer[i] = color;
+            dirty = true;
+        }
+    }
+    return dirty;
+}
+
+void rgb_matrix_render(void) {
+    needs_render = false;
+    if (render()) {
+        flush();
+    }
+}
+
+void rgb_matrix_init(void) {
+    memset(key_leds, RGB_MATRIX_NO_LED, sizeof(key_leds));
+    for (uint8_t i = 0; i < RGB_MATRIX_LED_COUNT; i++) {
+        uint8_t row = pgm_read_byte(&rgb_matrix_leds[i].row);
+        uint8_t col = pgm_read_byte(&rgb_matrix_leds[i].col);
+        if (row < MATRIX_ROWS && col < MATRIX_COLS) {
+            key_leds[row][col] = i;
+        }
+    }
+    memset(framebuffer, 0, sizeof(framebuffer));
+    clear_hits();
+    last_frame = timer_read32();
+    effect_updated = last_frame;
+    effect_time = 0;
+    effect_fraction = 0;
+    needs_render = false;
+    // The LEDs might not be dark after a reset, so they are always pushed
+    render();
+    flush();
+}
+
+void rgb_matrix_task(void) {
+    bool animated = rgb_matrix_config.enable && effect_animated(rgb_matrix_config.mode);
+    if (!needs_render && !animated) {
+        return;
+    }
+    if (timer_elapsed32(last_frame) < RGB_MATRIX_FRAME_MS) {
+        return;
+    }
+    rgb_matrix_render();
+}
+
+static void config_changed(void) {
+    needs_render = true;
+}
+
+void rgb_matrix_enable(void) {
+    rgb_matrix_config.enable = true;
+    config_changed();
+}
+
+void rgb_matrix_disable(void) {
+    rgb_matrix_config.enable = false;
+    config_changed();
+}
+
+void rgb_matrix_toggle(void) {
+    rgb_matrix_config.enable = !rgb_matrix_config.enable;
+    config_changed();
+}
+
+void rgb_matrix_mode(uint8_t mode) {
+    rgb_matrix_config.mode = mode < RGB_MATRIX_MODES ? mode : RGB_MATRIX_MODES - 1;
+    effect_time = 0;
+    effect_fraction = 0;
+    effect_updated = timer_read32();
+    clear_hits();
+    config_changed();
+}
+
+uint8_t rgb_matrix_get_mode(void) {
+    return rgb_matrix_config.mode;
+}
+
+void rgb_matrix_step(void) {
+    rgb_matrix_mode((rgb_matrix_config.mode + 1) % RGB_MATRIX_MODES);
+}
+
+void rgb_matrix_step_reverse(void) {
+    rgb_matrix_mode((rgb_matrix_config.mode + RGB_MATRIX_MODES - 1) % RGB_MATRIX_MODES);
+}
+
+void rgb_matrix_sethsv(uint16_t hue, uint8_t sat, uint8_t val) {
+    rgb_matrix_config.hue = hue % 360;
+    rgb_matrix_config.sat = sat;
+    rgb_matrix_config.val = val;
+    config_changed();
+}
+
+void rgb_matrix_increase_hue(void) {
+    rgb_matrix_sethsv(shift_hue(rgb_matrix_config.hue, RGB_MATRIX_HUE_STEP), rgb_matrix_config.sat, rgb_matrix_config.val);
+}
+
+void rgb_matrix_decrease_hue(void) {
+    rgb_matrix_sethsv(shift_hue(rgb_matrix_config.hue, -RGB_MATRIX_HUE_STEP), rgb_matrix_config.sat, rgb_matrix_config.val);
+}
+
+void rgb_matrix_increase_sat(void) {
+    rgb_matrix_sethsv(rgb_matrix_config.hue, add_clamped(rgb_matrix_config.sat, RGB_MATRIX_SAT_STEP), rgb_matrix_config.val);
+}
+
+void rgb_matrix_decrease_sat(void) {
+    rgb_matrix_sethsv(rgb_matrix_config.hue, add_clamped(rgb_matrix_config.sat, -RGB_MATRIX_SAT_STEP), rgb_matrix_config.val);
+}
+
+void rgb_matrix_increase_val(void) {
+    rgb_matrix_sethsv(rgb_matrix_config.hue, rgb_matrix_config.sat, add_clamped(rgb_matrix_config.val, RGB_MATRIX_VAL_STEP));
+}
+
+void rgb_matrix_decrease_val(void) {
+    rgb_matrix_sethsv(rgb_matrix_config.hue, rgb_matrix_config.sat, add_clamped(rgb_matrix_config.val, -RGB_MATRIX_VAL_STEP));
+}
+
+void rgb_matrix_set_speed(uint8_t speed) {
+    rgb_matrix_config.speed = speed;
+}
+
+const rgb_matrix_config_t* rgb_matrix_get_config(void) {
+    return &rgb_matrix_config;
+}
+
+uint8_t rgb_matrix_key_led(uint8_t row, uint8_t col) {
+    return row < MATRIX_ROWS && col < MATRIX_COLS ? key_leds[row][col] : RGB_MATRIX_NO_LED;
+}
+
+const LED_TYPE* rgb_matrix_framebuffer(void) {
+    return framebuffer;
+}
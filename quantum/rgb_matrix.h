@@ -0,0 +1,200 @@
+/* Copyright 2026 QMK Firmware contributors
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef RGB_MATRIX_H
+#define RGB_MATRIX_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "config.h"
+#include "progmem.h"
+#include "rgblight_types.h"
+
+/* Per key RGB lighting
+ *
+ * Unlike rgblight, which treats the LEDs as a strip, every LED here knows
+ * the key it sits under and its physical position on the board, so the
+ * effects are computed from the position and the time. The keyboard
+ * defines RGB_MATRIX_LED_COUNT in its config.h and the rgb_matrix_leds
+ * table, in the order the LEDs are chained.
+ *
+ * The LEDs are rendered to a framebuffer at most once per
+ * RGB_MATRIX_FRAME_MS, and only pushed to the LEDs when a color changed.
+ */
+
+#ifndef RGB_MATRIX_LED_COUNT
+#error RGB_MATRIX_LED_COUNT has to be defined by the keyboard
+#endif
+// The LEDs are indexed with 8 bits, and 0xFF is RGB_MATRIX_NO_LED
+#if RGB_MATRIX_LED_COUNT > 254
+#error RGB_MATRIX_LED_COUNT can be at most 254
+#endif
+
+#ifndef RGB_MATRIX_FRAME_MS
+#define RGB_MATRIX_FRAME_MS 16
+#endif
+
+#ifndef RGB_MATRIX_HUE_STEP
+#define RGB_MATRIX_HUE_STEP 10
+#endif
+#ifndef RGB_MATRIX_SAT_STEP
+#define RGB_MATRIX_SAT_STEP 17
+#endif
+#ifndef RGB_MATRIX_VAL_STEP
+#define RGB_MATRIX_VAL_STEP 17
+#endif
+#ifndef RGB_MATRIX_SPEED_STEP
+#define RGB_MATRIX_SPEED_STEP 32
+#endif
+
+// The key presses waiting for the next frame, a power of two
+#ifndef RGB_MATRIX_KEY_QUEUE
+#define RGB_MATRIX_KEY_QUEUE 8
+#endif
+// The number of recent key presses the ripples are drawn from
+#ifndef RGB_MATRIX_HITS
+#define RGB_MATRIX_HITS 8
+#endif
+// How long a ripple lasts
+#ifndef RGB_MATRIX_HIT_MS
+#define RGB_MATRIX_HIT_MS 1000
+#endif
+// How much heat a key press adds to the heatmap, out of 255
+#ifndef RGB_MATRIX_HEAT_STEP
+#define RGB_MATRIX_HEAT_STEP 32
+#endif
+// The time it takes for the heat to drop by one
+#ifndef RGB_MATRIX_HEAT_DECAY_MS
+#define RGB_MATRIX_HEAT_DECAY_MS 25
+#endif
+
+// The physical positions go from 0 to 224 from the left edge to the right
+// edge, and from 0 to 64 from the top to the bottom of the board
+#define RGB_MATRIX_WIDTH 224
+#define RGB_MATRIX_HEIGHT 64
+#define RGB_MATRIX_CENTER_X (RGB_MATRIX_WIDTH / 2)
+#define RGB_MATRIX_CENTER_Y (RGB_MATRIX_HEIGHT / 2)
+
+// The row of LEDs that aren't under a key, like underglow
+#define RGB_MATRIX_NO_KEY 0xFF
+// The LED index of keys without an LED
+#define RGB_MATRIX_NO_LED 0xFF
+
+typedef struct {
+    uint8_t row;
+    uint8_t col;
+    uint8_t x;
+    uint8_t y;
+} rgb_matrix_led_t;
+
+extern const rgb_matrix_led_t rgb_matrix_leds[RGB_MATRIX_LED_COUNT] PROGMEM;
+
+enum rgb_matrix_modes {
+    RGB_MATRIX_SOLID = 0,
+    RGB_MATRIX_BREATHING,
+    RGB_MATRIX_CYCLE_ALL,
+    RGB_MATRIX_CYCLE_LEFT_RIGHT,
+    RGB_MATRIX_CYCLE_UP_DOWN,
+    RGB_MATRIX_CYCLE_OUT_IN,
+    RGB_MATRIX_RIPPLE,
+    RGB_MATRIX_SPLASH,
+    RGB_MATRIX_HEATMAP,
+    RGB_MATRIX_MODES
+};
+
+typedef struct {
+    bool enable;
+    uint8_t mode;
+    uint16_t hue;
+    uint8_t sat;
+    uint8_t val;
+    // 128 runs the animations at their normal speed
+    uint8_t speed;
+} rgb_matrix_config_t;
+
+// A key press, at the position of the LED under the key
+typedef struct {
+    uint8_t x;
+    uint8_t y;
+    // The effect time of the frame that picked up the press
+    uint32_t time;
+} rgb_matrix_hit_t;
+
+// What an effect gets to compute the color of one LED
+typedef struct {
+    // The milliseconds since the effect started, scaled by the speed
+    uint32_t time;
+    const rgb_matrix_config_t* config;
+    // The recent key presses of reactive effects, in no particular order
+    const rgb_matrix_hit_t* hits;
+    uint8_t hit_count;
+    // The heat of each LED for reactive effects, from 0 to 255
+    const uint8_t* heat;
+} rgb_matrix_frame_t;
+
+typedef LED_TYPE (*rgb_matrix_effect_func_t)(const rgb_matrix_frame_t* frame, uint8_t index, const rgb_matrix_led_t* led);
+
+typedef struct {
+    rgb_matrix_effect_func_t func;
+    // Static effects are only rendered when the config changes
+    bool animated;
+    // Reactive effects pick up the key presses
+    bool reactive;
+} rgb_matrix_effect_t;
+
+void rgb_matrix_init(void);
+// Called from the matrix scan, renders a frame when it's time for one
+void rgb_matrix_task(void);
+/* Called from process_record_quantum for every key press
+ *
+ * The press is only queued for the next frame, which takes the same short
+ * time for every effect. When the queue is full, the press is dropped.
+ */
+void rgb_matrix_key_hit(uint8_t row, uint8_t col);
+// Renders a frame right away, and pushes the changed LEDs
+void rgb_matrix_render(void);
+
+void rgb_matrix_enable(void);
+void rgb_matrix_disable(void);
+void rgb_matrix_toggle(void);
+void rgb_matrix_mode(uint8_t mode);
+uint8_t rgb_matrix_get_mode(void);
+void rgb_matrix_step(void);
+void rgb_matrix_step_reverse(void);
+void rgb_matrix_sethsv(uint16_t hue, uint8_t sat, uint8_t val);
+void rgb_matrix_increase_hue(void);
+void rgb_matrix_decrease_hue(void);
+void rgb_matrix_increase_sat(void);
+void rgb_matrix_decrease_sat(void);
+void rgb_matrix_increase_val(void);
+void rgb_matrix_decrease_val(void);
+void rgb_matrix_set_speed(uint8_t speed);
+const rgb_matrix_config_t* rgb_matrix_get_config(void);
+
+// The LED under a key, or RGB_MATRIX_NO_LED
+uint8_t rgb_matrix_key_led(uint8_t row, uint8_t col);
+// The colors that were last pushed to the LEDs
+const LED_TYPE* rgb_matrix_framebuffer(void);
+
+#ifdef RGB_MATRIX_CUSTOM_DRIVER
+// Provided by keyboards that don't drive the LEDs with ws2812.c
+void rgb_matrix_driver_setleds(LED_TYPE* leds, uint16_t count);
+#endif
+
+// Integer HSV to RGB, the hue goes from 0 to 359
+LED_TYPE rgb_matrix_hsv_to_rgb(uint16_t hue, uint8_t sat, uint8_t val);
+
+#endif
@@ -14,9 +14,8 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 #include <math.h>
-#include <avr/eeprom.h>
-#include <avr/interrupt.h>
-#include <util/delay.h>
+#include "eeprom.h"
+#include "wait.h"
 #include "progmem.h"
 #include "timer.h"
 #include "rgblight.h"
@@ -43,6 +42,10 @@ LED_TYPE led[RGBLED_NUM];
 uint8_t rgblight_inited = 0;
 bool rgblight_timer_enabled = false;
 
+#ifdef RGBLIGHT_ANIMATIONS
+static void rgblight_effect_start(void);
+#endif
+
 void sethsv(uint16_t hue, uint8_t sat, uint8_t val, LED_TYPE *led1) {
   uint8_t r = 0, g = 0, b = 0, base, color;
 
@@ -239,6 +242,7 @@ void rgblight_mode(uint8_t mode) {
 
     #ifdef RGBLIGHT_ANIMATIONS
       rgblight_timer_enable();
+      rgblight_effect_start();
     #endif
   } else if (rgblight_config.mode >= 25 && rgblight_config.mode <= 34) {
     // MODE 25-34, static gradient
@@ -274,7 +278,7 @@ void rgblight_disable(void) {
   #ifdef RGBLIGHT_ANIMATIONS
     rgblight_timer_disable();
   #endif
-  _delay_ms(50);
+  wait_ms(50);
   rgblight_set();
 }
 
@@ -479,179 +483,227 @@ void rgblight_show_solid_color(uint8_t r, uint8_t g, uint8_t b) {
   rgblight_setrgb(r, g, b);
 }
 
-void rgblight_task(void) {
-  if (rgblight_timer_enabled) {
-    // mode = 1, static light, do nothing here
-    if (rgblight_config.mode >= 2 && rgblight_config.mode <= 5) {
-      // mode = 2 to 5, breathing mode
-      rgblight_effect_breathing(rgblight_config.mode - 2);
-    } else if (rgblight_config.mode >= 6 && rgblight_config.mode <= 8) {
-      // mode = 6 to 8, rainbow mood mod
-      rgblight_effect_rainbow_mood(rgblight_config.mode - 6);
-    } else if (rgblight_config.mode >= 9 && rgblight_config.mode <= 14) {
-      // mode = 9 to 14, rainbow swirl mode
-      rgblight_effect_rainbow_swirl(rgblight_config.mode - 9);
-    } else if (rgblight_config.mode >= 15 && rgblight_config.mode <= 20) {
-      // mode = 15 to 20, snake mode
-      rgblight_effect_snake(rgblight_config.mode - 15);
-    } else if (rgblight_config.mode >= 21 && rgblight_config.mode <= 23) {
-      // mode = 21 to 23, knight mode
-      rgblight_effect_knight(rgblight_config.mode - 21);
-    } else if (rgblight_config.mode == 24) {
-      // mode = 24, christmas mode
-      rgblight_effect_christmas();
-    }
+static void breathing_init(rgblight_effect_state_t *state, uint8_t variant) {
+  state->breathing.pos = 0;
+}
+static void breathing_step(rgblight_effect_state_t *state, uint8_t variant) {
+  state->breathing.pos++;
+}
+static void breathing_render(const rgblight_effect_state_t *state, uint8_t variant) {
+  // http://sean.voisen.org/blog/2011/10/breathing-led-with-arduino/
+  uint8_t pos = state->breathing.pos;
+  float val = (exp(sin((pos/255.0)*M_PI)) - RGBLIGHT_EFFECT_BREATHE_CENTER/M_E)*(RGBLIGHT_EFFECT_BREATHE_MAX/(M_E-1/M_E));
+  sethsv(rgblight_config.hue, rgblight_config.sat, val, &led[0]);
+  for (uint8_t i = 1; i < RGBLED_NUM; i++) {
+    led[i] = led[0];
   }
 }
+static uint16_t breathing_interval(uint8_t variant) {
+  return pgm_read_byte(&RGBLED_BREATHING_INTERVALS[variant]);
+}
 
-// Effects
-void rgblight_effect_breathing(uint8_t interval) {
-  static uint8_t pos = 0;
-  static uint16_t last_timer = 0;
-  float val;
-
-  if (timer_elapsed(last_timer) < pgm_read_byte(&RGBLED_BREATHING_INTERVALS[interval])) {
-    return;
+static void rainbow_mood_init(rgblight_effect_state_t *state, uint8_t variant) {
+  state->rainbow_mood.hue = 0;
+}
+static void rainbow_mood_step(rgblight_effect_state_t *state, uint8_t variant) {
+  state->rainbow_mood.hue = (state->rainbow_mood.hue + 1) % 360;
+}
+static void rainbow_mood_render(const rgblight_effect_state_t *state, uint8_t variant) {
+  sethsv(state->rainbow_mood.hue, rgblight_config.sat, rgblight_config.val, &led[0]);
+  for (uint8_t i = 1; i < RGBLED_NUM; i++) {
+    led[i] = led[0];
   }
-  last_timer = timer_read();
-
-
-  // http://sean.voisen.org/blog/2011/10/breathing-led-with-arduino/
-  val = (exp(sin((pos/255.0)*M_PI)) - RGBLIGHT_EFFECT_BREATHE_CENTER/M_E)*(RGBLIGHT_EFFECT_BREATHE_MAX/(M_E-1/M_E));
-  rgblight_sethsv_noeeprom(rgblight_config.hue, rgblight_config.sat, val);
-  pos = (pos + 1) % 256;
 }
-void rgblight_effect_rainbow_mood(uint8_t interval) {
-  static uint16_t current_hue = 0;
-  static uint16_t last_timer = 0;
+static uint16_t rainbow_mood_interval(uint8_t variant) {
+  return pgm_read_byte(&RGBLED_RAINBOW_MOOD_INTERVALS[variant]);
+}
 
-  if (timer_elapsed(last_timer) < pgm_read_byte(&RGBLED_RAINBOW_MOOD_INTERVALS[interval])) {
-    return;
-  }
-  last_timer = timer_read();
-  rgblight_sethsv_noeeprom(current_hue, rgblight_config.sat, rgblight_config.val);
-  current_hue = (current_hue + 1) % 360;
+static void rainbow_swirl_init(rgblight_effect_state_t *state, uint8_t variant) {
+  state->rainbow_swirl.hue = 0;
 }
-void rgblight_effect_rainbow_swirl(uint8_t interval) {
-  static uint16_t current_hue = 0;
-  static uint16_t last_timer = 0;
-  uint16_t hue;
-  uint8_t i;
-  if (timer_elapsed(last_timer) < pgm_read_byte(&RGBLED_RAINBOW_SWIRL_INTERVALS[interval / 2])) {
-    return;
+static void rainbow_swirl_step(rgblight_effect_state_t *state, uint8_t variant) {
+  if (variant % 2) {
+    state->rainbow_swirl.hue = (state->rainbow_swirl.hue + 1) % 360;
+  } else {
+    state->rainbow_swirl.hue = (state->rainbow_swirl.hue + 359) % 360;
   }
-  last_timer = timer_read();
-  for (i = 0; i < RGBLED_NUM; i++) {
-    hue = (360 / RGBLED_NUM * i + current_hue) % 360;
-    sethsv(hue, rgblight_config.sat, rgblight_config.val, (LED_TYPE *)&led[i]);
+}
+static void rainbow_swirl_render(const rgblight_effect_state_t *state, uint8_t variant) {
+  for (uint8_t i = 0; i < RGBLED_NUM; i++) {
+    uint16_t hue = (360 / RGBLED_NUM * i + state->rainbow_swirl.hue) % 360;
+    sethsv(hue, rgblight_config.sat, rgblight_config.val, &led[i]);
   }
-  rgblight_set();
+}
+static uint16_t rainbow_swirl_interval(uint8_t variant) {
+  return pgm_read_byte(&RGBLED_RAINBOW_SWIRL_INTERVALS[variant / 2]);
+}
 
-  if (interval % 2) {
-    current_hue = (current_hue + 1) % 360;
+static void snake_init(rgblight_effect_state_t *state, uint8_t variant) {
+  state->snake.pos = 0;
+}
+static void snake_step(rgblight_effect_state_t *state, uint8_t variant) {
+  if (variant % 2) {
+    state->snake.pos = (state->snake.pos + 1) % RGBLED_NUM;
   } else {
-    if (current_hue - 1 < 0) {
-      current_hue = 359;
-    } else {
-      current_hue = current_hue - 1;
-    }
+    state->snake.pos = state->snake.pos ? state->snake.pos - 1 : RGBLED_NUM - 1;
   }
 }
-void rgblight_effect_snake(uint8_t interval) {
-  static uint8_t pos = 0;
-  static uint16_t last_timer = 0;
-  uint8_t i, j;
-  int8_t k;
-  int8_t increment = 1;
-  if (interval % 2) {
-    increment = -1;
-  }
-  if (timer_elapsed(last_timer) < pgm_read_byte(&RGBLED_SNAKE_INTERVALS[interval / 2])) {
-    return;
-  }
-  last_timer = timer_read();
-  for (i = 0; i < RGBLED_NUM; i++) {
+static void snake_render(const rgblight_effect_state_t *state, uint8_t variant) {
+  int8_t increment = (variant % 2) ? -1 : 1;
+  for (uint8_t i = 0; i < RGBLED_NUM; i++) {
     led[i].r = 0;
     led[i].g = 0;
     led[i].b = 0;
-    for (j = 0; j < RGBLIGHT_EFFECT_SNAKE_LENGTH; j++) {
-      k = pos + j * increment;
+    for (uint8_t j = 0; j < RGBLIGHT_EFFECT_SNAKE_LENGTH; j++) {
+      int8_t k = state->snake.pos + j * increment;
       if (k < 0) {
         k = k + RGBLED_NUM;
       }
       if (i == k) {
-        sethsv(rgblight_config.hue, rgblight_config.sat, (uint8_t)(rgblight_config.val*(RGBLIGHT_EFFECT_SNAKE_LENGTH-j)/RGBLIGHT_EFFECT_SNAKE_LENGTH), (LED_TYPE *)&led[i]);
+        sethsv(rgblight_config.hue, rgblight_config.sat, (uint8_t)(rgblight_config.val*(RGBLIGHT_EFFECT_SNAKE_LENGTH-j)/RGBLIGHT_EFFECT_SNAKE_LENGTH), &led[i]);
       }
     }
   }
-  rgblight_set();
-  if (increment == 1) {
-    if (pos - 1 < 0) {
-      pos = RGBLED_NUM - 1;
-    } else {
-      pos -= 1;
-    }
-  } else {
-    pos = (pos + 1) % RGBLED_NUM;
-  }
 }
-void rgblight_effect_knight(uint8_t interval) {
-  static uint16_t last_timer = 0;
-  if (timer_elapsed(last_timer) < pgm_read_byte(&RGBLED_KNIGHT_INTERVALS[interval])) {
-    return;
-  }
-  last_timer = timer_read();
-
-  static int8_t low_bound = 0;
-  static int8_t high_bound = RGBLIGHT_EFFECT_KNIGHT_LENGTH - 1;
-  static int8_t increment = 1;
-  uint8_t i, cur;
+static uint16_t snake_interval(uint8_t variant) {
+  return pgm_read_byte(&RGBLED_SNAKE_INTERVALS[variant / 2]);
+}
 
-  // Set all the LEDs to 0
-  for (i = 0; i < RGBLED_NUM; i++) {
+static void knight_init(rgblight_effect_state_t *state, uint8_t variant) {
+  state->knight.low_bound = 0;
+  state->knight.high_bound = RGBLIGHT_EFFECT_KNIGHT_LENGTH - 1;
+  state->knight.increment = 1;
+}
+// Moves from low_bound to high_bound, changing the direction each time a
+// boundary is hit
+static void knight_step(rgblight_effect_state_t *state, uint8_t variant) {
+  rgblight_knight_state_t *knight = &state->knight;
+  knight->low_bound += knight->increment;
+  knight->high_bound += knight->increment;
+  if (knight->high_bound <= 0 || knight->low_bound >= RGBLIGHT_EFFECT_KNIGHT_LED_NUM - 1) {
+    knight->increment = -knight->increment;
+  }
+}
+static void knight_render(const rgblight_effect_state_t *state, uint8_t variant) {
+  for (uint8_t i = 0; i < RGBLED_NUM; i++) {
     led[i].r = 0;
     led[i].g = 0;
     led[i].b = 0;
   }
-  // Determine which LEDs should be lit up
-  for (i = 0; i < RGBLIGHT_EFFECT_KNIGHT_LED_NUM; i++) {
-    cur = (i + RGBLIGHT_EFFECT_KNIGHT_OFFSET) % RGBLED_NUM;
-
-    if (i >= low_bound && i <= high_bound) {
-      sethsv(rgblight_config.hue, rgblight_config.sat, rgblight_config.val, (LED_TYPE *)&led[cur]);
-    } else {
-      led[cur].r = 0;
-      led[cur].g = 0;
-      led[cur].b = 0;
+  for (uint8_t i = 0; i < RGBLIGHT_EFFECT_KNIGHT_LED_NUM; i++) {
+    uint8_t cur = (i + RGBLIGHT_EFFECT_KNIGHT_OFFSET) % RGBLED_NUM;
+    if (i >= state->knight.low_bound && i <= state->knight.high_bound) {
+      sethsv(rgblight_config.hue, rgblight_config.sat, rgblight_config.val, &led[cur]);
     }
   }
-  rgblight_set();
+}
+static uint16_t knight_interval(uint8_t variant) {
+  return pgm_read_byte(&RGBLED_KNIGHT_INTERVALS[variant]);
+}
 
-  // Move from low_bound to high_bound changing the direction we increment each
-  // time a boundary is hit.
-  low_bound += increment;
-  high_bound += increment;
+static void christmas_init(rgblight_effect_state_t *state, uint8_t variant) {
+  state->christmas.offset = 0;
+}
+static void christmas_step(rgblight_effect_state_t *state, uint8_t variant) {
+  state->christmas.offset = (state->christmas.offset + 1) % 2;
+}
+static void christmas_render(const rgblight_effect_state_t *state, uint8_t variant) {
+  for (uint8_t i = 0; i < RGBLED_NUM; i++) {
+    uint16_t hue = ((i / RGBLIGHT_EFFECT_CHRISTMAS_STEP + state->christmas.offset) % 2) * 120;
+    sethsv(hue, rgblight_config.sat, rgblight_config.val, &led[i]);
+  }
+}
+static uint16_t christmas_interval(uint8_t variant) {
+  return RGBLIGHT_EFFECT_CHRISTMAS_INTERVAL;
+}
+
+#define EFFECT(name, first, last) {first, last, name##_init, name##_step, name##_render, name##_interval}
+
+static const rgblight_effect_t rgblight_effects[] PROGMEM = {
+  EFFECT(breathing, 2, 5),
+  EFFECT(rainbow_mood, 6, 8),
+  EFFECT(rainbow_swirl, 9, 14),
+  EFFECT(snake, 15, 20),
+  EFFECT(knight, 21, 23),
+  EFFECT(christmas, 24, 24),
+};
+
+#define RGBLIGHT_EFFECT_COUNT (sizeof(rgblight_effects) / sizeof(rgblight_effects[0]))
+
+// The effect of the current mode, copied out of PROGMEM
+static rgblight_effect_t effect;
+static bool effect_active = false;
+static uint8_t effect_variant;
+static rgblight_effect_state_t effect_state;
+// Set when the first frame of the effect hasn't been rendered yet
+static bool effect_started;
+static uint16_t effect_last_step;
+static uint16_t effect_last_frame;
+
+static bool rgblight_effect_select(uint8_t mode) {
+  for (uint8_t i = 0; i < RGBLIGHT_EFFECT_COUNT; i++) {
+    if (mode >= pgm_read_byte(&rgblight_effects[i].first_mode) && mode <= pgm_read_byte(&rgblight_effects[i].last_mode)) {
+      memcpy_P(&effect, &rgblight_effects[i], sizeof(effect));
+      effect_variant = mode - effect.first_mode;
+      effect_active = true;
+      effect_started = true;
+      return true;
+    }
+  }
+  effect_active = false;
+  return false;
+}
 
-  if (high_bound <= 0 || low_bound >= RGBLIGHT_EFFECT_KNIGHT_LED_NUM - 1) {
-    increment = -increment;
+static void rgblight_effect_start(void) {
+  if (rgblight_effect_select(rgblight_config.mode)) {
+    effect.init(&effect_state, effect_variant);
   }
 }
 
+void rgblight_get_effect_sync(rgblight_effect_sync_t *sync) {
+  sync->mode = rgblight_config.mode;
+  sync->state = effect_state;
+}
 
-void rgblight_effect_christmas(void) {
-  static uint16_t current_offset = 0;
-  static uint16_t last_timer = 0;
-  uint16_t hue;
-  uint8_t i;
-  if (timer_elapsed(last_timer) < RGBLIGHT_EFFECT_CHRISTMAS_INTERVAL) {
+void rgblight_set_effect_sync(const rgblight_effect_sync_t *sync) {
+  if (!rgblight_config.enable) {
+    return;
+  }
+  if (sync->mode != rgblight_config.mode) {
+    rgblight_config.mode = sync->mode;
+    rgblight_timer_enable();
+  }
+  if (rgblight_effect_select(sync->mode)) {
+    effect_state = sync->state;
+  }
+}
+
+void rgblight_task(void) {
+  if (!rgblight_timer_enabled || !effect_active) {
     return;
   }
-  last_timer = timer_read();
-  current_offset = (current_offset + 1) % 2;
-  for (i = 0; i < RGBLED_NUM; i++) {
-    hue = 0 + ((i/RGBLIGHT_EFFECT_CHRISTMAS_STEP + current_offset) % 2) * 120;
-    sethsv(hue, rgblight_config.sat, rgblight_config.val, (LED_TYPE *)&led[i]);
+  uint16_t now = timer_read();
+  if (effect_started) {
+    effect_started = false;
+    effect_last_step = now;
+  } else {
+    if (TIMER_DIFF_16(now, effect_last_frame) < RGBLIGHT_FRAME_MS) {
+      return;
+    }
+    uint16_t interval = effect.interval(effect_variant);
+    uint16_t steps = TIMER_DIFF_16(now, effect_last_step) / interval;
+    if (steps == 0) {
+      return;
+    }
+    // Stepping from the last step instead of now keeps the speed exact,
+    // even when the task runs late
+    effect_last_step += steps * interval;
+    while (steps--) {
+      effect.step(&effect_state, effect_variant);
+    }
   }
+  effect_last_frame = now;
+  effect.render(&effect_state, effect_variant);
   rgblight_set();
 }
 
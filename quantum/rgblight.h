@@ -64,11 +64,19 @@
 #define RGBLIGHT_VAL_STEP 17
 #endif
 
+// The animations render at most this many frames per second, effects with
+// shorter intervals take several steps per frame to keep their speed
+#ifndef RGBLIGHT_FPS
+#define RGBLIGHT_FPS 100
+#endif
+#define RGBLIGHT_FRAME_MS (1000 / RGBLIGHT_FPS)
+
 #define RGBLED_TIMER_TOP F_CPU/(256*64)
 // #define RGBLED_TIMER_TOP 0xFF10
 
 #include <stdint.h>
 #include <stdbool.h>
+#include "progmem.h"
 #include "eeconfig.h"
 #ifndef RGBLIGHT_CUSTOM_DRIVER
 #include "ws2812.h"
@@ -138,11 +146,67 @@ void rgblight_timer_init(void);
 void rgblight_timer_enable(void);
 void rgblight_timer_disable(void);
 void rgblight_timer_toggle(void);
-void rgblight_effect_breathing(uint8_t interval);
-void rgblight_effect_rainbow_mood(uint8_t interval);
-void rgblight_effect_rainbow_swirl(uint8_t interval);
-void rgblight_effect_snake(uint8_t interval);
-void rgblight_effect_knight(uint8_t interval);
-void rgblight_effect_christmas(void);
+
+/* Animated effects
+ *
+ * Every effect keeps its position in its own state struct, which is reset
+ * when the mode is selected. The effect only advances the state by one step
+ * at a time and renders the current state to led[], while rgblight_task()
+ * decides how many steps are due and when to render from a single clock.
+ */
+typedef struct {
+  uint8_t pos;
+} rgblight_breathing_state_t;
+
+typedef struct {
+  uint16_t hue;
+} rgblight_rainbow_state_t;
+
+typedef struct {
+  uint8_t pos;
+} rgblight_snake_state_t;
+
+typedef struct {
+  int8_t low_bound;
+  int8_t high_bound;
+  int8_t increment;
+} rgblight_knight_state_t;
+
+typedef struct {
+  uint8_t offset;
+} rgblight_christmas_state_t;
+
+typedef union {
+  rgblight_breathing_state_t breathing;
+  rgblight_rainbow_state_t rainbow_mood;
+  rgblight_rainbow_state_t rainbow_swirl;
+  rgblight_snake_state_t snake;
+  rgblight_knight_state_t knight;
+  rgblight_christmas_state_t christmas;
+} rgblight_effect_state_t;
+
+typedef struct {
+  // The modes of the effect, the variant passed to the functions is the
+  // mode minus first_mode
+  uint8_t first_mode;
+  uint8_t last_mode;
+  void (*init)(rgblight_effect_state_t *state, uint8_t variant);
+  void (*step)(rgblight_effect_state_t *state, uint8_t variant);
+  void (*render)(const rgblight_effect_state_t *state, uint8_t variant);
+  // The milliseconds between two steps
+  uint16_t (*interval)(uint8_t variant);
+} rgblight_effect_t;
+
+// Everything the other half of a split keyboard needs to show the same
+// animation frame, it's plain data, so it can be sent as it is
+typedef struct {
+  uint8_t mode;
+  rgblight_effect_state_t state;
+} rgblight_effect_sync_t;
+
+void rgblight_get_effect_sync(rgblight_effect_sync_t *sync);
+// Selects the mode without writing it to the EEPROM, and continues the
+// animation from the given state
+void rgblight_set_effect_sync(const rgblight_effect_sync_t *sync);
 
 #endif
@@ -0,0 +1,122 @@
+/* Copyright 2026 QMK Firmware contributors
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "gtest/gtest.h"
+#include <cstdlib>
+#include <cstring>
+extern "C" {
+#include "config.h"
+#include "debounce.h"
+}
+
+namespace {
+
+// The per key counters that the ErgoDox EZ used to have, as a reference
+struct reference_debounce {
+    uint8_t counters[MATRIX_COLS];
+
+    matrix_row_t row(matrix_row_t debounced, matrix_row_t raw) {
+        matrix_row_t mask = 0;
+        for (uint8_t j = 0; j < MATRIX_COLS; ++j) {
+            if (counters[j]) {
+                --counters[j];
+            } else {
+                mask |= (matrix_row_t)1 << j;
+            }
+        }
+        matrix_row_t cols = (raw & mask) | (debounced & ~mask);
+        matrix_row_t change = cols ^ debounced;
+        for (uint8_t j = 0; j < MATRIX_COLS; ++j) {
+            if (change & ((matrix_row_t)1 << j)) {
+                counters[j] = DEBOUNCE;
+            }
+        }
+        return cols;
+    }
+};
+
+}
+
+class Debounce : public testing::Test {
+public:
+    Debounce() {
+        memset(counters, 0, sizeof(counters));
+        memset(reference, 0, sizeof(reference));
+        memset(debounced, 0, sizeof(debounced));
+        memset(expected, 0, sizeof(expected));
+        srand(1);
+    }
+
+    void scan(const matrix_row_t* raw) {
+        for (int row = 0; row < MATRIX_ROWS; row++) {
+            debounced[row] = debounce_row(&counters[row], debounced[row], raw[row]);
+            expected[row] = reference[row].row(expected[row], raw[row]);
+        }
+    }
+
+    debounce_row_t counters[MATRIX_ROWS];
+    reference_debounce reference[MATRIX_ROWS];
+    matrix_row_t debounced[MATRIX_ROWS];
+    matrix_row_t expected[MATRIX_ROWS];
+};
+
+TEST_F(Debounce, AKeyPressIsReportedImmediately) {
+    matrix_row_t raw[MATRIX_ROWS] = {0, 0b100};
+    scan(raw);
+    EXPECT_EQ(debounced[1], 0b100);
+}
+
+TEST_F(Debounce, AKeyCantChangeForDebounceScans) {
+    matrix_row_t pressed[MATRIX_ROWS] = {0, 0b100};
+    matrix_row_t released[MATRIX_ROWS] = {};
+    scan(pressed);
+    for (int i = 0; i < DEBOUNCE; i++) {
+        scan(released);
+        EXPECT_EQ(debounced[1], 0b100) << "scan " << i;
+    }
+    scan(released);
+    EXPECT_EQ(debounced[1], 0);
+}
+
+TEST_F(Debounce, OtherKeysCanChangeWhileAKeyIsBouncing) {
+    matrix_row_t raw[MATRIX_ROWS] = {0b1};
+    scan(raw);
+    raw[0] = 0b10;
+    scan(raw);
+    EXPECT_EQ(debounced[0], 0b11);
+}
+
+TEST_F(Debounce, MatchesTheReferenceOnRandomBounces) {
+    matrix_row_t raw[MATRIX_ROWS] = {};
+    for (int i = 0; i < 100000; i++) {
+        for (int row = 0; row < MATRIX_ROWS; row++) {
+            // Keys are pressed or released now and then, and bounce for a
+            // few scans after that
+            for (int col = 0; col < MATRIX_COLS; col++) {
+                if (rand() % 64 == 0) {
+                    raw[row] ^= (matrix_row_t)1 << col;
+                }
+            }
+            if (rand() % 4 == 0) {
+                raw[row] ^= (matrix_row_t)rand();
+            }
+        }
+        scan(raw);
+        for (int row = 0; row < MATRIX_ROWS; row++) {
+            ASSERT_EQ(debounced[row], expected[row]) << "scan " << i << " row " << row;
+        }
+    }
+}
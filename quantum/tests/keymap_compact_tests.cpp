@@ -0,0 +1,148 @@
+/* Copyright 2026 QMK Firmware contributors
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "gtest/gtest.h"
+#include <vector>
+#include <random>
+extern "C" {
+#include "keymap_compact.h"
+}
+
+namespace {
+
+const uint16_t KC_NO = 0;
+const uint16_t KC_TRNS = KEYMAP_COMPACT_TRANSPARENT;
+
+struct Sample {
+    const char* name;
+    uint16_t layers;
+    uint16_t rows;
+    uint16_t cols;
+    // Percentage of the keys above the base layer that are not transparent
+    int density;
+};
+
+std::ostream& operator<<(std::ostream& os, const Sample& s) {
+    return os << s.name;
+}
+
+// Layout shapes of typical boards, from a numpad to a big split keyboard
+const Sample samples[] = {
+    {"numpad", 4, 6, 4, 30},
+    {"planck", 16, 4, 12, 20},
+    {"ergodox", 32, 14, 6, 10},
+    {"fullsize", 8, 6, 21, 5},
+    {"single_key", 3, 1, 1, 50},
+    {"dense", 4, 5, 15, 100},
+    {"empty_layers", 20, 5, 14, 0},
+};
+
+}
+
+class KeymapCompact : public testing::TestWithParam<Sample> {
+public:
+    void generate(const Sample& s) {
+        std::mt19937 rng(s.layers * 1000 + s.rows * 100 + s.cols);
+        std::uniform_int_distribution<int> percent(0, 99);
+        std::uniform_int_distribution<int> keycode(0, 0x7FFF);
+        dense.resize(s.layers * s.rows * s.cols);
+        for (size_t i = 0; i < dense.size(); i++) {
+            bool base_layer = i < (size_t)s.rows * s.cols;
+            if (base_layer || percent(rng) < s.density) {
+                dense[i] = keycode(rng);
+                // Make sure the transparent keycode only appears where intended
+                if (dense[i] == KC_TRNS) {
+                    dense[i] = KC_NO;
+                }
+            } else {
+                dense[i] = KC_TRNS;
+            }
+        }
+        pack();
+    }
+
+    void pack() {
+        bitmap.resize(KEYMAP_COMPACT_BLOCKS(dense.size()));
+        base.resize(KEYMAP_COMPACT_BLOCKS(dense.size()));
+        keycodes.resize(dense.size() + 1);
+        num_keycodes = keymap_compact_pack(dense.data(), dense.size(), bitmap.data(), base.data(), keycodes.data());
+    }
+
+    uint16_t read(uint16_t cell) {
+        return keymap_compact_read(bitmap.data(), base.data(), keycodes.data(), cell);
+    }
+
+    std::vector<uint16_t> dense;
+    std::vector<uint16_t> bitmap;
+    std::vector<uint16_t> base;
+    std::vector<uint16_t> keycodes;
+    uint16_t num_keycodes;
+};
+
+TEST_P(KeymapCompact, LookupsMatchTheDenseKeymap) {
+    const Sample& s = GetParam();
+    generate(s);
+    for (uint16_t layer = 0; layer < s.layers; layer++) {
+        for (uint16_t row = 0; row < s.rows; row++) {
+            for (uint16_t col = 0; col < s.cols; col++) {
+                uint16_t cell = (layer * s.rows + row) * s.cols + col;
+                ASSERT_EQ(read(cell), dense[cell]) << "layer " << layer << " row " << row << " col " << col;
+                ASSERT_EQ(keymap_compact_is_set(bitmap.data(), cell), dense[cell] != KC_TRNS);
+            }
+        }
+    }
+}
+
+TEST_P(KeymapCompact, OnlyNonTransparentKeysAreStored) {
+    generate(GetParam());
+    uint16_t expected = 0;
+    for (uint16_t keycode : dense) {
+        expected += keycode != KC_TRNS;
+    }
+    EXPECT_EQ(num_keycodes, expected);
+}
+
+INSTANTIATE_TEST_CASE_P(Samples, KeymapCompact, testing::ValuesIn(samples));
+
+TEST_F(KeymapCompact, SparseKeymapsAreSmaller) {
+    generate(samples[1]);
+    size_t compact_size = bitmap.size() + base.size() + num_keycodes;
+    EXPECT_LT(compact_size * 2, dense.size());
+}
+
+TEST_F(KeymapCompact, NoKeyIsNotTransparent) {
+    dense = {KC_NO, KC_TRNS, KC_NO};
+    pack();
+    EXPECT_EQ(num_keycodes, 2);
+    EXPECT_EQ(read(0), KC_NO);
+    EXPECT_EQ(read(1), KC_TRNS);
+    EXPECT_EQ(read(2), KC_NO);
+}
+
+TEST_F(KeymapCompact, KeysAcrossBlockBoundaries) {
+    dense.assign(40, KC_TRNS);
+    dense[15] = 0x1234;
+    dense[16] = 0x5678;
+    dense[39] = 0x9ABC;
+    pack();
+    EXPECT_EQ(base[1], 1);
+    EXPECT_EQ(base[2], 2);
+    EXPECT_EQ(read(14), KC_TRNS);
+    EXPECT_EQ(read(15), 0x1234);
+    EXPECT_EQ(read(16), 0x5678);
+    EXPECT_EQ(read(17), KC_TRNS);
+    EXPECT_EQ(read(39), 0x9ABC);
+}
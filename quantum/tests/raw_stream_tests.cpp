@@ -0,0 +1,396 @@
+/* Copyright 2026 QMK Firmware contributors
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "gtest/gtest.h"
+#include <algorithm>
+#include <deque>
+#include <functional>
+#include <random>
+#include <vector>
+extern "C" {
+#include "raw_stream.h"
+#include "timer.h"
+void set_time(uint32_t t);
+void advance_time(uint32_t ms);
+}
+
+namespace {
+
+typedef std::vector<uint8_t> bytes;
+
+struct Endpoint {
+    raw_stream_t stream;
+    uint8_t buffer[RAW_STREAM_MESSAGE_SIZE];
+    std::vector<bytes> received;
+    std::vector<bytes> sent;
+    // Packets on their way to this endpoint
+    std::deque<bytes> inbox;
+    std::function<void(raw_stream_t*, uint8_t*, uint16_t)> on_receive;
+    // Return false to make the sending fail
+    std::function<bool(const bytes&)> can_send;
+};
+
+Endpoint host;
+Endpoint device;
+
+bool send(Endpoint& from, Endpoint& to, uint8_t* packet, uint8_t length) {
+    bytes data(packet, packet + length);
+    if (from.can_send && !from.can_send(data)) {
+        return false;
+    }
+    EXPECT_EQ(length, RAW_STREAM_PACKET_SIZE);
+    from.sent.push_back(data);
+    to.inbox.push_back(data);
+    return true;
+}
+
+bool host_send(uint8_t* packet, uint8_t length) { return send(host, device, packet, length); }
+bool device_send(uint8_t* packet, uint8_t length) { return send(device, host, packet, length); }
+
+void receive(Endpoint& endpoint, raw_stream_t* stream, uint8_t* message, uint16_t length) {
+    // The message is passed in place
+    EXPECT_EQ(message, endpoint.buffer);
+    endpoint.received.emplace_back(message, message + length);
+    if (endpoint.on_receive) {
+        endpoint.on_receive(stream, message, length);
+    }
+}
+
+void host_receive(raw_stream_t* stream, uint8_t* message, uint16_t length) { receive(host, stream, message, length); }
+void device_receive(raw_stream_t* stream, uint8_t* message, uint16_t length) { receive(device, stream, message, length); }
+
+void reset(Endpoint& endpoint, raw_stream_send_func_t send, raw_stream_receive_func_t receive) {
+    endpoint.received.clear();
+    endpoint.sent.clear();
+    endpoint.inbox.clear();
+    endpoint.on_receive = nullptr;
+    endpoint.can_send = nullptr;
+    raw_stream_init(&endpoint.stream, endpoint.buffer, send, receive);
+}
+
+bytes make_message(uint16_t length, uint8_t seed = 0) {
+    bytes message(length);
+    for (uint16_t i = 0; i < length; i++) {
+        message[i] = i * 7 + seed;
+    }
+    return message;
+}
+
+size_t count(const std::vector<bytes>& packets, uint8_t type) {
+    return std::count_if(packets.begin(), packets.end(), [type](const bytes& p) { return p[0] == type; });
+}
+
+}
+
+class RawStream : public testing::Test {
+public:
+    RawStream() {
+        set_time(0);
+        reset(host, host_send, host_receive);
+        reset(device, device_send, device_receive);
+    }
+
+    // Everything that's on the way arrives, in the order given by the link
+    void deliver(Endpoint& to) {
+        std::deque<bytes> packets;
+        packets.swap(to.inbox);
+        if (reorder) {
+            std::shuffle(packets.begin(), packets.end(), random);
+        }
+        for (bytes& packet : packets) {
+            if (drop && drop(packet)) {
+                continue;
+            }
+            EXPECT_TRUE(raw_stream_receive(&to.stream, packet.data(), packet.size()));
+        }
+    }
+
+    // Runs both sides for a while, 1ms per step
+    void run(uint32_t ms) {
+        for (uint32_t i = 0; i < ms; i++) {
+            deliver(device);
+            deliver(host);
+            raw_stream_task(&host.stream);
+            raw_stream_task(&device.stream);
+            advance_time(1);
+        }
+    }
+
+    void send_message(const bytes& message) {
+        EXPECT_TRUE(raw_stream_send_copy(&host.stream, message.data(), message.size()));
+    }
+
+    // Lets the host tell the device where its sequence numbers start, after
+    // that the host sends the first packets of the message
+    void synchronize() {
+        ASSERT_EQ(host.sent.size(), 1);
+        EXPECT_EQ(host.sent[0][0], RAW_STREAM_SYNC);
+        deliver(device);
+        deliver(host);
+    }
+
+    bool reorder = false;
+    std::function<bool(const bytes&)> drop;
+    std::mt19937 random{1};
+};
+
+TEST_F(RawStream, ShortMessageFitsInOnePacket) {
+    bytes message = make_message(10);
+    send_message(message);
+    synchronize();
+    ASSERT_EQ(host.sent.size(), 2);
+    EXPECT_EQ(host.sent[1][0], RAW_STREAM_DATA);
+    EXPECT_EQ(host.sent[1][2], RAW_STREAM_FLAG_START | RAW_STREAM_FLAG_END);
+    EXPECT_EQ(host.sent[1][3], 10);
+    run(1);
+    ASSERT_EQ(device.received.size(), 1);
+    EXPECT_EQ(device.received[0], message);
+    EXPECT_FALSE(raw_stream_busy(&host.stream));
+}
+
+TEST_F(RawStream, LongMessageIsReassembled) {
+    bytes message = make_message(RAW_STREAM_MESSAGE_SIZE);
+    send_message(message);
+    synchronize();
+    // The window limits the packets in flight
+    EXPECT_EQ(count(host.sent, RAW_STREAM_DATA), RAW_STREAM_WINDOW);
+    run(10);
+    ASSERT_EQ(device.received.size(), 1);
+    EXPECT_EQ(device.received[0], message);
+    EXPECT_EQ(count(host.sent, RAW_STREAM_DATA), (RAW_STREAM_MESSAGE_SIZE + RAW_STREAM_PAYLOAD - 1) / RAW_STREAM_PAYLOAD);
+    EXPECT_FALSE(raw_stream_busy(&host.stream));
+}
+
+TEST_F(RawStream, PacketsAreAcknowledgedTogether) {
+    send_message(make_message(RAW_STREAM_MESSAGE_SIZE));
+    run(10);
+    ASSERT_EQ(device.received.size(), 1);
+    EXPECT_LT(count(device.sent, RAW_STREAM_ACK), count(host.sent, RAW_STREAM_DATA));
+}
+
+TEST_F(RawStream, SeveralMessagesInARow) {
+    for (int i = 0; i < 100; i++) {
+        bytes message = make_message(1 + i % RAW_STREAM_MESSAGE_SIZE, i);
+        send_message(message);
+        run(10);
+        ASSERT_EQ(device.received.size(), i + 1);
+        EXPECT_EQ(device.received.back(), message);
+    }
+}
+
+TEST_F(RawStream, OnlyOneMessageAtATime) {
+    send_message(make_message(RAW_STREAM_MESSAGE_SIZE));
+    EXPECT_FALSE(raw_stream_send(&host.stream, 1));
+    EXPECT_FALSE(raw_stream_send(&host.stream, RAW_STREAM_MESSAGE_SIZE + 1));
+    run(10);
+    EXPECT_TRUE(raw_stream_send(&host.stream, 1));
+}
+
+TEST_F(RawStream, ReplyFromTheReceiveCallback) {
+    device.on_receive = [](raw_stream_t* stream, uint8_t* message, uint16_t length) {
+        std::reverse(message, message + length);
+        EXPECT_TRUE(raw_stream_send(stream, length));
+    };
+    bytes message = make_message(100);
+    send_message(message);
+    run(10);
+    ASSERT_EQ(host.received.size(), 1);
+    std::reverse(message.begin(), message.end());
+    EXPECT_EQ(host.received[0], message);
+    EXPECT_FALSE(raw_stream_busy(&device.stream));
+}
+
+TEST_F(RawStream, ReorderedPacketsAreReassembled) {
+    bytes message = make_message(RAW_STREAM_MESSAGE_SIZE);
+    send_message(message);
+    synchronize();
+    // The whole window arrives backwards
+    std::reverse(device.inbox.begin(), device.inbox.end());
+    run(10);
+    ASSERT_EQ(device.received.size(), 1);
+    EXPECT_EQ(device.received[0], message);
+    EXPECT_EQ(count(host.sent, RAW_STREAM_DATA), (RAW_STREAM_MESSAGE_SIZE + RAW_STREAM_PAYLOAD - 1) / RAW_STREAM_PAYLOAD);
+}
+
+TEST_F(RawStream, LostPacketIsSentAgain) {
+    int data_packets = 0;
+    drop = [&data_packets](const bytes& packet) {
+        return packet[0] == RAW_STREAM_DATA && ++data_packets == 2;
+    };
+    bytes message = make_message(RAW_STREAM_MESSAGE_SIZE);
+    send_message(message);
+    run(RAW_STREAM_TIMEOUT / 2);
+    EXPECT_TRUE(device.received.empty());
+    run(RAW_STREAM_TIMEOUT);
+    ASSERT_EQ(device.received.size(), 1);
+    EXPECT_EQ(device.received[0], message);
+    // Only the lost packet is sent again, the ones after it were
+    // acknowledged already
+    EXPECT_EQ(count(host.sent, RAW_STREAM_DATA), (RAW_STREAM_MESSAGE_SIZE + RAW_STREAM_PAYLOAD - 1) / RAW_STREAM_PAYLOAD + 1);
+}
+
+TEST_F(RawStream, LostSyncIsSentAgain) {
+    drop = [](const bytes& packet) { return packet[0] == RAW_STREAM_SYNC; };
+    bytes message = make_message(10);
+    send_message(message);
+    run(RAW_STREAM_TIMEOUT * 2);
+    EXPECT_EQ(count(host.sent, RAW_STREAM_SYNC), 2);
+    EXPECT_EQ(count(host.sent, RAW_STREAM_DATA), 0);
+    drop = nullptr;
+    run(RAW_STREAM_TIMEOUT);
+    ASSERT_EQ(device.received.size(), 1);
+    EXPECT_EQ(device.received[0], message);
+}
+
+TEST_F(RawStream, LostAcknowledgementDoesntDeliverTwice) {
+    int acks = 0;
+    // The first one acknowledges the sync
+    drop = [&acks](const bytes& packet) { return packet[0] == RAW_STREAM_ACK && ++acks == 2; };
+    bytes message = make_message(10);
+    send_message(message);
+    run(RAW_STREAM_TIMEOUT * 2);
+    EXPECT_EQ(count(host.sent, RAW_STREAM_DATA), 2);
+    EXPECT_EQ(device.received.size(), 1);
+    EXPECT_FALSE(raw_stream_busy(&host.stream));
+}
+
+TEST_F(RawStream, BusyEndpointIsRetried) {
+    int attempts = 0;
+    host.can_send = [&attempts](const bytes&) { return ++attempts % 3 == 0; };
+    bytes message = make_message(RAW_STREAM_MESSAGE_SIZE);
+    send_message(message);
+    // Well before the retransmission timeout
+    run(RAW_STREAM_TIMEOUT / 2);
+    ASSERT_EQ(device.received.size(), 1);
+    EXPECT_EQ(device.received[0], message);
+}
+
+TEST_F(RawStream, FollowsTheOtherSideWhenItStartsOver) {
+    for (int i = 0; i < 5; i++) {
+        send_message(make_message(RAW_STREAM_MESSAGE_SIZE, i));
+        run(10);
+    }
+    // The host tool is restarted, and begins from sequence number 0
+    reset(host, host_send, host_receive);
+    bytes message = make_message(50);
+    send_message(message);
+    run(10);
+    ASSERT_EQ(device.received.size(), 6);
+    EXPECT_EQ(device.received.back(), message);
+    EXPECT_FALSE(raw_stream_busy(&host.stream));
+}
+
+TEST_F(RawStream, RestartedHostCancelsTheReply) {
+    device.on_receive = [](raw_stream_t* stream, uint8_t* message, uint16_t length) {
+        raw_stream_send(stream, length - 1);
+    };
+    // The host tool exits before it has received the whole reply
+    drop = [](const bytes& packet) {
+        return packet[0] == RAW_STREAM_DATA && (packet[2] & RAW_STREAM_FLAG_END) && packet[3] == 99 % RAW_STREAM_PAYLOAD;
+    };
+    send_message(make_message(100));
+    run(10);
+    ASSERT_EQ(device.received.size(), 1);
+    EXPECT_TRUE(raw_stream_busy(&device.stream));
+    drop = nullptr;
+    reset(host, host_send, host_receive);
+    bytes message = make_message(20);
+    send_message(message);
+    run(10);
+    ASSERT_EQ(host.received.size(), 1);
+    message.pop_back();
+    EXPECT_EQ(host.received[0], message);
+}
+
+TEST_F(RawStream, RestartedDeviceFollowsTheHost) {
+    device.on_receive = [](raw_stream_t* stream, uint8_t* message, uint16_t length) {
+        EXPECT_TRUE(raw_stream_send(stream, length));
+    };
+    for (int i = 0; i < 5; i++) {
+        send_message(make_message(RAW_STREAM_MESSAGE_SIZE, i));
+        run(10);
+    }
+    // The keyboard is plugged in again, but the host tool keeps running
+    auto on_receive = device.on_receive;
+    reset(device, device_send, device_receive);
+    device.on_receive = on_receive;
+    bytes message = make_message(50);
+    send_message(message);
+    run(10);
+    ASSERT_EQ(device.received.size(), 1);
+    EXPECT_EQ(device.received[0], message);
+    // The reply starts over from sequence number 0 as well
+    ASSERT_EQ(host.received.size(), 6);
+    EXPECT_EQ(host.received.back(), message);
+}
+
+TEST_F(RawStream, TooLongMessageIsDropped) {
+    // Send the packets by hand, the stream itself never sends a message that
+    // doesn't fit
+    const uint8_t packets = RAW_STREAM_MESSAGE_SIZE / RAW_STREAM_PAYLOAD + 1;
+    for (uint8_t seq = 0; seq < packets; seq++) {
+        uint8_t packet[RAW_STREAM_PACKET_SIZE] = {RAW_STREAM_DATA, seq, 0, RAW_STREAM_PAYLOAD};
+        packet[2] = (seq == 0 ? RAW_STREAM_FLAG_START : 0) | (seq == packets - 1 ? RAW_STREAM_FLAG_END : 0);
+        EXPECT_TRUE(raw_stream_receive(&device.stream, packet, sizeof(packet)));
+        run(1);
+    }
+    EXPECT_TRUE(device.received.empty());
+    // But it's acknowledged, so that the next one can be sent
+    ASSERT_GE(count(device.sent, RAW_STREAM_ACK), 1);
+    EXPECT_EQ(device.sent.back()[1], packets);
+    bytes message = make_message(10);
+    send_message(message);
+    run(10);
+    ASSERT_EQ(device.received.size(), 1);
+    EXPECT_EQ(device.received[0], message);
+}
+
+TEST_F(RawStream, OtherPacketsArentPartOfTheStream) {
+    uint8_t packet[RAW_STREAM_PACKET_SIZE] = {0x01, 0x02};
+    EXPECT_FALSE(raw_stream_receive(&device.stream, packet, sizeof(packet)));
+    EXPECT_TRUE(device.sent.empty());
+}
+
+TEST_F(RawStream, LossyLinkWithReordering) {
+    std::bernoulli_distribution lost(0.2);
+    drop = [this, &lost](const bytes&) { return lost(random); };
+    reorder = true;
+    device.on_receive = [](raw_stream_t* stream, uint8_t* message, uint16_t length) {
+        EXPECT_TRUE(raw_stream_send(stream, length));
+    };
+    std::uniform_int_distribution<uint16_t> length(1, RAW_STREAM_MESSAGE_SIZE);
+    const int messages = 300;
+    uint32_t ms = 0;
+    for (int i = 0; i < messages; i++) {
+        bytes message = make_message(length(random), i);
+        send_message(message);
+        while (host.received.size() < (size_t)i + 1 && ms < 1000000) {
+            run(1);
+            ms++;
+        }
+        ASSERT_EQ(device.received.size(), i + 1);
+        ASSERT_EQ(host.received.size(), i + 1);
+        EXPECT_EQ(device.received.back(), message);
+        EXPECT_EQ(host.received.back(), message);
+        // The sides only start a new message when the previous one is done
+        run(RAW_STREAM_TIMEOUT * 3);
+        ms += RAW_STREAM_TIMEOUT * 3;
+    }
+    std::cout << "Transferred " << messages << " messages both ways through a lossy link with "
+        << count(host.sent, RAW_STREAM_DATA) + count(device.sent, RAW_STREAM_DATA) << " data and "
+        << count(host.sent, RAW_STREAM_ACK) + count(device.sent, RAW_STREAM_ACK) << " ack packets"
+        << std::endl;
+}
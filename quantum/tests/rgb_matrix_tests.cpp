@@ -0,0 +1,315 @@
+/* Copyright 2026 QMK Firmware contributors
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "gtest/gtest.h"
+#include <cstdio>
+#include <ctime>
+#include <vector>
+extern "C" {
+#include "rgb_matrix.h"
+void set_time(uint32_t t);
+void advance_time(uint32_t ms);
+}
+
+#define KEY(row, col) {row, col, (col) * RGB_MATRIX_WIDTH / MATRIX_COLS, (row) * RGB_MATRIX_HEIGHT / MATRIX_ROWS}
+#define KEY_ROW(row) \
+    KEY(row, 0), KEY(row, 1), KEY(row, 2), KEY(row, 3), KEY(row, 4), KEY(row, 5), KEY(row, 6), KEY(row, 7), \
+    KEY(row, 8), KEY(row, 9), KEY(row, 10), KEY(row, 11), KEY(row, 12), KEY(row, 13), KEY(row, 14), KEY(row, 15)
+
+extern "C" const rgb_matrix_led_t rgb_matrix_leds[RGB_MATRIX_LED_COUNT] = {
+    KEY_ROW(0), KEY_ROW(1), KEY_ROW(2), KEY_ROW(3), KEY_ROW(4), KEY_ROW(5),
+    // The underglow in the corners
+    {RGB_MATRIX_NO_KEY, 0, 0, 0},
+    {RGB_MATRIX_NO_KEY, 0, 223, 0},
+    {RGB_MATRIX_NO_KEY, 0, 0, 63},
+    {RGB_MATRIX_NO_KEY, 0, 223, 63},
+};
+
+namespace {
+
+std::vector<std::vector<LED_TYPE>> pushed;
+
+}
+
+extern "C" void rgb_matrix_driver_setleds(LED_TYPE* leds, uint16_t count) {
+    pushed.emplace_back(leds, leds + count);
+}
+
+class RgbMatrix : public testing::Test {
+public:
+    RgbMatrix() {
+        set_time(0);
+        rgb_matrix_enable();
+        rgb_matrix_mode(RGB_MATRIX_SOLID);
+        rgb_matrix_sethsv(0, 255, 255);
+        rgb_matrix_set_speed(128);
+        rgb_matrix_init();
+        pushed.clear();
+    }
+
+    // Runs the task every millisecond, like the matrix scan does
+    void run_ms(uint32_t ms) {
+        for (uint32_t i = 0; i < ms; i++) {
+            advance_time(1);
+            rgb_matrix_task();
+        }
+    }
+
+    static bool same(const LED_TYPE& a, const LED_TYPE& b) {
+        return a.r == b.r && a.g == b.g && a.b == b.b;
+    }
+};
+
+TEST_F(RgbMatrix, InitPushesTheLedsOnce) {
+    set_time(0);
+    rgb_matrix_init();
+    EXPECT_EQ(pushed.size(), 1);
+    EXPECT_EQ(pushed[0].size(), RGB_MATRIX_LED_COUNT);
+}
+
+TEST_F(RgbMatrix, StaticColorsArePushedOnlyWhenChanged) {
+    run_ms(1000);
+    EXPECT_EQ(pushed.size(), 0);
+    rgb_matrix_sethsv(120, 255, 255);
+    run_ms(1000);
+    EXPECT_EQ(pushed.size(), 1);
+    // Setting the same color again renders, but doesn't push anything
+    rgb_matrix_sethsv(120, 255, 255);
+    run_ms(1000);
+    EXPECT_EQ(pushed.size(), 1);
+}
+
+TEST_F(RgbMatrix, SolidColorIsTheSameOnAllLeds) {
+    rgb_matrix_sethsv(240, 255, 255);
+    rgb_matrix_render();
+    ASSERT_EQ(pushed.size(), 1);
+    for (const LED_TYPE& led : pushed[0]) {
+        EXPECT_EQ(led.r, 0);
+        EXPECT_EQ(led.g, 0);
+        EXPECT_EQ(led.b, 255);
+    }
+}
+
+TEST_F(RgbMatrix, DisablingTurnsTheLedsOff) {
+    rgb_matrix_disable();
+    rgb_matrix_render();
+    ASSERT_EQ(pushed.size(), 1);
+    for (const LED_TYPE& led : pushed[0]) {
+        EXPECT_EQ(led.r | led.g | led.b, 0);
+    }
+    rgb_matrix_mode(RGB_MATRIX_CYCLE_ALL);
+    run_ms(1000);
+    EXPECT_EQ(pushed.size(), 1);
+}
+
+TEST_F(RgbMatrix, GradientFollowsThePhysicalPosition) {
+    rgb_matrix_mode(RGB_MATRIX_CYCLE_LEFT_RIGHT);
+    rgb_matrix_render();
+    ASSERT_EQ(pushed.size(), 1);
+    const std::vector<LED_TYPE>& leds = pushed[0];
+    for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+        for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+            uint8_t x = col * RGB_MATRIX_WIDTH / MATRIX_COLS;
+            LED_TYPE expected = rgb_matrix_hsv_to_rgb(x * 360 / RGB_MATRIX_WIDTH, 255, 255);
+            EXPECT_TRUE(same(leds[rgb_matrix_key_led(row, col)], expected)) << int(row) << "," << int(col);
+            // The keys in a column all have the same color
+            EXPECT_TRUE(same(leds[rgb_matrix_key_led(row, col)], leds[rgb_matrix_key_led(0, col)]));
+        }
+    }
+    EXPECT_FALSE(same(leds[rgb_matrix_key_led(0, 0)], leds[rgb_matrix_key_led(0, 8)]));
+    EXPECT_TRUE(same(leds[96], leds[98]));
+}
+
+TEST_F(RgbMatrix, AnimationsAreLimitedToTheFrameRate) {
+    rgb_matrix_mode(RGB_MATRIX_CYCLE_ALL);
+    run_ms(1000);
+    EXPECT_GE(pushed.size(), 1000 / RGB_MATRIX_FRAME_MS - 1);
+    EXPECT_LE(pushed.size(), 1000 / RGB_MATRIX_FRAME_MS + 1);
+}
+
+TEST_F(RgbMatrix, SpeedScalesTheAnimation) {
+    rgb_matrix_mode(RGB_MATRIX_CYCLE_ALL);
+    rgb_matrix_set_speed(0);
+    run_ms(1000);
+    // Frozen at the start, which looks the same as the solid color
+    EXPECT_EQ(pushed.size(), 0);
+    rgb_matrix_set_speed(255);
+    rgb_matrix_mode(RGB_MATRIX_CYCLE_ALL);
+    rgb_matrix_render();
+    advance_time(500);
+    rgb_matrix_render();
+    // Twice the normal speed, 100 degrees of hue per second
+    EXPECT_TRUE(same(pushed.back()[0], rgb_matrix_hsv_to_rgb(99, 255, 255)));
+}
+
+TEST_F(RgbMatrix, AnimationsKeepRunningForHours) {
+    rgb_matrix_mode(RGB_MATRIX_CYCLE_ALL);
+    rgb_matrix_render();
+    // Past 2^25 milliseconds, where the time in 1/128 milliseconds wraps
+    for (uint32_t ms = 60000; ms <= 10 * 3600000ul; ms += 60000) {
+        advance_time(60000);
+        rgb_matrix_render();
+        uint16_t hue = ms / 10 % 360;
+        ASSERT_TRUE(same(rgb_matrix_framebuffer()[0], rgb_matrix_hsv_to_rgb(hue, 255, 255))) << ms << "ms";
+    }
+}
+
+TEST_F(RgbMatrix, KeysMapToTheirLeds) {
+    EXPECT_EQ(rgb_matrix_key_led(0, 0), 0);
+    EXPECT_EQ(rgb_matrix_key_led(2, 5), 2 * MATRIX_COLS + 5);
+    EXPECT_EQ(rgb_matrix_key_led(5, 15), 95);
+    EXPECT_EQ(rgb_matrix_key_led(MATRIX_ROWS, 0), RGB_MATRIX_NO_LED);
+}
+
+TEST_F(RgbMatrix, ModesWrapAround) {
+    rgb_matrix_step_reverse();
+    EXPECT_EQ(rgb_matrix_get_mode(), RGB_MATRIX_MODES - 1);
+    rgb_matrix_step();
+    EXPECT_EQ(rgb_matrix_get_mode(), RGB_MATRIX_SOLID);
+}
+
+TEST_F(RgbMatrix, HueWrapsAndValueSaturates) {
+    rgb_matrix_sethsv(355, 255, 250);
+    rgb_matrix_increase_hue();
+    rgb_matrix_increase_val();
+    EXPECT_EQ(rgb_matrix_get_config()->hue, 5);
+    EXPECT_EQ(rgb_matrix_get_config()->val, 255);
+    rgb_matrix_sethsv(5, 10, 255);
+    rgb_matrix_decrease_hue();
+    rgb_matrix_decrease_sat();
+    EXPECT_EQ(rgb_matrix_get_config()->hue, 355);
+    EXPECT_EQ(rgb_matrix_get_config()->sat, 0);
+}
+
+TEST_F(RgbMatrix, RipplesSpreadFromTheKey) {
+    rgb_matrix_mode(RGB_MATRIX_RIPPLE);
+    rgb_matrix_render();
+    for (const LED_TYPE& led : pushed.back()) {
+        EXPECT_EQ(led.r | led.g | led.b, 0);
+    }
+    pushed.clear();
+    rgb_matrix_key_hit(2, 5);
+    // Nothing happens until the next frame
+    EXPECT_EQ(pushed.size(), 0);
+    run_ms(RGB_MATRIX_FRAME_MS);
+    ASSERT_EQ(pushed.size(), 1);
+    EXPECT_GT(pushed.back()[rgb_matrix_key_led(2, 5)].r, 200);
+    EXPECT_EQ(pushed.back()[rgb_matrix_key_led(0, 15)].r, 0);
+
+    // Half way, the ring has left the key and reached the far side
+    run_ms(RGB_MATRIX_HIT_MS / 2);
+    EXPECT_EQ(pushed.back()[rgb_matrix_key_led(2, 5)].r, 0);
+    EXPECT_GT(pushed.back()[rgb_matrix_key_led(2, 13)].r, 0);
+
+    // And once it's gone, nothing is pushed anymore
+    run_ms(RGB_MATRIX_HIT_MS / 2);
+    for (const LED_TYPE& led : pushed.back()) {
+        EXPECT_EQ(led.r | led.g | led.b, 0);
+    }
+    size_t count = pushed.size();
+    run_ms(1000);
+    EXPECT_EQ(pushed.size(), count);
+}
+
+TEST_F(RgbMatrix, SplashShiftsTheHueAroundTheKey) {
+    rgb_matrix_mode(RGB_MATRIX_SPLASH);
+    rgb_matrix_key_hit(3, 3);
+    run_ms(RGB_MATRIX_FRAME_MS);
+    ASSERT_EQ(pushed.size(), 1);
+    EXPECT_TRUE(same(pushed.back()[rgb_matrix_key_led(3, 3)], rgb_matrix_hsv_to_rgb(180, 255, 255)));
+    EXPECT_TRUE(same(pushed.back()[rgb_matrix_key_led(0, 15)], rgb_matrix_hsv_to_rgb(0, 255, 255)));
+}
+
+TEST_F(RgbMatrix, HeatmapWarmsUpAndCoolsDown) {
+    rgb_matrix_mode(RGB_MATRIX_HEATMAP);
+    rgb_matrix_render();
+    const LED_TYPE cold = pushed.back()[0];
+    EXPECT_TRUE(same(cold, rgb_matrix_hsv_to_rgb(240, 255, 255)));
+    for (int i = 0; i < 4; i++) {
+        rgb_matrix_key_hit(1, 1);
+    }
+    run_ms(RGB_MATRIX_FRAME_MS);
+    uint8_t led = rgb_matrix_key_led(1, 1);
+    EXPECT_FALSE(same(pushed.back()[led], cold));
+    EXPECT_TRUE(same(pushed.back()[0], cold));
+    run_ms(4 * RGB_MATRIX_HEAT_STEP * RGB_MATRIX_HEAT_DECAY_MS);
+    EXPECT_TRUE(same(pushed.back()[led], cold));
+}
+
+TEST_F(RgbMatrix, KeyHitsAreQueuedUntilTheNextFrame) {
+    rgb_matrix_mode(RGB_MATRIX_HEATMAP);
+    rgb_matrix_render();
+    pushed.clear();
+    // Only a full queue makes it to the heatmap
+    for (int i = 0; i < 1000; i++) {
+        rgb_matrix_key_hit(1, 1);
+    }
+    EXPECT_EQ(pushed.size(), 0);
+    rgb_matrix_render();
+    uint16_t hue = 240 - RGB_MATRIX_KEY_QUEUE * RGB_MATRIX_HEAT_STEP * 240 / 255;
+    EXPECT_TRUE(same(pushed.back()[rgb_matrix_key_led(1, 1)], rgb_matrix_hsv_to_rgb(hue, 255, 255)));
+}
+
+TEST_F(RgbMatrix, OtherEffectsIgnoreKeyHits) {
+    rgb_matrix_key_hit(1, 1);
+    // Keys without an LED are ignored too
+    rgb_matrix_key_hit(MATRIX_ROWS, 0);
+    run_ms(1000);
+    EXPECT_EQ(pushed.size(), 0);
+}
+
+TEST_F(RgbMatrix, KeyHitsTakeTheSameTimeForAllEffects) {
+    const int hits = 100000;
+    for (uint8_t mode = 0; mode < RGB_MATRIX_MODES; mode++) {
+        rgb_matrix_mode(mode);
+        timespec start, end;
+        clock_gettime(CLOCK_THREAD_CPUTIME_ID, &start);
+        for (int i = 0; i < hits; i++) {
+            rgb_matrix_key_hit(i % MATRIX_ROWS, i % MATRIX_COLS);
+        }
+        clock_gettime(CLOCK_THREAD_CPUTIME_ID, &end);
+        double ns = ((end.tv_sec - start.tv_sec) * 1e9 + (end.tv_nsec - start.tv_nsec)) / hits;
+        printf("Mode %d: %.1fns per key hit\n", mode, ns);
+#ifdef RGB_MATRIX_CHECK_TIME
+        EXPECT_LT(ns, 1000);
+#endif
+    }
+    // Nothing is rendered or pushed from the key events
+    EXPECT_EQ(pushed.size(), 0);
+}
+
+TEST_F(RgbMatrix, FramesAreFastEnough) {
+    const int frames = 100;
+    for (uint8_t mode = 0; mode < RGB_MATRIX_MODES; mode++) {
+        rgb_matrix_mode(mode);
+        timespec start, end;
+        clock_gettime(CLOCK_THREAD_CPUTIME_ID, &start);
+        for (int i = 0; i < frames; i++) {
+            // Keep all the ripples busy
+            rgb_matrix_key_hit(i % MATRIX_ROWS, i % MATRIX_COLS);
+            advance_time(RGB_MATRIX_FRAME_MS);
+            rgb_matrix_render();
+        }
+        clock_gettime(CLOCK_THREAD_CPUTIME_ID, &end);
+        double us = ((end.tv_sec - start.tv_sec) * 1e9 + (end.tv_nsec - start.tv_nsec)) / 1e3 / frames;
+        printf("Mode %d: %.1fus per frame of %d LEDs\n", mode, us, RGB_MATRIX_LED_COUNT);
+#ifdef RGB_MATRIX_CHECK_TIME
+        // This measures the host, so it's only checked on request, with
+        // make test:rgb_matrix EXTRAFLAGS=-DRGB_MATRIX_CHECK_TIME
+        EXPECT_LT(us, 1000);
+#endif
+    }
+}
@@ -0,0 +1,174 @@
+/* Copyright 2026 QMK Firmware contributors
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "gtest/gtest.h"
+#include <vector>
+extern "C" {
+#include "rgblight.h"
+void set_time(uint32_t t);
+void advance_time(uint32_t ms);
+}
+
+// Fast enough that the frame rate limits the rendering
+extern "C" const uint8_t RGBLED_RAINBOW_MOOD_INTERVALS[] PROGMEM = {2, 60, 30};
+
+namespace {
+
+std::vector<std::vector<LED_TYPE>> pushed;
+
+bool lit(const LED_TYPE& led) {
+    return led.r || led.g || led.b;
+}
+
+}
+
+extern "C" void rgblight_set(void) {
+    pushed.emplace_back(led, led + RGBLED_NUM);
+}
+
+class Rgblight : public testing::Test {
+public:
+    Rgblight() {
+        set_time(0);
+        eeconfig_init();
+        rgblight_init();
+        rgblight_enable();
+        rgblight_sethsv(0, 255, 255);
+        pushed.clear();
+    }
+
+    void start(uint8_t mode) {
+        rgblight_mode(mode);
+        pushed.clear();
+    }
+
+    // Runs the task every millisecond, like the main loop does
+    void run_ms(uint32_t ms) {
+        for (uint32_t i = 0; i < ms; i++) {
+            rgblight_task();
+            advance_time(1);
+        }
+    }
+
+    static std::vector<uint8_t> lit_leds(const std::vector<LED_TYPE>& leds) {
+        std::vector<uint8_t> result;
+        for (uint8_t i = 0; i < leds.size(); i++) {
+            if (lit(leds[i])) {
+                result.push_back(i);
+            }
+        }
+        return result;
+    }
+
+    static bool same(const std::vector<LED_TYPE>& a, const std::vector<LED_TYPE>& b) {
+        for (size_t i = 0; i < a.size(); i++) {
+            if (a[i].r != b[i].r || a[i].g != b[i].g || a[i].b != b[i].b) {
+                return false;
+            }
+        }
+        return a.size() == b.size();
+    }
+};
+
+TEST_F(Rgblight, EffectsRenderTheSameFramesEveryTime) {
+    for (uint8_t mode = 2; mode <= 24; mode++) {
+        set_time(0);
+        start(mode);
+        run_ms(3000);
+        std::vector<std::vector<LED_TYPE>> first = pushed;
+        EXPECT_GT(first.size(), 2) << "mode " << int(mode);
+
+        set_time(0);
+        start(1);
+        start(mode);
+        run_ms(3000);
+        ASSERT_EQ(pushed.size(), first.size()) << "mode " << int(mode);
+        for (size_t i = 0; i < pushed.size(); i++) {
+            EXPECT_TRUE(same(pushed[i], first[i])) << "mode " << int(mode) << " frame " << i;
+        }
+    }
+}
+
+TEST_F(Rgblight, StaticModesDontRender) {
+    start(1);
+    run_ms(1000);
+    EXPECT_EQ(pushed.size(), 0);
+    start(25);
+    run_ms(1000);
+    EXPECT_EQ(pushed.size(), 0);
+}
+
+TEST_F(Rgblight, KnightMovesOneLedPerInterval) {
+    start(21);
+    const uint8_t interval = RGBLED_KNIGHT_INTERVALS[0];
+    run_ms(1);
+    ASSERT_EQ(pushed.size(), 1);
+    EXPECT_EQ(lit_leds(pushed.back()), std::vector<uint8_t>({0, 1, 2}));
+    run_ms(interval);
+    ASSERT_EQ(pushed.size(), 2);
+    EXPECT_EQ(lit_leds(pushed.back()), std::vector<uint8_t>({1, 2, 3}));
+    run_ms(interval * 3);
+    ASSERT_EQ(pushed.size(), 5);
+    EXPECT_EQ(lit_leds(pushed.back()), std::vector<uint8_t>({4, 5, 6}));
+}
+
+TEST_F(Rgblight, SelectingAModeRestartsTheEffect) {
+    start(21);
+    run_ms(RGBLED_KNIGHT_INTERVALS[0] * 5);
+    start(21);
+    run_ms(1);
+    EXPECT_EQ(lit_leds(pushed.back()), std::vector<uint8_t>({0, 1, 2}));
+}
+
+TEST_F(Rgblight, FrameRateIsLimitedWithoutSlowingTheEffect) {
+    start(6);
+    // Up to and including the frame at 1000ms
+    run_ms(1001);
+    EXPECT_LE(pushed.size(), RGBLIGHT_FPS + 1);
+    EXPECT_GE(pushed.size(), RGBLIGHT_FPS - 1);
+    // 500 steps of the 2ms interval, in 100 frames
+    LED_TYPE expected;
+    sethsv(500 % 360, 255, 255, &expected);
+    EXPECT_TRUE(same(pushed.back(), std::vector<LED_TYPE>(RGBLED_NUM, expected)));
+}
+
+TEST_F(Rgblight, TheOtherHalfContinuesFromTheSyncedState) {
+    start(9);
+    const uint8_t interval = RGBLED_RAINBOW_SWIRL_INTERVALS[0];
+    run_ms(interval * 10 + 1);
+    rgblight_effect_sync_t sync;
+    rgblight_get_effect_sync(&sync);
+    uint32_t synced_at = interval * 10;
+
+    pushed.clear();
+    run_ms(interval * 20);
+    std::vector<std::vector<LED_TYPE>> master = pushed;
+
+    // Start over with a different state, and sync to the saved one
+    start(15);
+    set_time(synced_at);
+    rgblight_set_effect_sync(&sync);
+    EXPECT_EQ(rgblight_get_mode(), 9);
+    run_ms(1);
+    // The synced state is rendered right away, then the same frames follow
+    ASSERT_EQ(pushed.size(), 1);
+    pushed.clear();
+    run_ms(interval * 20);
+    ASSERT_EQ(pushed.size(), master.size());
+    for (size_t i = 0; i < pushed.size(); i++) {
+        EXPECT_TRUE(same(pushed[i], master[i])) << "frame " << i;
+    }
+}
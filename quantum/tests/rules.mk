@@ -0,0 +1,51 @@
+# Copyright 2026 QMK Firmware contributors
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 2 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+debounce_DEFS := -DDEBOUNCE=13
+debounce_INC := $(QUANTUM_PATH)/tests
+debounce_SRC := $(QUANTUM_PATH)/tests/debounce_tests.cpp
+
+keymap_compact_SRC := \
+	$(QUANTUM_PATH)/tests/keymap_compact_tests.cpp \
+	$(QUANTUM_PATH)/keymap_compact_pack.c
+
+rgb_matrix_DEFS := -DRGB_MATRIX_CUSTOM_DRIVER -DUSE_CIE1931_CURVE -DNO_PRINT
+rgb_matrix_INC := $(QUANTUM_PATH)/tests
+rgb_matrix_SRC := \
+	$(QUANTUM_PATH)/tests/rgb_matrix_tests.cpp \
+	$(QUANTUM_PATH)/rgb_matrix.c \
+	$(QUANTUM_PATH)/led_tables.c \
+	$(TMK_PATH)/common/test/timer.c
+
+rgblight_DEFS := \
+	-DRGBLIGHT_ENABLE -DRGBLIGHT_ANIMATIONS -DRGBLIGHT_CUSTOM_DRIVER -DRGBLED_NUM=16 \
+	-DUSE_CIE1931_CURVE -DNO_PRINT
+rgblight_SRC := \
+	$(QUANTUM_PATH)/tests/rgblight_tests.cpp \
+	$(QUANTUM_PATH)/rgblight.c \
+	$(QUANTUM_PATH)/led_tables.c \
+	$(TMK_PATH)/common/eeconfig.c \
+	$(TMK_PATH)/common/debug.c \
+	$(TMK_PATH)/common/test/eeprom.c \
+	$(TMK_PATH)/common/test/timer.c
+
+ucis_index_SRC := \
+	$(QUANTUM_PATH)/tests/ucis_index_tests.cpp \
+	$(QUANTUM_PATH)/process_keycode/process_ucis_index.c
+
+raw_stream_SRC := \
+	$(QUANTUM_PATH)/tests/raw_stream_tests.cpp \
+	$(QUANTUM_PATH)/raw_stream.c \
+	$(TMK_PATH)/common/test/timer.c
@@ -0,0 +1,7 @@
+TEST_LIST +=\
+	debounce\
+	keymap_compact\
+	raw_stream\
+	rgb_matrix\
+	rgblight\
+	ucis_index
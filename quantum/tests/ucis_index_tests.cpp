@@ -0,0 +1,187 @@
+/* Copyright 2026 QMK Firmware contributors
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "gtest/gtest.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <set>
+#include <string>
+#include <vector>
+extern "C" {
+#include "process_ucis_index.h"
+}
+
+namespace {
+
+const int Symbols = 2000;
+
+// A symbol table that ends with a NULL symbol, like UCIS_TABLE
+struct table_t {
+    std::vector<std::string> names;
+    std::vector<qk_ucis_symbol_t> symbols;
+
+    explicit table_t(const std::vector<std::string>& names) : names(names) {
+        for (std::string& name : this->names) {
+            symbols.push_back({&name[0], (char*)"0x2603"});
+        }
+        symbols.push_back({nullptr, nullptr});
+    }
+};
+
+// Names of two to six letters and digits, where some are the prefixes of
+// others
+std::vector<std::string> random_names(int count) {
+    std::mt19937 rng(1);
+    const char chars[] = "abcdefghijklmnopqrstuvwxyz1234567890";
+    std::set<std::string> names;
+    while ((int)names.size() < count) {
+        std::string name;
+        int length = 2 + rng() % 5;
+        for (int i = 0; i < length; i++) {
+            name += chars[rng() % (sizeof(chars) - 1)];
+        }
+        names.insert(name);
+        if (name.size() > 3 && (int)names.size() < count) {
+            names.insert(name.substr(0, 3));
+        }
+    }
+    return std::vector<std::string>(names.begin(), names.end());
+}
+
+std::vector<std::string> shuffled(std::vector<std::string> names) {
+    std::shuffle(names.begin(), names.end(), std::mt19937(2));
+    return names;
+}
+
+const qk_ucis_symbol_t* type(ucis_index_t* index, const std::string& text) {
+    ucis_index_reset(index);
+    for (char c : text) {
+        ucis_index_narrow(index, c);
+    }
+    return ucis_index_find(index);
+}
+
+// The original lookup, which compared the input with every symbol
+const qk_ucis_symbol_t* linear_find(const qk_ucis_symbol_t* table, const std::string& text) {
+    for (int i = 0; table[i].symbol; i++) {
+        if (text == table[i].symbol) {
+            return &table[i];
+        }
+    }
+    return nullptr;
+}
+
+}
+
+TEST(UcisIndex, DetectsSortedTables) {
+    ucis_index_t index;
+    table_t sorted(random_names(100));
+    ucis_index_init(&index, &sorted.symbols[0]);
+    EXPECT_TRUE(index.sorted);
+    EXPECT_EQ(index.size, 100);
+    table_t unsorted(shuffled(random_names(100)));
+    ucis_index_init(&index, &unsorted.symbols[0]);
+    EXPECT_FALSE(index.sorted);
+}
+
+TEST(UcisIndex, FindsEverySymbol) {
+    for (bool sort : {true, false}) {
+        std::vector<std::string> names = random_names(Symbols);
+        table_t table(sort ? names : shuffled(names));
+        ucis_index_t index;
+        ucis_index_init(&index, &table.symbols[0]);
+        for (size_t i = 0; i < table.names.size(); i++) {
+            EXPECT_EQ(type(&index, table.names[i]), &table.symbols[i]) << table.names[i];
+        }
+    }
+}
+
+TEST(UcisIndex, APrefixOfASymbolIsNotFound) {
+    table_t table({"coffee", "heart", "snowman"});
+    ucis_index_t index;
+    ucis_index_init(&index, &table.symbols[0]);
+    EXPECT_EQ(type(&index, "coff"), nullptr);
+    EXPECT_EQ(type(&index, "coffees"), nullptr);
+    EXPECT_EQ(type(&index, ""), nullptr);
+}
+
+TEST(UcisIndex, NoMatchIsNoticedAtTheFirstWrongCharacter) {
+    for (bool sort : {true, false}) {
+        std::vector<std::string> names = {"bolt", "coffee", "cold", "heart", "snowman"};
+        table_t table(sort ? names : shuffled(names));
+        ucis_index_t index;
+        ucis_index_init(&index, &table.symbols[0]);
+        EXPECT_TRUE(ucis_index_narrow(&index, 'c'));
+        EXPECT_TRUE(ucis_index_narrow(&index, 'o'));
+        EXPECT_TRUE(ucis_index_narrow(&index, 'l'));
+        EXPECT_FALSE(ucis_index_narrow(&index, 'f'));
+        EXPECT_FALSE(ucis_index_narrow(&index, 'e'));
+        EXPECT_EQ(ucis_index_find(&index), nullptr);
+    }
+}
+
+TEST(UcisIndex, ShorterSymbolsInTheMiddleOfAnUnsortedTableAreSkipped) {
+    // The candidates are bounded by "heart" and "hex", "h" is in between but
+    // too short to be compared with the third character
+    table_t table({"heart", "h", "he", "x", "hex"});
+    ucis_index_t index;
+    ucis_index_init(&index, &table.symbols[0]);
+    EXPECT_EQ(type(&index, "hex"), &table.symbols[4]);
+    EXPECT_EQ(type(&index, "he"), &table.symbols[2]);
+}
+
+TEST(UcisIndex, TheFirstOfTheSameSymbolsIsFound) {
+    for (bool sort : {true, false}) {
+        table_t table(sort ? std::vector<std::string>{"a", "pi", "pi", "z"}
+                           : std::vector<std::string>{"z", "pi", "a", "pi"});
+        ucis_index_t index;
+        ucis_index_init(&index, &table.symbols[0]);
+        EXPECT_EQ(type(&index, "pi"), &table.symbols[1]);
+    }
+}
+
+TEST(UcisIndex, Benchmark) {
+    using clock = std::chrono::steady_clock;
+    std::vector<std::string> names = random_names(Symbols);
+    table_t sorted(names);
+    table_t unsorted(shuffled(names));
+    ucis_index_t sorted_index, unsorted_index;
+    ucis_index_init(&sorted_index, &sorted.symbols[0]);
+    ucis_index_init(&unsorted_index, &unsorted.symbols[0]);
+
+    double linear_ns = 0, sorted_ns = 0, unsorted_ns = 0;
+    for (const std::string& name : names) {
+        auto start = clock::now();
+        const qk_ucis_symbol_t* expected = linear_find(&unsorted.symbols[0], name);
+        auto linear_end = clock::now();
+        const qk_ucis_symbol_t* found_sorted = type(&sorted_index, name);
+        auto sorted_end = clock::now();
+        const qk_ucis_symbol_t* found_unsorted = type(&unsorted_index, name);
+        auto unsorted_end = clock::now();
+
+        ASSERT_NE(found_sorted, nullptr);
+        EXPECT_EQ(found_unsorted, expected);
+        EXPECT_STREQ(found_sorted->symbol, expected->symbol);
+        linear_ns += std::chrono::duration<double, std::nano>(linear_end - start).count();
+        sorted_ns += std::chrono::duration<double, std::nano>(sorted_end - linear_end).count();
+        unsorted_ns += std::chrono::duration<double, std::nano>(unsorted_end - sorted_end).count();
+    }
+    printf("%d symbols, average per symbol: linear %.0fns, sorted index %.0fns, unsorted index %.0fns\n",
+           Symbols, linear_ns / Symbols, sorted_ns / Symbols, unsorted_ns / Symbols);
+}
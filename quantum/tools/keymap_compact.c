@@ -0,0 +1,85 @@
+/* Copyright 2026 QMK Firmware contributors
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/* Host tool that converts the raw contents of the keymaps array, as extracted
+ * from the compiled keymap object, into the compacted keymap tables.
+ *
+ * Usage: keymap_compact <keymaps.bin> <output.c>
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "keymap_compact.h"
+
+#define MAX_CELLS 0xFFFF
+
+static void write_table(FILE* out, const char* name, const uint16_t* data, uint16_t size) {
+    fprintf(out, "const uint16_t %s[] PROGMEM = {", name);
+    for (uint16_t i = 0; i < size; i++) {
+        fprintf(out, "%s0x%04X,", i % 8 ? " " : "\n    ", data[i]);
+    }
+    fprintf(out, "\n};\n\n");
+}
+
+int main(int argc, char** argv) {
+    if (argc != 3) {
+        fprintf(stderr, "Usage: %s <keymaps.bin> <output.c>\n", argv[0]);
+        return 1;
+    }
+    FILE* in = fopen(argv[1], "rb");
+    if (!in) {
+        perror(argv[1]);
+        return 1;
+    }
+    static uint16_t dense[MAX_CELLS];
+    uint32_t num_cells = 0;
+    int lo, hi;
+    // The keymaps are stored little endian on all supported platforms
+    while ((lo = fgetc(in)) != EOF && (hi = fgetc(in)) != EOF) {
+        if (num_cells == MAX_CELLS) {
+            fprintf(stderr, "%s: too many keymap cells\n", argv[1]);
+            return 1;
+        }
+        dense[num_cells++] = lo | (hi << 8);
+    }
+    fclose(in);
+    if (num_cells == 0) {
+        fprintf(stderr, "%s: no keymaps found\n", argv[1]);
+        return 1;
+    }
+
+    static uint16_t bitmap[KEYMAP_COMPACT_BLOCKS(MAX_CELLS)];
+    static uint16_t base[KEYMAP_COMPACT_BLOCKS(MAX_CELLS)];
+    static uint16_t keycodes[MAX_CELLS];
+    uint16_t num_keycodes = keymap_compact_pack(dense, num_cells, bitmap, base, keycodes);
+
+    FILE* out = fopen(argv[2], "w");
+    if (!out) {
+        perror(argv[2]);
+        return 1;
+    }
+    fprintf(out, "/* Generated by quantum/tools/keymap_compact.c, do not edit */\n\n");
+    fprintf(out, "#include \"keymap_compact.h\"\n\n");
+    fprintf(out, "/* %u cells, %u keycodes, %u bytes instead of %u */\n",
+        num_cells, num_keycodes,
+        2 * (2 * KEYMAP_COMPACT_BLOCKS(num_cells) + num_keycodes + 1), 2 * num_cells);
+    fprintf(out, "const uint16_t keymap_compact_num_cells PROGMEM = %u;\n\n", num_cells);
+    write_table(out, "keymap_compact_bitmap", bitmap, KEYMAP_COMPACT_BLOCKS(num_cells));
+    write_table(out, "keymap_compact_base", base, KEYMAP_COMPACT_BLOCKS(num_cells));
+    // Keep the array valid even if everything is transparent
+    write_table(out, "keymap_compact_keycodes", keycodes, num_keycodes ? num_keycodes : 1);
+    return fclose(out) == 0 ? 0 : 1;
+}
@@ -0,0 +1,153 @@
+/* Copyright 2026 QMK Firmware contributors
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/* Linux host tool that sends PING messages of every length to a keyboard
+ * with RAW_STREAM_ENABLE, through hidraw, and checks that they come back
+ * unchanged. It runs the same transport code as the keyboard.
+ *
+ * Build:  cc -Iquantum -Itmk_core/common quantum/tools/raw_stream_loopback.c \
+ *             quantum/raw_stream.c -o raw_stream_loopback
+ * Usage:  raw_stream_loopback /dev/hidrawN [rounds]
+ *
+ * The RAW_STREAM_* settings have to match the keyboard, the tool checks
+ * them with GET_INFO before it starts.
+ */
+
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include "raw_stream.h"
+#include "timer.h"
+
+static int device = -1;
+static uint8_t buffer[RAW_STREAM_MESSAGE_SIZE];
+static uint8_t reply[RAW_STREAM_MESSAGE_SIZE];
+static uint16_t reply_length;
+static bool replied;
+static unsigned long packets_sent;
+
+static uint32_t now_ms(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000 + ts.tv_nsec / 1000000;
+}
+
+uint16_t timer_read(void) { return now_ms() & 0xFFFF; }
+uint16_t timer_elapsed(uint16_t last) { return TIMER_DIFF_16(timer_read(), last); }
+
+static bool send_packet(uint8_t* packet, uint8_t length) {
+    // The first byte is the report id, the raw HID interface doesn't use one
+    uint8_t report[RAW_STREAM_PACKET_SIZE + 1] = {0};
+    memcpy(&report[1], packet, length);
+    if (write(device, report, sizeof(report)) < 0) {
+        if (errno == EAGAIN) {
+            return false;
+        }
+        perror("write");
+        exit(1);
+    }
+    packets_sent++;
+    return true;
+}
+
+static void receive_message(raw_stream_t* stream, uint8_t* message, uint16_t length) {
+    memcpy(reply, message, length);
+    reply_length = length;
+    replied = true;
+}
+
+static raw_stream_t stream = RAW_STREAM_INITIALIZER(buffer, send_packet, receive_message);
+
+// Sends a message and waits for the reply, returns false on timeout
+static bool transact(const uint8_t* message, uint16_t length) {
+    replied = false;
+    if (!raw_stream_send_copy(&stream, message, length)) {
+        fprintf(stderr, "The stream is busy\n");
+        return false;
+    }
+    uint32_t start = now_ms();
+    while (!replied && now_ms() - start < 2000) {
+        struct pollfd fd = {.fd = device, .events = POLLIN};
+        if (poll(&fd, 1, 1) > 0) {
+            uint8_t packet[RAW_STREAM_PACKET_SIZE];
+            ssize_t size = read(device, packet, sizeof(packet));
+            if (size < 0) {
+                perror("read");
+                exit(1);
+            }
+            raw_stream_receive(&stream, packet, size);
+        }
+        raw_stream_task(&stream);
+    }
+    return replied;
+}
+
+int main(int argc, char** argv) {
+    if (argc < 2 || argc > 3) {
+        fprintf(stderr, "Usage: %s /dev/hidrawN [rounds]\n", argv[0]);
+        return 1;
+    }
+    int rounds = argc == 3 ? atoi(argv[2]) : 10;
+    device = open(argv[1], O_RDWR | O_NONBLOCK);
+    if (device < 0) {
+        perror(argv[1]);
+        return 1;
+    }
+
+    uint8_t info[] = {RAW_STREAM_GET_INFO};
+    if (!transact(info, sizeof(info))) {
+        fprintf(stderr, "No reply to GET_INFO, is RAW_STREAM_ENABLE on?\n");
+        return 1;
+    }
+    if (reply_length < 5 || reply[0] != RAW_STREAM_GET_INFO || reply[1] != RAW_STREAM_PACKET_SIZE ||
+        ((reply[2] << 8) | reply[3]) != RAW_STREAM_MESSAGE_SIZE || reply[4] != RAW_STREAM_WINDOW) {
+        fprintf(stderr, "The keyboard uses different RAW_STREAM settings\n");
+        return 1;
+    }
+
+    srand(time(NULL));
+    uint8_t message[RAW_STREAM_MESSAGE_SIZE];
+    unsigned long bytes = 0;
+    packets_sent = 0;
+    uint32_t start = now_ms();
+    for (int round = 0; round < rounds; round++) {
+        for (uint16_t length = 1; length <= RAW_STREAM_MESSAGE_SIZE; length++) {
+            message[0] = RAW_STREAM_PING;
+            for (uint16_t i = 1; i < length; i++) {
+                message[i] = rand();
+            }
+            if (!transact(message, length)) {
+                fprintf(stderr, "No reply to a PING of %u bytes\n", length);
+                return 1;
+            }
+            if (reply_length != length || memcmp(reply, message, length) != 0) {
+                fprintf(stderr, "The reply to a PING of %u bytes is different\n", length);
+                return 1;
+            }
+            bytes += length;
+        }
+    }
+    uint32_t elapsed = now_ms() - start;
+    printf("%lu bytes echoed in %u ms, %lu bytes/s, %lu packets sent\n",
+        bytes, elapsed, elapsed ? bytes * 1000 / elapsed : 0, packets_sent);
+    close(device);
+    return 0;
+}
@@ -0,0 +1,138 @@
+/* Copyright 2026 QMK Firmware contributors
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+/* Host tool that turns the binary records of a keyboard with TRACE_ENABLE
+ * back into text. It reads the console output from stdin, passes the
+ * printed text through, and formats each record with the table of
+ * tmk_core/common/trace_formats.h, which has to be the same version as the
+ * one the keyboard was built with.
+ *
+ * Build:  cc -Itmk_core/common quantum/tools/trace_decode.c -o trace_decode
+ * Usage:  hid_listen | trace_decode
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include "trace.h"
+
+#define TRACE_FORMAT(name) [name] = name##_FMT,
+static const char* formats[TRACE_COUNT] = {
+    TRACE_FORMATS(TRACE_FORMAT)
+};
+
+#define MAX_ARGS 16
+
+// The number of arguments, which is the number of conversions
+static unsigned count_args(const char* format) {
+    unsigned count = 0;
+    for (const char* c = format; *c; c++) {
+        if (*c == '%') {
+            if (c[1] == '%') {
+                c++;
+            } else {
+                count++;
+            }
+        }
+    }
+    return count;
+}
+
+static void print_record(const char* format, const uint16_t* args) {
+    unsigned arg = 0;
+    for (const char* c = format; *c; c++) {
+        if (*c != '%') {
+            putchar(*c);
+            continue;
+        }
+        if (c[1] == '%') {
+            putchar('%');
+            c++;
+            continue;
+        }
+        // Copy the flags and the width, and drop the length, the arguments
+        // are all 16 bit
+        char conversion[16] = "%";
+        size_t length = 1;
+        for (c++; *c && strchr("-+ #0123456789", *c) && length < sizeof(conversion) - 2; c++) {
+            conversion[length++] = *c;
+        }
+        while (*c == 'l' || *c == 'h') {
+            c++;
+        }
+        if (!*c) {
+            break;
+        }
+        conversion[length++] = *c;
+        conversion[length] = 0;
+        if (*c == 'd' || *c == 'i') {
+            printf(conversion, (int)(int16_t)args[arg]);
+        } else if (*c == 'c') {
+            printf(conversion, (int)(args[arg] & 0xFF));
+        } else {
+            printf(conversion, (unsigned)args[arg]);
+        }
+        arg++;
+    }
+}
+
+int main(void) {
+    int c;
+    uint16_t args[MAX_ARGS];
+    setvbuf(stdout, NULL, _IOLBF, 0);
+    while ((c = getchar()) != EOF) {
+        if (c < TRACE_RECORD_MARK) {
+            // The console packets are padded with zeros
+            if (c) {
+                putchar(c);
+            }
+            continue;
+        }
+        uint8_t id = c & ~TRACE_RECORD_MARK;
+        if (id == TRACE_NONE || id >= TRACE_COUNT) {
+            printf("<unknown trace %u>", id);
+            continue;
+        }
+        unsigned count = count_args(formats[id]);
+        unsigned i;
+        for (i = 0; i < count && i < MAX_ARGS; i++) {
+            uint16_t arg = 0;
+            unsigned b;
+            for (b = 0; b < TRACE_ARG_BYTES; b++) {
+                c = getchar();
+                if (c == EOF || c < TRACE_RECORD_MARK) {
+                    break;
+                }
+                arg |= (uint16_t)(c & ~TRACE_RECORD_MARK) << (7 * b);
+            }
+            if (b < TRACE_ARG_BYTES) {
+                break;
+            }
+            args[i] = arg;
+        }
+        if (i < count) {
+            // Cut off by a reset, or the decoder doesn't match the keyboard
+            printf("<broken trace %u>", id);
+            if (c != EOF) {
+                ungetc(c, stdin);
+            }
+            continue;
+        }
+        print_record(formats[id], args);
+    }
+    return 0;
+}
@@ -0,0 +1,111 @@
+/* Copyright 2026 QMK Firmware contributors
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _GFX_H
+#define _GFX_H
+
+/* A native stand-in for the parts of uGFX that the visualizer uses
+ *
+ * The displays are kept in memory, with one byte of luma per pixel, and the
+ * time only advances when gfx_simulator_advance is called, so that the
+ * visualizer can run on the host without ChibiOS or a real uGFX build. See
+ * gfx_simulator.h for the functions used to inspect the displays.
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifndef TRUE
+#define TRUE 1
+#endif
+#ifndef FALSE
+#define FALSE 0
+#endif
+
+typedef bool bool_t;
+
+// One tick is one millisecond
+typedef uint32_t systemticks_t;
+typedef uint32_t delaytime_t;
+#define TIME_IMMEDIATE 0
+#define TIME_INFINITE ((systemticks_t)-1)
+#define gfxMillisecondsToTicks(ms) ((systemticks_t)(ms))
+
+typedef int16_t coord_t;
+typedef uint8_t color_t;
+typedef color_t pixel_t;
+#define LUMA2COLOR(l) ((color_t)(l))
+#define White 255
+#define Black 0
+
+typedef enum {
+    powerOff,
+    powerSleep,
+    powerDeepSleep,
+    powerOn,
+} powermode_t;
+
+typedef enum {
+    GDISP_ROTATE_0 = 0,
+    GDISP_ROTATE_90 = 90,
+    GDISP_ROTATE_180 = 180,
+    GDISP_ROTATE_270 = 270,
+} orientation_t;
+
+typedef struct GDisplay GDisplay;
+typedef const struct gfx_simulator_font* font_t;
+
+// The event system is only used to wake up the visualizer thread, the
+// simulator just counts the events
+typedef void* GSourceHandle;
+typedef struct GSourceListener GSourceListener;
+
+void gfxInit(void);
+systemticks_t gfxSystemTicks(void);
+// There's only one thread, so there's nothing to lock
+#define gfxSystemLock()
+#define gfxSystemUnlock()
+
+GSourceListener* geventGetSourceListener(GSourceHandle gsh, GSourceListener* lastlr);
+void geventSendEvent(GSourceListener* psl);
+
+extern GDisplay* GDISP;
+GDisplay* gdispGetDisplay(unsigned display);
+
+void gdispGClear(GDisplay* g, color_t color);
+void gdispGDrawPixel(GDisplay* g, coord_t x, coord_t y, color_t color);
+void gdispGDrawLine(GDisplay* g, coord_t x0, coord_t y0, coord_t x1, coord_t y1, color_t color);
+color_t gdispGGetPixelColor(GDisplay* g, coord_t x, coord_t y);
+// The bitmap has one bit per pixel, most significant bit first, like the
+// images in the resources folder
+void gdispGBlitArea(GDisplay* g, coord_t x, coord_t y, coord_t cx, coord_t cy,
+        coord_t srcx, coord_t srcy, coord_t srccx, const pixel_t* buffer);
+void gdispGDrawString(GDisplay* g, coord_t x, coord_t y, const char* str, font_t font, color_t color);
+void gdispGSetPowerMode(GDisplay* g, powermode_t mode);
+void gdispGSetOrientation(GDisplay* g, orientation_t orientation);
+void gdispGSetBacklight(GDisplay* g, uint8_t percent);
+void gdispGFlush(GDisplay* g);
+
+font_t gdispOpenFont(const char* name);
+void gdispCloseFont(font_t font);
+
+#define gdispClear(c) gdispGClear(GDISP, c)
+#define gdispDrawPixel(x, y, c) gdispGDrawPixel(GDISP, x, y, c)
+#define gdispDrawString(x, y, s, f, c) gdispGDrawString(GDISP, x, y, s, f, c)
+#define gdispSetPowerMode(m) gdispGSetPowerMode(GDISP, m)
+#define gdispFlush() gdispGFlush(GDISP)
+
+#endif
@@ -0,0 +1,288 @@
+/* Copyright 2026 QMK Firmware contributors
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "gfx_simulator.h"
+#include <stdio.h>
+#include <string.h>
+#include "lcd_backlight.h"
+// The Adafruit 5x7 font, used for all the fonts
+#include "glcdfont.c"
+
+#ifndef GFX_SIMULATOR_MAX_PIXELS
+#define GFX_SIMULATOR_MAX_PIXELS (128 * 64)
+#endif
+
+struct GDisplay {
+    coord_t width;
+    coord_t height;
+    orientation_t orientation;
+    powermode_t power;
+    uint8_t backlight;
+    uint32_t flushes;
+    color_t pixels[GFX_SIMULATOR_MAX_PIXELS];
+};
+
+struct GSourceListener {
+    uint32_t events;
+};
+
+struct gfx_simulator_font {
+    const char* name;
+};
+
+static const struct gfx_simulator_font fonts[] = {
+    {"fixed_5x8"},
+    {"DejaVuSansBold12"},
+};
+
+#define FONT_WIDTH 5
+#define FONT_HEIGHT 8
+
+static GDisplay displays[GFX_SIMULATOR_DISPLAYS];
+static systemticks_t ticks;
+static uint16_t lcd_backlight[3];
+static GSourceListener listener;
+
+GDisplay* GDISP = &displays[0];
+
+static void init_display(unsigned display, coord_t width, coord_t height) {
+    GDisplay* g = &displays[display];
+    memset(g, 0, sizeof(*g));
+    g->width = width;
+    g->height = height;
+    g->orientation = GDISP_ROTATE_0;
+    g->power = powerOn;
+    g->backlight = 100;
+}
+
+void gfx_simulator_reset(void) {
+    for (unsigned i = 0; i < GFX_SIMULATOR_DISPLAYS; i++) {
+        init_display(i, 0, 0);
+    }
+#ifdef LCD_DISPLAY_NUMBER
+    _Static_assert(LCD_WIDTH * LCD_HEIGHT <= GFX_SIMULATOR_MAX_PIXELS, "The LCD is too big for the simulator");
+    init_display(LCD_DISPLAY_NUMBER, LCD_WIDTH, LCD_HEIGHT);
+#endif
+#ifdef LED_DISPLAY_NUMBER
+    _Static_assert(LED_WIDTH * LED_HEIGHT <= GFX_SIMULATOR_MAX_PIXELS, "The LED display is too big for the simulator");
+    init_display(LED_DISPLAY_NUMBER, LED_WIDTH, LED_HEIGHT);
+#endif
+    GDISP = &displays[0];
+    ticks = 0;
+    memset(lcd_backlight, 0, sizeof(lcd_backlight));
+    listener.events = 0;
+}
+
+void gfx_simulator_advance(systemticks_t t) {
+    ticks += t;
+}
+
+void gfxInit(void) {
+}
+
+systemticks_t gfxSystemTicks(void) {
+    return ticks;
+}
+
+// There's always someone listening, so that the events can be counted
+GSourceListener* geventGetSourceListener(GSourceHandle gsh, GSourceListener* lastlr) {
+    (void)gsh;
+    return lastlr ? NULL : &listener;
+}
+
+void geventSendEvent(GSourceListener* psl) {
+    psl->events++;
+}
+
+GDisplay* gdispGetDisplay(unsigned display) {
+    return display < GFX_SIMULATOR_DISPLAYS ? &displays[display] : NULL;
+}
+
+// Returns the pixel at the given coordinates, rotated like the uGFX
+// drivers do it, or NULL when it's outside of the display
+static color_t* pixel(GDisplay* g, coord_t x, coord_t y) {
+    coord_t px = x;
+    coord_t py = y;
+    switch (g->orientation) {
+    case GDISP_ROTATE_90:
+        px = g->width - 1 - y;
+        py = x;
+        break;
+    case GDISP_ROTATE_180:
+        px = g->width - 1 - x;
+        py = g->height - 1 - y;
+        break;
+    case GDISP_ROTATE_270:
+        px = y;
+        py = g->height - 1 - x;
+        break;
+    default:
+        break;
+    }
+    if (px < 0 || py < 0 || px >= g->width || py >= g->height) {
+        return NULL;
+    }
+    return &g->pixels[py * g->width + px];
+}
+
+void gdispGClear(GDisplay* g, color_t color) {
+    memset(g->pixels, color, (size_t)g->width * g->height);
+}
+
+void gdispGDrawPixel(GDisplay* g, coord_t x, coord_t y, color_t color) {
+    color_t* p = pixel(g, x, y);
+    if (p) {
+        *p = color;
+    }
+}
+
+void gdispGDrawLine(GDisplay* g, coord_t x0, coord_t y0, coord_t x1, coord_t y1, color_t color) {
+    int dx = x1 > x0 ? x1 - x0 : x0 - x1;
+    int dy = y1 > y0 ? y0 - y1 : y1 - y0;
+    int sx = x0 < x1 ? 1 : -1;
+    int sy = y0 < y1 ? 1 : -1;
+    int err = dx + dy;
+    while (true) {
+        gdispGDrawPixel(g, x0, y0, color);
+        if (x0 == x1 && y0 == y1) {
+            break;
+        }
+        int e2 = 2 * err;
+        if (e2 >= dy) {
+            err += dy;
+            x0 += sx;
+        }
+        if (e2 <= dx) {
+            err += dx;
+            y0 += sy;
+        }
+    }
+}
+
+color_t gdispGGetPixelColor(GDisplay* g, coord_t x, coord_t y) {
+    color_t* p = pixel(g, x, y);
+    return p ? *p : 0;
+}
+
+void gdispGBlitArea(GDisplay* g, coord_t x, coord_t y, coord_t cx, coord_t cy,
+        coord_t srcx, coord_t srcy, coord_t srccx, const pixel_t* buffer) {
+    for (coord_t j = 0; j < cy; j++) {
+        for (coord_t i = 0; i < cx; i++) {
+            unsigned bit = (unsigned)(srcy + j) * srccx + srcx + i;
+            bool set = buffer[bit / 8] & (0x80 >> (bit % 8));
+            gdispGDrawPixel(g, x + i, y + j, set ? White : Black);
+        }
+    }
+}
+
+// Only the set pixels of the glyphs are drawn, like uGFX does when there's
+// no background color
+void gdispGDrawString(GDisplay* g, coord_t x, coord_t y, const char* str, font_t f, color_t color) {
+    (void)f;
+    for (; *str; str++, x += FONT_WIDTH + 1) {
+        const unsigned char* glyph = &font[(uint8_t)*str * FONT_WIDTH];
+        for (coord_t i = 0; i < FONT_WIDTH; i++) {
+            for (coord_t j = 0; j < FONT_HEIGHT; j++) {
+                if (glyph[i] & (1 << j)) {
+                    gdispGDrawPixel(g, x + i, y + j, color);
+                }
+            }
+        }
+    }
+}
+
+void gdispGSetPowerMode(GDisplay* g, powermode_t mode) {
+    g->power = mode;
+}
+
+void gdispGSetOrientation(GDisplay* g, orientation_t orientation) {
+    g->orientation = orientation;
+}
+
+void gdispGSetBacklight(GDisplay* g, uint8_t percent) {
+    g->backlight = percent > 100 ? 100 : percent;
+}
+
+void gdispGFlush(GDisplay* g) {
+    g->flushes++;
+}
+
+font_t gdispOpenFont(const char* name) {
+    for (unsigned i = 0; i < sizeof(fonts) / sizeof(fonts[0]); i++) {
+        if (strcmp(fonts[i].name, name) == 0) {
+            return &fonts[i];
+        }
+    }
+    return NULL;
+}
+
+void gdispCloseFont(font_t f) {
+    (void)f;
+}
+
+void lcd_backlight_hal_init(void) {
+}
+
+void lcd_backlight_hal_color(uint16_t r, uint16_t g, uint16_t b) {
+    lcd_backlight[0] = r;
+    lcd_backlight[1] = g;
+    lcd_backlight[2] = b;
+}
+
+coord_t gfx_simulator_width(GDisplay* g) {
+    return g->width;
+}
+
+coord_t gfx_simulator_height(GDisplay* g) {
+    return g->height;
+}
+
+const color_t* gfx_simulator_pixels(GDisplay* g) {
+    return g->pixels;
+}
+
+powermode_t gfx_simulator_power(GDisplay* g) {
+    return g->power;
+}
+
+uint8_t gfx_simulator_backlight(GDisplay* g) {
+    return g->backlight;
+}
+
+uint32_t gfx_simulator_flushes(GDisplay* g) {
+    return g->flushes;
+}
+
+uint32_t gfx_simulator_events(void) {
+    return listener.events;
+}
+
+void gfx_simulator_lcd_backlight(uint16_t* r, uint16_t* g, uint16_t* b) {
+    *r = lcd_backlight[0];
+    *g = lcd_backlight[1];
+    *b = lcd_backlight[2];
+}
+
+bool gfx_simulator_write_pgm(GDisplay* g, const char* path) {
+    FILE* f = fopen(path, "wb");
+    if (!f) {
+        return false;
+    }
+    fprintf(f, "P5\n%d %d\n255\n", g->width, g->height);
+    size_t size = (size_t)g->width * g->height;
+    bool ok = fwrite(g->pixels, 1, size, f) == size;
+    return fclose(f) == 0 && ok;
+}
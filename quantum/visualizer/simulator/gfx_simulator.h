@@ -0,0 +1,45 @@
+/* Copyright 2026 QMK Firmware contributors
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef GFX_SIMULATOR_H
+#define GFX_SIMULATOR_H
+
+#include "gfx.h"
+
+#define GFX_SIMULATOR_DISPLAYS 2
+
+// Clears the displays and sets the time back to zero
+void gfx_simulator_reset(void);
+void gfx_simulator_advance(systemticks_t ticks);
+
+coord_t gfx_simulator_width(GDisplay* g);
+coord_t gfx_simulator_height(GDisplay* g);
+// The pixels in the native orientation of the display, row by row
+const color_t* gfx_simulator_pixels(GDisplay* g);
+powermode_t gfx_simulator_power(GDisplay* g);
+uint8_t gfx_simulator_backlight(GDisplay* g);
+uint32_t gfx_simulator_flushes(GDisplay* g);
+
+// The number of events sent to wake up the visualizer thread
+uint32_t gfx_simulator_events(void);
+
+// The last color set by lcd_backlight_hal_color
+void gfx_simulator_lcd_backlight(uint16_t* r, uint16_t* g, uint16_t* b);
+
+// Writes the display as a binary PGM image, returns false on errors
+bool gfx_simulator_write_pgm(GDisplay* g, const char* path);
+
+#endif
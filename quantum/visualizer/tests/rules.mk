@@ -0,0 +1,36 @@
+# Copyright 2026 QMK Firmware contributors
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 2 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+visualizer_DEFS := \
+	-DVISUALIZER_ENABLE -DVISUALIZER_SIMULATOR -DNO_PRINT \
+	-DLCD_ENABLE -DLCD_BACKLIGHT_ENABLE -DBACKLIGHT_ENABLE -DBACKLIGHT_LEVELS=3 \
+	-DLCD_WIDTH=128 -DLCD_HEIGHT=32 -DLCD_DISPLAY_NUMBER=0 \
+	-DLED_WIDTH=7 -DLED_HEIGHT=7 -DLED_DISPLAY_NUMBER=1
+visualizer_INC := \
+	$(QUANTUM_PATH)/visualizer/tests \
+	$(QUANTUM_PATH)/visualizer/simulator \
+	$(QUANTUM_PATH)/visualizer \
+	$(DRIVER_PATH)/avr
+visualizer_SRC := \
+	$(QUANTUM_PATH)/visualizer/tests/visualizer_tests.cpp \
+	$(QUANTUM_PATH)/visualizer/simulator/gfx_simulator.c \
+	$(QUANTUM_PATH)/visualizer/visualizer.c \
+	$(QUANTUM_PATH)/visualizer/visualizer_keyframes.c \
+	$(QUANTUM_PATH)/visualizer/default_animations.c \
+	$(QUANTUM_PATH)/visualizer/lcd_keyframes.c \
+	$(QUANTUM_PATH)/visualizer/lcd_backlight.c \
+	$(QUANTUM_PATH)/visualizer/lcd_backlight_keyframes.c \
+	$(QUANTUM_PATH)/visualizer/led_backlight_keyframes.c \
+	$(QUANTUM_PATH)/visualizer/resources/lcd_logo.c
@@ -0,0 +1,420 @@
+/* Copyright 2026 QMK Firmware contributors
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "gtest/gtest.h"
+#include <time.h>
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+extern "C" {
+#include "visualizer.h"
+#include "default_animations.h"
+#include "gfx_simulator.h"
+#include "resources/resources.h"
+}
+
+namespace {
+
+// The visualizer updates at most this often while an animation is running
+const systemticks_t FRAME_TICKS = gfxMillisecondsToTicks(10);
+
+keyframe_animation_t* startup_animation;
+int user_updates;
+int user_suspends;
+visualizer_changes_t user_changes;
+visualizer_keyboard_status_t user_status;
+int user_resumes;
+uint8_t test_mods;
+uint8_t test_oneshot_mods;
+
+}
+
+extern "C" {
+
+uint8_t get_mods(void) {
+    return test_mods;
+}
+
+uint8_t get_oneshot_mods(void) {
+    return test_oneshot_mods;
+}
+
+bool has_oneshot_mods_timed_out(void) {
+    return test_oneshot_mods == 0;
+}
+
+void initialize_user_visualizer(visualizer_state_t* state) {
+    state->layer_text = "Default";
+    state->current_lcd_color = LCD_COLOR(0, 0, 0);
+    state->target_lcd_color = LCD_COLOR(0, 0xFF, 0xFF);
+    lcd_backlight_brightness(0xFF);
+    start_keyframe_animation(startup_animation);
+}
+
+void update_user_visualizer_state(visualizer_state_t* state, visualizer_keyboard_status_t* prev_status) {
+    (void)prev_status;
+    user_updates++;
+    user_changes = state->changes;
+    user_status = state->status;
+}
+
+void user_visualizer_suspend(visualizer_state_t* state) {
+    user_suspends++;
+    user_changes = state->changes;
+    start_keyframe_animation(&default_suspend_animation);
+}
+
+void user_visualizer_resume(visualizer_state_t* state) {
+    (void)state;
+    user_resumes++;
+    start_keyframe_animation(&default_startup_animation);
+}
+
+}
+
+/* Runs the visualizer in the simulator
+ *
+ * Every update is timed with the thread CPU clock, and the statistics are
+ * printed at the end of each test, so the tests double as a frame time
+ * benchmark of the default animations. Set VISUALIZER_DUMP to a directory
+ * to also write each frame of the displays there as PGM images.
+ */
+class Visualizer : public testing::Test {
+public:
+    struct frame_t {
+        systemticks_t time;
+        uint64_t cpu_ns;
+        color_t led;
+    };
+
+    Visualizer() {
+        visualizer_resume();
+        backlight_set(0);
+        visualizer_set_layer_state(0);
+        visualizer_set_default_layer_state(0);
+        visualizer_set_mods(0);
+        visualizer_set_leds(0);
+        test_mods = 0;
+        test_oneshot_mods = 0;
+        gfx_simulator_reset();
+        events = 0;
+        user_updates = 0;
+        user_changes = 0;
+        user_suspends = 0;
+        user_resumes = 0;
+        sleep = 0;
+        dump_dir = getenv("VISUALIZER_DUMP");
+    }
+
+    ~Visualizer() {
+        if (frames.empty()) {
+            return;
+        }
+        uint64_t total = 0;
+        uint64_t longest = 0;
+        for (const frame_t& frame : frames) {
+            total += frame.cpu_ns;
+            longest = std::max(longest, frame.cpu_ns);
+        }
+        printf("%s: %zu frames, %.1fus average, %.1fus max\n", test_name().c_str(), frames.size(),
+                total / 1000.0 / frames.size(), longest / 1000.0);
+#ifdef VISUALIZER_CHECK_FRAME_TIME
+        // Even unoptimized on the host, a frame has to fit the frame period.
+        // This measures the host, so it's only checked on request, with
+        // make test:visualizer EXTRAFLAGS=-DVISUALIZER_CHECK_FRAME_TIME
+        EXPECT_LT(longest, FRAME_TICKS * 1000000ull);
+#endif
+    }
+
+    void init(keyframe_animation_t* animation) {
+        startup_animation = animation;
+        visualizer_init();
+        run_ms(0);
+    }
+
+    // Updates whenever the visualizer asks for it, until the given time
+    // has passed
+    void run_ms(systemticks_t ms) {
+        systemticks_t end = gfxSystemTicks() + gfxMillisecondsToTicks(ms);
+        // The visualizer thread wakes up when the status changes
+        if (gfx_simulator_events() != events) {
+            events = gfx_simulator_events();
+            sleep = 0;
+        }
+        while (sleep <= end - gfxSystemTicks()) {
+            gfx_simulator_advance(sleep);
+            update();
+        }
+        gfx_simulator_advance(end - gfxSystemTicks());
+    }
+
+    color_t lcd_pixel(coord_t x, coord_t y) {
+        return gfx_simulator_pixels(LCD_DISPLAY)[y * LCD_WIDTH + x];
+    }
+
+    color_t led_pixel(coord_t x, coord_t y) {
+        return gfx_simulator_pixels(LED_DISPLAY)[y * LED_WIDTH + x];
+    }
+
+    bool lcd_shows_logo() {
+        for (coord_t y = 0; y < LCD_HEIGHT; y++) {
+            for (coord_t x = 0; x < LCD_WIDTH; x++) {
+                unsigned bit = y * LCD_WIDTH + x;
+                bool set = resource_lcd_logo[bit / 8] & (0x80 >> (bit % 8));
+                if (lcd_pixel(x, y) != (set ? White : Black)) {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+
+    systemticks_t sleep;
+    uint32_t events;
+    std::vector<frame_t> frames;
+
+private:
+    static std::string test_name() {
+        return testing::UnitTest::GetInstance()->current_test_info()->name();
+    }
+
+    static uint64_t cpu_time_ns() {
+        timespec ts;
+        clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+        return (uint64_t)ts.tv_sec * 1000000000ull + ts.tv_nsec;
+    }
+
+    void update() {
+        uint64_t start = cpu_time_ns();
+        sleep = visualizer_simulator_update();
+        uint64_t cpu_ns = cpu_time_ns() - start;
+        frames.push_back({gfxSystemTicks(), cpu_ns, led_pixel(0, 0)});
+        if (dump_dir) {
+            dump("lcd", LCD_DISPLAY);
+            dump("led", LED_DISPLAY);
+        }
+    }
+
+    void dump(const char* display, GDisplay* g) {
+        char name[32];
+        snprintf(name, sizeof(name), "_%s_%05zu.pgm", display, frames.size() - 1);
+        std::string path = std::string(dump_dir) + "/" + test_name() + name;
+        EXPECT_TRUE(gfx_simulator_write_pgm(g, path.c_str())) << "Can't write " << path;
+    }
+
+    const char* dump_dir;
+};
+
+TEST_F(Visualizer, StartupAnimationDrawsTheLogo) {
+    init(&default_startup_animation);
+    EXPECT_TRUE(lcd_shows_logo());
+    EXPECT_EQ(gfx_simulator_power(LCD_DISPLAY), powerOn);
+    EXPECT_EQ(led_pixel(0, 0), 0);
+    EXPECT_GT(gfx_simulator_flushes(LCD_DISPLAY), 0u);
+}
+
+TEST_F(Visualizer, StartupAnimationFadesIn) {
+    init(&default_startup_animation);
+    run_ms(2500);
+    EXPECT_NEAR(led_pixel(LED_WIDTH - 1, LED_HEIGHT - 1), 127, 3);
+    run_ms(2500);
+    EXPECT_EQ(led_pixel(0, 0), 255);
+    for (size_t i = 1; i < frames.size(); i++) {
+        EXPECT_GE(frames[i].led, frames[i - 1].led) << "at " << frames[i].time << "ms";
+    }
+    uint16_t r, g, b;
+    gfx_simulator_lcd_backlight(&r, &g, &b);
+    EXPECT_GT(r, g);
+    EXPECT_GT(r, b);
+}
+
+TEST_F(Visualizer, FadesArePacedByTheFramePeriod) {
+    init(&default_startup_animation);
+    run_ms(5000);
+    // The zero length keyframes run back to back, without waiting
+    size_t waits = 0;
+    for (size_t i = 1; i < frames.size(); i++) {
+        systemticks_t wait = frames[i].time - frames[i - 1].time;
+        if (wait != 0) {
+            EXPECT_EQ(wait, FRAME_TICKS) << "at " << frames[i].time << "ms";
+            waits++;
+        }
+    }
+    EXPECT_EQ(waits, 5000 / FRAME_TICKS);
+}
+
+TEST_F(Visualizer, SleepsWhenTheAnimationsHaveFinished) {
+    init(&default_startup_animation);
+    run_ms(5000);
+    EXPECT_EQ(user_updates, 1);
+    EXPECT_EQ(sleep, TIME_INFINITE);
+    size_t count = frames.size();
+    run_ms(10000);
+    EXPECT_EQ(frames.size(), count);
+}
+
+TEST_F(Visualizer, SuspendShowsTheLayerAndPowersOff) {
+    init(&default_startup_animation);
+    run_ms(5000);
+    visualizer_suspend();
+    run_ms(1000);
+    EXPECT_EQ(user_suspends, 1);
+    EXPECT_EQ(gfx_simulator_power(LCD_DISPLAY), powerOff);
+    EXPECT_EQ(gfx_simulator_power(LED_DISPLAY), powerOff);
+    EXPECT_EQ(led_pixel(0, 0), 0);
+    // The layer text is drawn in black, starting from the 10th row
+    int text_pixels = 0;
+    for (coord_t y = 0; y < LCD_HEIGHT; y++) {
+        for (coord_t x = 0; x < LCD_WIDTH; x++) {
+            if (lcd_pixel(x, y) == Black) {
+                EXPECT_GE(y, 10);
+                text_pixels++;
+            }
+        }
+    }
+    EXPECT_GT(text_pixels, 0);
+    EXPECT_EQ(sleep, TIME_INFINITE);
+}
+
+TEST_F(Visualizer, ResumeRestartsTheStartupAnimation) {
+    init(&default_startup_animation);
+    run_ms(5000);
+    visualizer_suspend();
+    run_ms(1000);
+    visualizer_resume();
+    run_ms(FRAME_TICKS);
+    EXPECT_EQ(user_resumes, 1);
+    EXPECT_EQ(gfx_simulator_power(LCD_DISPLAY), powerOn);
+    EXPECT_TRUE(lcd_shows_logo());
+    run_ms(5000);
+    EXPECT_EQ(led_pixel(0, 0), 255);
+    EXPECT_EQ(user_updates, 2);
+}
+
+TEST_F(Visualizer, BacklightLevelControlsTheLedDisplay) {
+    init(&default_startup_animation);
+    run_ms(5000);
+    backlight_set(2);
+    run_ms(FRAME_TICKS);
+    EXPECT_EQ(gfx_simulator_power(LED_DISPLAY), powerOn);
+    EXPECT_EQ(gfx_simulator_backlight(LED_DISPLAY), 2 * 100 / BACKLIGHT_LEVELS);
+    backlight_set(0);
+    run_ms(FRAME_TICKS);
+    EXPECT_EQ(gfx_simulator_power(LED_DISPLAY), powerOff);
+}
+
+TEST_F(Visualizer, LedTestAnimationLoops) {
+    init(&led_test_animation);
+    run_ms(500);
+    EXPECT_NEAR(led_pixel(0, 0), 127, 3);
+    // Halfway through the first left to right gradient, the columns differ
+    run_ms(5000);
+    EXPECT_NE(led_pixel(0, 0), led_pixel(LED_WIDTH / 2, 0));
+    EXPECT_EQ(led_pixel(0, 0), led_pixel(0, LED_HEIGHT - 1));
+    // The whole animation is 20 seconds, after that it fades in again
+    run_ms(15000);
+    EXPECT_NEAR(led_pixel(0, 0), 127, 3);
+    EXPECT_EQ(led_pixel(0, 0), led_pixel(LED_WIDTH - 1, LED_HEIGHT - 1));
+    EXPECT_EQ(sleep, FRAME_TICKS);
+}
+
+TEST_F(Visualizer, ChangesBeforeAnUpdateAreCoalesced) {
+    init(&default_startup_animation);
+    run_ms(5000);
+    uint32_t start_events = gfx_simulator_events();
+    visualizer_set_layer_state(0x4);
+    visualizer_set_mods(0x2);
+    visualizer_set_mods(0x3);
+    visualizer_set_leds(0x1);
+    EXPECT_EQ(gfx_simulator_events(), start_events + 1);
+    run_ms(FRAME_TICKS);
+    EXPECT_EQ(user_updates, 2);
+    EXPECT_EQ(user_changes, VISUALIZER_CHANGED_LAYER | VISUALIZER_CHANGED_MODS | VISUALIZER_CHANGED_LEDS);
+    EXPECT_EQ(user_status.layer, 0x4u);
+    EXPECT_EQ(user_status.mods, 0x3);
+    EXPECT_EQ(user_status.leds, 0x1u);
+}
+
+TEST_F(Visualizer, UnchangedValuesDontWakeTheVisualizer) {
+    init(&default_startup_animation);
+    run_ms(5000);
+    uint32_t start_events = gfx_simulator_events();
+    visualizer_set_layer_state(0);
+    visualizer_set_default_layer_state(0);
+    visualizer_set_mods(0);
+    visualizer_set_leds(0);
+    EXPECT_EQ(gfx_simulator_events(), start_events);
+    run_ms(FRAME_TICKS);
+    EXPECT_EQ(user_updates, 1);
+}
+
+TEST_F(Visualizer, ChangesAfterAnUpdateWakeTheVisualizerAgain) {
+    init(&default_startup_animation);
+    run_ms(5000);
+    uint32_t start_events = gfx_simulator_events();
+    visualizer_set_default_layer_state(0x2);
+    run_ms(FRAME_TICKS);
+    EXPECT_EQ(user_changes, VISUALIZER_CHANGED_DEFAULT_LAYER);
+    visualizer_set_default_layer_state(0x1);
+    EXPECT_EQ(gfx_simulator_events(), start_events + 2);
+    run_ms(FRAME_TICKS);
+    EXPECT_EQ(user_updates, 3);
+    EXPECT_EQ(user_changes, VISUALIZER_CHANGED_DEFAULT_LAYER);
+    EXPECT_EQ(user_status.default_layer, 0x1u);
+}
+
+TEST_F(Visualizer, ChangesDuringTheStartupAnimationAreHandledAfterIt) {
+    init(&default_startup_animation);
+    run_ms(1000);
+    visualizer_set_layer_state(0x8);
+    run_ms(1000);
+    EXPECT_EQ(user_updates, 0);
+    run_ms(3000);
+    EXPECT_EQ(user_updates, 1);
+    EXPECT_EQ(user_changes, VISUALIZER_CHANGED_ALL);
+    EXPECT_EQ(user_status.layer, 0x8u);
+}
+
+TEST_F(Visualizer, TheUserSeesWhichPartChanged) {
+    init(&default_startup_animation);
+    run_ms(5000);
+    backlight_set(1);
+    run_ms(FRAME_TICKS);
+    EXPECT_EQ(user_changes, VISUALIZER_CHANGED_BACKLIGHT);
+    visualizer_suspend();
+    run_ms(FRAME_TICKS);
+    EXPECT_EQ(user_suspends, 1);
+    EXPECT_EQ(user_changes, VISUALIZER_CHANGED_SUSPENDED);
+}
+
+TEST_F(Visualizer, ExpiredOneshotModsAreRemovedByTheTask) {
+    init(&default_startup_animation);
+    run_ms(5000);
+    test_mods = 0x1;
+    test_oneshot_mods = 0x2;
+    visualizer_task();
+    run_ms(FRAME_TICKS);
+    EXPECT_EQ(user_changes, VISUALIZER_CHANGED_MODS);
+    EXPECT_EQ(user_status.mods, 0x3);
+    // The oneshot mods time out, which doesn't send a report
+    test_oneshot_mods = 0;
+    visualizer_task();
+    run_ms(FRAME_TICKS);
+    EXPECT_EQ(user_updates, 3);
+    EXPECT_EQ(user_status.mods, 0x1);
+}
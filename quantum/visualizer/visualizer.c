@@ -56,41 +56,47 @@ SOFTWARE.
 #define VISUALIZER_THREAD_PRIORITY (NORMAL_PRIORITY - 2)
 #endif
 
+// The status published by the keyboard, together with the parts of it that
+// the visualizer thread hasn't seen yet. The main thread writes both under
+// the system lock, and the visualizer thread reads them under it.
 static visualizer_keyboard_status_t current_status = {
-    .layer = 0xFFFFFFFF,
-    .default_layer = 0xFFFFFFFF,
-    .leds = 0xFFFFFFFF,
+    .layer = 0,
+    .default_layer = 0,
+    .leds = 0,
 #ifdef BACKLIGHT_ENABLE
     .backlight_level = 0,
 #endif
-    .mods = 0xFF,
+    .mods = 0,
     .suspended = false,
 #ifdef VISUALIZER_USER_DATA_SIZE
     .user_data = {0}
 #endif
 };
-
-static bool same_status(visualizer_keyboard_status_t* status1, visualizer_keyboard_status_t* status2) {
-    return status1->layer == status2->layer &&
-        status1->default_layer == status2->default_layer &&
-        status1->mods == status2->mods &&
-        status1->leds == status2->leds &&
-        status1->suspended == status2->suspended
+static visualizer_changes_t pending_changes = 0;
+
+// The status of this keyboard itself, which is shown unless a serial link
+// master is connected. Only the main thread uses it.
+static visualizer_keyboard_status_t local_status;
+
+static visualizer_changes_t status_changes(const visualizer_keyboard_status_t* status1, const visualizer_keyboard_status_t* status2) {
+    visualizer_changes_t changes = 0;
+    changes |= status1->layer != status2->layer ? VISUALIZER_CHANGED_LAYER : 0;
+    changes |= status1->default_layer != status2->default_layer ? VISUALIZER_CHANGED_DEFAULT_LAYER : 0;
+    changes |= status1->mods != status2->mods ? VISUALIZER_CHANGED_MODS : 0;
+    changes |= status1->leds != status2->leds ? VISUALIZER_CHANGED_LEDS : 0;
+    changes |= status1->suspended != status2->suspended ? VISUALIZER_CHANGED_SUSPENDED : 0;
 #ifdef BACKLIGHT_ENABLE
-        && status1->backlight_level == status2->backlight_level
+    changes |= status1->backlight_level != status2->backlight_level ? VISUALIZER_CHANGED_BACKLIGHT : 0;
 #endif
 #ifdef VISUALIZER_USER_DATA_SIZE
-        && memcmp(status1->user_data, status2->user_data, VISUALIZER_USER_DATA_SIZE) == 0
+    changes |= memcmp(status1->user_data, status2->user_data, VISUALIZER_USER_DATA_SIZE) != 0 ?
+        VISUALIZER_CHANGED_USER_DATA : 0;
 #endif
-    ;
+    return changes;
 }
 
 static bool visualizer_enabled = false;
 
-#ifdef VISUALIZER_USER_DATA_SIZE
-static uint8_t user_data[VISUALIZER_USER_DATA_SIZE];
-#endif
-
 #define MAX_SIMULTANEOUS_ANIMATIONS 4
 static keyframe_animation_t* animations[MAX_SIMULTANEOUS_ANIMATIONS] = {};
 
@@ -241,30 +247,31 @@ void run_next_keyframe(keyframe_animation_t* animation, visualizer_state_t* stat
     (*temp_animation.frame_functions[next_frame])(&temp_animation, &temp_state);
 }
 
-// TODO: Optimize the stack size, this is probably way too big
-static DECLARE_THREAD_STACK(visualizerThreadStack, 1024);
-static DECLARE_THREAD_FUNCTION(visualizerThread, arg) {
-    (void)arg;
+static const visualizer_keyboard_status_t initial_status = {
+    .default_layer = 0xFFFFFFFF,
+    .layer = 0xFFFFFFFF,
+    .mods = 0xFF,
+    .leds = 0xFFFFFFFF,
+    .suspended = false,
+#ifdef BACKLIGHT_ENABLE
+    .backlight_level = 0,
+#endif
+#ifdef VISUALIZER_USER_DATA_SIZE
+    .user_data = {0},
+#endif
+};
 
-    GListener event_listener;
-    geventListenerInit(&event_listener);
-    geventAttachSource(&event_listener, (GSourceHandle)&current_status, 0);
+// The state of the visualizer thread, kept outside of it so that the
+// simulator can run the thread one update at a time
+static visualizer_state_t visualizer_state;
+static systemticks_t current_time;
+static bool force_update;
 
-    visualizer_keyboard_status_t initial_status = {
-        .default_layer = 0xFFFFFFFF,
-        .layer = 0xFFFFFFFF,
-        .mods = 0xFF,
-        .leds = 0xFFFFFFFF,
-        .suspended = false,
-    #ifdef BACKLIGHT_ENABLE
-        .backlight_level = 0,
-    #endif
-    #ifdef VISUALIZER_USER_DATA_SIZE
-        .user_data = {0},
-    #endif
-    };
+static void visualizer_thread_init(void) {
+    stop_all_keyframe_animations();
+    visualizer_enabled = false;
 
-    visualizer_state_t state = {
+    visualizer_state_t initial_state = {
         .status = initial_status,
         .current_lcd_color = 0,
 #ifdef LCD_ENABLE
@@ -272,99 +279,136 @@ static DECLARE_THREAD_FUNCTION(visualizerThread, arg) {
         .font_dejavusansbold12 = gdispOpenFont("DejaVuSansBold12")
 #endif
     };
-    initialize_user_visualizer(&state);
-    state.prev_lcd_color = state.current_lcd_color;
+    visualizer_state = initial_state;
+    initialize_user_visualizer(&visualizer_state);
+    visualizer_state.prev_lcd_color = visualizer_state.current_lcd_color;
 
 #ifdef LCD_BACKLIGHT_ENABLE
     lcd_backlight_color(
-            LCD_HUE(state.current_lcd_color),
-            LCD_SAT(state.current_lcd_color),
-            LCD_INT(state.current_lcd_color));
+            LCD_HUE(visualizer_state.current_lcd_color),
+            LCD_SAT(visualizer_state.current_lcd_color),
+            LCD_INT(visualizer_state.current_lcd_color));
 #endif
 
-    systemticks_t sleep_time = TIME_INFINITE;
-    systemticks_t current_time = gfxSystemTicks();
-    bool force_update = true;
+    current_time = gfxSystemTicks();
+    force_update = true;
+}
 
-    while(true) {
-        systemticks_t new_time = gfxSystemTicks();
-        systemticks_t delta = new_time - current_time;
-        current_time = new_time;
-        bool enabled = visualizer_enabled;
-        if (force_update || !same_status(&state.status, &current_status)) {
-            force_update = false;
-    #if BACKLIGHT_ENABLE
-            if(current_status.backlight_level != state.status.backlight_level) {
-                if (current_status.backlight_level != 0) {
-                    gdispGSetPowerMode(LED_DISPLAY, powerOn);
-                    uint16_t percent = (uint16_t)current_status.backlight_level * 100 / BACKLIGHT_LEVELS;
-                    gdispGSetBacklight(LED_DISPLAY, percent);
-                }
-                else {
-                    gdispGSetPowerMode(LED_DISPLAY, powerOff);
-                }
-                state.status.backlight_level = current_status.backlight_level;
+// Runs the animations and the user callbacks once, and returns the number
+// of ticks until the next update is needed
+static systemticks_t visualizer_thread_update(void) {
+    systemticks_t sleep_time = TIME_INFINITE;
+    systemticks_t new_time = gfxSystemTicks();
+    systemticks_t delta = new_time - current_time;
+    current_time = new_time;
+    bool enabled = visualizer_enabled;
+    // Take the published changes, anything that changes after this wakes up
+    // the thread again
+    gfxSystemLock();
+    visualizer_keyboard_status_t status = current_status;
+    visualizer_changes_t changes = pending_changes;
+    pending_changes = 0;
+    gfxSystemUnlock();
+    if (force_update) {
+        force_update = false;
+        changes = VISUALIZER_CHANGED_ALL;
+    }
+    if (changes) {
+#if BACKLIGHT_ENABLE
+        if((changes & VISUALIZER_CHANGED_BACKLIGHT) &&
+                status.backlight_level != visualizer_state.status.backlight_level) {
+            if (status.backlight_level != 0) {
+                gdispGSetPowerMode(LED_DISPLAY, powerOn);
+                uint16_t percent = (uint16_t)status.backlight_level * 100 / BACKLIGHT_LEVELS;
+                gdispGSetBacklight(LED_DISPLAY, percent);
             }
-    #endif
-            if (visualizer_enabled) {
-                if (current_status.suspended) {
-                    stop_all_keyframe_animations();
-                    visualizer_enabled = false;
-                    state.status = current_status;
-                    user_visualizer_suspend(&state);
-                }
-                else {
-                    visualizer_keyboard_status_t prev_status = state.status;
-                    state.status = current_status;
-                    update_user_visualizer_state(&state, &prev_status);
-                }
-                state.prev_lcd_color = state.current_lcd_color;
+            else {
+                gdispGSetPowerMode(LED_DISPLAY, powerOff);
             }
+            visualizer_state.status.backlight_level = status.backlight_level;
         }
-        if (!enabled && state.status.suspended && current_status.suspended == false) {
-            // Setting the status to the initial status will force an update
-            // when the visualizer is enabled again
-            state.status = initial_status;
-            state.status.suspended = false;
-            stop_all_keyframe_animations();
-            user_visualizer_resume(&state);
-            state.prev_lcd_color = state.current_lcd_color;
-        }
-        sleep_time = TIME_INFINITE;
-        for (int i=0;i<MAX_SIMULTANEOUS_ANIMATIONS;i++) {
-            if (animations[i]) {
-                update_keyframe_animation(animations[i], &state, delta, &sleep_time);
+#endif
+        if (visualizer_enabled) {
+            visualizer_state.changes = changes;
+            if (status.suspended) {
+                stop_all_keyframe_animations();
+                visualizer_enabled = false;
+                visualizer_state.status = status;
+                user_visualizer_suspend(&visualizer_state);
             }
+            else {
+                visualizer_keyboard_status_t prev_status = visualizer_state.status;
+                visualizer_state.status = status;
+                update_user_visualizer_state(&visualizer_state, &prev_status);
+            }
+            visualizer_state.prev_lcd_color = visualizer_state.current_lcd_color;
+        }
+    }
+    if (!enabled && visualizer_state.status.suspended && status.suspended == false) {
+        // Setting the status to the initial status will force an update
+        // when the visualizer is enabled again
+        visualizer_state.status = initial_status;
+        visualizer_state.status.suspended = false;
+        visualizer_state.changes = VISUALIZER_CHANGED_SUSPENDED;
+        stop_all_keyframe_animations();
+        user_visualizer_resume(&visualizer_state);
+        visualizer_state.prev_lcd_color = visualizer_state.current_lcd_color;
+    }
+    for (int i=0;i<MAX_SIMULTANEOUS_ANIMATIONS;i++) {
+        if (animations[i]) {
+            update_keyframe_animation(animations[i], &visualizer_state, delta, &sleep_time);
         }
+    }
 #ifdef BACKLIGHT_ENABLE
-        gdispGFlush(LED_DISPLAY);
+    gdispGFlush(LED_DISPLAY);
 #endif
 
 #ifdef LCD_ENABLE
-        gdispGFlush(LCD_DISPLAY);
+    gdispGFlush(LCD_DISPLAY);
 #endif
 
 #ifdef EMULATOR
-        draw_emulator();
+    draw_emulator();
 #endif
-        // Enable the visualizer when the startup or the suspend animation has finished
-        if (!visualizer_enabled && state.status.suspended == false && get_num_running_animations() == 0) {
-            visualizer_enabled = true;
-            force_update = true;
+    // Enable the visualizer when the startup or the suspend animation has finished
+    if (!visualizer_enabled && visualizer_state.status.suspended == false && get_num_running_animations() == 0) {
+        visualizer_enabled = true;
+        force_update = true;
+        sleep_time = 0;
+    }
+
+    systemticks_t after_update = gfxSystemTicks();
+    unsigned update_delta = after_update - current_time;
+    if (sleep_time != TIME_INFINITE) {
+        if (sleep_time > update_delta) {
+            sleep_time -= update_delta;
+        }
+        else {
             sleep_time = 0;
         }
+    }
+    dprintf("Update took %d, last delta %d, sleep_time %d\n", update_delta, delta, sleep_time);
+    return sleep_time;
+}
 
-        systemticks_t after_update = gfxSystemTicks();
-        unsigned update_delta = after_update - current_time;
-        if (sleep_time != TIME_INFINITE) {
-            if (sleep_time > update_delta) {
-                sleep_time -= update_delta;
-            }
-            else {
-                sleep_time = 0;
-            }
-        }
-        dprintf("Update took %d, last delta %d, sleep_time %d\n", update_delta, delta, sleep_time);
+#ifdef VISUALIZER_SIMULATOR
+systemticks_t visualizer_simulator_update(void) {
+    return visualizer_thread_update();
+}
+#else
+// TODO: Optimize the stack size, this is probably way too big
+static DECLARE_THREAD_STACK(visualizerThreadStack, 1024);
+static DECLARE_THREAD_FUNCTION(visualizerThread, arg) {
+    (void)arg;
+
+    GListener event_listener;
+    geventListenerInit(&event_listener);
+    geventAttachSource(&event_listener, (GSourceHandle)&current_status, 0);
+
+    visualizer_thread_init();
+
+    while(true) {
+        systemticks_t sleep_time = visualizer_thread_update();
 #ifdef PROTOCOL_CHIBIOS
         // The gEventWait function really takes milliseconds, even if the documentation says ticks.
         // Unfortunately there's no generic ugfx conversion from system time to milliseconds,
@@ -378,12 +422,13 @@ static DECLARE_THREAD_FUNCTION(visualizerThread, arg) {
         geventEventWait(&event_listener, sleep_time);
     }
 #ifdef LCD_ENABLE
-    gdispCloseFont(state.font_fixed5x8);
-    gdispCloseFont(state.font_dejavusansbold12);
+    gdispCloseFont(visualizer_state.font_fixed5x8);
+    gdispCloseFont(visualizer_state.font_dejavusansbold12);
 #endif
 
     return 0;
 }
+#endif
 
 void visualizer_init(void) {
     gfxInit();
@@ -404,30 +449,62 @@ void visualizer_init(void) {
     LED_DISPLAY = get_led_display();
   #endif
 
+#ifdef VISUALIZER_SIMULATOR
+    // The simulator calls visualizer_simulator_update instead of running
+    // the thread
+    visualizer_thread_init();
+#else
     // We are using a low priority thread, the idea is to have it run only
     // when the main thread is sleeping during the matrix scanning
   gfxThreadCreate(visualizerThreadStack, sizeof(visualizerThreadStack),
                   VISUALIZER_THREAD_PRIORITY, visualizerThread, NULL);
+#endif
 }
 
-void update_status(bool changed) {
-    if (changed) {
+#ifdef SERIAL_LINK_ENABLE
+static bool remote_status_sent = false;
+#endif
+
+// Only the first change after the thread has taken the previous ones wakes
+// it up, the rest are coalesced into the same update
+static void publish_changes(visualizer_changes_t changes) {
+    if (!changes) {
+        return;
+    }
+    gfxSystemLock();
+    bool wake = pending_changes == 0;
+    pending_changes |= changes;
+    gfxSystemUnlock();
+    if (wake) {
         GSourceListener* listener = geventGetSourceListener((GSourceHandle)&current_status, NULL);
         if (listener) {
             geventSendEvent(listener);
         }
     }
 #ifdef SERIAL_LINK_ENABLE
-    static systime_t last_update = 0;
-    systime_t current_update = chVTGetSystemTimeX();
-    systime_t delta = current_update - last_update;
-    if (changed || delta > MS2ST(10)) {
-        last_update = current_update;
-        visualizer_keyboard_status_t* r = begin_write_current_status();
-        *r = current_status;
-        end_write_current_status();
+    remote_status_sent = false;
+#endif
+}
+
+// Makes status the current one, and wakes up the visualizer if anything
+// changed
+static void set_status(const visualizer_keyboard_status_t* status) {
+    gfxSystemLock();
+    visualizer_changes_t changes = status_changes(&current_status, status);
+    current_status = *status;
+    gfxSystemUnlock();
+    publish_changes(changes);
+}
+
+// A connected serial link slave shows the status of the master instead of
+// its own
+static void set_local_status(void) {
+#ifdef SERIAL_LINK_ENABLE
+    if (is_serial_link_connected()) {
+        return;
     }
 #endif
+    set_status(&local_status);
 }
 
 uint8_t visualizer_get_mods() {
@@ -443,65 +520,84 @@ uint8_t visualizer_get_mods() {
 
 #ifdef VISUALIZER_USER_DATA_SIZE
 void visualizer_set_user_data(void* u) {
-    memcpy(user_data, u, VISUALIZER_USER_DATA_SIZE);
+    if (memcmp(local_status.user_data, u, VISUALIZER_USER_DATA_SIZE) != 0) {
+        memcpy(local_status.user_data, u, VISUALIZER_USER_DATA_SIZE);
+        set_local_status();
+    }
 }
 #endif
 
-void visualizer_update(uint32_t default_state, uint32_t state, uint8_t mods, uint32_t leds) {
-    // Note that there's a small race condition here, the thread could read
-    // a state where one of these are set but not the other. But this should
-    // not really matter as it will be fixed during the next loop step.
-    // Alternatively a mutex could be used instead of the volatile variables
+void visualizer_set_layer_state(uint32_t state) {
+    if (local_status.layer != state) {
+        local_status.layer = state;
+        set_local_status();
+    }
+}
+
+void visualizer_set_default_layer_state(uint32_t state) {
+    if (local_status.default_layer != state) {
+        local_status.default_layer = state;
+        set_local_status();
+    }
+}
 
-    bool changed = false;
+void visualizer_set_mods(uint8_t mods) {
+    if (local_status.mods != mods) {
+        local_status.mods = mods;
+        set_local_status();
+    }
+}
+
+void visualizer_set_leds(uint32_t leds) {
+    if (local_status.leds != leds) {
+        local_status.leds = leds;
+        set_local_status();
+    }
+}
+
+void visualizer_task(void) {
+    // The oneshot mods can time out without a report being sent, so the
+    // mods are polled
+    visualizer_set_mods(visualizer_get_mods());
 #ifdef SERIAL_LINK_ENABLE
-    if (is_serial_link_connected ()) {
+    static bool was_connected = false;
+    bool connected = is_serial_link_connected();
+    if (connected) {
         visualizer_keyboard_status_t* new_status = read_current_status();
         if (new_status) {
-            if (!same_status(&current_status, new_status)) {
-                changed = true;
-                current_status = *new_status;
-            }
+            set_status(new_status);
         }
+    } else if (was_connected) {
+        // Our own status has been kept up to date while the master was shown
+        set_status(&local_status);
     }
-    else {
-#else
-   {
-#endif
-        visualizer_keyboard_status_t new_status = {
-            .layer = state,
-            .default_layer = default_state,
-            .mods = mods,
-            .leds = leds,
-#ifdef BACKLIGHT_ENABLE
-            .backlight_level = current_status.backlight_level,
-#endif
-            .suspended = current_status.suspended,
-        };
-#ifdef VISUALIZER_USER_DATA_SIZE
-       memcpy(new_status.user_data, user_data, VISUALIZER_USER_DATA_SIZE);
-#endif
-        if (!same_status(&current_status, &new_status)) {
-            changed = true;
-            current_status = new_status;
-        }
+    was_connected = connected;
+    static systime_t last_update = 0;
+    systime_t current_update = chVTGetSystemTimeX();
+    systime_t delta = current_update - last_update;
+    if (!remote_status_sent || delta > MS2ST(10)) {
+        last_update = current_update;
+        remote_status_sent = true;
+        visualizer_keyboard_status_t* r = begin_write_current_status();
+        *r = current_status;
+        end_write_current_status();
     }
-    update_status(changed);
+#endif
 }
 
 void visualizer_suspend(void) {
-    current_status.suspended = true;
-    update_status(true);
+    local_status.suspended = true;
+    set_local_status();
 }
 
 void visualizer_resume(void) {
-    current_status.suspended = false;
-    update_status(true);
+    local_status.suspended = false;
+    set_local_status();
 }
 
 #ifdef BACKLIGHT_ENABLE
 void backlight_set(uint8_t level) {
-    current_status.backlight_level = level;
-    update_status(true);
+    local_status.backlight_level = level;
+    set_local_status();
 }
 #endif
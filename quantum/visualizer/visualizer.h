@@ -42,10 +42,31 @@ SOFTWARE.
 // use this function to merge both real_mods and oneshot_mods in a uint16_t
 uint8_t visualizer_get_mods(void);
 
+// The parts of the keyboard status that have changed since the last update
+// of the visualizer
+#define VISUALIZER_CHANGED_LAYER (1 << 0)
+#define VISUALIZER_CHANGED_DEFAULT_LAYER (1 << 1)
+#define VISUALIZER_CHANGED_MODS (1 << 2)
+#define VISUALIZER_CHANGED_LEDS (1 << 3)
+#define VISUALIZER_CHANGED_SUSPENDED (1 << 4)
+#define VISUALIZER_CHANGED_BACKLIGHT (1 << 5)
+#define VISUALIZER_CHANGED_USER_DATA (1 << 6)
+#define VISUALIZER_CHANGED_ALL 0x7F
+typedef uint8_t visualizer_changes_t;
+
 // This need to be called once at the start
 void visualizer_init(void);
-// This should be called at every matrix scan
-void visualizer_update(uint32_t default_state, uint32_t state, uint8_t mods, uint32_t leds);
+// This should be called at every matrix scan, it only has work to do when
+// the status is shared over the serial link
+void visualizer_task(void);
+
+// These are called by the keyboard when the status changes, the visualizer
+// thread only wakes up when something actually changed, and several changes
+// before it runs are handled in one update
+void visualizer_set_layer_state(uint32_t state);
+void visualizer_set_default_layer_state(uint32_t state);
+void visualizer_set_mods(uint8_t mods);
+void visualizer_set_leds(uint32_t leds);
 
 // This should be called when the keyboard goes to suspend state
 void visualizer_suspend(void);
@@ -62,6 +83,12 @@ GDisplay* get_led_display(void);
 void draw_emulator(void);
 #endif
 
+// The native simulator runs the visualizer without a thread, each call
+// updates the animations once, and returns the ticks until the next update
+#ifdef VISUALIZER_SIMULATOR
+systemticks_t visualizer_simulator_update(void);
+#endif
+
 // If you need support for more than 16 keyframes per animation, you can change this
 #define MAX_VISUALIZER_KEY_FRAMES 16
 
@@ -91,6 +118,9 @@ typedef struct visualizer_state_t {
 
     // The user visualizer(and animation functions) can read these
     visualizer_keyboard_status_t status;
+    // What changed in the status since the previous update, all bits are
+    // set when the visualizer is enabled after the startup animation
+    visualizer_changes_t changes;
 
     // These are used by the animation functions
     uint32_t current_lcd_color;
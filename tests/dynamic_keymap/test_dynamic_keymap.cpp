@@ -0,0 +1,199 @@
+/* Copyright 2026 QMK Firmware contributors
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "test_common.hpp"
+#include <vector>
+
+extern "C" {
+#include "dynamic_keymap.h"
+#include "raw_hid.h"
+#include "eeprom.h"
+}
+
+using testing::_;
+using testing::AnyNumber;
+using testing::ElementsAre;
+
+namespace {
+
+const uint8_t PACKET_SIZE = 32;
+
+std::vector<std::vector<uint8_t>> sent_packets;
+
+}
+
+// The fake HID transport, collects everything sent back to the host
+extern "C" bool raw_hid_send(uint8_t* data, uint8_t length) {
+    sent_packets.emplace_back(data, data + length);
+    return true;
+}
+
+class DynamicKeymap : public TestFixture {
+public:
+    DynamicKeymap() {
+        sent_packets.clear();
+    }
+
+    ~DynamicKeymap() {
+        dynamic_keymap_reset();
+    }
+
+    // Sends a request padded to the packet size and returns the response
+    std::vector<uint8_t> transact(std::vector<uint8_t> request) {
+        request.resize(PACKET_SIZE);
+        sent_packets.clear();
+        raw_hid_receive(request.data(), request.size());
+        EXPECT_EQ(sent_packets.size(), 1);
+        if (sent_packets.empty()) {
+            return {};
+        }
+        EXPECT_EQ(sent_packets[0].size(), PACKET_SIZE);
+        return sent_packets[0];
+    }
+
+    uint16_t get_keycode(uint8_t layer, uint8_t row, uint8_t col) {
+        auto response = transact({DYNAMIC_KEYMAP_GET_KEYCODE, layer, row, col});
+        EXPECT_EQ(response[0], DYNAMIC_KEYMAP_GET_KEYCODE);
+        return (response[4] << 8) | response[5];
+    }
+
+    void set_keycode(uint8_t layer, uint8_t row, uint8_t col, uint16_t keycode) {
+        auto response = transact({DYNAMIC_KEYMAP_SET_KEYCODE, layer, row, col,
+            (uint8_t)(keycode >> 8), (uint8_t)(keycode & 0xFF)});
+        EXPECT_EQ(response[0], DYNAMIC_KEYMAP_SET_KEYCODE);
+    }
+};
+
+TEST_F(DynamicKeymap, InfoDescribesTheKeymap) {
+    auto response = transact({DYNAMIC_KEYMAP_GET_INFO});
+    EXPECT_THAT(std::vector<uint8_t>(response.begin(), response.begin() + 4),
+        ElementsAre(DYNAMIC_KEYMAP_GET_INFO, 2, MATRIX_ROWS, MATRIX_COLS));
+}
+
+TEST_F(DynamicKeymap, DefaultsComeFromTheKeymap) {
+    EXPECT_EQ(get_keycode(0, 0, 0), KC_A);
+    EXPECT_EQ(get_keycode(0, 3, 9), KC_C);
+    EXPECT_EQ(get_keycode(1, 0, 1), KC_TRNS);
+    EXPECT_EQ(get_keycode(1, 3, 9), KC_2);
+}
+
+TEST_F(DynamicKeymap, RemappedKeyIsReported) {
+    TestDriver driver;
+    set_keycode(0, 0, 0, KC_Z);
+    EXPECT_EQ(get_keycode(0, 0, 0), KC_Z);
+    press_key(0, 0);
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_Z)));
+    keyboard_task();
+    release_key(0, 0);
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport()));
+    keyboard_task();
+}
+
+TEST_F(DynamicKeymap, RemappedLayerKeyIsReported) {
+    TestDriver driver;
+    set_keycode(1, 0, 1, KC_X);
+    press_key(2, 0);
+    keyboard_task();
+    press_key(1, 0);
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_X)));
+    keyboard_task();
+    release_key(1, 0);
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport()));
+    keyboard_task();
+    release_key(2, 0);
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport())).Times(AnyNumber());
+    keyboard_task();
+}
+
+TEST_F(DynamicKeymap, LayersAboveTheDynamicOnesComeFromTheKeymap) {
+    TestDriver driver;
+    press_key(3, 0);
+    keyboard_task();
+    press_key(0, 0);
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_3)));
+    keyboard_task();
+    release_key(0, 0);
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport()));
+    keyboard_task();
+    release_key(3, 0);
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport())).Times(AnyNumber());
+    keyboard_task();
+}
+
+TEST_F(DynamicKeymap, RemapIsRestoredFromEeprom) {
+    set_keycode(0, 0, 1, KC_Y);
+    dynamic_keymap_init();
+    EXPECT_EQ(get_keycode(0, 0, 1), KC_Y);
+}
+
+TEST_F(DynamicKeymap, InvalidEepromLoadsTheDefaults) {
+    set_keycode(0, 0, 1, KC_Y);
+    eeprom_update_word((uint16_t*)DYNAMIC_KEYMAP_EEPROM_ADDR, 0xFFFF);
+    dynamic_keymap_init();
+    EXPECT_EQ(get_keycode(0, 0, 1), KC_B);
+}
+
+TEST_F(DynamicKeymap, ResetRestoresTheDefaults) {
+    set_keycode(0, 0, 0, KC_Z);
+    auto response = transact({DYNAMIC_KEYMAP_RESET});
+    EXPECT_EQ(response[0], DYNAMIC_KEYMAP_RESET);
+    EXPECT_EQ(get_keycode(0, 0, 0), KC_A);
+    dynamic_keymap_init();
+    EXPECT_EQ(get_keycode(0, 0, 0), KC_A);
+}
+
+TEST_F(DynamicKeymap, LayerCanBeReadAndWrittenInBulk) {
+    const uint8_t chunk = PACKET_SIZE - DYNAMIC_KEYMAP_BUFFER_HEADER;
+    std::vector<uint8_t> layer;
+    for (uint16_t offset = 0; offset < DYNAMIC_KEYMAP_LAYER_SIZE; offset += chunk) {
+        uint8_t size = std::min<uint16_t>(chunk, DYNAMIC_KEYMAP_LAYER_SIZE - offset);
+        auto response = transact({DYNAMIC_KEYMAP_GET_BUFFER, 1, (uint8_t)(offset >> 8), (uint8_t)offset, size});
+        ASSERT_EQ(response[0], DYNAMIC_KEYMAP_GET_BUFFER);
+        layer.insert(layer.end(), response.begin() + DYNAMIC_KEYMAP_BUFFER_HEADER,
+            response.begin() + DYNAMIC_KEYMAP_BUFFER_HEADER + size);
+    }
+    ASSERT_EQ(layer.size(), DYNAMIC_KEYMAP_LAYER_SIZE);
+    EXPECT_EQ(layer[0] | (layer[1] << 8), KC_1);
+    EXPECT_EQ(layer[2] | (layer[3] << 8), KC_TRNS);
+
+    // Write the layer back shifted by one key
+    std::vector<uint8_t> shifted(layer.begin() + 2, layer.end());
+    shifted.push_back(layer[0]);
+    shifted.push_back(layer[1]);
+    for (uint16_t offset = 0; offset < DYNAMIC_KEYMAP_LAYER_SIZE; offset += chunk) {
+        uint8_t size = std::min<uint16_t>(chunk, DYNAMIC_KEYMAP_LAYER_SIZE - offset);
+        std::vector<uint8_t> request = {DYNAMIC_KEYMAP_SET_BUFFER, 1, (uint8_t)(offset >> 8), (uint8_t)offset, size};
+        request.insert(request.end(), shifted.begin() + offset, shifted.begin() + offset + size);
+        auto response = transact(request);
+        ASSERT_EQ(response[0], DYNAMIC_KEYMAP_SET_BUFFER);
+    }
+    dynamic_keymap_init();
+    EXPECT_EQ(get_keycode(1, 0, 0), KC_TRNS);
+    EXPECT_EQ(get_keycode(1, 3, 8), KC_2);
+    EXPECT_EQ(get_keycode(1, 3, 9), KC_1);
+}
+
+TEST_F(DynamicKeymap, InvalidRequestsAreRejected) {
+    EXPECT_EQ(transact({DYNAMIC_KEYMAP_GET_KEYCODE, 2, 0, 0})[0], DYNAMIC_KEYMAP_ERROR);
+    EXPECT_EQ(transact({DYNAMIC_KEYMAP_GET_KEYCODE, 0, MATRIX_ROWS, 0})[0], DYNAMIC_KEYMAP_ERROR);
+    EXPECT_EQ(transact({DYNAMIC_KEYMAP_SET_KEYCODE, 0, 0, MATRIX_COLS, 0, KC_Z})[0], DYNAMIC_KEYMAP_ERROR);
+    // The buffer doesn't fit in the packet
+    EXPECT_EQ(transact({DYNAMIC_KEYMAP_GET_BUFFER, 0, 0, 0, PACKET_SIZE})[0], DYNAMIC_KEYMAP_ERROR);
+    // The buffer goes past the end of the layer
+    EXPECT_EQ(transact({DYNAMIC_KEYMAP_SET_BUFFER, 0, 0, DYNAMIC_KEYMAP_LAYER_SIZE - 2, 4})[0], DYNAMIC_KEYMAP_ERROR);
+    EXPECT_EQ(transact({0x42})[0], DYNAMIC_KEYMAP_ERROR);
+    EXPECT_EQ(get_keycode(0, 0, 0), KC_A);
+}
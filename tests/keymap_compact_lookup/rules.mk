@@ -0,0 +1,23 @@
+# Copyright 2026 QMK Firmware contributors
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 2 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+CUSTOM_MATRIX=yes
+KEYMAP_COMPACT_ENABLE=yes
+
+# Generate the compacted tables from the test keymap like the firmware build
+# does, with the host objcopy
+KEYMAP_OUTPUT := $(TEST_OBJ)/$(TEST)
+KEYMAP_C := tests/$(TEST)/keymap.c
+KEYMAP_COMPACT_OBJCOPY := objcopy
@@ -0,0 +1,113 @@
+/* Copyright 2026 QMK Firmware contributors
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "test_common.hpp"
+
+extern "C" {
+#include "keymap_compact.h"
+}
+
+using testing::_;
+using testing::AnyNumber;
+
+namespace {
+
+const uint8_t NUM_LAYERS = 4;
+
+uint16_t dense_keycode(uint8_t layer, uint8_t row, uint8_t col) {
+    return pgm_read_word(&keymaps[layer][row][col]);
+}
+
+// The layer that the dense keymap resolves the key to
+int8_t dense_layer(uint32_t layers, uint8_t row, uint8_t col) {
+    for (int8_t layer = NUM_LAYERS - 1; layer >= 0; layer--) {
+        if ((layers & (1UL << layer)) && dense_keycode(layer, row, col) != KC_TRNS) {
+            return layer;
+        }
+    }
+    return 0;
+}
+
+}
+
+class KeymapCompactLookup : public TestFixture {
+public:
+    KeymapCompactLookup() {
+        EXPECT_CALL(driver, send_keyboard_mock(_)).Times(AnyNumber());
+    }
+
+    TestDriver driver;
+};
+
+TEST_F(KeymapCompactLookup, EveryKeyReadsLikeTheDenseKeymap) {
+    for (uint8_t layer = 0; layer < NUM_LAYERS; layer++) {
+        for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+            for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+                keypos_t key = { .col = col, .row = row };
+                uint16_t expected = dense_keycode(layer, row, col);
+                EXPECT_EQ(keymap_key_to_keycode(layer, key), expected)
+                    << "layer " << (int)layer << " row " << (int)row << " col " << (int)col;
+                EXPECT_EQ(keymap_compact_has_key(layer, key), expected != KC_TRNS)
+                    << "layer " << (int)layer << " row " << (int)row << " col " << (int)col;
+            }
+        }
+    }
+}
+
+TEST_F(KeymapCompactLookup, LayersAboveTheKeymapAreTransparent) {
+    keypos_t key = { .col = 0, .row = 0 };
+    EXPECT_EQ(keymap_key_to_keycode(NUM_LAYERS, key), KC_TRNS);
+    EXPECT_FALSE(keymap_compact_has_key(NUM_LAYERS, key));
+}
+
+TEST_F(KeymapCompactLookup, TransparentKeysFallThroughLikeTheDenseKeymap) {
+    for (uint32_t layers = 0; layers < (1UL << NUM_LAYERS); layers++) {
+        layer_state_set(layers);
+        for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+            for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+                keypos_t key = { .col = col, .row = row };
+                EXPECT_EQ(layer_switch_get_layer(key), dense_layer(layers | default_layer_state, row, col))
+                    << "layers " << layers << " row " << (int)row << " col " << (int)col;
+            }
+        }
+    }
+}
+
+TEST_F(KeymapCompactLookup, TransparentKeysTypeTheLowerLayer) {
+    // MO(3), layer 2 is transparent everywhere
+    press_key(4, 0);
+    run_one_scan_loop();
+    testing::Mock::VerifyAndClearExpectations(&driver);
+
+    // Transparent on layer 3
+    press_key(1, 1);
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_L)));
+    run_one_scan_loop();
+    testing::Mock::VerifyAndClearExpectations(&driver);
+
+    // Set on layer 3
+    press_key(9, 1);
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_L, KC_F3)));
+    run_one_scan_loop();
+    testing::Mock::VerifyAndClearExpectations(&driver);
+
+    EXPECT_CALL(driver, send_keyboard_mock(_)).Times(AnyNumber());
+    release_key(1, 1);
+    release_key(9, 1);
+    release_key(4, 0);
+    run_one_scan_loop();
+}
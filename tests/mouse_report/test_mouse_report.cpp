@@ -0,0 +1,144 @@
+/* Copyright 2026 QMK Firmware contributors
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "test_common.hpp"
+#include <vector>
+
+extern "C" {
+#include "mouse_report.h"
+#include "mousekey.h"
+#include "pointing_device.h"
+}
+
+using testing::_;
+using testing::AnyNumber;
+using testing::Invoke;
+
+class MouseReport : public TestFixture {
+public:
+    MouseReport() {
+        EXPECT_CALL(driver, send_keyboard_mock(_)).Times(AnyNumber());
+        EXPECT_CALL(driver, send_mouse_mock(_)).WillRepeatedly(Invoke([this](report_mouse_t& report) {
+            reports.push_back(report);
+            times.push_back(timer_read32());
+        }));
+    }
+
+    void pointing_device(int8_t x, int8_t y, uint8_t buttons) {
+        report_mouse_t report = {};
+        report.x = x;
+        report.y = y;
+        report.buttons = buttons;
+        pointing_device_set_report(report);
+        pointing_device_send();
+    }
+
+    TestDriver driver;
+    std::vector<report_mouse_t> reports;
+    std::vector<uint32_t> times;
+};
+
+TEST_F(MouseReport, NoMotionIsLostWhenSaturated) {
+    int expected_x = 0;
+    int expected_y = 0;
+    for (int i = 0; i < 200; i++) {
+        pointing_device(127, -127, 0);
+        expected_x += 127;
+        expected_y -= 127;
+        run_one_scan_loop();
+    }
+    idle_for(200 * 10);
+    int x = 0;
+    int y = 0;
+    for (auto& r : reports) {
+        EXPECT_GE(r.x, -127);
+        EXPECT_GE(r.y, -127);
+        x += r.x;
+        y += r.y;
+    }
+    EXPECT_EQ(x, expected_x);
+    EXPECT_EQ(y, expected_y);
+}
+
+TEST_F(MouseReport, AtMostOneReportPerInterval) {
+    for (int i = 0; i < 500; i++) {
+        pointing_device(3, 1, 0);
+        run_one_scan_loop();
+    }
+    ASSERT_GT(times.size(), 1);
+    for (size_t i = 1; i < times.size(); i++) {
+        EXPECT_GE(times[i] - times[i - 1], MOUSE_REPORT_INTERVAL);
+    }
+}
+
+TEST_F(MouseReport, MotionFromDifferentSourcesIsSummed) {
+    press_key(1, 0);
+    pointing_device(10, 0, 0);
+    run_one_scan_loop();
+    idle_for(MOUSE_REPORT_INTERVAL);
+    int x = 0;
+    for (auto& r : reports) {
+        x += r.x;
+    }
+    EXPECT_EQ(x, 10 + MOUSEKEY_MOVE_DELTA);
+    release_key(1, 0);
+    run_one_scan_loop();
+}
+
+TEST_F(MouseReport, ButtonsAreMerged) {
+    press_key(0, 0);
+    run_one_scan_loop();
+    idle_for(MOUSE_REPORT_INTERVAL);
+    pointing_device(0, 0, MOUSE_BTN2);
+    idle_for(MOUSE_REPORT_INTERVAL);
+    release_key(0, 0);
+    idle_for(MOUSE_REPORT_INTERVAL);
+    pointing_device(0, 0, 0);
+    idle_for(MOUSE_REPORT_INTERVAL);
+    ASSERT_EQ(reports.size(), 4);
+    EXPECT_EQ(reports[0].buttons, MOUSE_BTN1);
+    EXPECT_EQ(reports[1].buttons, MOUSE_BTN1 | MOUSE_BTN2);
+    EXPECT_EQ(reports[2].buttons, MOUSE_BTN2);
+    EXPECT_EQ(reports[3].buttons, 0);
+}
+
+TEST_F(MouseReport, ShortClickIsNotLost) {
+    pointing_device(0, 0, MOUSE_BTN1);
+    run_one_scan_loop();
+    pointing_device(0, 0, 0);
+    pointing_device(0, 0, MOUSE_BTN1);
+    pointing_device(0, 0, 0);
+    idle_for(MOUSE_REPORT_INTERVAL * 4);
+    ASSERT_EQ(reports.size(), 4);
+    EXPECT_EQ(reports[0].buttons, MOUSE_BTN1);
+    EXPECT_EQ(reports[1].buttons, 0);
+    EXPECT_EQ(reports[2].buttons, MOUSE_BTN1);
+    EXPECT_EQ(reports[3].buttons, 0);
+}
+
+TEST_F(MouseReport, NoClickIsLostWhenTheQueueIsFull) {
+    const int clicks = MOUSE_REPORT_BUTTON_QUEUE_SIZE;
+    for (int i = 0; i < clicks; i++) {
+        pointing_device(0, 0, MOUSE_BTN1);
+        pointing_device(0, 0, 0);
+    }
+    idle_for(MOUSE_REPORT_INTERVAL * clicks * 2);
+    ASSERT_EQ(reports.size(), clicks * 2);
+    for (int i = 0; i < clicks; i++) {
+        EXPECT_EQ(reports[i * 2].buttons, MOUSE_BTN1);
+        EXPECT_EQ(reports[i * 2 + 1].buttons, 0);
+    }
+}
@@ -0,0 +1,207 @@
+/* Copyright 2026 QMK Firmware contributors
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "test_common.hpp"
+#include <map>
+
+extern "C" {
+#include "mousekey.h"
+    void advance_time(uint32_t ms);
+}
+
+using testing::_;
+using testing::AnyNumber;
+using testing::Invoke;
+
+namespace {
+
+struct Position {
+    int x;
+    int y;
+    int v;
+    bool operator==(const Position& other) const {
+        return x == other.x && y == other.y && v == other.v;
+    }
+};
+
+std::ostream& operator<<(std::ostream& os, const Position& p) {
+    return os << "(" << p.x << ", " << p.y << ", " << p.v << ")";
+}
+
+}
+
+class Mousekey : public TestFixture {
+public:
+    ~Mousekey() {
+        mk_report_interval = MOUSEKEY_REPORT_INTERVAL;
+        mk_curve = MOUSEKEY_CURVE;
+    }
+
+    // Holds the keys for hold_time ms while running the scan loop every period
+    // ms and returns the accumulated position after each report, keyed by the
+    // time relative to the key press
+    std::map<uint32_t, Position> run(std::initializer_list<uint8_t> cols, uint32_t period, uint32_t hold_time) {
+        TestDriver driver;
+        std::map<uint32_t, Position> trajectory;
+        Position pos = {0, 0, 0};
+        uint32_t start = timer_read32();
+        EXPECT_CALL(driver, send_keyboard_mock(_)).Times(AnyNumber());
+        EXPECT_CALL(driver, send_mouse_mock(_)).WillRepeatedly(Invoke([&](report_mouse_t& report) {
+            pos.x += report.x;
+            pos.y += report.y;
+            pos.v += report.v;
+            trajectory[timer_read32() - start] = pos;
+        }));
+        for (uint8_t col : cols) {
+            press_key(col, 0);
+        }
+        for (uint32_t t = 0; t < hold_time; t += period) {
+            keyboard_task();
+            advance_time(period);
+        }
+        // Only one key change is processed per scan
+        for (uint8_t col : cols) {
+            release_key(col, 0);
+            keyboard_task();
+        }
+        return trajectory;
+    }
+};
+
+TEST_F(Mousekey, TapMovesOneStep) {
+    auto trajectory = run({3}, 1, 100);
+    ASSERT_EQ(trajectory.size(), 1);
+    EXPECT_EQ(trajectory.begin()->second, (Position{MOUSEKEY_MOVE_DELTA, 0, 0}));
+}
+
+TEST_F(Mousekey, NoMotionDuringInitialDelay) {
+    auto trajectory = run({1}, 1, MOUSEKEY_DELAY);
+    for (auto& p : trajectory) {
+        EXPECT_EQ(p.second, (Position{0, MOUSEKEY_MOVE_DELTA, 0}));
+    }
+}
+
+TEST_F(Mousekey, ReportsAreRateLimited) {
+    auto trajectory = run({3}, 1, 2000);
+    uint32_t last = 0;
+    for (auto& p : trajectory) {
+        if (p.first > MOUSEKEY_DELAY && last > MOUSEKEY_DELAY) {
+            EXPECT_GE(p.first - last, MOUSEKEY_REPORT_INTERVAL);
+        }
+        last = p.first;
+    }
+}
+
+TEST_F(Mousekey, SlowSpeedsMoveInSubPixelSteps) {
+    // One unit per interval at the start of the ramp, reported every ms
+    mk_report_interval = 1;
+    auto trajectory = run({4}, 1, MOUSEKEY_DELAY + 200);
+    int previous = 0;
+    for (auto& p : trajectory) {
+        EXPECT_LE(p.second.v - previous, 1);
+        previous = p.second.v;
+    }
+    EXPECT_GT(previous, MOUSEKEY_WHEEL_DELTA);
+}
+
+TEST_F(Mousekey, TrajectoryIsIndependentOfLoopRate) {
+    for (uint8_t curve : {MOUSEKEY_CURVE_LINEAR, MOUSEKEY_CURVE_QUADRATIC, MOUSEKEY_CURVE_CONSTANT}) {
+        mk_curve = curve;
+        mk_report_interval = 1;
+        auto reference = run({1, 3}, 1, 3000);
+        // Fill in the times without a report, the position didn't change then
+        std::map<uint32_t, Position> expected;
+        Position pos = {0, 0, 0};
+        for (uint32_t t = 0; t <= 3000; t++) {
+            auto it = reference.find(t);
+            if (it != reference.end()) {
+                pos = it->second;
+            }
+            expected[t] = pos;
+        }
+        EXPECT_GT(expected[2999].x, 1000);
+        EXPECT_EQ(expected[2999].x, expected[2999].y);
+
+        for (uint32_t period : {2, 3, 7, 16}) {
+            for (uint8_t report_interval : {MOUSEKEY_REPORT_INTERVAL, 25}) {
+                mk_report_interval = report_interval;
+                auto trajectory = run({1, 3}, period, 3000);
+                for (auto& p : trajectory) {
+                    if (p.first < 3000) {
+                        EXPECT_EQ(p.second, expected[p.first]) << "curve " << (int)curve
+                            << " period " << period << " interval " << (int)report_interval
+                            << " time " << p.first;
+                    }
+                }
+            }
+        }
+    }
+}
+
+TEST_F(Mousekey, ButtonDoesNotResendMotion) {
+    TestDriver driver;
+    press_key(3, 0);
+    EXPECT_CALL(driver, send_mouse_mock(_));
+    run_one_scan_loop();
+    testing::Mock::VerifyAndClearExpectations(&driver);
+    press_key(6, 0);
+    EXPECT_CALL(driver, send_mouse_mock(_)).WillOnce(Invoke([](report_mouse_t& report) {
+        EXPECT_EQ(report.buttons, MOUSE_BTN1);
+        EXPECT_EQ(report.x, 0);
+    }));
+    run_one_scan_loop();
+    testing::Mock::VerifyAndClearExpectations(&driver);
+    release_key(3, 0);
+    release_key(6, 0);
+    // Releasing the movement key has nothing new to report
+    EXPECT_CALL(driver, send_mouse_mock(_)).WillOnce(Invoke([](report_mouse_t& report) {
+        EXPECT_EQ(report.buttons, 0);
+    }));
+    run_one_scan_loop();
+    run_one_scan_loop();
+}
+
+TEST_F(Mousekey, StalledScanDoesNotStoreMotion) {
+    TestDriver driver;
+    int x = 0;
+    EXPECT_CALL(driver, send_keyboard_mock(_)).Times(AnyNumber());
+    EXPECT_CALL(driver, send_mouse_mock(_)).WillRepeatedly(Invoke([&](report_mouse_t& report) {
+        x += report.x;
+    }));
+    press_key(3, 0);
+    for (uint32_t t = 0; t < 3000; t++) {
+        keyboard_task();
+        advance_time(1);
+    }
+    // Motion in 100 ms at full speed
+    x = 0;
+    for (uint32_t t = 0; t < 100; t++) {
+        keyboard_task();
+        advance_time(1);
+    }
+    int normal = x;
+    x = 0;
+    advance_time(5000);
+    for (uint32_t t = 0; t < 100; t++) {
+        keyboard_task();
+        advance_time(1);
+    }
+    // The stall is worth at most one report at the maximum on top of the
+    // normal motion, the following reports don't catch up on the rest
+    EXPECT_LE(x, normal + 2 * MOUSEKEY_MOVE_MAX);
+    release_key(3, 0);
+    keyboard_task();
+}
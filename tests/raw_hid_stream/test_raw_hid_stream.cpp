@@ -0,0 +1,158 @@
+/* Copyright 2026 QMK Firmware contributors
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "test_common.hpp"
+#include <deque>
+#include <vector>
+
+extern "C" {
+#include "raw_stream.h"
+#include "dynamic_keymap.h"
+#include "raw_hid.h"
+}
+
+using testing::_;
+using testing::AnyNumber;
+using testing::ElementsAre;
+
+namespace {
+
+typedef std::vector<uint8_t> bytes;
+
+const uint8_t CUSTOM_COMMAND = 0x42;
+
+// Packets from the keyboard to the host
+std::deque<bytes> keyboard_packets;
+// Packets from the host to the keyboard
+std::deque<bytes> host_packets;
+std::vector<bytes> host_messages;
+
+bool host_send(uint8_t* packet, uint8_t length) {
+    host_packets.emplace_back(packet, packet + length);
+    return true;
+}
+
+void host_receive(raw_stream_t* stream, uint8_t* message, uint16_t length) {
+    host_messages.emplace_back(message, message + length);
+}
+
+}
+
+// The fake HID transport, collects everything sent to the host
+extern "C" bool raw_hid_send(uint8_t* data, uint8_t length) {
+    keyboard_packets.emplace_back(data, data + length);
+    return true;
+}
+
+extern "C" uint16_t raw_stream_command_user(uint8_t* data, uint16_t length, uint16_t size) {
+    if (data[0] == CUSTOM_COMMAND) {
+        data[1] = length >> 8;
+        data[2] = length & 0xFF;
+        return 3;
+    }
+    data[0] = RAW_STREAM_ERROR;
+    return length;
+}
+
+class RawHidStream : public TestFixture {
+public:
+    RawHidStream() {
+        keyboard_packets.clear();
+        host_packets.clear();
+        host_messages.clear();
+        raw_stream_init(&host, buffer, host_send, host_receive);
+        EXPECT_CALL(driver, send_keyboard_mock(_)).Times(AnyNumber());
+    }
+
+    ~RawHidStream() {
+        dynamic_keymap_reset();
+    }
+
+    // Sends a message from the host, and returns the reply
+    bytes transact(const bytes& request) {
+        EXPECT_TRUE(raw_stream_send_copy(&host, request.data(), request.size()));
+        for (int i = 0; i < 20 && host_messages.empty(); i++) {
+            while (!host_packets.empty()) {
+                raw_hid_receive(host_packets.front().data(), host_packets.front().size());
+                host_packets.pop_front();
+            }
+            run_one_scan_loop();
+            while (!keyboard_packets.empty()) {
+                EXPECT_EQ(keyboard_packets.front().size(), RAW_STREAM_PACKET_SIZE);
+                EXPECT_TRUE(raw_stream_receive(&host, keyboard_packets.front().data(), keyboard_packets.front().size()));
+                keyboard_packets.pop_front();
+            }
+            raw_stream_task(&host);
+        }
+        EXPECT_EQ(host_messages.size(), 1);
+        if (host_messages.empty()) {
+            return {};
+        }
+        bytes reply = host_messages[0];
+        host_messages.clear();
+        return reply;
+    }
+
+    TestDriver driver;
+    raw_stream_t host;
+    uint8_t buffer[RAW_STREAM_MESSAGE_SIZE];
+};
+
+TEST_F(RawHidStream, PingIsEchoed) {
+    bytes request(100);
+    request[0] = RAW_STREAM_PING;
+    for (uint8_t i = 1; i < request.size(); i++) {
+        request[i] = i;
+    }
+    EXPECT_EQ(transact(request), request);
+}
+
+TEST_F(RawHidStream, InfoDescribesTheTransport) {
+    EXPECT_THAT(transact({RAW_STREAM_GET_INFO}), ElementsAre(RAW_STREAM_GET_INFO, RAW_STREAM_PACKET_SIZE,
+        RAW_STREAM_MESSAGE_SIZE >> 8, RAW_STREAM_MESSAGE_SIZE & 0xFF, RAW_STREAM_WINDOW));
+}
+
+TEST_F(RawHidStream, WholeLayerInOneMessage) {
+    bytes request = {DYNAMIC_KEYMAP_GET_BUFFER, 1, 0, 0, DYNAMIC_KEYMAP_LAYER_SIZE};
+    request.resize(DYNAMIC_KEYMAP_BUFFER_HEADER + DYNAMIC_KEYMAP_LAYER_SIZE);
+    bytes layer = transact(request);
+    ASSERT_EQ(layer.size(), request.size());
+    ASSERT_EQ(layer[0], DYNAMIC_KEYMAP_GET_BUFFER);
+    EXPECT_EQ(layer[5] | (layer[6] << 8), KC_1);
+    EXPECT_EQ(layer[7] | (layer[8] << 8), KC_TRNS);
+    EXPECT_EQ(layer[layer.size() - 2] | (layer[layer.size() - 1] << 8), KC_2);
+
+    layer[0] = DYNAMIC_KEYMAP_SET_BUFFER;
+    layer[5] = KC_Z;
+    EXPECT_EQ(transact(layer)[0], DYNAMIC_KEYMAP_SET_BUFFER);
+    EXPECT_EQ(dynamic_keymap_get_keycode(1, 0, 0), KC_Z);
+}
+
+TEST_F(RawHidStream, SinglePacketCommandsStillWork) {
+    bytes request = {DYNAMIC_KEYMAP_GET_KEYCODE, 0, 3, 9};
+    request.resize(RAW_STREAM_PACKET_SIZE);
+    raw_hid_receive(request.data(), request.size());
+    ASSERT_EQ(keyboard_packets.size(), 1);
+    EXPECT_EQ(keyboard_packets[0].size(), RAW_STREAM_PACKET_SIZE);
+    EXPECT_EQ((keyboard_packets[0][4] << 8) | keyboard_packets[0][5], KC_C);
+}
+
+TEST_F(RawHidStream, OtherCommandsGoToTheKeymap) {
+    bytes request(60);
+    request[0] = CUSTOM_COMMAND;
+    EXPECT_THAT(transact(request), ElementsAre(CUSTOM_COMMAND, 0, 60));
+    EXPECT_EQ(transact({0x43, 1})[0], RAW_STREAM_ERROR);
+}
@@ -0,0 +1,235 @@
+/* Copyright 2026 QMK Firmware contributors
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "test_common.hpp"
+#include <algorithm>
+#include <random>
+#include <vector>
+
+extern "C" {
+#include "process_steno.h"
+}
+
+using testing::_;
+using testing::AnyNumber;
+
+namespace {
+
+enum { S1, TL, A, O, E, U, ZR, KEYS };
+
+// The steno keys of the columns
+const uint8_t steno_keys[KEYS] = {7, 9, 15, 16, 24, 25, 41};
+
+typedef std::vector<uint8_t> bytes_t;
+
+// The fake virtual serial port takes up to capacity bytes per write
+bytes_t serial;
+uint8_t capacity;
+unsigned writes;
+
+bytes_t gemini(std::vector<int> keys) {
+    bytes_t packet(6, 0);
+    packet[0] = 0x80;
+    for (int key : keys) {
+        uint8_t k = steno_keys[key];
+        packet[k / 7] |= 1 << (6 - k % 7);
+    }
+    return packet;
+}
+
+}
+
+extern "C" uint8_t virtser_write(const uint8_t* data, uint8_t length) {
+    uint8_t written = std::min(length, capacity);
+    serial.insert(serial.end(), data, data + written);
+    writes++;
+    return written;
+}
+
+class Steno : public TestFixture {
+public:
+    Steno() {
+        serial.clear();
+        capacity = 64;
+        writes = 0;
+        steno_set_mode(STENO_MODE_GEMINI);
+        EXPECT_CALL(driver, send_keyboard_mock(_)).Times(AnyNumber());
+    }
+
+    ~Steno() {
+        steno_set_first_up(false);
+        steno_set_repeat(false);
+    }
+
+    void press(int key) {
+        press_key(key, 0);
+        run_one_scan_loop();
+    }
+
+    void release(int key) {
+        release_key(key, 0);
+        run_one_scan_loop();
+    }
+
+    void stroke(const std::vector<int>& keys) {
+        for (int key : keys) {
+            press(key);
+        }
+        for (int key : keys) {
+            release(key);
+        }
+    }
+
+    TestDriver driver;
+};
+
+TEST_F(Steno, GeminiChordIsSentWhenAllKeysAreReleased) {
+    press(S1);
+    press(A);
+    release(S1);
+    run_one_scan_loop();
+    EXPECT_TRUE(serial.empty());
+    release(A);
+    run_one_scan_loop();
+    EXPECT_EQ(serial, (bytes_t{0x80, 0x40, 0x20, 0, 0, 0}));
+    EXPECT_EQ(serial, gemini({S1, A}));
+}
+
+TEST_F(Steno, BoltChordSkipsTheEmptyGroups) {
+    steno_set_mode(STENO_MODE_BOLT);
+    stroke({S1, E, ZR});
+    run_one_scan_loop();
+    EXPECT_EQ(serial, (bytes_t{0x01, 0x50, 0xC8, 0x00}));
+}
+
+TEST_F(Steno, AChordIsWrittenAtOnce) {
+    stroke({S1, TL, A, O, E, U, ZR});
+    idle_for(10);
+    EXPECT_EQ(serial, gemini({S1, TL, A, O, E, U, ZR}));
+    EXPECT_EQ(writes, 1);
+}
+
+TEST_F(Steno, FirstUpSendsTheChordWhenTheFirstKeyIsReleased) {
+    steno_set_first_up(true);
+    press(S1);
+    press(A);
+    release(S1);
+    run_one_scan_loop();
+    EXPECT_EQ(serial, gemini({S1, A}));
+    // A is still held, but only the keys pressed after the chord are sent
+    press(O);
+    release(A);
+    run_one_scan_loop();
+    release(O);
+    idle_for(10);
+    bytes_t expected = gemini({S1, A});
+    bytes_t second = gemini({O});
+    expected.insert(expected.end(), second.begin(), second.end());
+    EXPECT_EQ(serial, expected);
+}
+
+TEST_F(Steno, HeldChordsRepeat) {
+    steno_set_repeat(true);
+    press(E);
+    press(U);
+    idle_for(STENO_REPEAT_DELAY + 2 * STENO_REPEAT_INTERVAL);
+    release(E);
+    release(U);
+    idle_for(10);
+    bytes_t chord = gemini({E, U});
+    bytes_t expected;
+    for (int i = 0; i < 3; i++) {
+        expected.insert(expected.end(), chord.begin(), chord.end());
+    }
+    EXPECT_EQ(serial, expected);
+}
+
+TEST_F(Steno, ShortChordsDontRepeat) {
+    steno_set_repeat(true);
+    press(E);
+    idle_for(STENO_REPEAT_DELAY - 10);
+    press(U);
+    idle_for(STENO_REPEAT_DELAY - 10);
+    release(E);
+    release(U);
+    idle_for(10);
+    EXPECT_EQ(serial, gemini({E, U}));
+}
+
+TEST_F(Steno, ChordsWaitForTheEndpoint) {
+    capacity = 0;
+    stroke({S1});
+    stroke({A});
+    idle_for(10);
+    EXPECT_TRUE(serial.empty());
+    capacity = 4;
+    idle_for(10);
+    bytes_t expected = gemini({S1});
+    bytes_t second = gemini({A});
+    expected.insert(expected.end(), second.begin(), second.end());
+    EXPECT_EQ(serial, expected);
+}
+
+TEST_F(Steno, AFullBufferDropsWholeChords) {
+    capacity = 0;
+    const int chords = STENO_BUFFER_SIZE / 6 + 5;
+    for (int i = 0; i < chords; i++) {
+        stroke({i % 2 ? A : O});
+    }
+    capacity = 64;
+    idle_for(10);
+    bytes_t expected;
+    for (int i = 0; i < STENO_BUFFER_SIZE / 6; i++) {
+        bytes_t chord = gemini({i % 2 ? A : O});
+        expected.insert(expected.end(), chord.begin(), chord.end());
+    }
+    EXPECT_EQ(serial, expected);
+}
+
+TEST_F(Steno, StreamsThousandsOfChords) {
+    std::mt19937 rng(1);
+    bytes_t expected;
+    unsigned scans = 0;
+    for (int i = 0; i < 5000; i++) {
+        std::vector<int> keys;
+        for (int key = 0; key < KEYS; key++) {
+            if (rng() % 3 == 0) {
+                keys.push_back(key);
+            }
+        }
+        if (keys.empty()) {
+            keys.push_back(rng() % KEYS);
+        }
+        std::shuffle(keys.begin(), keys.end(), rng);
+        bytes_t chord = gemini(keys);
+        expected.insert(expected.end(), chord.begin(), chord.end());
+        // The host reads a random amount each time
+        for (int key : keys) {
+            capacity = rng() % 16;
+            press(key);
+        }
+        for (int key : keys) {
+            capacity = rng() % 16;
+            release(key);
+        }
+        scans += 2 * keys.size();
+    }
+    capacity = 64;
+    idle_for(10);
+    EXPECT_EQ(serial, expected);
+    // Never more than two writes per scan
+    EXPECT_LE(writes, 2 * (scans + 10));
+}
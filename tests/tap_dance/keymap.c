@@ -0,0 +1,52 @@
+/* Copyright 2026 QMK Firmware contributors
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "quantum.h"
+
+// Dance n is at col n % 8, row n / 8, followed by a normal key
+const uint16_t PROGMEM keymaps[][MATRIX_ROWS][MATRIX_COLS] = {
+    [0] = {
+        {TD(0),  TD(1),  TD(2),  TD(3),  TD(4),  TD(5),  TD(6),  TD(7)},
+        {TD(8),  TD(9),  TD(10), TD(11), TD(12), TD(13), TD(14), TD(15)},
+        {TD(16), TD(17), TD(18), TD(19), TD(20), TD(21), TD(22), TD(23)},
+        {TD(24), TD(25), TD(26), TD(27), TD(28), TD(29), TD(30), TD(31)},
+        {TD(32), TD(33), TD(34), TD(35), TD(36), TD(37), TD(38), TD(39)},
+        {TD(40), TD(41), TD(42), TD(43), TD(44), TD(45), TD(46), TD(47)},
+        {TD(48), TD(49), TD(50), TD(51), TD(52), TD(53), TD(54), TD(55)},
+        {TD(56), TD(57), TD(58), TD(59), TD(60), TD(61), TD(62), TD(63)},
+        {KC_Z,   KC_NO,  KC_NO,  KC_NO,  KC_NO,  KC_NO,  KC_NO,  KC_NO},
+    },
+};
+
+// Dance n sends the nth letter on one tap, and the nth digit on two taps
+#define PAIR(n) [n] = ACTION_TAP_DANCE_DOUBLE(KC_A + (n) % 26, KC_1 + (n) % 10)
+
+qk_tap_dance_action_t tap_dance_actions[] = {
+    PAIR(0),  PAIR(1),  PAIR(2),  PAIR(3),  PAIR(4),  PAIR(5),  PAIR(6),  PAIR(7),
+    PAIR(8),  PAIR(9),  PAIR(10), PAIR(11), PAIR(12), PAIR(13), PAIR(14), PAIR(15),
+    PAIR(16), PAIR(17), PAIR(18), PAIR(19), PAIR(20), PAIR(21), PAIR(22), PAIR(23),
+    PAIR(24), PAIR(25), PAIR(26), PAIR(27), PAIR(28), PAIR(29), PAIR(30), PAIR(31),
+    PAIR(32), PAIR(33), PAIR(34), PAIR(35), PAIR(36), PAIR(37), PAIR(38), PAIR(39),
+    PAIR(40), PAIR(41), PAIR(42), PAIR(43), PAIR(44), PAIR(45), PAIR(46), PAIR(47),
+    PAIR(48), PAIR(49), PAIR(50), PAIR(51), PAIR(52), PAIR(53), PAIR(54), PAIR(55),
+    PAIR(56), PAIR(57), PAIR(58), PAIR(59), PAIR(60), PAIR(61), PAIR(62),
+    // The last dance has a shorter tapping term
+    [63] = {
+        .fn = { qk_tap_dance_pair_on_each_tap, qk_tap_dance_pair_finished, qk_tap_dance_pair_reset },
+        .user_data = (void *)&((qk_tap_dance_pair_t) { KC_L, KC_4 }),
+        .custom_tapping_term = 50,
+    },
+};
@@ -0,0 +1,169 @@
+/* Copyright 2026 QMK Firmware contributors
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "test_common.hpp"
+#include "action_tapping.h"
+
+using testing::_;
+using testing::AnyNumber;
+using testing::AtLeast;
+using testing::InSequence;
+using testing::Mock;
+
+namespace {
+
+const int Dances = 64;
+
+uint8_t letter(int dance) {
+    return KC_A + dance % 26;
+}
+
+uint8_t digit(int dance) {
+    return KC_1 + dance % 10;
+}
+
+uint16_t term(int dance) {
+    return dance == 63 ? 50 : TAPPING_TERM;
+}
+
+}
+
+class TapDance : public TestFixture {
+public:
+    void press(int dance) {
+        press_key(dance % MATRIX_COLS, dance / MATRIX_COLS);
+        run_one_scan_loop();
+    }
+
+    void release(int dance) {
+        release_key(dance % MATRIX_COLS, dance / MATRIX_COLS);
+        run_one_scan_loop();
+    }
+
+    void tap(int dance) {
+        press(dance);
+        release(dance);
+    }
+
+    // The reports without keys are not interesting, the dances send a few
+    // of them when they finish and reset
+    void ignore_empty_reports() {
+        EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport())).Times(AnyNumber());
+    }
+
+    TestDriver driver;
+};
+
+TEST_F(TapDance, EveryDanceFinishesAfterItsTappingTerm) {
+    for (int dance = 0; dance < Dances; dance++) {
+        EXPECT_CALL(driver, send_keyboard_mock(_)).Times(0);
+        tap(dance);
+        // The tap is two scans, and the term has to be exceeded
+        idle_for(term(dance) - 1);
+        Mock::VerifyAndClearExpectations(&driver);
+
+        ignore_empty_reports();
+        EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(letter(dance))));
+        run_one_scan_loop();
+        Mock::VerifyAndClearExpectations(&driver);
+
+        EXPECT_CALL(driver, send_keyboard_mock(_)).Times(0);
+        idle_for(TAPPING_TERM);
+        Mock::VerifyAndClearExpectations(&driver);
+    }
+}
+
+TEST_F(TapDance, EveryDanceCanBeDoubleTapped) {
+    for (int dance = 0; dance < Dances; dance++) {
+        EXPECT_CALL(driver, send_keyboard_mock(_)).Times(0);
+        tap(dance);
+        Mock::VerifyAndClearExpectations(&driver);
+
+        EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(digit(dance))));
+        press(dance);
+        Mock::VerifyAndClearExpectations(&driver);
+
+        EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport())).Times(AnyNumber());
+        release(dance);
+        idle_for(TAPPING_TERM);
+        Mock::VerifyAndClearExpectations(&driver);
+    }
+}
+
+TEST_F(TapDance, AKeyPressInterruptsTheDance) {
+    ignore_empty_reports();
+    {
+        InSequence s;
+        EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(letter(45))));
+        EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_Z)));
+    }
+    tap(45);
+    idle_for(10);
+    press_key(0, 8);
+    run_one_scan_loop();
+    Mock::VerifyAndClearExpectations(&driver);
+
+    // The dance doesn't finish again
+    EXPECT_CALL(driver, send_keyboard_mock(_)).Times(0);
+    idle_for(TAPPING_TERM);
+    Mock::VerifyAndClearExpectations(&driver);
+
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport()));
+    release_key(0, 8);
+    run_one_scan_loop();
+}
+
+TEST_F(TapDance, AnotherDanceInterruptsTheDance) {
+    ignore_empty_reports();
+    {
+        InSequence s;
+        EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(letter(5))));
+        EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(letter(60))));
+    }
+    tap(5);
+    idle_for(10);
+    tap(60);
+    idle_for(TAPPING_TERM);
+}
+
+TEST_F(TapDance, AHeldDanceIsReleasedWithTheKey) {
+    ignore_empty_reports();
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(letter(20))));
+    press(20);
+    idle_for(TAPPING_TERM * 3);
+    Mock::VerifyAndClearExpectations(&driver);
+
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport())).Times(AtLeast(1));
+    release(20);
+}
+
+TEST_F(TapDance, ADanceCanFinishWhileAnotherIsHeld) {
+    ignore_empty_reports();
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(letter(1))));
+    press(1);
+    idle_for(TAPPING_TERM + 1);
+    Mock::VerifyAndClearExpectations(&driver);
+
+    // The first dance stays finished, and its key stays pressed
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(letter(1)))).Times(AnyNumber());
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(letter(1), letter(2))));
+    tap(2);
+    idle_for(TAPPING_TERM);
+    Mock::VerifyAndClearExpectations(&driver);
+
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport())).Times(AtLeast(1));
+    release(1);
+}
@@ -0,0 +1,34 @@
+/* Copyright 2026 QMK Firmware contributors
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "quantum.h"
+
+const uint16_t PROGMEM keymaps[][MATRIX_ROWS][MATRIX_COLS] = {
+    [0] = {
+        {X(0), X(1), X(2), KC_LSFT, KC_A},
+    },
+};
+
+// e acute, a grinning face, and a code point outside of Unicode
+const uint32_t PROGMEM unicode_map[] = {
+    0x00E9, 0x1F600, 0x110000,
+};
+
+int unicode_map_errors;
+
+void unicode_map_input_error(void) {
+    unicode_map_errors++;
+}
@@ -0,0 +1,243 @@
+/* Copyright 2026 QMK Firmware contributors
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "test_common.hpp"
+#include <vector>
+
+extern "C" {
+#include "process_unicode_common.h"
+extern int unicode_map_errors;
+}
+
+using testing::_;
+using testing::Invoke;
+using testing::Mock;
+
+namespace {
+
+const uint8_t E_ACUTE = 0;
+const uint8_t GRINNING = 1;
+const uint8_t OUT_OF_RANGE = 2;
+const uint8_t SHIFT = 3;
+const uint8_t LETTER = 4;
+
+const uint8_t LALT = MOD_BIT(KC_LALT);
+const uint8_t RALT = MOD_BIT(KC_RALT);
+const uint8_t CTRL_SHIFT = MOD_BIT(KC_LCTL) | MOD_BIT(KC_LSFT);
+
+// A report with the given mods and at most one key
+struct step_t {
+    uint8_t mods;
+    uint8_t key;
+
+    bool operator==(const step_t& other) const {
+        return mods == other.mods && key == other.key;
+    }
+};
+
+std::ostream& operator<<(std::ostream& stream, const step_t& step) {
+    return stream << "{mods " << (int)step.mods << ", key " << (int)step.key << "}";
+}
+
+typedef std::vector<step_t> steps_t;
+
+steps_t operator+(steps_t lhs, const steps_t& rhs) {
+    lhs.insert(lhs.end(), rhs.begin(), rhs.end());
+    return lhs;
+}
+
+steps_t digits(uint8_t mods, std::vector<uint8_t> keys) {
+    steps_t steps;
+    for (uint8_t key : keys) {
+        steps.push_back({mods, key});
+        steps.push_back({mods, KC_NO});
+    }
+    return steps;
+}
+
+const steps_t LINUX_START = {{CTRL_SHIFT, KC_NO}, {CTRL_SHIFT, KC_U}, {0, KC_NO}};
+const steps_t LINUX_FINISH = {{0, KC_SPC}, {0, KC_NO}};
+const steps_t E_ACUTE_LINUX = LINUX_START + digits(0, {KC_0, KC_0, KC_E, KC_9}) + LINUX_FINISH;
+
+}
+
+class UnicodeMap : public TestFixture {
+public:
+    UnicodeMap() {
+        unicode_map_errors = 0;
+        ON_CALL(driver, send_keyboard_mock(_)).WillByDefault(Invoke([this](report_keyboard_t& report) {
+            uint8_t key = KC_NO;
+            for (uint8_t i = 0; i < KEYBOARD_REPORT_KEYS; i++) {
+                if (report.keys[i]) {
+                    EXPECT_EQ(key, KC_NO) << "More than one key is pressed";
+                    key = report.keys[i];
+                }
+            }
+            reports.push_back({report.mods, key});
+            times.push_back(timer_read());
+        }));
+        EXPECT_CALL(driver, send_keyboard_mock(_)).Times(testing::AnyNumber());
+    }
+
+    ~UnicodeMap() {
+        set_unicode_input_mode(UC_OSX);
+    }
+
+    void tap(uint8_t col) {
+        press_key(col, 0);
+        run_one_scan_loop();
+        release_key(col, 0);
+        run_one_scan_loop();
+    }
+
+    void type(uint8_t col) {
+        tap(col);
+        idle_for(100);
+    }
+
+    TestDriver driver;
+    steps_t reports;
+    std::vector<uint16_t> times;
+};
+
+TEST_F(UnicodeMap, TypesOnLinux) {
+    set_unicode_input_mode(UC_LNX);
+    type(E_ACUTE);
+    EXPECT_EQ(reports, E_ACUTE_LINUX);
+}
+
+TEST_F(UnicodeMap, TypesFiveDigitsOnLinux) {
+    set_unicode_input_mode(UC_LNX);
+    type(GRINNING);
+    EXPECT_EQ(reports, LINUX_START + digits(0, {KC_1, KC_F, KC_6, KC_0, KC_0}) + LINUX_FINISH);
+}
+
+TEST_F(UnicodeMap, TypesSurrogatePairsOnOSX) {
+    for (uint8_t mode : {UC_OSX, UC_OSX_RALT}) {
+        reports.clear();
+        set_unicode_input_mode(mode);
+        type(GRINNING);
+        uint8_t alt = mode == UC_OSX ? LALT : RALT;
+        steps_t expected = steps_t{{alt, KC_NO}} +
+            digits(alt, {KC_D, KC_8, KC_3, KC_D, KC_D, KC_E, KC_0, KC_0}) +
+            steps_t{{0, KC_NO}};
+        EXPECT_EQ(reports, expected);
+    }
+}
+
+TEST_F(UnicodeMap, TypesOnWindows) {
+    set_unicode_input_mode(UC_WIN);
+    type(E_ACUTE);
+    steps_t expected = steps_t{{LALT, KC_NO}, {LALT, KC_PPLS}, {LALT, KC_NO}} +
+        digits(LALT, {KC_0, KC_0, KC_E, KC_9}) +
+        steps_t{{0, KC_NO}};
+    EXPECT_EQ(reports, expected);
+}
+
+TEST_F(UnicodeMap, TypesWithWinCompose) {
+    set_unicode_input_mode(UC_WINC);
+    type(E_ACUTE);
+    steps_t expected = steps_t{{RALT, KC_NO}, {0, KC_NO}, {0, KC_U}, {0, KC_NO}} +
+        digits(0, {KC_0, KC_0, KC_E, KC_9});
+    EXPECT_EQ(reports, expected);
+}
+
+TEST_F(UnicodeMap, UnsupportedCodePointsAreReported) {
+    set_unicode_input_mode(UC_OSX);
+    type(OUT_OF_RANGE);
+    set_unicode_input_mode(UC_LNX);
+    type(OUT_OF_RANGE);
+    EXPECT_EQ(unicode_map_errors, 2);
+    EXPECT_TRUE(reports.empty());
+    set_unicode_input_mode(UC_WINC);
+    type(OUT_OF_RANGE);
+    EXPECT_EQ(unicode_map_errors, 2);
+    EXPECT_FALSE(reports.empty());
+}
+
+TEST_F(UnicodeMap, HeldModsAreClearedAndRestoredOnce) {
+    set_unicode_input_mode(UC_LNX);
+    press_key(SHIFT, 0);
+    run_one_scan_loop();
+    type(E_ACUTE);
+    steps_t expected = steps_t{{MOD_BIT(KC_LSFT), KC_NO}, {0, KC_NO}} +
+        E_ACUTE_LINUX +
+        steps_t{{MOD_BIT(KC_LSFT), KC_NO}};
+    EXPECT_EQ(reports, expected);
+}
+
+TEST_F(UnicodeMap, OneReportIsSentPerScan) {
+    set_unicode_input_mode(UC_LNX);
+    tap(E_ACUTE);
+    tap(E_ACUTE);
+    tap(E_ACUTE);
+    idle_for(100);
+    EXPECT_EQ(reports, E_ACUTE_LINUX + E_ACUTE_LINUX + E_ACUTE_LINUX);
+    // Each scan takes a millisecond
+    for (size_t i = 1; i < times.size(); i++) {
+        EXPECT_GT(times[i], times[i - 1]);
+    }
+    // The first digit waits for UNICODE_TYPE_DELAY after the start
+    for (size_t i = 0; i < 3; i++) {
+        size_t start = i * E_ACUTE_LINUX.size() + LINUX_START.size() - 1;
+        EXPECT_GE(times[start + 1] - times[start], UNICODE_TYPE_DELAY);
+    }
+}
+
+TEST_F(UnicodeMap, TheQueueIsTypedBeforeOtherKeys) {
+    set_unicode_input_mode(UC_LNX);
+    tap(E_ACUTE);
+    press_key(LETTER, 0);
+    run_one_scan_loop();
+    EXPECT_EQ(reports, (E_ACUTE_LINUX + steps_t{{0, KC_A}}));
+    release_key(LETTER, 0);
+    run_one_scan_loop();
+}
+
+TEST_F(UnicodeMap, AFullQueueIsTypedAtOnce) {
+    set_unicode_input_mode(UC_LNX);
+    for (int i = 0; i < UNICODE_QUEUE_SIZE; i++) {
+        EXPECT_TRUE(unicode_send(0xE9));
+    }
+    EXPECT_TRUE(reports.empty());
+    EXPECT_TRUE(unicode_send(0xE9));
+    EXPECT_EQ(reports.size(), E_ACUTE_LINUX.size() * UNICODE_QUEUE_SIZE);
+    idle_for(100);
+    EXPECT_EQ(reports.size(), E_ACUTE_LINUX.size() * (UNICODE_QUEUE_SIZE + 1));
+}
+
+TEST_F(UnicodeMap, TypesUTF8Strings) {
+    set_unicode_input_mode(UC_LNX);
+    EXPECT_TRUE(unicode_send_string("\xC3\xA9" "a\xF0\x9F\x98\x80"));
+    idle_for(100);
+    steps_t expected = E_ACUTE_LINUX +
+        LINUX_START + digits(0, {KC_0, KC_0, KC_6, KC_1}) + LINUX_FINISH +
+        LINUX_START + digits(0, {KC_1, KC_F, KC_6, KC_0, KC_0}) + LINUX_FINISH;
+    EXPECT_EQ(reports, expected);
+    EXPECT_FALSE(unicode_send_string("\xC3"));
+}
+
+TEST_F(UnicodeMap, TheBlockingFunctionsTypeTheSame) {
+    set_unicode_input_mode(UC_LNX);
+    press_key(SHIFT, 0);
+    run_one_scan_loop();
+    reports.clear();
+    unicode_input_start();
+    register_hex(0xE9);
+    unicode_input_finish();
+    steps_t expected = steps_t{{0, KC_NO}} + E_ACUTE_LINUX + steps_t{{MOD_BIT(KC_LSFT), KC_NO}};
+    EXPECT_EQ(reports, expected);
+}
@@ -68,6 +68,11 @@ else
     TMK_COMMON_DEFS += -DNO_DEBUG
 endif
 
+ifeq ($(strip $(TRACE_ENABLE)), yes)
+    TMK_COMMON_SRC += $(COMMON_DIR)/trace.c
+    TMK_COMMON_DEFS += -DTRACE_ENABLE
+endif
+
 ifeq ($(strip $(COMMAND_ENABLE)), yes)
     TMK_COMMON_SRC += $(COMMON_DIR)/command.c
     TMK_COMMON_DEFS += -DCOMMAND_ENABLE
@@ -143,6 +148,11 @@ ifeq ($(strip $(KEYMAP_SECTION_ENABLE)), yes)
     endif
 endif
 
+# Mouse report aggregator, shared by all pointing sources
+ifneq ($(filter -DMOUSE_ENABLE,$(OPT_DEFS) $(TMK_COMMON_DEFS)),)
+    TMK_COMMON_SRC += $(COMMON_DIR)/mouse_report.c
+endif
+
 # Bootloader address
 ifdef STM32_BOOTLOADER_ADDRESS
     TMK_COMMON_DEFS += -DSTM32_BOOTLOADER_ADDRESS=$(STM32_BOOTLOADER_ADDRESS)
@@ -47,8 +47,8 @@ int retro_tapping_counter = 0;
 void action_exec(keyevent_t event)
 {
     if (!IS_NOEVENT(event)) {
-        dprint("\n---- action_exec: start -----\n");
-        dprint("EVENT: "); debug_event(event); dprintln();
+        dtrace(TRACE_ACTION_EXEC);
+        dtrace(TRACE_ACTION_EVENT, TRACE_EVENT_ARGS(event));
 #ifdef RETRO_TAPPING
         retro_tapping_counter++;
 #endif
@@ -86,7 +86,7 @@ void action_exec(keyevent_t event)
 #else
     process_record(&record);
     if (!IS_NOEVENT(record.event)) {
-        dprint("processed: "); debug_record(record); dprintln();
+        dtrace(TRACE_PROCESSED_EVENT, TRACE_EVENT_ARGS(record.event));
     }
 #endif
 }
@@ -140,12 +140,14 @@ void process_record(keyrecord_t *record)
         return;
 
     action_t action = store_or_get_action(record->event.pressed, record->event.key);
-    dprint("ACTION: "); debug_action(action);
+    dtrace(TRACE_ACTION); debug_action(action);
 #ifndef NO_ACTION_LAYER
-    dprint(" layer_state: "); layer_debug();
-    dprint(" default_layer_state: "); default_layer_debug();
+    dtrace(TRACE_LAYER_STATES,
+           (uint16_t)(layer_state >> 16), (uint16_t)layer_state, biton32(layer_state),
+           (uint16_t)(default_layer_state >> 16), (uint16_t)default_layer_state, biton32(default_layer_state));
+#else
+    dtrace(TRACE_NEWLINE);
 #endif
-    dprintln();
 
     process_action(record, action);
 }
@@ -216,14 +218,14 @@ void process_action(keyrecord_t *record, action_t action)
                         // Oneshot modifier
                         if (event.pressed) {
                             if (tap_count == 0) {
-                                dprint("MODS_TAP: Oneshot: 0\n");
+                                dtrace(TRACE_MODS_TAP_ONESHOT_0);
                                 register_mods(mods);
                             } else if (tap_count == 1) {
-                                dprint("MODS_TAP: Oneshot: start\n");
+                                dtrace(TRACE_MODS_TAP_ONESHOT_START);
                                 set_oneshot_mods(mods);
                     #if defined(ONESHOT_TAP_TOGGLE) && ONESHOT_TAP_TOGGLE > 1
                             } else if (tap_count == ONESHOT_TAP_TOGGLE) {
-                                dprint("MODS_TAP: Toggling oneshot");
+                                dtrace(TRACE_MODS_TAP_ONESHOT_TOGGLE);
                                 clear_oneshot_mods();
                                 set_oneshot_locked_mods(mods);
                                 register_mods(mods);
@@ -269,26 +271,26 @@ void process_action(keyrecord_t *record, action_t action)
                             if (tap_count > 0) {
 #ifndef IGNORE_MOD_TAP_INTERRUPT
                                 if (record->tap.interrupted) {
-                                    dprint("mods_tap: tap: cancel: add_mods\n");
+                                    dtrace(TRACE_MODS_TAP_CANCEL);
                                     // ad hoc: set 0 to cancel tap
                                     record->tap.count = 0;
                                     register_mods(mods);
                                 } else
 #endif
                                 {
-                                    dprint("MODS_TAP: Tap: register_code\n");
+                                    dtrace(TRACE_MODS_TAP_REGISTER);
                                     register_code(action.key.code);
                                 }
                             } else {
-                                dprint("MODS_TAP: No tap: add_mods\n");
+                                dtrace(TRACE_MODS_TAP_ADD_MODS);
                                 register_mods(mods);
                             }
                         } else {
                             if (tap_count > 0) {
-                                dprint("MODS_TAP: Tap: unregister_code\n");
+                                dtrace(TRACE_MODS_TAP_UNREGISTER);
                                 unregister_code(action.key.code);
                             } else {
-                                dprint("MODS_TAP: No tap: add_mods\n");
+                                dtrace(TRACE_MODS_TAP_ADD_MODS);
                                 unregister_mods(mods);
                             }
                         }
@@ -467,21 +469,21 @@ void process_action(keyrecord_t *record, action_t action)
                     /* tap key */
                     if (event.pressed) {
                         if (tap_count > 0) {
-                            dprint("KEYMAP_TAP_KEY: Tap: register_code\n");
+                            dtrace(TRACE_LAYER_TAP_REGISTER);
                             register_code(action.layer_tap.code);
                         } else {
-                            dprint("KEYMAP_TAP_KEY: No tap: On on press\n");
+                            dtrace(TRACE_LAYER_TAP_ON);
                             layer_on(action.layer_tap.val);
                         }
                     } else {
                         if (tap_count > 0) {
-                            dprint("KEYMAP_TAP_KEY: Tap: unregister_code\n");
+                            dtrace(TRACE_LAYER_TAP_UNREGISTER);
                             if (action.layer_tap.code == KC_CAPS) {
                                 wait_ms(80);
                             }
                             unregister_code(action.layer_tap.code);
                         } else {
-                            dprint("KEYMAP_TAP_KEY: No tap: Off on release\n");
+                            dtrace(TRACE_LAYER_TAP_OFF);
                             layer_off(action.layer_tap.val);
                         }
                     }
@@ -849,34 +851,35 @@ bool is_tap_key(keypos_t key)
  */
 void debug_event(keyevent_t event)
 {
-    dprintf("%04X%c(%u)", (event.key.row<<8 | event.key.col), (event.pressed ? 'd' : 'u'), event.time);
+    dtrace(TRACE_EVENT, TRACE_EVENT_ARGS(event));
 }
 
 void debug_record(keyrecord_t record)
 {
-    debug_event(record.event);
 #ifndef NO_ACTION_TAPPING
-    dprintf(":%u%c", record.tap.count, (record.tap.interrupted ? '-' : ' '));
+    dtrace(TRACE_RECORD, TRACE_RECORD_ARGS(record));
+#else
+    debug_event(record.event);
 #endif
 }
 
 void debug_action(action_t action)
 {
+    __attribute__((unused)) uint16_t param = action.kind.param;
     switch (action.kind.id) {
-        case ACT_LMODS:             dprint("ACT_LMODS");             break;
-        case ACT_RMODS:             dprint("ACT_RMODS");             break;
-        case ACT_LMODS_TAP:         dprint("ACT_LMODS_TAP");         break;
-        case ACT_RMODS_TAP:         dprint("ACT_RMODS_TAP");         break;
-        case ACT_USAGE:             dprint("ACT_USAGE");             break;
-        case ACT_MOUSEKEY:          dprint("ACT_MOUSEKEY");          break;
-        case ACT_LAYER:             dprint("ACT_LAYER");             break;
-        case ACT_LAYER_TAP:         dprint("ACT_LAYER_TAP");         break;
-        case ACT_LAYER_TAP_EXT:     dprint("ACT_LAYER_TAP_EXT");     break;
-        case ACT_MACRO:             dprint("ACT_MACRO");             break;
-        case ACT_COMMAND:           dprint("ACT_COMMAND");           break;
-        case ACT_FUNCTION:          dprint("ACT_FUNCTION");          break;
-        case ACT_SWAP_HANDS:        dprint("ACT_SWAP_HANDS");        break;
-        default:                    dprint("UNKNOWN");               break;
-    }
-    dprintf("[%X:%02X]", action.kind.param>>8, action.kind.param&0xff);
+        case ACT_LMODS:             dtrace(TRACE_ACT_LMODS, param >> 8, param & 0xff);         break;
+        case ACT_RMODS:             dtrace(TRACE_ACT_RMODS, param >> 8, param & 0xff);         break;
+        case ACT_LMODS_TAP:         dtrace(TRACE_ACT_LMODS_TAP, param >> 8, param & 0xff);     break;
+        case ACT_RMODS_TAP:         dtrace(TRACE_ACT_RMODS_TAP, param >> 8, param & 0xff);     break;
+        case ACT_USAGE:             dtrace(TRACE_ACT_USAGE, param >> 8, param & 0xff);         break;
+        case ACT_MOUSEKEY:          dtrace(TRACE_ACT_MOUSEKEY, param >> 8, param & 0xff);      break;
+        case ACT_LAYER:             dtrace(TRACE_ACT_LAYER, param >> 8, param & 0xff);         break;
+        case ACT_LAYER_TAP:         dtrace(TRACE_ACT_LAYER_TAP, param >> 8, param & 0xff);     break;
+        case ACT_LAYER_TAP_EXT:     dtrace(TRACE_ACT_LAYER_TAP_EXT, param >> 8, param & 0xff); break;
+        case ACT_MACRO:             dtrace(TRACE_ACT_MACRO, param >> 8, param & 0xff);         break;
+        case ACT_COMMAND:           dtrace(TRACE_ACT_COMMAND, param >> 8, param & 0xff);       break;
+        case ACT_FUNCTION:          dtrace(TRACE_ACT_FUNCTION, param >> 8, param & 0xff);      break;
+        case ACT_SWAP_HANDS:        dtrace(TRACE_ACT_SWAP_HANDS, param >> 8, param & 0xff);    break;
+        default:                    dtrace(TRACE_ACT_UNKNOWN, param >> 8, param & 0xff);       break;
+    }
 }
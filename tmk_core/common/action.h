@@ -101,6 +101,12 @@ void debug_event(keyevent_t event);
 void debug_record(keyrecord_t record);
 void debug_action(action_t action);
 
+/* the arguments of TRACE_EVENT_FORMAT and TRACE_RECORD_FORMAT */
+#define TRACE_EVENT_ARGS(event) ((event).key.row << 8 | (event).key.col), ((event).pressed ? 'd' : 'u'), (event).time
+#ifndef NO_ACTION_TAPPING
+#define TRACE_RECORD_ARGS(record) TRACE_EVENT_ARGS((record).event), (record).tap.count, ((record).tap.interrupted ? '-' : ' ')
+#endif
+
 #ifdef __cplusplus
 }
 #endif
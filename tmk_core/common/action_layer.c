@@ -3,6 +3,12 @@
 #include "action.h"
 #include "util.h"
 #include "action_layer.h"
+#ifdef KEYMAP_COMPACT_ENABLE
+#include "keymap_compact.h"
+#endif
+#ifdef VISUALIZER_ENABLE
+#include "visualizer/visualizer.h"
+#endif
 
 #ifdef DEBUG_ACTION
 #include "debug.h"
@@ -28,6 +34,9 @@ static void default_layer_state_set(uint32_t state)
     default_layer_debug(); debug(" to ");
     default_layer_state = state;
     default_layer_debug(); debug("\n");
+#ifdef VISUALIZER_ENABLE
+    visualizer_set_default_layer_state(default_layer_state);
+#endif
     clear_keyboard_but_mods(); // To avoid stuck keys
 }
 
@@ -80,6 +89,9 @@ void layer_state_set(uint32_t state)
     layer_debug(); dprint(" to ");
     layer_state = state;
     layer_debug(); dprintln();
+#ifdef VISUALIZER_ENABLE
+    visualizer_set_layer_state(layer_state);
+#endif
     clear_keyboard_but_mods(); // To avoid stuck keys
 }
 
@@ -211,6 +223,12 @@ int8_t layer_switch_get_layer(keypos_t key)
     /* check top layer first */
     for (int8_t i = 31; i >= 0; i--) {
         if (layers & (1UL<<i)) {
+#ifdef KEYMAP_COMPACT_ENABLE
+            /* transparent keys can be skipped without decoding them */
+            if (!keymap_compact_has_key(i, key)) {
+                continue;
+            }
+#endif
             action = action_for_key(i, key);
             if (action.code != ACTION_TRANSPARENT) {
                 return i;
@@ -40,12 +40,12 @@ void action_tapping_process(keyrecord_t record)
 {
     if (process_tapping(&record)) {
         if (!IS_NOEVENT(record.event)) {
-            debug("processed: "); debug_record(record); debug("\n");
+            dtrace(TRACE_PROCESSED, TRACE_RECORD_ARGS(record));
         }
     } else {
         if (!waiting_buffer_enq(record)) {
             // clear all in case of overflow.
-            debug("OVERFLOW: CLEAR ALL STATES\n");
+            dtrace(TRACE_TAPPING_OVERFLOW);
             clear_keyboard();
             waiting_buffer_clear();
             tapping_key = (keyrecord_t){};
@@ -54,18 +54,17 @@ void action_tapping_process(keyrecord_t record)
 
     // process waiting_buffer
     if (!IS_NOEVENT(record.event) && waiting_buffer_head != waiting_buffer_tail) {
-        debug("---- action_exec: process waiting_buffer -----\n");
+        dtrace(TRACE_WAITING_BUFFER_PROCESS);
     }
     for (; waiting_buffer_tail != waiting_buffer_head; waiting_buffer_tail = (waiting_buffer_tail + 1) % WAITING_BUFFER_SIZE) {
         if (process_tapping(&waiting_buffer[waiting_buffer_tail])) {
-            debug("processed: waiting_buffer["); debug_dec(waiting_buffer_tail); debug("] = ");
-            debug_record(waiting_buffer[waiting_buffer_tail]); debug("\n\n");
+            dtrace(TRACE_WAITING_BUFFER_PROCESSED, waiting_buffer_tail, TRACE_RECORD_ARGS(waiting_buffer[waiting_buffer_tail]));
         } else {
             break;
         }
     }
     if (!IS_NOEVENT(record.event)) {
-        debug("\n");
+        dtrace(TRACE_NEWLINE);
     }
 }
 
@@ -86,7 +85,7 @@ bool process_tapping(keyrecord_t *keyp)
             if (tapping_key.tap.count == 0) {
                 if (IS_TAPPING_KEY(event.key) && !event.pressed) {
                     // first tap!
-                    debug("Tapping: First tap(0->1).\n");
+                    dtrace(TRACE_TAPPING_FIRST_TAP);
                     tapping_key.tap.count = 1;
                     debug_tapping_key();
                     process_record(&tapping_key);
@@ -102,7 +101,7 @@ bool process_tapping(keyrecord_t *keyp)
                  * useful for long TAPPING_TERM but may prevent fast typing.
                  */
                 else if (IS_RELEASED(event) && waiting_buffer_typed(event)) {
-                    debug("Tapping: End. No tap. Interfered by typing key\n");
+                    dtrace(TRACE_TAPPING_INTERFERED);
                     process_record(&tapping_key);
                     tapping_key = (keyrecord_t){};
                     debug_tapping_key();
@@ -130,7 +129,7 @@ bool process_tapping(keyrecord_t *keyp)
                             break;
                     }
                     // Release of key should be process immediately.
-                    debug("Tapping: release event of a key pressed before tapping\n");
+                    dtrace(TRACE_TAPPING_EARLY_RELEASE);
                     process_record(keyp);
                     return true;
                 }
@@ -146,7 +145,7 @@ bool process_tapping(keyrecord_t *keyp)
             // tap_count > 0
             else {
                 if (IS_TAPPING_KEY(event.key) && !event.pressed) {
-                    debug("Tapping: Tap release("); debug_dec(tapping_key.tap.count); debug(")\n");
+                    dtrace(TRACE_TAPPING_TAP_RELEASE, tapping_key.tap.count);
                     keyp->tap = tapping_key.tap;
                     process_record(keyp);
                     tapping_key = *keyp;
@@ -155,7 +154,7 @@ bool process_tapping(keyrecord_t *keyp)
                 }
                 else if (is_tap_key(event.key) && event.pressed) {
                     if (tapping_key.tap.count > 1) {
-                        debug("Tapping: Start new tap with releasing last tap(>1).\n");
+                        dtrace(TRACE_TAPPING_NEW_TAP);
                         // unregister key
                         process_record(&(keyrecord_t){
                                 .tap = tapping_key.tap,
@@ -164,7 +163,7 @@ bool process_tapping(keyrecord_t *keyp)
                                 .event.pressed = false
                         });
                     } else {
-                        debug("Tapping: Start while last tap(1).\n");
+                        dtrace(TRACE_TAPPING_LAST_TAP);
                     }
                     tapping_key = *keyp;
                     waiting_buffer_scan_tap();
@@ -173,7 +172,7 @@ bool process_tapping(keyrecord_t *keyp)
                 }
                 else {
                     if (!IS_NOEVENT(event)) {
-                        debug("Tapping: key event while last tap(>0).\n");
+                        dtrace(TRACE_TAPPING_KEY_EVENT);
                     }
                     process_record(keyp);
                     return true;
@@ -183,15 +182,14 @@ bool process_tapping(keyrecord_t *keyp)
         // after TAPPING_TERM
         else {
             if (tapping_key.tap.count == 0) {
-                debug("Tapping: End. Timeout. Not tap(0): ");
-                debug_event(event); debug("\n");
+                dtrace(TRACE_TAPPING_TIMEOUT, TRACE_EVENT_ARGS(event));
                 process_record(&tapping_key);
                 tapping_key = (keyrecord_t){};
                 debug_tapping_key();
                 return false;
             }  else {
                 if (IS_TAPPING_KEY(event.key) && !event.pressed) {
-                    debug("Tapping: End. last timeout tap release(>0).");
+                    dtrace(TRACE_TAPPING_TIMEOUT_RELEASE);
                     keyp->tap = tapping_key.tap;
                     process_record(keyp);
                     tapping_key = (keyrecord_t){};
@@ -199,7 +197,7 @@ bool process_tapping(keyrecord_t *keyp)
                 }
                 else if (is_tap_key(event.key) && event.pressed) {
                     if (tapping_key.tap.count > 1) {
-                        debug("Tapping: Start new tap with releasing last timeout tap(>1).\n");
+                        dtrace(TRACE_TAPPING_TIMEOUT_NEW_TAP);
                         // unregister key
                         process_record(&(keyrecord_t){
                                 .tap = tapping_key.tap,
@@ -208,7 +206,7 @@ bool process_tapping(keyrecord_t *keyp)
                                 .event.pressed = false
                         });
                     } else {
-                        debug("Tapping: Start while last timeout tap(1).\n");
+                        dtrace(TRACE_TAPPING_TIMEOUT_LAST_TAP);
                     }
                     tapping_key = *keyp;
                     waiting_buffer_scan_tap();
@@ -217,7 +215,7 @@ bool process_tapping(keyrecord_t *keyp)
                 }
                 else {
                     if (!IS_NOEVENT(event)) {
-                        debug("Tapping: key event while last timeout tap(>0).\n");
+                        dtrace(TRACE_TAPPING_TIMEOUT_KEY_EVENT);
                     }
                     process_record(keyp);
                     return true;
@@ -233,7 +231,7 @@ bool process_tapping(keyrecord_t *keyp)
                         // sequential tap.
                         keyp->tap = tapping_key.tap;
                         if (keyp->tap.count < 15) keyp->tap.count += 1;
-                        debug("Tapping: Tap press("); debug_dec(keyp->tap.count); debug(")\n");
+                        dtrace(TRACE_TAPPING_TAP_PRESS, keyp->tap.count);
                         process_record(keyp);
                         tapping_key = *keyp;
                         debug_tapping_key();
@@ -245,7 +243,7 @@ bool process_tapping(keyrecord_t *keyp)
                     return true;
                 } else if (is_tap_key(event.key)) {
                     // Sequential tap can be interfered with other tap key.
-                    debug("Tapping: Start with interfering other tap.\n");
+                    dtrace(TRACE_TAPPING_INTERFERING_TAP);
                     tapping_key = *keyp;
                     waiting_buffer_scan_tap();
                     debug_tapping_key();
@@ -258,15 +256,14 @@ bool process_tapping(keyrecord_t *keyp)
                     return true;
                 }
             } else {
-                if (!IS_NOEVENT(event)) debug("Tapping: other key just after tap.\n");
+                if (!IS_NOEVENT(event)) dtrace(TRACE_TAPPING_AFTER_TAP);
                 process_record(keyp);
                 return true;
             }
         } else {
             // FIX: process_aciton here?
             // timeout. no sequential tap.
-            debug("Tapping: End(Timeout after releasing last tap): ");
-            debug_event(event); debug("\n");
+            dtrace(TRACE_TAPPING_TIMEOUT_AFTER_TAP, TRACE_EVENT_ARGS(event));
             tapping_key = (keyrecord_t){};
             debug_tapping_key();
             return false;
@@ -275,7 +272,7 @@ bool process_tapping(keyrecord_t *keyp)
     // not tapping state
     else {
         if (event.pressed && is_tap_key(event.key)) {
-            debug("Tapping: Start(Press tap key).\n");
+            dtrace(TRACE_TAPPING_START);
             tapping_key = *keyp;
             waiting_buffer_scan_tap();
             debug_tapping_key();
@@ -298,14 +295,14 @@ bool waiting_buffer_enq(keyrecord_t record)
     }
 
     if ((waiting_buffer_head + 1) % WAITING_BUFFER_SIZE == waiting_buffer_tail) {
-        debug("waiting_buffer_enq: Over flow.\n");
+        dtrace(TRACE_WAITING_BUFFER_OVERFLOW);
         return false;
     }
 
     waiting_buffer[waiting_buffer_head] = record;
     waiting_buffer_head = (waiting_buffer_head + 1) % WAITING_BUFFER_SIZE;
 
-    debug("waiting_buffer_enq: "); debug_waiting_buffer();
+    dtrace(TRACE_WAITING_BUFFER_ENQ); debug_waiting_buffer();
     return true;
 }
 
@@ -350,7 +347,7 @@ void waiting_buffer_scan_tap(void)
             waiting_buffer[i].tap.count = 1;
             process_record(&tapping_key);
 
-            debug("waiting_buffer_scan_tap: found at ["); debug_dec(i); debug("]\n");
+            dtrace(TRACE_WAITING_BUFFER_SCAN_TAP, i);
             debug_waiting_buffer();
             return;
         }
@@ -363,16 +360,16 @@ void waiting_buffer_scan_tap(void)
  */
 static void debug_tapping_key(void)
 {
-    debug("TAPPING_KEY="); debug_record(tapping_key); debug("\n");
+    dtrace(TRACE_TAPPING_KEY, TRACE_RECORD_ARGS(tapping_key));
 }
 
 static void debug_waiting_buffer(void)
 {
-    debug("{ ");
+    dtrace(TRACE_WAITING_BUFFER_START);
     for (uint8_t i = waiting_buffer_tail; i != waiting_buffer_head; i = (i + 1) % WAITING_BUFFER_SIZE) {
-        debug("["); debug_dec(i); debug("]="); debug_record(waiting_buffer[i]); debug(" ");
+        dtrace(TRACE_WAITING_BUFFER_ITEM, i, TRACE_RECORD_ARGS(waiting_buffer[i]));
     }
-    debug("}\n");
+    dtrace(TRACE_WAITING_BUFFER_END);
 }
 
 #endif
@@ -0,0 +1,166 @@
+/* Copyright 2026 QMK Firmware contributors
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef BYTE_QUEUE_H
+#define BYTE_QUEUE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/* Lock-free single producer, single consumer byte queue
+ *
+ * One side, for example an interrupt handler, pushes bytes while the other
+ * side, for example the main loop, pops them, without either side turning
+ * the interrupts off. Only the producer writes the head, and only the
+ * consumer writes the tail. The indices run freely and wrap at 256, so the
+ * capacity has to be a power of two of at most 128, and the whole capacity
+ * can be used.
+ *
+ * The bulk functions give direct access to the contiguous part of the
+ * buffer, so that the bytes can be copied to and from the USB endpoints
+ * without going through them one at a time.
+ */
+typedef struct {
+    uint8_t *data;
+    uint8_t mask;
+    uint8_t head;
+    uint8_t tail;
+} byte_queue_t;
+
+#define BYTE_QUEUE_INITIALIZER(buffer) { .data = (buffer), .mask = sizeof(buffer) - 1, .head = 0, .tail = 0 }
+
+// The loads that see the other side's index also see the bytes it wrote
+#define BYTE_QUEUE_LOAD(index) __atomic_load_n(&(index), __ATOMIC_ACQUIRE)
+#define BYTE_QUEUE_STORE(index, value) __atomic_store_n(&(index), (value), __ATOMIC_RELEASE)
+
+static inline void byte_queue_init(byte_queue_t *queue, uint8_t *data, uint8_t capacity) {
+    queue->data = data;
+    queue->mask = capacity - 1;
+    queue->head = 0;
+    queue->tail = 0;
+}
+
+static inline uint8_t byte_queue_capacity(const byte_queue_t *queue) {
+    return queue->mask + 1;
+}
+
+// The number of bytes that can be popped, safe to call from both sides
+static inline uint8_t byte_queue_length(byte_queue_t *queue) {
+    return (uint8_t)(BYTE_QUEUE_LOAD(queue->head) - BYTE_QUEUE_LOAD(queue->tail));
+}
+
+// The number of bytes that can be pushed, safe to call from both sides
+static inline uint8_t byte_queue_space(byte_queue_t *queue) {
+    return byte_queue_capacity(queue) - byte_queue_length(queue);
+}
+
+/* Producer */
+
+// Returns the contiguous free space at the head, and its size
+static inline uint8_t byte_queue_reserve(byte_queue_t *queue, uint8_t **span) {
+    uint8_t head = queue->head;
+    uint8_t space = byte_queue_capacity(queue) - (uint8_t)(head - BYTE_QUEUE_LOAD(queue->tail));
+    uint8_t offset = head & queue->mask;
+    uint8_t contiguous = byte_queue_capacity(queue) - offset;
+    *span = &queue->data[offset];
+    return space < contiguous ? space : contiguous;
+}
+
+// Makes count bytes that were written to the reserved span visible
+static inline void byte_queue_commit(byte_queue_t *queue, uint8_t count) {
+    BYTE_QUEUE_STORE(queue->head, (uint8_t)(queue->head + count));
+}
+
+static inline bool byte_queue_push(byte_queue_t *queue, uint8_t byte) {
+    uint8_t head = queue->head;
+    if ((uint8_t)(head - BYTE_QUEUE_LOAD(queue->tail)) > queue->mask) {
+        return false;
+    }
+    queue->data[head & queue->mask] = byte;
+    BYTE_QUEUE_STORE(queue->head, (uint8_t)(head + 1));
+    return true;
+}
+
+// Pushes as many bytes as fit, and returns their count
+static inline uint8_t byte_queue_write(byte_queue_t *queue, const uint8_t *data, uint8_t length) {
+    uint8_t written = 0;
+    while (written < length) {
+        uint8_t *span;
+        uint8_t count = byte_queue_reserve(queue, &span);
+        if (count == 0) {
+            break;
+        }
+        if (count > length - written) {
+            count = length - written;
+        }
+        for (uint8_t i = 0; i < count; i++) {
+            span[i] = data[written + i];
+        }
+        byte_queue_commit(queue, count);
+        written += count;
+    }
+    return written;
+}
+
+/* Consumer */
+
+// Returns the contiguous bytes at the tail, and their count
+static inline uint8_t byte_queue_peek(byte_queue_t *queue, const uint8_t **span) {
+    uint8_t tail = queue->tail;
+    uint8_t length = (uint8_t)(BYTE_QUEUE_LOAD(queue->head) - tail);
+    uint8_t offset = tail & queue->mask;
+    uint8_t contiguous = byte_queue_capacity(queue) - offset;
+    *span = &queue->data[offset];
+    return length < contiguous ? length : contiguous;
+}
+
+// Frees count bytes that were read from the peeked span
+static inline void byte_queue_consume(byte_queue_t *queue, uint8_t count) {
+    BYTE_QUEUE_STORE(queue->tail, (uint8_t)(queue->tail + count));
+}
+
+static inline bool byte_queue_pop(byte_queue_t *queue, uint8_t *byte) {
+    uint8_t tail = queue->tail;
+    if (BYTE_QUEUE_LOAD(queue->head) == tail) {
+        return false;
+    }
+    *byte = queue->data[tail & queue->mask];
+    BYTE_QUEUE_STORE(queue->tail, (uint8_t)(tail + 1));
+    return true;
+}
+
+// Pops up to length bytes, and returns their count
+static inline uint8_t byte_queue_read(byte_queue_t *queue, uint8_t *data, uint8_t length) {
+    uint8_t read = 0;
+    while (read < length) {
+        const uint8_t *span;
+        uint8_t count = byte_queue_peek(queue, &span);
+        if (count == 0) {
+            break;
+        }
+        if (count > length - read) {
+            count = length - read;
+        }
+        for (uint8_t i = 0; i < count; i++) {
+            data[read + i] = span[i];
+        }
+        byte_queue_consume(queue, count);
+        read += count;
+    }
+    return read;
+}
+
+#endif
@@ -583,6 +583,8 @@ static void mousekey_param_print(void)
     print("4: time_to_max: "); pdec(mk_time_to_max); print("\n");
     print("5: wheel_max_speed: "); pdec(mk_wheel_max_speed); print("\n");
     print("6: wheel_time_to_max: "); pdec(mk_wheel_time_to_max); print("\n");
+    print("7: report_interval(ms): "); pdec(mk_report_interval); print("\n");
+    print("8: curve: "); pdec(mk_curve); print("\n");
 #endif /* !NO_PRINT */
 
 }
@@ -634,6 +636,20 @@ static void mousekey_param_inc(uint8_t param, uint8_t inc)
                 mk_wheel_time_to_max = UINT8_MAX;
             PRINT_SET_VAL(mk_wheel_time_to_max);
             break;
+        case 7:
+            if (mk_report_interval + inc < UINT8_MAX)
+                mk_report_interval += inc;
+            else
+                mk_report_interval = UINT8_MAX;
+            PRINT_SET_VAL(mk_report_interval);
+            break;
+        case 8:
+            if (mk_curve + inc < MOUSEKEY_CURVE_CONSTANT)
+                mk_curve += inc;
+            else
+                mk_curve = MOUSEKEY_CURVE_CONSTANT;
+            PRINT_SET_VAL(mk_curve);
+            break;
     }
 }
 
@@ -682,6 +698,20 @@ static void mousekey_param_dec(uint8_t param, uint8_t dec)
                 mk_wheel_time_to_max = 0;
             PRINT_SET_VAL(mk_wheel_time_to_max);
             break;
+        case 7:
+            if (mk_report_interval > dec)
+                mk_report_interval -= dec;
+            else
+                mk_report_interval = 0;
+            PRINT_SET_VAL(mk_report_interval);
+            break;
+        case 8:
+            if (mk_curve > dec)
+                mk_curve -= dec;
+            else
+                mk_curve = 0;
+            PRINT_SET_VAL(mk_curve);
+            break;
     }
 }
 
@@ -695,6 +725,8 @@ static void mousekey_console_help(void)
           "4:	time_to_max\n"
           "5:	wheel_max_speed\n"
           "6:	wheel_time_to_max\n"
+          "7:	report_interval(ms)\n"
+          "8:	curve(0:linear 1:quadratic 2:constant)\n"
           "\n"
           "p:	print values\n"
           "d:	set defaults\n"
@@ -734,6 +766,8 @@ static bool mousekey_console(uint8_t code)
         case KC_4:
         case KC_5:
         case KC_6:
+        case KC_7:
+        case KC_8:
             mousekey_param = numkey2num(code);
             break;
         case KC_UP:
@@ -755,6 +789,8 @@ static bool mousekey_console(uint8_t code)
             mk_time_to_max = MOUSEKEY_TIME_TO_MAX;
             mk_wheel_max_speed = MOUSEKEY_WHEEL_MAX_SPEED;
             mk_wheel_time_to_max = MOUSEKEY_WHEEL_TIME_TO_MAX;
+            mk_report_interval = MOUSEKEY_REPORT_INTERVAL;
+            mk_curve = MOUSEKEY_CURVE;
             print("set default\n");
             break;
         default:
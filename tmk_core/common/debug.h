@@ -20,6 +20,7 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 
 #include <stdbool.h>
 #include "print.h"
+#include "trace.h"
 
 
 #ifdef __cplusplus
@@ -63,6 +64,13 @@ extern debug_config_t debug_config;
 #define dprintf(fmt, ...)           do { if (debug_enable) xprintf(fmt, ##__VA_ARGS__); } while (0)
 #define dmsg(s)                     dprintf("%s at %s: %S\n", __FILE__, __LINE__, PSTR(s))
 
+/* Logs one of the traces of trace_formats.h, see trace.h */
+#if defined(TRACE_ENABLE) && !defined(NO_PRINT) && !defined(USER_PRINT)
+#define dtrace(id, ...)             do { if (debug_enable) TRACE_WRITE(id, ##__VA_ARGS__); } while (0)
+#else
+#define dtrace(id, ...)             dprintf(id##_FMT, ##__VA_ARGS__)
+#endif
+
 /* Deprecated. DO NOT USE these anymore, use dprintf instead. */
 #define debug(s)                    do { if (debug_enable) print(s); } while (0)
 #define debugln(s)                  do { if (debug_enable) println(s); } while (0)
@@ -93,6 +101,7 @@ extern debug_config_t debug_config;
 #define dprintln(s)
 #define dprintf(fmt, ...)
 #define dmsg(s)
+#define dtrace(id, ...)
 #define debug(s)
 #define debugln(s)
 #define debug_msg(s)
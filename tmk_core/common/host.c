@@ -49,11 +49,13 @@ void host_keyboard_send(report_keyboard_t *report)
     (*driver->send_keyboard)(report);
 
     if (debug_keyboard) {
-        dprint("keyboard_report: ");
-        for (uint8_t i = 0; i < KEYBOARD_REPORT_SIZE; i++) {
-            dprintf("%02X ", report->raw[i]);
+        dtrace(TRACE_KEYBOARD_REPORT, report->raw[0], report->raw[1], report->raw[2], report->raw[3],
+               report->raw[4], report->raw[5], report->raw[6], report->raw[7]);
+        for (uint8_t i = 8; i < KEYBOARD_REPORT_SIZE; i += 8) {
+            dtrace(TRACE_KEYBOARD_REPORT_MORE, report->raw[i], report->raw[i + 1], report->raw[i + 2], report->raw[i + 3],
+                   report->raw[i + 4], report->raw[i + 5], report->raw[i + 6], report->raw[i + 7]);
         }
-        dprint("\n");
+        dtrace(TRACE_NEWLINE);
     }
 }
 
@@ -66,17 +66,22 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #ifdef POINTING_DEVICE_ENABLE
 #   include "pointing_device.h"
 #endif
+#ifdef MOUSE_ENABLE
+#   include "mouse_report.h"
+#endif
+#ifdef DYNAMIC_KEYMAP_ENABLE
+#   include "dynamic_keymap.h"
+#endif
 #ifdef MIDI_ENABLE
 #   include "process_midi.h"
 #endif
 
 #ifdef MATRIX_HAS_GHOST
-extern const uint16_t keymaps[][MATRIX_ROWS][MATRIX_COLS];
 static matrix_row_t get_real_keys(uint8_t row, matrix_row_t rowdata){
     matrix_row_t out = 0;
     for (uint8_t col = 0; col < MATRIX_COLS; col++) {
         //read each key in the row data and check if the keymap defines it as a real key
-        if (pgm_read_byte(&keymaps[0][row][col]) && (rowdata & (1<<col))){
+        if ((uint8_t)keymap_key_to_keycode(0, (keypos_t){ .row = row, .col = col }) && (rowdata & (1<<col))){
             //this creates new row data, if a key is defined in the keymap, it will be set here
             out |= 1<<col;
         }
@@ -133,6 +138,10 @@ bool is_keyboard_master(void) {
 void keyboard_init(void) {
     timer_init();
     matrix_init();
+#ifdef DYNAMIC_KEYMAP_ENABLE
+    // Before bootmagic, which looks up keycodes
+    dynamic_keymap_init();
+#endif
 #ifdef PS2_MOUSE_ENABLE
     ps2_mouse_init();
 #endif
@@ -256,13 +265,18 @@ MATRIX_LOOP_END:
 #endif
 
 #ifdef VISUALIZER_ENABLE
-    visualizer_update(default_layer_state, layer_state, visualizer_get_mods(), host_keyboard_leds());
+    visualizer_task();
 #endif
 
 #ifdef POINTING_DEVICE_ENABLE
     pointing_device_task();
 #endif
 
+#ifdef MOUSE_ENABLE
+    // send the motion and buttons collected from all pointing sources
+    mouse_report_task();
+#endif
+
 #ifdef MIDI_ENABLE
     midi_task();
 #endif
@@ -271,7 +285,14 @@ MATRIX_LOOP_END:
     if (led_status != host_keyboard_leds()) {
         led_status = host_keyboard_leds();
         keyboard_set_leds(led_status);
+#ifdef VISUALIZER_ENABLE
+        visualizer_set_leds(led_status);
+#endif
     }
+
+#ifdef TRACE_ENABLE
+    trace_task();
+#endif
 }
 
 void keyboard_set_leds(uint8_t leds)
@@ -0,0 +1,117 @@
+/*
+Copyright 2026 QMK Firmware contributors
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "host.h"
+#include "timer.h"
+#include "mouse_report.h"
+
+
+/* motion not yet sent to the host */
+static int16_t pending_x = 0;
+static int16_t pending_y = 0;
+static int16_t pending_v = 0;
+static int16_t pending_h = 0;
+
+/* last button state of each source */
+static uint8_t source_buttons[MOUSE_SOURCE_COUNT] = {};
+
+/* button states waiting to be sent, oldest first */
+static uint8_t button_queue[MOUSE_REPORT_BUTTON_QUEUE_SIZE];
+static uint8_t button_queue_len = 0;
+
+static uint8_t sent_buttons = 0;
+static uint16_t last_report = 0;
+static bool report_sent = false;
+
+
+static void accumulate(int16_t *pending, int8_t delta)
+{
+    int16_t sum = *pending + delta;
+    if (sum > INT16_MAX - INT8_MAX) sum = INT16_MAX - INT8_MAX;
+    if (sum < INT16_MIN + INT8_MAX) sum = INT16_MIN + INT8_MAX;
+    *pending = sum;
+}
+
+/* takes as much of the pending motion as fits in a report, -127 to 127 */
+static int8_t take(int16_t *pending)
+{
+    int16_t value = *pending;
+    if (value > 127) value = 127;
+    if (value < -127) value = -127;
+    *pending -= value;
+    return value;
+}
+
+/* sends the oldest queued button state with as much of the pending motion as fits */
+static void send_report(void)
+{
+    report_mouse_t report = {};
+    if (button_queue_len) {
+        report.buttons = button_queue[0];
+        button_queue_len--;
+        for (uint8_t i = 0; i < button_queue_len; i++) {
+            button_queue[i] = button_queue[i + 1];
+        }
+    } else {
+        report.buttons = sent_buttons;
+    }
+    report.x = take(&pending_x);
+    report.y = take(&pending_y);
+    report.v = take(&pending_v);
+    report.h = take(&pending_h);
+
+    sent_buttons = report.buttons;
+    host_mouse_send(&report);
+    last_report = timer_read();
+    report_sent = true;
+}
+
+void mouse_report_add(mouse_source_t source, const report_mouse_t *report)
+{
+    accumulate(&pending_x, report->x);
+    accumulate(&pending_y, report->y);
+    accumulate(&pending_v, report->v);
+    accumulate(&pending_h, report->h);
+
+    source_buttons[source] = report->buttons;
+    uint8_t buttons = 0;
+    for (uint8_t i = 0; i < MOUSE_SOURCE_COUNT; i++) {
+        buttons |= source_buttons[i];
+    }
+
+    // Queue every change so a click shorter than the interval still gets through
+    uint8_t last = button_queue_len ? button_queue[button_queue_len - 1] : sent_buttons;
+    if (buttons == last) return;
+    if (button_queue_len == MOUSE_REPORT_BUTTON_QUEUE_SIZE) {
+        // Sending early is better than losing a transition
+        send_report();
+    }
+    button_queue[button_queue_len++] = buttons;
+}
+
+void mouse_report_task(void)
+{
+    if (!pending_x && !pending_y && !pending_v && !pending_h && !button_queue_len)
+        return;
+
+    if (report_sent && timer_elapsed(last_report) < MOUSE_REPORT_INTERVAL)
+        return;
+
+    send_report();
+}
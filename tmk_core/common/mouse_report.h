@@ -0,0 +1,62 @@
+/*
+Copyright 2026 QMK Firmware contributors
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef MOUSE_REPORT_H
+#define MOUSE_REPORT_H
+
+#include <stdint.h>
+#include "report.h"
+
+/*
+ * Mouse report aggregator
+ *
+ * Every pointing source hands its reports to mouse_report_add() instead of
+ * sending them to the host directly. Motion is accumulated, buttons are merged
+ * and mouse_report_task() sends at most one report per host poll interval.
+ * Motion that doesn't fit in a single report is carried over to the next one.
+ */
+
+/* minimum time between two reports (ms), the mouse endpoint polling interval */
+#ifndef MOUSE_REPORT_INTERVAL
+#define MOUSE_REPORT_INTERVAL 10
+#endif
+
+/* number of button changes that can be waiting to be sent, when one more
+ * comes in the oldest is sent right away */
+#ifndef MOUSE_REPORT_BUTTON_QUEUE_SIZE
+#define MOUSE_REPORT_BUTTON_QUEUE_SIZE 4
+#endif
+
+typedef enum {
+    MOUSE_SOURCE_MOUSEKEY,
+    MOUSE_SOURCE_POINTING_DEVICE,
+    MOUSE_SOURCE_PS2,
+    MOUSE_SOURCE_COUNT
+} mouse_source_t;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+void mouse_report_add(mouse_source_t source, const report_mouse_t *report);
+void mouse_report_task(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -22,13 +22,32 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #include "print.h"
 #include "debug.h"
 #include "mousekey.h"
+#include "mouse_report.h"
 
 
 
 static report_mouse_t mouse_report = {};
-static uint8_t mousekey_repeat =  0;
 static uint8_t mousekey_accel = 0;
 
+/* direction of each axis, -1, 0 or 1 */
+static int8_t move_dir_x = 0;
+static int8_t move_dir_y = 0;
+static int8_t wheel_dir_v = 0;
+static int8_t wheel_dir_h = 0;
+
+/* sub-pixel accumulators in 1/256 units, carried over between reports */
+static int32_t accum_x = 0;
+static int32_t accum_y = 0;
+static int32_t accum_v = 0;
+static int32_t accum_h = 0;
+
+/* time spent accelerating (ms), saturates at the ramp length */
+static uint16_t move_time = 0;
+static uint16_t wheel_time = 0;
+
+/* set once the initial delay has passed */
+static bool mousekey_moving = false;
+
 static void mousekey_debug(void);
 
 
@@ -37,17 +56,24 @@ static void mousekey_debug(void);
  *  http://en.wikipedia.org/wiki/Mouse_keys
  *
  *  speed = delta * max_speed * (repeat / time_to_max)**((1000+curve)/1000)
+ *
+ * Motion is integrated over the real time elapsed since the last report, so the
+ * cursor travels the same distance regardless of how often mousekey_task() runs.
+ * Speeds are expressed in units per mk_interval and converted to 1/256 units
+ * per millisecond internally.
  */
 /* milliseconds between the initial key press and first repeated motion event (0-2550) */
 uint8_t mk_delay = MOUSEKEY_DELAY/10;
 /* milliseconds between repeated motion events (0-255) */
 uint8_t mk_interval = MOUSEKEY_INTERVAL;
+/* milliseconds between motion reports sent to the host (0-255) */
+uint8_t mk_report_interval = MOUSEKEY_REPORT_INTERVAL;
 /* steady speed (in action_delta units) applied each event (0-255) */
 uint8_t mk_max_speed = MOUSEKEY_MAX_SPEED;
 /* number of events (count) accelerating to steady speed (0-255) */
 uint8_t mk_time_to_max = MOUSEKEY_TIME_TO_MAX;
-/* ramp used to reach maximum pointer speed (NOT SUPPORTED) */
-//int8_t mk_curve = 0;
+/* ramp used to reach maximum pointer speed */
+uint8_t mk_curve = MOUSEKEY_CURVE;
 /* wheel params */
 uint8_t mk_wheel_max_speed = MOUSEKEY_WHEEL_MAX_SPEED;
 uint8_t mk_wheel_time_to_max = MOUSEKEY_WHEEL_TIME_TO_MAX;
@@ -55,94 +81,191 @@ uint8_t mk_wheel_time_to_max = MOUSEKEY_WHEEL_TIME_TO_MAX;
 
 static uint16_t last_timer = 0;
 
-inline int8_t times_inv_sqrt2(int8_t x)
+typedef struct {
+    uint32_t start_speed;   // 1/256 units per ms
+    uint32_t max_speed;     // 1/256 units per ms
+    uint16_t ramp;          // ms
+} mousekey_ramp_t;
+
+static uint32_t times_inv_sqrt2(uint32_t x)
 {
     // 181/256 is pretty close to 1/sqrt(2)
     // 0.70703125                 0.707106781
-    // 1 too small for x=99 and x=198
     // This ends up being a mult and discard lower 8 bits
     return (x * 181) >> 8;
 }
 
-static uint8_t move_unit(void)
+static uint32_t unit_speed(uint16_t unit)
 {
-    uint16_t unit;
+    return ((uint32_t)unit << 8) / (mk_interval ? mk_interval : 1);
+}
+
+static void make_ramp(mousekey_ramp_t *ramp, uint8_t delta, uint8_t max_speed,
+                      uint8_t time_to_max, uint8_t max)
+{
+    uint16_t top = delta * max_speed;
+    if (top > max) top = max;
+    if (top == 0) top = 1;
+
     if (mousekey_accel & (1<<0)) {
-        unit = (MOUSEKEY_MOVE_DELTA * mk_max_speed)/4;
+        ramp->max_speed = unit_speed(top / 4 ? top / 4 : 1);
     } else if (mousekey_accel & (1<<1)) {
-        unit = (MOUSEKEY_MOVE_DELTA * mk_max_speed)/2;
-    } else if (mousekey_accel & (1<<2)) {
-        unit = (MOUSEKEY_MOVE_DELTA * mk_max_speed);
-    } else if (mousekey_repeat == 0) {
-        unit = MOUSEKEY_MOVE_DELTA;
-    } else if (mousekey_repeat >= mk_time_to_max) {
-        unit = MOUSEKEY_MOVE_DELTA * mk_max_speed;
+        ramp->max_speed = unit_speed(top / 2 ? top / 2 : 1);
+    } else {
+        ramp->max_speed = unit_speed(top);
+    }
+
+    if (mousekey_accel || mk_curve == MOUSEKEY_CURVE_CONSTANT) {
+        ramp->start_speed = ramp->max_speed;
+        ramp->ramp = 0;
     } else {
-        unit = (MOUSEKEY_MOVE_DELTA * mk_max_speed * mousekey_repeat) / mk_time_to_max;
+        ramp->start_speed = unit_speed(delta > top ? top : delta);
+        ramp->ramp = time_to_max * mk_interval;
     }
-    return (unit > MOUSEKEY_MOVE_MAX ? MOUSEKEY_MOVE_MAX : (unit == 0 ? 1 : unit));
 }
 
-static uint8_t wheel_unit(void)
+/* distance travelled after t ms of acceleration, t <= ramp->ramp */
+static uint32_t ramp_distance(const mousekey_ramp_t *ramp, uint16_t t)
 {
-    uint16_t unit;
-    if (mousekey_accel & (1<<0)) {
-        unit = (MOUSEKEY_WHEEL_DELTA * mk_wheel_max_speed)/4;
-    } else if (mousekey_accel & (1<<1)) {
-        unit = (MOUSEKEY_WHEEL_DELTA * mk_wheel_max_speed)/2;
-    } else if (mousekey_accel & (1<<2)) {
-        unit = (MOUSEKEY_WHEEL_DELTA * mk_wheel_max_speed);
-    } else if (mousekey_repeat == 0) {
-        unit = MOUSEKEY_WHEEL_DELTA;
-    } else if (mousekey_repeat >= mk_wheel_time_to_max) {
-        unit = MOUSEKEY_WHEEL_DELTA * mk_wheel_max_speed;
+    uint32_t dv = ramp->max_speed - ramp->start_speed;
+    uint32_t d = ramp->start_speed * t;
+    if (ramp->ramp == 0) return d;
+
+    if (mk_curve == MOUSEKEY_CURVE_QUADRATIC) {
+        // v(t) = v0 + dv * (t/T)^2
+        d += dv * t / ramp->ramp * t / ramp->ramp * t / 3;
     } else {
-        unit = (MOUSEKEY_WHEEL_DELTA * mk_wheel_max_speed * mousekey_repeat) / mk_wheel_time_to_max;
+        // v(t) = v0 + dv * t/T
+        d += dv * t / ramp->ramp * t / 2;
     }
-    return (unit > MOUSEKEY_WHEEL_MAX ? MOUSEKEY_WHEEL_MAX : (unit == 0 ? 1 : unit));
+    return d;
 }
 
-void mousekey_task(void)
+/*
+ * Advances *time by dt and returns the distance covered in that span. The
+ * distance is the difference of two points on the same curve, so it does not
+ * depend on how the span is split up between calls.
+ */
+static uint32_t ramp_advance(const mousekey_ramp_t *ramp, uint16_t *time, uint16_t dt)
 {
-    if (timer_elapsed(last_timer) < (mousekey_repeat ? mk_interval : mk_delay*10))
-        return;
+    if (*time >= ramp->ramp) {
+        *time = ramp->ramp;
+        return ramp->max_speed * dt;
+    }
 
-    if (mouse_report.x == 0 && mouse_report.y == 0 && mouse_report.v == 0 && mouse_report.h == 0)
-        return;
+    uint32_t end = (uint32_t)*time + dt;
+    uint32_t d;
+    if (end <= ramp->ramp) {
+        d = ramp_distance(ramp, end) - ramp_distance(ramp, *time);
+        *time = end;
+    } else {
+        d = ramp_distance(ramp, ramp->ramp) - ramp_distance(ramp, *time);
+        d += ramp->max_speed * (end - ramp->ramp);
+        *time = ramp->ramp;
+    }
+    return d;
+}
+
+static int8_t take_whole_units(int32_t *accum, int8_t max)
+{
+    int32_t whole = *accum / 256;
+    if (whole > max) whole = max;
+    if (whole < -max) whole = -max;
+    *accum -= whole * 256;
+    // Motion that didn't fit in the report is dropped, not saved for later
+    int32_t limit = (int32_t)max * 256 + 255;
+    if (*accum > limit) *accum = limit;
+    if (*accum < -limit) *accum = -limit;
+    return whole;
+}
+
+static bool mousekey_motion_keys_held(void)
+{
+    return move_dir_x || move_dir_y || wheel_dir_v || wheel_dir_h;
+}
+
+static void mousekey_integrate(uint16_t dt)
+{
+    mousekey_ramp_t ramp;
 
-    if (mousekey_repeat != UINT8_MAX)
-        mousekey_repeat++;
+    if (move_dir_x || move_dir_y) {
+        make_ramp(&ramp, MOUSEKEY_MOVE_DELTA, mk_max_speed, mk_time_to_max, MOUSEKEY_MOVE_MAX);
+        /* diagonal move [1/sqrt(2)] */
+        if (move_dir_x && move_dir_y) {
+            ramp.start_speed = times_inv_sqrt2(ramp.start_speed);
+            ramp.max_speed = times_inv_sqrt2(ramp.max_speed);
+        }
+        int32_t d = ramp_advance(&ramp, &move_time, dt);
+        accum_x += move_dir_x * d;
+        accum_y += move_dir_y * d;
+    }
 
+    if (wheel_dir_v || wheel_dir_h) {
+        make_ramp(&ramp, MOUSEKEY_WHEEL_DELTA, mk_wheel_max_speed, mk_wheel_time_to_max, MOUSEKEY_WHEEL_MAX);
+        int32_t d = ramp_advance(&ramp, &wheel_time, dt);
+        accum_v += wheel_dir_v * d;
+        accum_h += wheel_dir_h * d;
+    }
+}
 
-    if (mouse_report.x > 0) mouse_report.x = move_unit();
-    if (mouse_report.x < 0) mouse_report.x = move_unit() * -1;
-    if (mouse_report.y > 0) mouse_report.y = move_unit();
-    if (mouse_report.y < 0) mouse_report.y = move_unit() * -1;
+void mousekey_task(void)
+{
+    if (!mousekey_motion_keys_held())
+        return;
 
-    /* diagonal move [1/sqrt(2)] */
-    if (mouse_report.x && mouse_report.y) {
-        mouse_report.x = times_inv_sqrt2(mouse_report.x);
-        mouse_report.y = times_inv_sqrt2(mouse_report.y);
+    // Plain unsigned subtraction, TIMER_DIFF_16 is off by one across a wrap
+    uint16_t elapsed = timer_read() - last_timer;
+    if (!mousekey_moving) {
+        uint16_t delay = mk_delay * 10;
+        if (elapsed < delay)
+            return;
+        // Acceleration starts exactly when the delay expires
+        mousekey_moving = true;
+        last_timer += delay;
+        elapsed -= delay;
+    } else if (elapsed < mk_report_interval) {
+        return;
     }
+    last_timer += elapsed;
+
+    mousekey_integrate(elapsed);
+    if (accum_x / 256 || accum_y / 256 || accum_v / 256 || accum_h / 256)
+        mousekey_send();
+}
 
-    if (mouse_report.v > 0) mouse_report.v = wheel_unit();
-    if (mouse_report.v < 0) mouse_report.v = wheel_unit() * -1;
-    if (mouse_report.h > 0) mouse_report.h = wheel_unit();
-    if (mouse_report.h < 0) mouse_report.h = wheel_unit() * -1;
+static void mousekey_start_axis(int8_t *dir, int32_t *accum, int8_t sign, uint8_t delta)
+{
+    if (!mousekey_motion_keys_held()) {
+        mousekey_moving = false;
+        move_time = 0;
+        wheel_time = 0;
+        last_timer = timer_read();
+    }
+    if (*dir != sign) {
+        *accum = 0;
+        // Nudge by one step immediately so a short tap still moves
+        if (!mousekey_moving) *accum = (int32_t)sign * delta * 256;
+    }
+    *dir = sign;
+}
 
-    mousekey_send();
+static void mousekey_stop_axis(int8_t *dir, int32_t *accum, int8_t sign)
+{
+    if (*dir != sign) return;
+    *dir = 0;
+    *accum = 0;
 }
 
 void mousekey_on(uint8_t code)
 {
-    if      (code == KC_MS_UP)       mouse_report.y = move_unit() * -1;
-    else if (code == KC_MS_DOWN)     mouse_report.y = move_unit();
-    else if (code == KC_MS_LEFT)     mouse_report.x = move_unit() * -1;
-    else if (code == KC_MS_RIGHT)    mouse_report.x = move_unit();
-    else if (code == KC_MS_WH_UP)    mouse_report.v = wheel_unit();
-    else if (code == KC_MS_WH_DOWN)  mouse_report.v = wheel_unit() * -1;
-    else if (code == KC_MS_WH_LEFT)  mouse_report.h = wheel_unit() * -1;
-    else if (code == KC_MS_WH_RIGHT) mouse_report.h = wheel_unit();
+    if      (code == KC_MS_UP)       mousekey_start_axis(&move_dir_y, &accum_y, -1, MOUSEKEY_MOVE_DELTA);
+    else if (code == KC_MS_DOWN)     mousekey_start_axis(&move_dir_y, &accum_y, 1, MOUSEKEY_MOVE_DELTA);
+    else if (code == KC_MS_LEFT)     mousekey_start_axis(&move_dir_x, &accum_x, -1, MOUSEKEY_MOVE_DELTA);
+    else if (code == KC_MS_RIGHT)    mousekey_start_axis(&move_dir_x, &accum_x, 1, MOUSEKEY_MOVE_DELTA);
+    else if (code == KC_MS_WH_UP)    mousekey_start_axis(&wheel_dir_v, &accum_v, 1, MOUSEKEY_WHEEL_DELTA);
+    else if (code == KC_MS_WH_DOWN)  mousekey_start_axis(&wheel_dir_v, &accum_v, -1, MOUSEKEY_WHEEL_DELTA);
+    else if (code == KC_MS_WH_LEFT)  mousekey_start_axis(&wheel_dir_h, &accum_h, -1, MOUSEKEY_WHEEL_DELTA);
+    else if (code == KC_MS_WH_RIGHT) mousekey_start_axis(&wheel_dir_h, &accum_h, 1, MOUSEKEY_WHEEL_DELTA);
     else if (code == KC_MS_BTN1)     mouse_report.buttons |= MOUSE_BTN1;
     else if (code == KC_MS_BTN2)     mouse_report.buttons |= MOUSE_BTN2;
     else if (code == KC_MS_BTN3)     mouse_report.buttons |= MOUSE_BTN3;
@@ -155,14 +278,14 @@ void mousekey_on(uint8_t code)
 
 void mousekey_off(uint8_t code)
 {
-    if      (code == KC_MS_UP       && mouse_report.y < 0) mouse_report.y = 0;
-    else if (code == KC_MS_DOWN     && mouse_report.y > 0) mouse_report.y = 0;
-    else if (code == KC_MS_LEFT     && mouse_report.x < 0) mouse_report.x = 0;
-    else if (code == KC_MS_RIGHT    && mouse_report.x > 0) mouse_report.x = 0;
-    else if (code == KC_MS_WH_UP    && mouse_report.v > 0) mouse_report.v = 0;
-    else if (code == KC_MS_WH_DOWN  && mouse_report.v < 0) mouse_report.v = 0;
-    else if (code == KC_MS_WH_LEFT  && mouse_report.h < 0) mouse_report.h = 0;
-    else if (code == KC_MS_WH_RIGHT && mouse_report.h > 0) mouse_report.h = 0;
+    if      (code == KC_MS_UP)       mousekey_stop_axis(&move_dir_y, &accum_y, -1);
+    else if (code == KC_MS_DOWN)     mousekey_stop_axis(&move_dir_y, &accum_y, 1);
+    else if (code == KC_MS_LEFT)     mousekey_stop_axis(&move_dir_x, &accum_x, -1);
+    else if (code == KC_MS_RIGHT)    mousekey_stop_axis(&move_dir_x, &accum_x, 1);
+    else if (code == KC_MS_WH_UP)    mousekey_stop_axis(&wheel_dir_v, &accum_v, 1);
+    else if (code == KC_MS_WH_DOWN)  mousekey_stop_axis(&wheel_dir_v, &accum_v, -1);
+    else if (code == KC_MS_WH_LEFT)  mousekey_stop_axis(&wheel_dir_h, &accum_h, -1);
+    else if (code == KC_MS_WH_RIGHT) mousekey_stop_axis(&wheel_dir_h, &accum_h, 1);
     else if (code == KC_MS_BTN1) mouse_report.buttons &= ~MOUSE_BTN1;
     else if (code == KC_MS_BTN2) mouse_report.buttons &= ~MOUSE_BTN2;
     else if (code == KC_MS_BTN3) mouse_report.buttons &= ~MOUSE_BTN3;
@@ -172,33 +295,42 @@ void mousekey_off(uint8_t code)
     else if (code == KC_MS_ACCEL1) mousekey_accel &= ~(1<<1);
     else if (code == KC_MS_ACCEL2) mousekey_accel &= ~(1<<2);
 
-    if (mouse_report.x == 0 && mouse_report.y == 0 && mouse_report.v == 0 && mouse_report.h == 0)
-        mousekey_repeat = 0;
+    if (!mousekey_motion_keys_held()) {
+        mousekey_moving = false;
+        move_time = 0;
+        wheel_time = 0;
+    }
 }
 
 void mousekey_send(void)
 {
+    mouse_report.x = take_whole_units(&accum_x, MOUSEKEY_MOVE_MAX);
+    mouse_report.y = take_whole_units(&accum_y, MOUSEKEY_MOVE_MAX);
+    mouse_report.v = take_whole_units(&accum_v, MOUSEKEY_WHEEL_MAX);
+    mouse_report.h = take_whole_units(&accum_h, MOUSEKEY_WHEEL_MAX);
     mousekey_debug();
-    host_mouse_send(&mouse_report);
-    last_timer = timer_read();
+    mouse_report_add(MOUSE_SOURCE_MOUSEKEY, &mouse_report);
 }
 
 void mousekey_clear(void)
 {
     mouse_report = (report_mouse_t){};
-    mousekey_repeat = 0;
     mousekey_accel = 0;
+    move_dir_x = move_dir_y = wheel_dir_v = wheel_dir_h = 0;
+    accum_x = accum_y = accum_v = accum_h = 0;
+    move_time = wheel_time = 0;
+    mousekey_moving = false;
 }
 
 static void mousekey_debug(void)
 {
     if (!debug_mouse) return;
-    print("mousekey [btn|x y v h](rep/acl): [");
+    print("mousekey [btn|x y v h](time/acl): [");
     phex(mouse_report.buttons); print("|");
     print_decs(mouse_report.x); print(" ");
     print_decs(mouse_report.y); print(" ");
     print_decs(mouse_report.v); print(" ");
     print_decs(mouse_report.h); print("](");
-    print_dec(mousekey_repeat); print("/");
+    print_dec(move_time); print("/");
     print_dec(mousekey_accel); print(")\n");
 }
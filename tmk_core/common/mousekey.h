@@ -59,6 +59,18 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #ifndef MOUSEKEY_WHEEL_TIME_TO_MAX
 #define MOUSEKEY_WHEEL_TIME_TO_MAX 40
 #endif
+#ifndef MOUSEKEY_REPORT_INTERVAL
+#define MOUSEKEY_REPORT_INTERVAL MOUSEKEY_INTERVAL
+#endif
+
+/* acceleration curves */
+#define MOUSEKEY_CURVE_LINEAR    0
+#define MOUSEKEY_CURVE_QUADRATIC 1
+#define MOUSEKEY_CURVE_CONSTANT  2
+
+#ifndef MOUSEKEY_CURVE
+#define MOUSEKEY_CURVE MOUSEKEY_CURVE_LINEAR
+#endif
 
 
 #ifdef __cplusplus
@@ -67,8 +79,10 @@ extern "C" {
 
 extern uint8_t mk_delay;
 extern uint8_t mk_interval;
+extern uint8_t mk_report_interval;
 extern uint8_t mk_max_speed;
 extern uint8_t mk_time_to_max;
+extern uint8_t mk_curve;
 extern uint8_t mk_wheel_max_speed;
 extern uint8_t mk_wheel_time_to_max;
 
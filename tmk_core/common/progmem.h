@@ -4,10 +4,13 @@
 #if defined(__AVR__)
 #   include <avr/pgmspace.h>
 #else
+#   include <string.h>
 #   define PROGMEM
 #   define pgm_read_byte(p)     *((unsigned char*)p)
 #   define pgm_read_word(p)     *((uint16_t*)p)
 #   define pgm_read_dword(p)    *((uint32_t*)p)
+#   define pgm_read_ptr(p)      *((void* const*)p)
+#   define memcpy_P(d, s, n)    memcpy(d, s, n)
 #endif
 
 #endif
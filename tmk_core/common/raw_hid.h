@@ -1,8 +1,13 @@
 #ifndef _RAW_HID_H_
 #define _RAW_HID_H_
 
+#include <stdint.h>
+#include <stdbool.h>
+
 void raw_hid_receive( uint8_t *data, uint8_t length );
 
-void raw_hid_send( uint8_t *data, uint8_t length );
+// Returns false if the packet couldn't be sent, because the host hasn't
+// read the previous one yet
+bool raw_hid_send( uint8_t *data, uint8_t length );
 
 #endif
@@ -0,0 +1,64 @@
+/* Copyright 2026 QMK Firmware contributors
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <stdbool.h>
+#include "trace.h"
+#include "byte_queue.h"
+#include "sendchar.h"
+
+_Static_assert(TRACE_COUNT <= TRACE_RECORD_MARK, "There are too many traces");
+
+static uint8_t trace_data[TRACE_BUFFER_SIZE];
+static byte_queue_t trace_queue = BYTE_QUEUE_INITIALIZER(trace_data);
+static uint16_t trace_dropped = 0;
+
+static bool trace_put(uint8_t id, const uint16_t *args, uint8_t count) {
+    if (byte_queue_space(&trace_queue) < 2 + count * sizeof(uint16_t)) {
+        return false;
+    }
+    byte_queue_push(&trace_queue, id);
+    byte_queue_push(&trace_queue, count);
+    byte_queue_write(&trace_queue, (const uint8_t*)args, count * sizeof(uint16_t));
+    return true;
+}
+
+void trace_write(uint8_t id, const uint16_t *args, uint8_t count) {
+    if (trace_dropped && trace_put(TRACE_DROPPED, &trace_dropped, 1)) {
+        trace_dropped = 0;
+    }
+    // Nothing is logged before the count of the dropped records
+    if (trace_dropped || !trace_put(id, args, count)) {
+        if (trace_dropped < UINT16_MAX) {
+            trace_dropped++;
+        }
+    }
+}
+
+void trace_task(void) {
+    uint8_t header[2];
+    if (byte_queue_read(&trace_queue, header, sizeof(header)) != sizeof(header)) {
+        return;
+    }
+    sendchar(TRACE_RECORD_MARK | header[0]);
+    for (uint8_t i = 0; i < header[1]; i++) {
+        uint16_t arg;
+        byte_queue_read(&trace_queue, (uint8_t*)&arg, sizeof(arg));
+        sendchar(TRACE_RECORD_MARK | (arg & 0x7F));
+        sendchar(TRACE_RECORD_MARK | ((arg >> 7) & 0x7F));
+        sendchar(TRACE_RECORD_MARK | (arg >> 14));
+    }
+}
@@ -0,0 +1,77 @@
+/* Copyright 2026 QMK Firmware contributors
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <stdint.h>
+#include "trace_formats.h"
+
+/* Binary trace log
+ *
+ * With TRACE_ENABLE, dtrace() doesn't format anything. It copies the number
+ * of the trace and its arguments to a ring buffer, and trace_task() sends
+ * one record at a time to the console from the main loop, after the keys
+ * have been processed. Without TRACE_ENABLE, dtrace() is dprintf() with the
+ * format of the trace, so the output is the same text in both cases.
+ *
+ * On the console, a record is the byte 0x80 | number, followed by three
+ * bytes for each argument, with the low seven bits first and the top bit of
+ * every byte set. The printed text stays below 0x80, so the host decoder
+ * passes it through unchanged.
+ *
+ * When the buffer is full the records are dropped, and a TRACE_DROPPED
+ * record with their count is logged when there is space again.
+ */
+
+#define TRACE_ID(name) name,
+enum trace_id {
+    TRACE_NONE,
+    TRACE_FORMATS(TRACE_ID)
+    TRACE_COUNT
+};
+#undef TRACE_ID
+
+#define TRACE_RECORD_MARK 0x80
+#define TRACE_ARG_BYTES 3
+
+// The size of the ring buffer in bytes, a record takes two bytes and two
+// more for each argument
+#ifndef TRACE_BUFFER_SIZE
+#define TRACE_BUFFER_SIZE 128
+#endif
+
+#if TRACE_BUFFER_SIZE > 128 || (TRACE_BUFFER_SIZE & (TRACE_BUFFER_SIZE - 1)) != 0
+#error "TRACE_BUFFER_SIZE has to be a power of two of at most 128"
+#endif
+
+#define TRACE_WRITE(id, ...) trace_write((id), (const uint16_t[]){0, ##__VA_ARGS__} + 1, \
+    sizeof((const uint16_t[]){0, ##__VA_ARGS__}) / sizeof(uint16_t) - 1)
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+void trace_write(uint8_t id, const uint16_t *args, uint8_t count);
+// Sends the oldest record to the console, call it from the main loop
+void trace_task(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
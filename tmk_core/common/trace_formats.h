@@ -0,0 +1,175 @@
+/* Copyright 2026 QMK Firmware contributors
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef TRACE_FORMATS_H
+#define TRACE_FORMATS_H
+
+/* The format table of the trace log
+ *
+ * Every trace has a name and a printf format, whose conversions all take
+ * 16 bit arguments. The firmware only stores the number of the trace and its
+ * arguments, and the host decoder in quantum/tools/trace_decode.c formats
+ * them with this same table, so a decoder has to be built from the same
+ * version of this file as the firmware.
+ *
+ * New traces go to the end of TRACE_FORMATS, so that the numbers of the old
+ * ones don't change. There can be at most 127 of them.
+ */
+
+// The arguments are TRACE_EVENT_ARGS, and TRACE_RECORD_ARGS, from action.h
+#define TRACE_EVENT_FORMAT "%04X%c(%u)"
+#define TRACE_RECORD_FORMAT TRACE_EVENT_FORMAT ":%u%c"
+
+#define TRACE_DROPPED_FMT "trace: %u records dropped\n"
+#define TRACE_NEWLINE_FMT "\n"
+
+/* action.c */
+#define TRACE_EVENT_FMT TRACE_EVENT_FORMAT
+#define TRACE_RECORD_FMT TRACE_RECORD_FORMAT
+#define TRACE_ACTION_EXEC_FMT "\n---- action_exec: start -----\n"
+#define TRACE_ACTION_EVENT_FMT "EVENT: " TRACE_EVENT_FORMAT "\n"
+#define TRACE_PROCESSED_FMT "processed: " TRACE_RECORD_FORMAT "\n"
+#define TRACE_PROCESSED_EVENT_FMT "processed: " TRACE_EVENT_FORMAT "\n"
+#define TRACE_ACTION_FMT "ACTION: "
+#define TRACE_ACT_LMODS_FMT "ACT_LMODS[%X:%02X]"
+#define TRACE_ACT_RMODS_FMT "ACT_RMODS[%X:%02X]"
+#define TRACE_ACT_LMODS_TAP_FMT "ACT_LMODS_TAP[%X:%02X]"
+#define TRACE_ACT_RMODS_TAP_FMT "ACT_RMODS_TAP[%X:%02X]"
+#define TRACE_ACT_USAGE_FMT "ACT_USAGE[%X:%02X]"
+#define TRACE_ACT_MOUSEKEY_FMT "ACT_MOUSEKEY[%X:%02X]"
+#define TRACE_ACT_LAYER_FMT "ACT_LAYER[%X:%02X]"
+#define TRACE_ACT_LAYER_TAP_FMT "ACT_LAYER_TAP[%X:%02X]"
+#define TRACE_ACT_LAYER_TAP_EXT_FMT "ACT_LAYER_TAP_EXT[%X:%02X]"
+#define TRACE_ACT_MACRO_FMT "ACT_MACRO[%X:%02X]"
+#define TRACE_ACT_COMMAND_FMT "ACT_COMMAND[%X:%02X]"
+#define TRACE_ACT_FUNCTION_FMT "ACT_FUNCTION[%X:%02X]"
+#define TRACE_ACT_SWAP_HANDS_FMT "ACT_SWAP_HANDS[%X:%02X]"
+#define TRACE_ACT_UNKNOWN_FMT "UNKNOWN[%X:%02X]"
+// The layer states are 32 bits, so they take two arguments each
+#define TRACE_LAYER_STATES_FMT " layer_state: %04X%04X(%u) default_layer_state: %04X%04X(%u)\n"
+#define TRACE_MODS_TAP_ONESHOT_0_FMT "MODS_TAP: Oneshot: 0\n"
+#define TRACE_MODS_TAP_ONESHOT_START_FMT "MODS_TAP: Oneshot: start\n"
+#define TRACE_MODS_TAP_ONESHOT_TOGGLE_FMT "MODS_TAP: Toggling oneshot"
+#define TRACE_MODS_TAP_CANCEL_FMT "mods_tap: tap: cancel: add_mods\n"
+#define TRACE_MODS_TAP_REGISTER_FMT "MODS_TAP: Tap: register_code\n"
+#define TRACE_MODS_TAP_UNREGISTER_FMT "MODS_TAP: Tap: unregister_code\n"
+#define TRACE_MODS_TAP_ADD_MODS_FMT "MODS_TAP: No tap: add_mods\n"
+#define TRACE_LAYER_TAP_REGISTER_FMT "KEYMAP_TAP_KEY: Tap: register_code\n"
+#define TRACE_LAYER_TAP_ON_FMT "KEYMAP_TAP_KEY: No tap: On on press\n"
+#define TRACE_LAYER_TAP_UNREGISTER_FMT "KEYMAP_TAP_KEY: Tap: unregister_code\n"
+#define TRACE_LAYER_TAP_OFF_FMT "KEYMAP_TAP_KEY: No tap: Off on release\n"
+
+/* action_tapping.c */
+#define TRACE_TAPPING_OVERFLOW_FMT "OVERFLOW: CLEAR ALL STATES\n"
+#define TRACE_WAITING_BUFFER_PROCESS_FMT "---- action_exec: process waiting_buffer -----\n"
+#define TRACE_WAITING_BUFFER_PROCESSED_FMT "processed: waiting_buffer[%u] = " TRACE_RECORD_FORMAT "\n\n"
+#define TRACE_TAPPING_FIRST_TAP_FMT "Tapping: First tap(0->1).\n"
+#define TRACE_TAPPING_INTERFERED_FMT "Tapping: End. No tap. Interfered by typing key\n"
+#define TRACE_TAPPING_EARLY_RELEASE_FMT "Tapping: release event of a key pressed before tapping\n"
+#define TRACE_TAPPING_TAP_RELEASE_FMT "Tapping: Tap release(%u)\n"
+#define TRACE_TAPPING_NEW_TAP_FMT "Tapping: Start new tap with releasing last tap(>1).\n"
+#define TRACE_TAPPING_LAST_TAP_FMT "Tapping: Start while last tap(1).\n"
+#define TRACE_TAPPING_KEY_EVENT_FMT "Tapping: key event while last tap(>0).\n"
+#define TRACE_TAPPING_TIMEOUT_FMT "Tapping: End. Timeout. Not tap(0): " TRACE_EVENT_FORMAT "\n"
+#define TRACE_TAPPING_TIMEOUT_RELEASE_FMT "Tapping: End. last timeout tap release(>0)."
+#define TRACE_TAPPING_TIMEOUT_NEW_TAP_FMT "Tapping: Start new tap with releasing last timeout tap(>1).\n"
+#define TRACE_TAPPING_TIMEOUT_LAST_TAP_FMT "Tapping: Start while last timeout tap(1).\n"
+#define TRACE_TAPPING_TIMEOUT_KEY_EVENT_FMT "Tapping: key event while last timeout tap(>0).\n"
+#define TRACE_TAPPING_TAP_PRESS_FMT "Tapping: Tap press(%u)\n"
+#define TRACE_TAPPING_INTERFERING_TAP_FMT "Tapping: Start with interfering other tap.\n"
+#define TRACE_TAPPING_AFTER_TAP_FMT "Tapping: other key just after tap.\n"
+#define TRACE_TAPPING_TIMEOUT_AFTER_TAP_FMT "Tapping: End(Timeout after releasing last tap): " TRACE_EVENT_FORMAT "\n"
+#define TRACE_TAPPING_START_FMT "Tapping: Start(Press tap key).\n"
+#define TRACE_TAPPING_KEY_FMT "TAPPING_KEY=" TRACE_RECORD_FORMAT "\n"
+#define TRACE_WAITING_BUFFER_OVERFLOW_FMT "waiting_buffer_enq: Over flow.\n"
+#define TRACE_WAITING_BUFFER_ENQ_FMT "waiting_buffer_enq: "
+#define TRACE_WAITING_BUFFER_SCAN_TAP_FMT "waiting_buffer_scan_tap: found at [%u]\n"
+#define TRACE_WAITING_BUFFER_START_FMT "{ "
+#define TRACE_WAITING_BUFFER_ITEM_FMT "[%u]=" TRACE_RECORD_FORMAT " "
+#define TRACE_WAITING_BUFFER_END_FMT "}\n"
+
+/* host.c */
+#define TRACE_KEYBOARD_REPORT_FMT "keyboard_report: %02X %02X %02X %02X %02X %02X %02X %02X "
+#define TRACE_KEYBOARD_REPORT_MORE_FMT "%02X %02X %02X %02X %02X %02X %02X %02X "
+
+#define TRACE_FORMATS(X) \
+    X(TRACE_DROPPED) \
+    X(TRACE_NEWLINE) \
+    X(TRACE_EVENT) \
+    X(TRACE_RECORD) \
+    X(TRACE_ACTION_EXEC) \
+    X(TRACE_ACTION_EVENT) \
+    X(TRACE_PROCESSED) \
+    X(TRACE_PROCESSED_EVENT) \
+    X(TRACE_ACTION) \
+    X(TRACE_ACT_LMODS) \
+    X(TRACE_ACT_RMODS) \
+    X(TRACE_ACT_LMODS_TAP) \
+    X(TRACE_ACT_RMODS_TAP) \
+    X(TRACE_ACT_USAGE) \
+    X(TRACE_ACT_MOUSEKEY) \
+    X(TRACE_ACT_LAYER) \
+    X(TRACE_ACT_LAYER_TAP) \
+    X(TRACE_ACT_LAYER_TAP_EXT) \
+    X(TRACE_ACT_MACRO) \
+    X(TRACE_ACT_COMMAND) \
+    X(TRACE_ACT_FUNCTION) \
+    X(TRACE_ACT_SWAP_HANDS) \
+    X(TRACE_ACT_UNKNOWN) \
+    X(TRACE_LAYER_STATES) \
+    X(TRACE_MODS_TAP_ONESHOT_0) \
+    X(TRACE_MODS_TAP_ONESHOT_START) \
+    X(TRACE_MODS_TAP_ONESHOT_TOGGLE) \
+    X(TRACE_MODS_TAP_CANCEL) \
+    X(TRACE_MODS_TAP_REGISTER) \
+    X(TRACE_MODS_TAP_UNREGISTER) \
+    X(TRACE_MODS_TAP_ADD_MODS) \
+    X(TRACE_LAYER_TAP_REGISTER) \
+    X(TRACE_LAYER_TAP_ON) \
+    X(TRACE_LAYER_TAP_UNREGISTER) \
+    X(TRACE_LAYER_TAP_OFF) \
+    X(TRACE_TAPPING_OVERFLOW) \
+    X(TRACE_WAITING_BUFFER_PROCESS) \
+    X(TRACE_WAITING_BUFFER_PROCESSED) \
+    X(TRACE_TAPPING_FIRST_TAP) \
+    X(TRACE_TAPPING_INTERFERED) \
+    X(TRACE_TAPPING_EARLY_RELEASE) \
+    X(TRACE_TAPPING_TAP_RELEASE) \
+    X(TRACE_TAPPING_NEW_TAP) \
+    X(TRACE_TAPPING_LAST_TAP) \
+    X(TRACE_TAPPING_KEY_EVENT) \
+    X(TRACE_TAPPING_TIMEOUT) \
+    X(TRACE_TAPPING_TIMEOUT_RELEASE) \
+    X(TRACE_TAPPING_TIMEOUT_NEW_TAP) \
+    X(TRACE_TAPPING_TIMEOUT_LAST_TAP) \
+    X(TRACE_TAPPING_TIMEOUT_KEY_EVENT) \
+    X(TRACE_TAPPING_TAP_PRESS) \
+    X(TRACE_TAPPING_INTERFERING_TAP) \
+    X(TRACE_TAPPING_AFTER_TAP) \
+    X(TRACE_TAPPING_TIMEOUT_AFTER_TAP) \
+    X(TRACE_TAPPING_START) \
+    X(TRACE_TAPPING_KEY) \
+    X(TRACE_WAITING_BUFFER_OVERFLOW) \
+    X(TRACE_WAITING_BUFFER_ENQ) \
+    X(TRACE_WAITING_BUFFER_SCAN_TAP) \
+    X(TRACE_WAITING_BUFFER_START) \
+    X(TRACE_WAITING_BUFFER_ITEM) \
+    X(TRACE_WAITING_BUFFER_END) \
+    X(TRACE_KEYBOARD_REPORT) \
+    X(TRACE_KEYBOARD_REPORT_MORE)
+
+#endif
@@ -1,10 +1,16 @@
 #ifndef _VIRTSER_H_
 #define _VIRTSER_H_
 
+#include <stdint.h>
+
 /* Define this function in your code to process incoming bytes */
 void virtser_recv(const uint8_t ch);
 
 /* Call this to send a character over the Virtual Serial Device */
 void virtser_send(const uint8_t byte);
 
+/* Sends as many bytes as fit in the endpoint without waiting, and returns
+ * their count. The bytes are dropped when no program has the port open. */
+uint8_t virtser_write(const uint8_t *data, uint8_t length);
+
 #endif
@@ -824,14 +824,14 @@ void sendchar_pf(void *p, char c) {
 }
 
 #ifdef RAW_ENABLE
-void raw_hid_send( uint8_t *data, uint8_t length ) {
+bool raw_hid_send( uint8_t *data, uint8_t length ) {
 	// TODO: implement variable size packet
 	if ( length != RAW_EPSIZE )
 	{
-		return;
+		return false;
 
 	}
-  chnWrite(&drivers.raw_driver.driver, data, length);
+  return chnWriteTimeout(&drivers.raw_driver.driver, data, length, TIME_IMMEDIATE) == length;
 }
 
 __attribute__ ((weak))
@@ -873,6 +873,10 @@ void virtser_send(const uint8_t byte) {
   chnWrite(&drivers.serial_driver.driver, &byte, 1);
 }
 
+uint8_t virtser_write(const uint8_t *data, uint8_t length) {
+  return chnWriteTimeout(&drivers.serial_driver.driver, data, length, TIME_IMMEDIATE);
+}
+
 __attribute__ ((weak))
 void virtser_recv(uint8_t c)
 {
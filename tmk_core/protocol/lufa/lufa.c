@@ -53,6 +53,7 @@
 #include "lufa.h"
 #include "quantum.h"
 #include <util/atomic.h>
+#include "byte_queue.h"
 #include "outputselect.h"
 
 #ifdef NKRO_ENABLE
@@ -141,19 +142,21 @@ USB_ClassInfo_CDC_Device_t cdc_device =
 
 #ifdef RAW_ENABLE
 
-void raw_hid_send( uint8_t *data, uint8_t length )
+bool raw_hid_send( uint8_t *data, uint8_t length )
 {
 	// TODO: implement variable size packet
 	if ( length != RAW_EPSIZE )
 	{
-		return;
+		return false;
 	}
 
 	if (USB_DeviceState != DEVICE_STATE_Configured)
 	{
-		return;
+		return false;
 	}
 
+	bool sent = false;
+
 	// TODO: decide if we allow calls to raw_hid_send() in the middle
 	// of other endpoint usage.
 	uint8_t ep = Endpoint_GetCurrentEndpoint();
@@ -167,9 +170,11 @@ void raw_hid_send( uint8_t *data, uint8_t length )
 		Endpoint_Write_Stream_LE(data, RAW_EPSIZE, NULL);
 		// Finalize the stream transfer to send the last packet
 		Endpoint_ClearIN();
+		sent = true;
 	}
 
 	Endpoint_SelectEndpoint(ep);
+	return sent;
 }
 
 __attribute__ ((weak))
@@ -218,6 +223,19 @@ static void raw_hid_task(void)
  * Console
  ******************************************************************************/
 #ifdef CONSOLE_ENABLE
+#ifndef CONSOLE_QUEUE_SIZE
+#define CONSOLE_QUEUE_SIZE 64
+#endif
+#if CONSOLE_QUEUE_SIZE > 128 || (CONSOLE_QUEUE_SIZE & (CONSOLE_QUEUE_SIZE - 1))
+#error "CONSOLE_QUEUE_SIZE must be a power of two of at most 128"
+#endif
+
+/* sendchar() only queues the characters, Console_Task() sends them from the
+ * main loop, a full packet at a time.
+ */
+static uint8_t console_data[CONSOLE_QUEUE_SIZE];
+static byte_queue_t console_queue = BYTE_QUEUE_INITIALIZER(console_data);
+
 static void Console_Task(void)
 {
     /* Device must be connected and configured for the task to run */
@@ -253,7 +271,27 @@ static void Console_Task(void)
 
     /* IN packet */
     Endpoint_SelectEndpoint(CONSOLE_IN_EPNUM);
-    if (!Endpoint_IsEnabled() || !Endpoint_IsConfigured()) {
+    if (!Endpoint_IsEnabled() || !Endpoint_IsConfigured() || !Endpoint_IsINReady()) {
+        Endpoint_SelectEndpoint(ep);
+        return;
+    }
+
+    // send one packet of the queued characters, the queue is drained a
+    // contiguous span at a time
+    const uint8_t *span;
+    uint8_t length;
+    uint8_t written = 0;
+    while (written < CONSOLE_EPSIZE && (length = byte_queue_peek(&console_queue, &span)) > 0) {
+        if (length > CONSOLE_EPSIZE - written) {
+            length = CONSOLE_EPSIZE - written;
+        }
+        for (uint8_t i = 0; i < length; i++) {
+            Endpoint_Write_8(span[i]);
+        }
+        byte_queue_consume(&console_queue, length);
+        written += length;
+    }
+    if (written == 0) {
         Endpoint_SelectEndpoint(ep);
         return;
     }
@@ -262,10 +300,7 @@ static void Console_Task(void)
     while (Endpoint_IsReadWriteAllowed())
         Endpoint_Write_8(0);
 
-    // flash senchar packet
-    if (Endpoint_IsINReady()) {
-        Endpoint_ClearIN();
-    }
+    Endpoint_ClearIN();
 
     Endpoint_SelectEndpoint(ep);
 }
@@ -289,7 +324,6 @@ void EVENT_USB_Device_Connect(void)
     if (!USB_IsInitialized) {
         USB_Disable();
         USB_Init();
-        USB_Device_EnableSOFEvents();
     }
 }
 
@@ -334,28 +368,6 @@ void EVENT_USB_Device_WakeUp()
 
 
 
-#ifdef CONSOLE_ENABLE
-static bool console_flush = false;
-#define CONSOLE_FLUSH_SET(b)   do { \
-  ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {\
-    console_flush = b; \
-  } \
-} while (0)
-
-// called every 1ms
-void EVENT_USB_Device_StartOfFrame(void)
-{
-    static uint8_t count;
-    if (++count % 50) return;
-    count = 0;
-
-    if (!console_flush) return;
-    Console_Task();
-    console_flush = false;
-}
-
-#endif
-
 /** Event handler for the USB_ConfigurationChanged event.
  * This is fired when the host sets the current configuration of the USB device after enumeration.
  *
@@ -745,55 +757,46 @@ int8_t sendchar(uint8_t c)
     // Because sendchar() is called so many times, waiting each call causes big lag.
     static bool timeouted = false;
 
-    // prevents Console_Task() from running during sendchar() runs.
-    // or char will be lost. These two function is mutually exclusive.
-    CONSOLE_FLUSH_SET(false);
-
     if (USB_DeviceState != DEVICE_STATE_Configured)
         return -1;
 
-    uint8_t ep = Endpoint_GetCurrentEndpoint();
-    Endpoint_SelectEndpoint(CONSOLE_IN_EPNUM);
-    if (!Endpoint_IsEnabled() || !Endpoint_IsConfigured()) {
-        goto ERROR_EXIT;
+    // The USB events print from the interrupt, which could have interrupted
+    // Console_Task(). Only the main loop sends the queue, so the characters
+    // that don't fit are dropped.
+    if (!(SREG & (1 << SREG_I))) {
+        return byte_queue_push(&console_queue, c) ? 0 : -1;
     }
 
-    if (timeouted && !Endpoint_IsReadWriteAllowed()) {
-        goto ERROR_EXIT;
+    if (timeouted && byte_queue_space(&console_queue) == 0) {
+        Console_Task();
+        if (byte_queue_space(&console_queue) == 0)
+            return -1;
     }
 
     timeouted = false;
 
     uint8_t timeout = SEND_TIMEOUT;
-    while (!Endpoint_IsReadWriteAllowed()) {
-        if (USB_DeviceState != DEVICE_STATE_Configured) {
-            goto ERROR_EXIT;
+    while (byte_queue_space(&console_queue) == 0) {
+        Console_Task();
+        if (byte_queue_space(&console_queue) > 0) {
+            break;
         }
-        if (Endpoint_IsStalled()) {
-            goto ERROR_EXIT;
+        if (USB_DeviceState != DEVICE_STATE_Configured) {
+            return -1;
         }
         if (!(timeout--)) {
             timeouted = true;
-            goto ERROR_EXIT;
+            return -1;
         }
         _delay_ms(1);
     }
 
-    Endpoint_Write_8(c);
-
-    // send when bank is full
-    if (!Endpoint_IsReadWriteAllowed()) {
-        while (!(Endpoint_IsINReady()));
-        Endpoint_ClearIN();
-    } else {
-        CONSOLE_FLUSH_SET(true);
+    // The USB events print from the interrupt too, so the producers have to
+    // take turns
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+        byte_queue_push(&console_queue, c);
     }
-
-    Endpoint_SelectEndpoint(ep);
     return 0;
-ERROR_EXIT:
-    Endpoint_SelectEndpoint(ep);
-    return -1;
 }
 #else
 int8_t sendchar(uint8_t c)
@@ -842,6 +845,50 @@ bool recv_midi_packet(MIDI_EventPacket_t* const event) {
  ******************************************************************************/
 
 #ifdef VIRTSER_ENABLE
+#ifndef VIRTSER_QUEUE_SIZE
+#define VIRTSER_QUEUE_SIZE 64
+#endif
+#if VIRTSER_QUEUE_SIZE > 128 || (VIRTSER_QUEUE_SIZE & (VIRTSER_QUEUE_SIZE - 1))
+#error "VIRTSER_QUEUE_SIZE must be a power of two of at most 128"
+#endif
+
+/* virtser_send() only queues the bytes, virtser_task() sends them from the
+ * main loop, a packet at a time.
+ */
+static uint8_t virtser_data[VIRTSER_QUEUE_SIZE];
+static byte_queue_t virtser_queue = BYTE_QUEUE_INITIALIZER(virtser_data);
+
+static uint8_t virtser_write_packet(const uint8_t *data, uint8_t length)
+{
+  if (!(cdc_device.State.ControlLineStates.HostToDevice & CDC_CONTROL_LINE_OUT_DTR)) {
+    return length;
+  }
+
+  uint8_t written = 0;
+  uint8_t ep = Endpoint_GetCurrentEndpoint();
+  Endpoint_SelectEndpoint(cdc_device.Config.DataINEndpoint.Address);
+
+  if (Endpoint_IsEnabled() && Endpoint_IsConfigured() && Endpoint_IsReadWriteAllowed()) {
+    /* one IN packet, the rest is written when the host has read it */
+    while (written < length && Endpoint_BytesInEndpoint() < CDC_EPSIZE) {
+      Endpoint_Write_8(data[written++]);
+    }
+    Endpoint_ClearIN();
+  }
+
+  Endpoint_SelectEndpoint(ep);
+  return written;
+}
+
+static void virtser_flush(void)
+{
+  const uint8_t *span;
+  uint8_t length = byte_queue_peek(&virtser_queue, &span);
+  if (length > 0) {
+    byte_queue_consume(&virtser_queue, virtser_write_packet(span, length));
+  }
+}
+
 void virtser_init(void)
 {
   cdc_device.State.ControlLineStates.DeviceToHost = CDC_CONTROL_LINE_IN_DSR ;
@@ -856,6 +903,8 @@ void virtser_recv(uint8_t c)
 
 void virtser_task(void)
 {
+  virtser_flush();
+
   uint16_t count = CDC_Device_BytesReceived(&cdc_device);
   uint8_t ch;
   if (count)
@@ -864,32 +913,28 @@ void virtser_task(void)
     virtser_recv(ch);
   }
 }
+
+#define VIRTSER_SEND_TIMEOUT 10
 void virtser_send(const uint8_t byte)
 {
-  uint8_t timeout = 255;
-  uint8_t ep = Endpoint_GetCurrentEndpoint();
-
-  if (cdc_device.State.ControlLineStates.HostToDevice & CDC_CONTROL_LINE_OUT_DTR)
-  {
-    /* IN packet */
-    Endpoint_SelectEndpoint(cdc_device.Config.DataINEndpoint.Address);
-
-    if (!Endpoint_IsEnabled() || !Endpoint_IsConfigured()) {
-        Endpoint_SelectEndpoint(ep);
-        return;
-    }
-
-    while (timeout-- && !Endpoint_IsReadWriteAllowed()) _delay_us(40);
-
-    Endpoint_Write_8(byte);
-    CDC_Device_Flush(&cdc_device);
-
-    if (Endpoint_IsINReady()) {
-      Endpoint_ClearIN();
+  uint8_t timeout = VIRTSER_SEND_TIMEOUT;
+  while (!byte_queue_push(&virtser_queue, byte)) {
+    virtser_flush();
+    if (!(timeout--)) {
+      return;
     }
+    _delay_ms(1);
+  }
+}
 
-    Endpoint_SelectEndpoint(ep);
+uint8_t virtser_write(const uint8_t *data, uint8_t length)
+{
+  // The bytes queued by virtser_send() go first
+  virtser_flush();
+  if (byte_queue_length(&virtser_queue) > 0) {
+    return 0;
   }
+  return virtser_write_packet(data, length);
 }
 #endif
 
@@ -916,8 +961,6 @@ static void setup_usb(void)
 
     USB_Init();
 
-    // for Console_Task
-    USB_Device_EnableSOFEvents();
     print_set_sendchar(sendchar);
 }
 
@@ -976,6 +1019,10 @@ int main(void)
 
         keyboard_task();
 
+#ifdef CONSOLE_ENABLE
+        Console_Task();
+#endif
+
 #ifdef MIDI_ENABLE
         MIDI_Device_USBTask(&USB_MIDI_Interface);
 #endif
@@ -48,8 +48,8 @@ extern "C" {
  */
 
 #include "midi_function_types.h"
-#include "bytequeue/bytequeue.h"
-#define MIDI_INPUT_QUEUE_LENGTH 192
+#include "byte_queue.h"
+#define MIDI_INPUT_QUEUE_LENGTH 128
 
 typedef enum {
    IDLE, 
@@ -109,7 +109,7 @@ struct _midi_device {
 
    //for queueing data between the input and the processing functions
    uint8_t input_queue_data[MIDI_INPUT_QUEUE_LENGTH];
-   byteQueue_t input_queue;
+   byte_queue_t input_queue;
 };
 
 /**
@@ -85,6 +85,8 @@ POSSIBILITY OF SUCH DAMAGE.
 
 
 extern uint8_t ps2_error;
+/* number of received bytes dropped by the interrupt drivers, wraps around */
+extern volatile uint8_t ps2_rx_dropped;
 
 void ps2_host_init(void);
 uint8_t ps2_host_send(uint8_t data);
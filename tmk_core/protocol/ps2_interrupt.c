@@ -56,6 +56,7 @@ POSSIBILITY OF SUCH DAMAGE.
 
 
 uint8_t ps2_error = PS2_ERR_NONE;
+volatile uint8_t ps2_rx_dropped = 0;
 
 
 static inline uint8_t pbuf_dequeue(void);
@@ -211,6 +212,7 @@ ISR(PS2_INT_VECT)
     goto RETURN;
 ERROR:
     ps2_error = state;
+    ps2_rx_dropped++;
 DONE:
     state = INIT;
     data = 0;
@@ -243,6 +245,7 @@ static inline void pbuf_enqueue(uint8_t data)
         pbuf[pbuf_head] = data;
         pbuf_head = next;
     } else {
+        ps2_rx_dropped++;
         print("pbuf: full\n");
     }
     SREG = sreg;
@@ -25,16 +25,22 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #include "report.h"
 #include "debug.h"
 #include "ps2.h"
+#include "mouse_report.h"
+#include "ps2_mouse_packet.h"
 
 /* ============================= MACROS ============================ */
 
 static report_mouse_t mouse_report = {};
+#ifdef PS2_MOUSE_STREAM_BUFFERED
+static ps2_mouse_packet_t packet;
+#endif
 
 static inline void ps2_mouse_print_report(report_mouse_t *mouse_report);
 static inline void ps2_mouse_convert_report_to_hid(report_mouse_t *mouse_report);
 static inline void ps2_mouse_clear_report(report_mouse_t *mouse_report);
 static inline void ps2_mouse_enable_scrolling(void);
 static inline void ps2_mouse_scroll_button_task(report_mouse_t *mouse_report);
+static void ps2_mouse_process_report(report_mouse_t *mouse_report);
 
 /* ============================= IMPLEMENTATION ============================ */
 
@@ -49,10 +55,8 @@ void ps2_mouse_init(void) {
     PS2_MOUSE_RECEIVE("ps2_mouse_init: read BAT");
     PS2_MOUSE_RECEIVE("ps2_mouse_init: read DevID");
 
-#ifdef PS2_MOUSE_USE_REMOTE_MODE
-    ps2_mouse_set_remote_mode();
-#else
-    ps2_mouse_enable_data_reporting();
+#ifdef PS2_MOUSE_STREAM_BUFFERED
+    ps2_mouse_packet_init(&packet, PS2_MOUSE_PACKET_SIZE_STANDARD);
 #endif
 
 #ifdef PS2_MOUSE_ENABLE_SCROLLING
@@ -63,6 +67,17 @@ void ps2_mouse_init(void) {
     ps2_mouse_set_scaling_2_1();
 #endif
 
+#ifdef PS2_MOUSE_SAMPLE_RATE
+    ps2_mouse_set_sample_rate(PS2_MOUSE_SAMPLE_RATE);
+#endif
+
+    // Enabled last so the device id isn't mixed up with movement packets
+#ifdef PS2_MOUSE_USE_REMOTE_MODE
+    ps2_mouse_set_remote_mode();
+#else
+    ps2_mouse_enable_data_reporting();
+#endif
+
     ps2_mouse_init_user();
 }
 
@@ -71,9 +86,32 @@ void ps2_mouse_init_user(void) {
 }
 
 void ps2_mouse_task(void) {
-    static uint8_t buttons_prev = 0;
     extern int tp_buttons;
 
+#ifdef PS2_MOUSE_STREAM_BUFFERED
+    static uint8_t dropped_prev = 0;
+
+    /* a byte lost by the driver breaks the packet being assembled */
+    if (ps2_rx_dropped != dropped_prev) {
+        dropped_prev = ps2_rx_dropped;
+        ps2_mouse_packet_reset(&packet);
+    }
+
+    /* only takes the bytes already buffered by the driver, never waits for more */
+    while (true) {
+        uint8_t data = ps2_host_recv();
+        if (ps2_error == PS2_ERR_NODATA) break;
+        if (!ps2_mouse_packet_feed(&packet, data)) continue;
+
+        mouse_report.buttons = packet.data[0] | tp_buttons;
+        mouse_report.x = packet.data[1] * PS2_MOUSE_X_MULTIPLIER;
+        mouse_report.y = packet.data[2] * PS2_MOUSE_Y_MULTIPLIER;
+        if (packet.size == PS2_MOUSE_PACKET_SIZE_INTELLIMOUSE) {
+            mouse_report.v = -(packet.data[3] & PS2_MOUSE_SCROLL_MASK) * PS2_MOUSE_V_MULTIPLIER;
+        }
+        ps2_mouse_process_report(&mouse_report);
+    }
+#else
     /* receives packet from mouse */
     uint8_t rcv;
     rcv = ps2_host_send(PS2_MOUSE_READ_DATA);
@@ -89,26 +127,33 @@ void ps2_mouse_task(void) {
         return;
     }
 
+    ps2_mouse_process_report(&mouse_report);
+#endif
+}
+
+static void ps2_mouse_process_report(report_mouse_t *mouse_report) {
+    static uint8_t buttons_prev = 0;
+
     /* if mouse moves or buttons state changes */
-    if (mouse_report.x || mouse_report.y || mouse_report.v ||
-            ((mouse_report.buttons ^ buttons_prev) & PS2_MOUSE_BTN_MASK)) {
+    if (mouse_report->x || mouse_report->y || mouse_report->v ||
+            ((mouse_report->buttons ^ buttons_prev) & PS2_MOUSE_BTN_MASK)) {
 #ifdef PS2_MOUSE_DEBUG_RAW
         // Used to debug raw ps2 bytes from mouse
-        ps2_mouse_print_report(&mouse_report);
+        ps2_mouse_print_report(mouse_report);
 #endif
-        buttons_prev = mouse_report.buttons;
-        ps2_mouse_convert_report_to_hid(&mouse_report);
+        buttons_prev = mouse_report->buttons;
+        ps2_mouse_convert_report_to_hid(mouse_report);
 #if PS2_MOUSE_SCROLL_BTN_MASK
-        ps2_mouse_scroll_button_task(&mouse_report);
+        ps2_mouse_scroll_button_task(mouse_report);
 #endif
 #ifdef PS2_MOUSE_DEBUG_HID
         // Used to debug the bytes sent to the host
-        ps2_mouse_print_report(&mouse_report);
+        ps2_mouse_print_report(mouse_report);
 #endif
-        host_mouse_send(&mouse_report);
+        mouse_report_add(MOUSE_SOURCE_PS2, mouse_report);
     }
 
-    ps2_mouse_clear_report(&mouse_report);
+    ps2_mouse_clear_report(mouse_report);
 }
 
 void ps2_mouse_disable_data_reporting(void) {
@@ -205,6 +250,14 @@ static inline void ps2_mouse_enable_scrolling(void) {
     PS2_MOUSE_SEND(PS2_MOUSE_SET_SAMPLE_RATE, "Set sample rate");
     PS2_MOUSE_SEND(80, "80");
     PS2_MOUSE_SEND(PS2_MOUSE_GET_DEVICE_ID, "Finished enabling scroll wheel");
+    uint8_t device_id = ps2_host_recv_response();
+    if (debug_mouse) xprintf("ps2_mouse: device id %X\n", device_id);
+#ifdef PS2_MOUSE_STREAM_BUFFERED
+    // IntelliMouse compatible devices add the wheel movement as a 4th byte
+    if (device_id == 3 || device_id == 4) {
+        ps2_mouse_packet_init(&packet, PS2_MOUSE_PACKET_SIZE_INTELLIMOUSE);
+    }
+#endif
     _delay_ms(20);
 }
 
@@ -246,9 +299,9 @@ static inline void ps2_mouse_scroll_button_task(report_mouse_t *mouse_report) {
 #if PS2_MOUSE_SCROLL_BTN_SEND
         if (scroll_state == SCROLL_BTN
                 && timer_elapsed(scroll_button_time) < PS2_MOUSE_SCROLL_BTN_SEND) {
+            // The release is queued behind the press, no need to wait here
             PRESS_SCROLL_BUTTONS;
-            host_mouse_send(mouse_report);
-            _delay_ms(100);
+            mouse_report_add(MOUSE_SOURCE_PS2, mouse_report);
             RELEASE_SCROLL_BUTTONS;
         }
 #endif
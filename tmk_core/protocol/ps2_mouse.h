@@ -153,6 +153,12 @@ typedef enum ps2_mouse_sample_rate_e {
     PS2_MOUSE_200_SAMPLES_SEC = 200,
 } ps2_mouse_sample_rate_t;
 
+/* In stream mode the interrupt and USART drivers buffer incoming packets, so
+ * they can be assembled without ever blocking the keyboard loop */
+#if !defined(PS2_MOUSE_USE_REMOTE_MODE) && (defined(PS2_USE_INT) || defined(PS2_USE_USART))
+#define PS2_MOUSE_STREAM_BUFFERED
+#endif
+
 void ps2_mouse_init(void);
 
 void ps2_mouse_init_user(void);
@@ -0,0 +1,80 @@
+/*
+Copyright 2026 QMK Firmware contributors
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "ps2_mouse_packet.h"
+
+void ps2_mouse_packet_init(ps2_mouse_packet_t *packet, uint8_t size)
+{
+    packet->size = size;
+    packet->len = 0;
+    packet->dropped = 0;
+}
+
+/* discards a partially received packet */
+void ps2_mouse_packet_reset(ps2_mouse_packet_t *packet)
+{
+    if (packet->len) {
+        packet->dropped += packet->len;
+        packet->len = 0;
+    }
+}
+
+static bool packet_is_valid(const ps2_mouse_packet_t *packet)
+{
+    if (!(packet->data[0] & PS2_MOUSE_PACKET_ALWAYS_1)) return false;
+    if (packet->size == PS2_MOUSE_PACKET_SIZE_INTELLIMOUSE) {
+        // The wheel movement is small, so the two top bits are both sign bits
+        // This also holds for 5 button mice, which use bit 4 and 5 for buttons
+        uint8_t top = packet->data[3] & 0xC0;
+        if (top != 0 && top != 0xC0) return false;
+    }
+    return true;
+}
+
+/* drops the first byte and everything up to the next possible packet start */
+static void resync(ps2_mouse_packet_t *packet)
+{
+    uint8_t skip = 1;
+    while (skip < packet->len && !(packet->data[skip] & PS2_MOUSE_PACKET_ALWAYS_1)) {
+        skip++;
+    }
+    for (uint8_t i = skip; i < packet->len; i++) {
+        packet->data[i - skip] = packet->data[i];
+    }
+    packet->len -= skip;
+    packet->dropped += skip;
+}
+
+/* returns true when data completes a packet, which is then available in packet->data */
+bool ps2_mouse_packet_feed(ps2_mouse_packet_t *packet, uint8_t data)
+{
+    if (packet->len == 0 && !(data & PS2_MOUSE_PACKET_ALWAYS_1)) {
+        packet->dropped++;
+        return false;
+    }
+
+    packet->data[packet->len++] = data;
+    if (packet->len < packet->size) {
+        return false;
+    }
+    if (!packet_is_valid(packet)) {
+        resync(packet);
+        return false;
+    }
+    packet->len = 0;
+    return true;
+}
@@ -0,0 +1,50 @@
+/*
+Copyright 2026 QMK Firmware contributors
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef PS2_MOUSE_PACKET_H
+#define PS2_MOUSE_PACKET_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/*
+ * Assembles stream mode packets from the bytes received by the PS/2 driver.
+ *
+ * Standard mice send 3 byte packets, IntelliMouse compatible ones send a 4th
+ * byte with the wheel movement. Bit 3 of the first byte is always set, a byte
+ * without it can't start a packet, so it is dropped until the stream is back
+ * in sync.
+ */
+
+#define PS2_MOUSE_PACKET_SIZE_STANDARD      3
+#define PS2_MOUSE_PACKET_SIZE_INTELLIMOUSE  4
+
+#define PS2_MOUSE_PACKET_ALWAYS_1   (1<<3)
+
+typedef struct {
+    uint8_t data[PS2_MOUSE_PACKET_SIZE_INTELLIMOUSE];
+    uint8_t len;
+    uint8_t size;
+    /* number of bytes dropped to resynchronize */
+    uint8_t dropped;
+} ps2_mouse_packet_t;
+
+void ps2_mouse_packet_init(ps2_mouse_packet_t *packet, uint8_t size);
+void ps2_mouse_packet_reset(ps2_mouse_packet_t *packet);
+bool ps2_mouse_packet_feed(ps2_mouse_packet_t *packet, uint8_t data);
+
+#endif
@@ -56,6 +56,7 @@ POSSIBILITY OF SUCH DAMAGE.
 
 
 uint8_t ps2_error = PS2_ERR_NONE;
+volatile uint8_t ps2_rx_dropped = 0;
 
 
 static inline uint8_t pbuf_dequeue(void);
@@ -160,6 +161,7 @@ ISR(PS2_USART_RX_VECT)
     if (!error) {
         pbuf_enqueue(data);
     } else {
+        ps2_rx_dropped++;
         xprintf("PS2 USART error: %02X data: %02X\n", error, data);
     }
 }
@@ -188,6 +190,7 @@ static inline void pbuf_enqueue(uint8_t data)
         pbuf[pbuf_head] = data;
         pbuf_head = next;
     } else {
+        ps2_rx_dropped++;
         print("pbuf: full\n");
     }
     SREG = sreg;
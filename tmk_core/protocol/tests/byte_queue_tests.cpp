@@ -0,0 +1,210 @@
+/* Copyright 2026 QMK Firmware contributors
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "gtest/gtest.h"
+#include <pthread.h>
+#include <sched.h>
+#include <random>
+#include <vector>
+extern "C" {
+#include "byte_queue.h"
+}
+
+class ByteQueue : public testing::Test {
+public:
+    ByteQueue() {
+        byte_queue_init(&queue, data, sizeof(data));
+    }
+
+    uint8_t data[8];
+    byte_queue_t queue;
+};
+
+TEST_F(ByteQueue, PopsInTheOrderOfPushing) {
+    for (uint8_t i = 0; i < 8; i++) {
+        EXPECT_TRUE(byte_queue_push(&queue, i));
+    }
+    EXPECT_FALSE(byte_queue_push(&queue, 8));
+    EXPECT_EQ(byte_queue_length(&queue), 8);
+    EXPECT_EQ(byte_queue_space(&queue), 0);
+    for (uint8_t i = 0; i < 8; i++) {
+        uint8_t byte;
+        EXPECT_TRUE(byte_queue_pop(&queue, &byte));
+        EXPECT_EQ(byte, i);
+    }
+    uint8_t byte;
+    EXPECT_FALSE(byte_queue_pop(&queue, &byte));
+}
+
+TEST_F(ByteQueue, IndicesWrapAround) {
+    uint8_t expected = 0;
+    uint8_t next = 0;
+    // Enough rounds to wrap the 8 bit indices a few times
+    for (int round = 0; round < 1000; round++) {
+        for (int i = 0; i < 5; i++) {
+            EXPECT_TRUE(byte_queue_push(&queue, next++));
+        }
+        for (int i = 0; i < 5; i++) {
+            uint8_t byte;
+            EXPECT_TRUE(byte_queue_pop(&queue, &byte));
+            EXPECT_EQ(byte, expected++);
+        }
+        EXPECT_EQ(byte_queue_length(&queue), 0);
+    }
+}
+
+TEST_F(ByteQueue, SpansStopAtTheEndOfTheBuffer) {
+    const uint8_t bytes[] = {1, 2, 3, 4, 5, 6};
+    EXPECT_EQ(byte_queue_write(&queue, bytes, 6), 6);
+    uint8_t read[6];
+    EXPECT_EQ(byte_queue_read(&queue, read, 5), 5);
+    EXPECT_EQ(byte_queue_write(&queue, bytes, 6), 6);
+    // The bytes are at 5, 6, 7, 0, 1, 2 and 3
+    const uint8_t* span;
+    EXPECT_EQ(byte_queue_peek(&queue, &span), 3);
+    EXPECT_EQ(span[0], 6);
+    EXPECT_EQ(span[1], 1);
+    byte_queue_consume(&queue, 3);
+    EXPECT_EQ(byte_queue_peek(&queue, &span), 4);
+    EXPECT_EQ(span[0], 3);
+    uint8_t* free;
+    EXPECT_EQ(byte_queue_reserve(&queue, &free), 4);
+    EXPECT_EQ(free, &data[4]);
+}
+
+TEST_F(ByteQueue, BulkWritesStopWhenFull) {
+    const uint8_t bytes[10] = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+    EXPECT_EQ(byte_queue_write(&queue, bytes, 3), 3);
+    EXPECT_EQ(byte_queue_write(&queue, bytes, 10), 5);
+    uint8_t read[10];
+    EXPECT_EQ(byte_queue_read(&queue, read, 10), 8);
+    EXPECT_EQ(std::vector<uint8_t>(read, read + 8), (std::vector<uint8_t>{0, 1, 2, 0, 1, 2, 3, 4}));
+}
+
+TEST(ByteQueueCapacity, TheFullCapacityIsUsed) {
+    uint8_t data[128];
+    byte_queue_t queue;
+    byte_queue_init(&queue, data, sizeof(data));
+    for (int i = 0; i < 128; i++) {
+        EXPECT_TRUE(byte_queue_push(&queue, i));
+    }
+    EXPECT_FALSE(byte_queue_push(&queue, 0));
+    EXPECT_EQ(byte_queue_length(&queue), 128);
+}
+
+namespace {
+
+const uint32_t STRESS_BYTES = 1000000;
+
+struct stress_t {
+    byte_queue_t queue;
+    uint8_t data[64];
+    uint32_t errors;
+};
+
+void* stress_producer(void* arg) {
+    stress_t* stress = static_cast<stress_t*>(arg);
+    std::mt19937 rng(1);
+    uint32_t sent = 0;
+    while (sent < STRESS_BYTES) {
+        // Let the other side run when the queue is full, also on one core
+        if (byte_queue_space(&stress->queue) == 0) {
+            sched_yield();
+        }
+        // Mix single bytes, bulk writes and direct span access
+        switch (rng() % 3) {
+        case 0:
+            if (byte_queue_push(&stress->queue, sent & 0xFF)) {
+                sent++;
+            }
+            break;
+        case 1: {
+            uint8_t bytes[40];
+            uint8_t length = std::min<uint32_t>(rng() % 40 + 1, STRESS_BYTES - sent);
+            for (uint8_t i = 0; i < length; i++) {
+                bytes[i] = (sent + i) & 0xFF;
+            }
+            sent += byte_queue_write(&stress->queue, bytes, length);
+            break;
+        }
+        default: {
+            uint8_t* span;
+            uint8_t length = std::min<uint32_t>(byte_queue_reserve(&stress->queue, &span), STRESS_BYTES - sent);
+            for (uint8_t i = 0; i < length; i++) {
+                span[i] = (sent + i) & 0xFF;
+            }
+            byte_queue_commit(&stress->queue, length);
+            sent += length;
+        }
+        }
+    }
+    return nullptr;
+}
+
+void* stress_consumer(void* arg) {
+    stress_t* stress = static_cast<stress_t*>(arg);
+    std::mt19937 rng(2);
+    uint32_t received = 0;
+    while (received < STRESS_BYTES) {
+        if (byte_queue_length(&stress->queue) == 0) {
+            sched_yield();
+        }
+        switch (rng() % 3) {
+        case 0: {
+            uint8_t byte;
+            if (byte_queue_pop(&stress->queue, &byte)) {
+                stress->errors += byte != (received & 0xFF);
+                received++;
+            }
+            break;
+        }
+        case 1: {
+            uint8_t bytes[40];
+            uint8_t length = byte_queue_read(&stress->queue, bytes, rng() % 40 + 1);
+            for (uint8_t i = 0; i < length; i++) {
+                stress->errors += bytes[i] != ((received + i) & 0xFF);
+            }
+            received += length;
+            break;
+        }
+        default: {
+            const uint8_t* span;
+            uint8_t length = byte_queue_peek(&stress->queue, &span);
+            for (uint8_t i = 0; i < length; i++) {
+                stress->errors += span[i] != ((received + i) & 0xFF);
+            }
+            byte_queue_consume(&stress->queue, length);
+            received += length;
+        }
+        }
+    }
+    return nullptr;
+}
+
+}
+
+TEST(ByteQueueStress, ProducerAndConsumerThreads) {
+    stress_t stress;
+    byte_queue_init(&stress.queue, stress.data, sizeof(stress.data));
+    stress.errors = 0;
+    pthread_t producer, consumer;
+    ASSERT_EQ(pthread_create(&consumer, nullptr, stress_consumer, &stress), 0);
+    ASSERT_EQ(pthread_create(&producer, nullptr, stress_producer, &stress), 0);
+    pthread_join(producer, nullptr);
+    pthread_join(consumer, nullptr);
+    EXPECT_EQ(stress.errors, 0u);
+    EXPECT_EQ(byte_queue_length(&stress.queue), 0);
+}
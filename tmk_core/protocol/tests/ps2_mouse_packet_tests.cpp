@@ -0,0 +1,124 @@
+/* Copyright 2026 QMK Firmware contributors
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+#include <vector>
+extern "C" {
+#include "protocol/ps2_mouse_packet.h"
+}
+
+using testing::ElementsAre;
+using testing::ElementsAreArray;
+
+class PS2MousePacket : public testing::Test {
+public:
+    void init(uint8_t size) {
+        ps2_mouse_packet_init(&packet, size);
+    }
+
+    void feed(std::vector<uint8_t> data) {
+        for (uint8_t d : data) {
+            if (ps2_mouse_packet_feed(&packet, d)) {
+                packets.emplace_back(packet.data, packet.data + packet.size);
+            }
+        }
+    }
+
+    ps2_mouse_packet_t packet;
+    std::vector<std::vector<uint8_t>> packets;
+};
+
+TEST_F(PS2MousePacket, AssemblesStandardPackets) {
+    init(PS2_MOUSE_PACKET_SIZE_STANDARD);
+    feed({0x08, 0x01, 0x02, 0x19, 0xFF, 0x03});
+    EXPECT_THAT(packets, ElementsAre(
+        ElementsAre(0x08, 0x01, 0x02),
+        ElementsAre(0x19, 0xFF, 0x03)));
+    EXPECT_EQ(packet.dropped, 0);
+}
+
+TEST_F(PS2MousePacket, AssemblesIntelliMousePackets) {
+    init(PS2_MOUSE_PACKET_SIZE_INTELLIMOUSE);
+    feed({0x08, 0x01, 0x02, 0x01, 0x09, 0x00, 0x00, 0xFF});
+    EXPECT_THAT(packets, ElementsAre(
+        ElementsAre(0x08, 0x01, 0x02, 0x01),
+        ElementsAre(0x09, 0x00, 0x00, 0xFF)));
+}
+
+TEST_F(PS2MousePacket, PacketsCanArriveAcrossSeveralCalls) {
+    init(PS2_MOUSE_PACKET_SIZE_STANDARD);
+    feed({0x08});
+    feed({0x05});
+    EXPECT_TRUE(packets.empty());
+    feed({0x06});
+    EXPECT_THAT(packets, ElementsAre(ElementsAre(0x08, 0x05, 0x06)));
+}
+
+TEST_F(PS2MousePacket, BytesThatCantStartAPacketAreDropped) {
+    init(PS2_MOUSE_PACKET_SIZE_STANDARD);
+    // Joined in the middle of a packet
+    feed({0x10, 0x00, 0x08, 0x01, 0x02});
+    EXPECT_THAT(packets, ElementsAre(ElementsAre(0x08, 0x01, 0x02)));
+    EXPECT_EQ(packet.dropped, 2);
+}
+
+TEST_F(PS2MousePacket, ResetDiscardsPartialPacket) {
+    init(PS2_MOUSE_PACKET_SIZE_STANDARD);
+    feed({0x08, 0x7F});
+    // The driver lost the third byte
+    ps2_mouse_packet_reset(&packet);
+    feed({0x09, 0x01, 0x02});
+    EXPECT_THAT(packets, ElementsAre(ElementsAre(0x09, 0x01, 0x02)));
+    EXPECT_EQ(packet.dropped, 2);
+}
+
+TEST_F(PS2MousePacket, ResyncsAfterLostIntelliMouseByte) {
+    init(PS2_MOUSE_PACKET_SIZE_INTELLIMOUSE);
+    // The wheel byte of the first packet is lost, which can't be detected
+    // until the remains of the second packet fail to start a new one
+    feed({0x08, 0x01, 0x02, 0x09, 0x00, 0x00, 0x01});
+    EXPECT_EQ(packets.size(), 1);
+    EXPECT_EQ(packet.dropped, 3);
+    // The next packet gets through intact
+    feed({0x0A, 0x05, 0x06, 0x00});
+    ASSERT_EQ(packets.size(), 2);
+    EXPECT_THAT(packets.back(), ElementsAre(0x0A, 0x05, 0x06, 0x00));
+}
+
+TEST_F(PS2MousePacket, InvalidWheelByteTriggersResync) {
+    init(PS2_MOUSE_PACKET_SIZE_INTELLIMOUSE);
+    // 0x48 can't be a wheel byte, so the packet starts at 0x48 instead
+    feed({0x08, 0x01, 0x02, 0x48, 0x03, 0x04, 0xFF});
+    EXPECT_THAT(packets, ElementsAre(ElementsAre(0x48, 0x03, 0x04, 0xFF)));
+    EXPECT_EQ(packet.dropped, 3);
+}
+
+TEST_F(PS2MousePacket, RecoversFromRandomCorruption) {
+    init(PS2_MOUSE_PACKET_SIZE_STANDARD);
+    std::vector<uint8_t> good = {0x08, 0x10, 0x20};
+    std::vector<uint8_t> stream;
+    for (int i = 0; i < 10; i++) {
+        stream.insert(stream.end(), good.begin(), good.end());
+    }
+    // Drop a byte in the middle
+    stream.erase(stream.begin() + 4);
+    feed(stream);
+    ASSERT_GE(packets.size(), 7);
+    for (size_t i = packets.size() - 5; i < packets.size(); i++) {
+        EXPECT_THAT(packets[i], ElementsAreArray(good));
+    }
+}
@@ -0,0 +1,29 @@
+# Copyright 2026 QMK Firmware contributors
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 2 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+PROTOCOL_PATH = $(TMK_PATH)/protocol
+
+ps2_mouse_packet_SRC := \
+	$(PROTOCOL_PATH)/tests/ps2_mouse_packet_tests.cpp \
+	$(PROTOCOL_PATH)/ps2_mouse_packet.c
+
+byte_queue_SRC := \
+	$(PROTOCOL_PATH)/tests/byte_queue_tests.cpp
+
+trace_SRC := \
+	$(PROTOCOL_PATH)/tests/trace_tests.cpp \
+	$(TMK_PATH)/common/trace.c
+
+trace_DEFS := -DTRACE_BUFFER_SIZE=32
@@ -0,0 +1,4 @@
+TEST_LIST +=\
+	ps2_mouse_packet\
+	byte_queue\
+	trace
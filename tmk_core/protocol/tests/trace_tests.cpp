@@ -0,0 +1,132 @@
+/* Copyright 2026 QMK Firmware contributors
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+#include <vector>
+extern "C" {
+#include "trace.h"
+}
+
+using testing::ElementsAre;
+using testing::ElementsAreArray;
+
+static std::vector<uint8_t> sent;
+
+extern "C" int8_t sendchar(uint8_t c) {
+    sent.push_back(c);
+    return 0;
+}
+
+class Trace : public testing::Test {
+public:
+    Trace() {
+        drain();
+    }
+
+    ~Trace() {
+        drain();
+    }
+
+    void drain() {
+        size_t size;
+        do {
+            size = sent.size();
+            trace_task();
+        } while (sent.size() != size);
+        sent.clear();
+    }
+
+    void write(uint8_t id, std::vector<uint16_t> args = {}) {
+        trace_write(id, args.data(), args.size());
+    }
+
+    std::vector<uint8_t> record(uint8_t id, std::vector<uint16_t> args = {}) {
+        std::vector<uint8_t> bytes = {(uint8_t)(TRACE_RECORD_MARK | id)};
+        for (uint16_t arg : args) {
+            bytes.push_back(0x80 | (arg & 0x7F));
+            bytes.push_back(0x80 | ((arg >> 7) & 0x7F));
+            bytes.push_back(0x80 | (arg >> 14));
+        }
+        return bytes;
+    }
+};
+
+TEST_F(Trace, RecordsAreSentByTheTask) {
+    write(TRACE_TAPPING_TAP_PRESS, {3});
+    EXPECT_TRUE(sent.empty());
+    trace_task();
+    EXPECT_THAT(sent, ElementsAre(0x80 | TRACE_TAPPING_TAP_PRESS, 0x83, 0x80, 0x80));
+}
+
+TEST_F(Trace, TheTaskSendsOneRecordAtATime) {
+    write(TRACE_NEWLINE);
+    write(TRACE_TAPPING_TAP_PRESS, {1});
+    trace_task();
+    EXPECT_THAT(sent, ElementsAreArray(record(TRACE_NEWLINE)));
+    sent.clear();
+    trace_task();
+    EXPECT_THAT(sent, ElementsAreArray(record(TRACE_TAPPING_TAP_PRESS, {1})));
+    sent.clear();
+    trace_task();
+    EXPECT_TRUE(sent.empty());
+}
+
+TEST_F(Trace, ArgumentsKeepAllSixteenBits) {
+    write(TRACE_ACTION_EVENT, {0xFFFF, 'd', 0x1234});
+    trace_task();
+    EXPECT_THAT(sent, ElementsAre(0x80 | TRACE_ACTION_EVENT, 0xFF, 0xFF, 0x83, 0xE4, 0x80, 0x80, 0xB4, 0xA4, 0x80));
+}
+
+TEST_F(Trace, TheOutputCanBeToldApartFromText) {
+    write(TRACE_KEYBOARD_REPORT, {0, 0, 0, 0, 0, 0, 0, 0});
+    trace_task();
+    for (uint8_t byte : sent) {
+        EXPECT_GE(byte, 0x80);
+    }
+}
+
+TEST_F(Trace, RecordsAreDroppedAndCountedWhenTheBufferIsFull) {
+    // Records without arguments take two bytes
+    for (int i = 0; i < TRACE_BUFFER_SIZE / 2; i++) {
+        write(TRACE_NEWLINE);
+    }
+    write(TRACE_TAPPING_TAP_PRESS, {1});
+    write(TRACE_TAPPING_TAP_PRESS, {2});
+    write(TRACE_TAPPING_TAP_PRESS, {3});
+    drain();
+    write(TRACE_TAPPING_TAP_PRESS, {4});
+    trace_task();
+    EXPECT_THAT(sent, ElementsAreArray(record(TRACE_DROPPED, {3})));
+    sent.clear();
+    trace_task();
+    EXPECT_THAT(sent, ElementsAreArray(record(TRACE_TAPPING_TAP_PRESS, {4})));
+}
+
+TEST_F(Trace, NothingIsLoggedBeforeTheDroppedCount) {
+    for (int i = 0; i < TRACE_BUFFER_SIZE / 2; i++) {
+        write(TRACE_NEWLINE);
+    }
+    write(TRACE_TAPPING_TAP_PRESS, {1});
+    // There is space for a record without arguments, but not for the count
+    trace_task();
+    write(TRACE_NEWLINE);
+    drain();
+    write(TRACE_NEWLINE);
+    trace_task();
+    EXPECT_THAT(sent, ElementsAreArray(record(TRACE_DROPPED, {2})));
+}